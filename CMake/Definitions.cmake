@@ -10,6 +10,7 @@ foreach(
   DISABLE_STREAMING_MUSIC
   DISABLE_STREAMING_SOUNDS
   DISABLE_DEMOMODE
+  DISABLE_FRAME_PROFILER
   BUILD_TESTING
   GPERF
   GPERF_HEAP_MAIN
@@ -94,6 +95,8 @@ foreach(
   REMAP_KEYBOARD_KEYS
   DEVILUTIONX_DEFAULT_RESAMPLER
   STREAM_ALL_AUDIO_MIN_FILE_SIZE
+  DEVILUTIONX_MPQ_CACHE_SIZE
+  DEVILUTIONX_SOUND_CACHE_SIZE
   DEVILUTIONX_DISPLAY_PIXELFORMAT # SDL2-only
   DEVILUTIONX_DISPLAY_TEXTURE_FORMAT # SDL2-only
   DEVILUTIONX_SCREENSHOT_FORMAT
@@ -23,9 +23,11 @@ set(tests
   drlg_l2_test
   drlg_l3_test
   drlg_l4_test
+  dun_render_test
   effects_test
   inv_test
   items_test
+  loadsave_test
   math_test
   missiles_test
   multi_logging_test
@@ -39,6 +41,7 @@ set(tests
   townerdat_test
   writehero_test
   vendor_test
+  world_snapshot_test
   panel_state_test
   store_transaction_test
   visual_store_test
@@ -49,12 +52,18 @@ set(tests
   game_menu_test
 )
 set(standalone_tests
+  asset_prefetch_test
   codec_test
   crawl_test
   data_file_test
+  delimiter_scan_test
   file_util_test
   format_int_test
+  frame_profiler_test
+  frame_time_stats_test
   ini_test
+  light_render_test
+  light_table_simd_test
   mod_identity_test
   palette_blending_test
   parse_int_test
@@ -63,17 +72,29 @@ set(standalone_tests
   random_test
   rectangle_test
   sheen_bidi_test
+  shared_asset_cache_test
+  sound_cache_test
   static_vector_test
   str_cat_test
+  task_graph_test
+  thread_pool_test
   utf8_test
 )
 if(NOT USE_SDL1)
   list(APPEND standalone_tests text_render_integration_test)
 endif()
+if(SUPPORTS_MPQ)
+  list(APPEND tests clx_cache_test mpq_reader_test)
+  list(APPEND standalone_tests mpq_file_cache_test)
+endif()
 set(benchmarks
+  asset_lookup_benchmark
   clx_render_benchmark
+  codec_benchmark
   crawl_benchmark
+  data_file_benchmark
   dun_render_benchmark
+  level_load_benchmark
   light_render_benchmark
   palette_blending_benchmark
   path_benchmark
@@ -113,6 +134,7 @@ target_sources(app_fatal_for_testing INTERFACE $<TARGET_OBJECTS:app_fatal_for_te
 add_library(language_for_testing OBJECT test/language_for_testing.cpp)
 target_sources(language_for_testing INTERFACE $<TARGET_OBJECTS:language_for_testing>)
 
+target_link_dependencies(asset_prefetch_test PRIVATE libdevilutionx_asset_prefetch app_fatal_for_testing)
 target_link_dependencies(codec_test PRIVATE libdevilutionx_codec app_fatal_for_testing)
 
 add_custom_target(clx_render_benchmark_resources
@@ -132,16 +154,28 @@ target_link_dependencies(clx_render_benchmark
   libdevilutionx_log
   libdevilutionx_surface
 )
+target_link_dependencies(asset_lookup_benchmark PRIVATE libdevilutionx_so)
+target_link_dependencies(codec_benchmark PRIVATE libdevilutionx_codec app_fatal_for_testing)
 target_link_dependencies(crawl_test PRIVATE libdevilutionx_crawl)
 target_link_dependencies(crawl_benchmark PRIVATE libdevilutionx_crawl)
+target_link_dependencies(data_file_benchmark PRIVATE libdevilutionx_so)
 target_link_dependencies(data_file_test PRIVATE libdevilutionx_txtdata app_fatal_for_testing language_for_testing)
+target_link_dependencies(delimiter_scan_test PRIVATE libdevilutionx_delimiter_scan)
 target_link_dependencies(dun_render_benchmark PRIVATE libdevilutionx_so)
 target_link_dependencies(file_util_test PRIVATE libdevilutionx_file_util app_fatal_for_testing)
 target_link_dependencies(format_int_test PRIVATE libdevilutionx_format_int language_for_testing)
+target_link_dependencies(frame_profiler_test PRIVATE libdevilutionx_frame_profiler app_fatal_for_testing)
+target_link_dependencies(frame_time_stats_test PRIVATE libdevilutionx_frame_time_stats)
 target_link_dependencies(ini_test PRIVATE libdevilutionx_ini app_fatal_for_testing)
+target_link_dependencies(level_load_benchmark PRIVATE libdevilutionx_so)
+target_link_dependencies(light_table_simd_test PRIVATE libdevilutionx_light_table_simd)
+if(SUPPORTS_MPQ)
+  target_link_dependencies(mpq_file_cache_test PRIVATE libdevilutionx_mpq_file_cache app_fatal_for_testing)
+endif()
 target_link_dependencies(mod_identity_test PRIVATE libdevilutionx_mod_identity app_fatal_for_testing)
 target_include_directories(mod_identity_test PRIVATE "${PROJECT_SOURCE_DIR}/3rdParty/PicoSHA2")
 target_link_dependencies(light_render_benchmark PRIVATE libdevilutionx_light_render DevilutionX::SDL libdevilutionx_surface libdevilutionx_paths app_fatal_for_testing)
+target_link_dependencies(light_render_test PRIVATE libdevilutionx_light_render)
 target_link_dependencies(palette_blending_test PRIVATE libdevilutionx_palette_blending DevilutionX::SDL libdevilutionx_strings GTest::gmock app_fatal_for_testing)
 target_link_dependencies(palette_blending_benchmark
   PRIVATE
@@ -155,8 +189,12 @@ target_link_dependencies(path_test PRIVATE libdevilutionx_pathfinding libdevilut
 target_link_dependencies(vision_test PRIVATE libdevilutionx_vision)
 target_link_dependencies(path_benchmark PRIVATE libdevilutionx_pathfinding app_fatal_for_testing)
 target_link_dependencies(random_test PRIVATE libdevilutionx_random)
+target_link_dependencies(shared_asset_cache_test PRIVATE unordered_dense::unordered_dense)
+target_link_dependencies(sound_cache_test PRIVATE unordered_dense::unordered_dense)
 target_link_dependencies(static_vector_test PRIVATE libdevilutionx_random app_fatal_for_testing)
 target_link_dependencies(str_cat_test PRIVATE libdevilutionx_strings)
+target_link_dependencies(task_graph_test PRIVATE libdevilutionx_task_graph app_fatal_for_testing)
+target_link_dependencies(thread_pool_test PRIVATE libdevilutionx_thread_pool app_fatal_for_testing)
 if(DEVILUTIONX_SCREENSHOT_FORMAT STREQUAL DEVILUTIONX_SCREENSHOT_FORMAT_PNG AND NOT USE_SDL1)
   target_link_dependencies(text_render_integration_test
     PRIVATE
@@ -4,6 +4,7 @@ set(UBSAN OFF)
 set(NONET ON)
 set(USE_SDL1 ON)
 set(SDL1_VIDEO_MODE_BPP 8)
+set(DEVILUTIONX_MPQ_CACHE_SIZE 0)
 
 set(DEVILUTIONX_SYSTEM_BZIP2 OFF)
 set(DEVILUTIONX_SYSTEM_ZLIB OFF)
@@ -5,6 +5,7 @@ set(DIST ON)
 set(NONET ON)
 set(PACKET_ENCRYPTION OFF)
 set(DEFAULT_PER_PIXEL_LIGHTING false)
+set(DEVILUTIONX_MPQ_CACHE_SIZE 0)
 
 set(DEVILUTIONX_SYSTEM_BZIP2 OFF)
 set(DEVILUTIONX_SYSTEM_ZLIB OFF)
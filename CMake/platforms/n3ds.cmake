@@ -7,6 +7,9 @@ set(DEVILUTIONX_SYSTEM_LIBSODIUM OFF)
 set(DEVILUTIONX_STATIC_LIBSODIUM ON)
 set(DISABLE_ZERO_TIER ON)
 set(MPQFS_FILE_BUFFER_SIZE 32768)
+# Not enough RAM to keep decompressed MPQ files around.
+set(DEVILUTIONX_MPQ_CACHE_SIZE 0)
+set(DEVILUTIONX_SOUND_CACHE_SIZE 4194304)
 set(NOEXIT ON)
 
 # 3DS libraries and compile definitions
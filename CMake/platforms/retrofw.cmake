@@ -1,6 +1,8 @@
 set(BUILD_ASSETS_MPQ OFF)
 set(NONET ON)
 set(USE_SDL1 ON)
+set(DEVILUTIONX_MPQ_CACHE_SIZE 0)
+set(DEVILUTIONX_SOUND_CACHE_SIZE 4194304)
 set(PREFILL_PLAYER_NAME ON)
 set(HAS_KBCTRL 1)
 set(DEVILUTIONX_GAMEPAD_TYPE Nintendo)
@@ -24,6 +24,8 @@ set(DEVILUTIONX_PALETTE_TRANSPARENCY_BLACK_16_LUT OFF)
 
 # Must stream most of the audio due to RAM constraints.
 set(STREAM_ALL_AUDIO_MIN_FILE_SIZE 4096)
+# Keep at most 2 MiB of sound effects loaded.
+set(DEVILUTIONX_SOUND_CACHE_SIZE 2097152)
 
 # Must use a smaller audio buffer due to RAM constraints.
 set(DEFAULT_AUDIO_BUFFER_SIZE 768)
@@ -19,6 +19,9 @@ set(DEVILUTIONX_WINDOWS_NO_WCHAR ON)
 set(DEVILUTIONX_RESAMPLER_SPEEX OFF)
 set(DEFAULT_AUDIO_BUFFER_SIZE 5120)
 
+# 64 MiB of RAM, leave it to the game.
+set(DEVILUTIONX_MPQ_CACHE_SIZE 0)
+
 set(DEVILUTIONX_GAMEPAD_TYPE Xbox)
 
 set(CMAKE_THREAD_LIBS_INIT "-lpthread")
@@ -31,7 +31,7 @@ enum MapExplorationType : uint8_t {
 /** Specifies whether the automap is enabled. */
 extern DVL_API_FOR_TEST bool AutomapActive;
 /** Tracks the explored areas of the map. */
-extern uint8_t AutomapView[DMAXX][DMAXY];
+extern DVL_API_FOR_TEST uint8_t AutomapView[DMAXX][DMAXY];
 /** Specifies the scale of the automap. */
 extern DVL_API_FOR_TEST int AutoMapScale;
 extern DVL_API_FOR_TEST int MinimapScale;
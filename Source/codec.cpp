@@ -1,4 +1,3 @@
-#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -6,7 +5,7 @@
 #include "appfat.h"
 #include "sha.h"
 #include "utils/endian_read.hpp"
-#include "utils/endian_swap.hpp"
+#include "utils/endian_write.hpp"
 #include "utils/log.hpp"
 
 namespace devilution {
@@ -75,42 +74,47 @@ void SetCodecSignature(std::byte *dst, CodecSignature sig)
 	*dst++ = static_cast<std::byte>(0);
 }
 
-void ByteSwapBlock(uint32_t *data)
+/**
+ * @brief Encodes or decodes a run of whole blocks in place.
+ *
+ * Each block is XORed with the digest of all the plain text before it, so this is inherently sequential.
+ *
+ * @tparam Encode Whether `data` is plain text, which decides whether the digest is updated before or after the XOR
+ */
+template <bool Encode>
+void CodecBlocks(SHA1Context &context, std::byte *data, size_t count)
 {
-	for (size_t i = 0; i < BlockSize; ++i)
-		data[i] = Swap32LE(data[i]);
-}
-
-void XorBlock(const uint32_t *shaResult, uint32_t *out)
-{
-	for (unsigned i = 0; i < BlockSize; ++i)
-		out[i] ^= shaResult[i % SHA1HashSize];
+	uint32_t block[BlockSize];
+	for (; count != 0; --count, data += BlockSizeBytes) {
+		for (size_t i = 0; i < BlockSize; ++i)
+			block[i] = LoadLE32(&data[i * sizeof(uint32_t)]);
+		const SHA1Context key = context;
+		if constexpr (Encode)
+			SHA1Calculate(context, block);
+		for (size_t i = 0; i < BlockSize; ++i)
+			block[i] ^= key.state[i % SHA1HashSize];
+		if constexpr (!Encode)
+			SHA1Calculate(context, block);
+		for (size_t i = 0; i < BlockSize; ++i)
+			WriteLE32(&data[i * sizeof(uint32_t)], block[i]);
+	}
 }
 
 } // namespace
 
 std::size_t codec_decode(std::byte *pbSrcDst, std::size_t size, const char *pszPassword)
 {
-	uint32_t buf[BlockSize];
 	uint32_t dst[SHA1HashSize];
 
 	SHA1Context context = CodecInitKey(pszPassword);
 	if (size <= SignatureSize)
 		return 0;
 	size -= SignatureSize;
-	if (size % BlockSize != 0)
+	if (size % BlockSizeBytes != 0)
 		return 0;
-	for (size_t i = 0; i < size; pbSrcDst += BlockSizeBytes, i += BlockSizeBytes) {
-		memcpy(buf, pbSrcDst, BlockSizeBytes);
-		ByteSwapBlock(buf);
-		SHA1Result(context, dst);
-		XorBlock(dst, buf);
-		SHA1Calculate(context, buf);
-		ByteSwapBlock(buf);
-		memcpy(pbSrcDst, buf, BlockSizeBytes);
-	}
+	CodecBlocks</*Encode=*/false>(context, pbSrcDst, size / BlockSizeBytes);
+	pbSrcDst += size;
 
-	memset(buf, 0, sizeof(buf));
 	const CodecSignature sig = GetCodecSignature(pbSrcDst);
 	if (sig.error > 0) {
 		return 0;
@@ -136,30 +140,19 @@ std::size_t codec_get_encoded_len(std::size_t dwSrcBytes)
 
 void codec_encode(std::byte *pbSrcDst, std::size_t size, std::size_t size64, const char *pszPassword)
 {
-	uint32_t buf[BlockSize];
 	uint32_t tmp[SHA1HashSize];
-	uint32_t dst[SHA1HashSize];
 
 	if (size64 != codec_get_encoded_len(size))
 		app_fatal("Invalid encode parameters");
 	SHA1Context context = CodecInitKey(pszPassword);
 
-	size_t lastChunk = 0;
-	while (size != 0) {
-		const size_t chunk = std::min(size, BlockSizeBytes);
-		memset(buf, 0, sizeof(buf));
-		memcpy(buf, pbSrcDst, chunk);
-		ByteSwapBlock(buf);
-		SHA1Result(context, dst);
-		SHA1Calculate(context, buf);
-		XorBlock(dst, buf);
-		ByteSwapBlock(buf);
-		memcpy(pbSrcDst, buf, BlockSizeBytes);
-		pbSrcDst += BlockSizeBytes;
-		lastChunk = chunk;
-		size -= chunk;
-	}
-	memset(buf, 0, sizeof(buf));
+	// The last block is padded with zeroes, in place, so that all blocks can be encoded in one go.
+	const size_t paddedSize = size64 - SignatureSize;
+	memset(pbSrcDst + size, 0, paddedSize - size);
+	CodecBlocks</*Encode=*/true>(context, pbSrcDst, paddedSize / BlockSizeBytes);
+	pbSrcDst += paddedSize;
+
+	const size_t lastChunk = size == 0 ? 0 : (size - 1) % BlockSizeBytes + 1;
 	SHA1Result(context, tmp);
 	SetCodecSignature(pbSrcDst, CodecSignature { /*.checksum=*/*reinterpret_cast<uint32_t *>(tmp),
 	                                /*.error=*/0,
@@ -0,0 +1,262 @@
+#include "data/compiled_file.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "engine/assets.hpp"
+#include "utils/file_util.h"
+#include "utils/log.hpp"
+#include "utils/mapped_file.hpp"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+
+namespace {
+
+/** @brief Bump this whenever the compiled format changes. */
+constexpr uint32_t CompiledDataFileVersion = 3;
+
+constexpr char CompiledDataFileMagic[4] = { 'D', 'X', 'T', 'B' };
+
+/**
+ * @brief The header of a compiled data file, followed by the key of its source and then the records.
+ *
+ * Compiled files are never shared between systems, so the header is stored in native byte order.
+ */
+struct CompiledDataFileHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t keySize;
+	uint32_t reserved;
+	/** @brief `HashDataFileSource` of the source. */
+	uint64_t sourceHash;
+	/** @brief Same as `DataFile::numRecords()` of the source. */
+	uint64_t numRecords;
+	uint64_t recordsSize;
+};
+
+std::string CacheDirectory;
+
+std::atomic<size_t> Hits;
+std::atomic<size_t> Misses;
+std::atomic<uint32_t> NextTempFileId;
+
+void AppendFieldLength(std::string &out, size_t length)
+{
+	out += static_cast<char>(length & 0xFF);
+	out += static_cast<char>((length >> 8) & 0xFF);
+}
+
+uint64_t HashBytes(std::string_view bytes)
+{
+	// 64-bit FNV-1a, stable across platforms and runs.
+	uint64_t hash = 0xcbf29ce484222325;
+	for (const char c : bytes) {
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 0x100000001b3;
+	}
+	return hash;
+}
+
+std::string CacheFilePath(std::string_view sourceKey)
+{
+	char name[17];
+	std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(HashBytes(sourceKey)));
+	return StrCat(CacheDirectory, name, ".dxtb");
+}
+
+/** @return An empty string if the file can't be inspected. */
+std::string GetFileIdentity(const std::string &path)
+{
+	std::uintmax_t size;
+	std::int64_t mtime;
+	if (!GetFileSize(path.c_str(), &size) || !GetFileModificationTime(path.c_str(), &mtime))
+		return {};
+	return StrCat(path, "|", size, "|", mtime);
+}
+
+/** @brief Reads a whole file, for platforms that can't memory-map it. */
+std::optional<std::string> ReadWholeFile(const char *path)
+{
+	std::uintmax_t size;
+	if (!GetFileSize(path, &size) || size == 0)
+		return std::nullopt;
+	FILE *file = OpenFile(path, "rb");
+	if (file == nullptr)
+		return std::nullopt;
+	std::string contents(static_cast<size_t>(size), '\0');
+	const bool ok = std::fread(contents.data(), contents.size(), 1, file) == 1;
+	std::fclose(file);
+	if (!ok)
+		return std::nullopt;
+	return contents;
+}
+
+std::optional<DataFile> OpenCachedDataFile(const std::string &cachePath, std::string_view sourceKey, std::optional<uint64_t> sourceHash)
+{
+	if (std::optional<MappedFile> mapped = MappedFile::Open(cachePath.c_str())) {
+		auto file = std::make_shared<MappedFile>(*std::move(mapped));
+		const char *data = file->data();
+		const size_t size = file->size();
+		return OpenCompiledDataFile(std::shared_ptr<const char>(std::move(file), data), size, sourceKey, sourceHash);
+	}
+	if (std::optional<std::string> contents = ReadWholeFile(cachePath.c_str())) {
+		auto file = std::make_shared<const std::string>(*std::move(contents));
+		const char *data = file->data();
+		const size_t size = file->size();
+		return OpenCompiledDataFile(std::shared_ptr<const char>(std::move(file), data), size, sourceKey, sourceHash);
+	}
+	return std::nullopt;
+}
+
+void StoreCompiledDataFile(const std::string &cachePath, std::string_view compiled)
+{
+	// Written under a unique name and then renamed, so that a partially written file is never
+	// read, even if several threads compile the same file.
+	const std::string tempPath = StrCat(cachePath, ".", NextTempFileId++, ".tmp");
+	FILE *file = OpenFile(tempPath.c_str(), "wb");
+	if (file == nullptr) {
+		LogError("Failed to write data file cache file {}", tempPath);
+		return;
+	}
+	const bool ok = std::fwrite(compiled.data(), compiled.size(), 1, file) == 1;
+	if (std::fclose(file) != 0 || !ok) {
+		LogError("Failed to write data file cache file {}", tempPath);
+		RemoveFile(tempPath.c_str());
+		return;
+	}
+	RenameFile(tempPath.c_str(), cachePath.c_str());
+	// The rename fails on some systems if another thread got there first.
+	if (FileExists(tempPath))
+		RemoveFile(tempPath.c_str());
+}
+
+} // namespace
+
+std::optional<std::string> DataFileSourceKey(const AssetRef &ref, std::string_view path)
+{
+	std::string identity;
+#ifdef UNPACKED_MPQS
+	identity = GetFileIdentity(ref.path);
+#else
+	if (ref.archive != nullptr) {
+		identity = GetFileIdentity(ref.archive->path());
+		if (!identity.empty())
+			StrAppend(identity, "|", ref.hashIndex, "|", ref.size());
+	} else if (!ref.directPath.empty()) {
+		identity = GetFileIdentity(ref.directPath);
+	}
+#endif
+	if (identity.empty())
+		return std::nullopt;
+	StrAppend(identity, "|", path);
+	return identity;
+}
+
+uint64_t HashDataFileSource(const DataFile &source)
+{
+	return HashBytes({ source.data(), source.size() });
+}
+
+std::expected<std::string, std::string> CompileDataFile(const DataFile &source, std::string_view sourceKey)
+{
+	std::string compiled(sizeof(CompiledDataFileHeader), '\0');
+	// Every field gains a length prefix, which is at least as long as a separator.
+	compiled.reserve(sizeof(CompiledDataFileHeader) + sourceKey.size() + source.size() * 2);
+	compiled.append(sourceKey);
+
+	// Every field is read, so it pays to find the delimiters of a text file up front.
+	std::optional<DelimiterIndex> index;
+	if (source.encoding() == FieldEncoding::Text && GetDelimiterScanIsa() != DelimiterScanIsa::Scalar)
+		index.emplace(source.data(), source.size());
+	const DelimiterIndex *indexPtr = index.has_value() ? &*index : nullptr;
+
+	for (RecordIterator it { source.data(), source.data() + source.size(), false, source.encoding(), indexPtr }; it != RecordIterator {}; ++it) {
+		for (DataFileField field : *it) {
+			const std::string_view value = field.value();
+			if (value.size() > std::numeric_limits<uint16_t>::max())
+				return std::unexpected(StrCat("Field at row ", field.row(), " and column ", field.column(), " is too long"));
+			AppendFieldLength(compiled, value.size());
+			compiled.append(value);
+			compiled += '\t';
+		}
+		compiled.back() = '\n';
+	}
+
+	CompiledDataFileHeader header {};
+	std::memcpy(header.magic, CompiledDataFileMagic, sizeof(CompiledDataFileMagic));
+	header.version = CompiledDataFileVersion;
+	header.keySize = static_cast<uint32_t>(sourceKey.size());
+	header.sourceHash = HashDataFileSource(source);
+	header.numRecords = source.numRecords();
+	header.recordsSize = compiled.size() - sizeof(header) - sourceKey.size();
+	std::memcpy(compiled.data(), &header, sizeof(header));
+	return compiled;
+}
+
+std::optional<DataFile> OpenCompiledDataFile(std::shared_ptr<const char> data, size_t size, std::string_view sourceKey, std::optional<uint64_t> sourceHash)
+{
+	CompiledDataFileHeader header;
+	if (size < sizeof(header) + sourceKey.size())
+		return std::nullopt;
+	std::memcpy(&header, data.get(), sizeof(header));
+	// The file name is only a hash of the key, so the key itself is compared too.
+	if (std::memcmp(header.magic, CompiledDataFileMagic, sizeof(CompiledDataFileMagic)) != 0
+	    || header.version != CompiledDataFileVersion
+	    || header.keySize != sourceKey.size()
+	    || std::string_view { data.get() + sizeof(header), sourceKey.size() } != sourceKey
+	    || (sourceHash.has_value() && header.sourceHash != *sourceHash)
+	    || header.recordsSize != size - sizeof(header) - sourceKey.size()) {
+		return std::nullopt;
+	}
+	const std::string_view records { data.get() + sizeof(header) + sourceKey.size(), static_cast<size_t>(header.recordsSize) };
+	return DataFile { std::move(data), records, FieldEncoding::LengthPrefixed, static_cast<size_t>(header.numRecords) };
+}
+
+void EnableDataFileCache(std::string directory)
+{
+	if (!directory.empty() && directory.back() != DirectorySeparator && directory.back() != '/')
+		directory += DIRECTORY_SEPARATOR_STR;
+	RecursivelyCreateDir(directory.c_str());
+	CacheDirectory = std::move(directory);
+	LogVerbose("Caching compiled data files in {}", CacheDirectory);
+}
+
+bool IsDataFileCacheEnabled()
+{
+	return !CacheDirectory.empty();
+}
+
+std::optional<DataFile> LoadCachedDataFile(std::string_view sourceKey, std::optional<uint64_t> sourceHash)
+{
+	if (std::optional<DataFile> cached = OpenCachedDataFile(CacheFilePath(sourceKey), sourceKey, sourceHash)) {
+		++Hits;
+		return cached;
+	}
+	++Misses;
+	return std::nullopt;
+}
+
+std::optional<DataFile> CompileAndCacheDataFile(const DataFile &source, std::string_view sourceKey, std::string_view path)
+{
+	std::expected<std::string, std::string> compiled = CompileDataFile(source, sourceKey);
+	if (!compiled.has_value()) {
+		LogError("Can't compile {}: {}", path, compiled.error());
+		return std::nullopt;
+	}
+	StoreCompiledDataFile(CacheFilePath(sourceKey), *compiled);
+	auto file = std::make_shared<const std::string>(*std::move(compiled));
+	const char *data = file->data();
+	const size_t size = file->size();
+	return OpenCompiledDataFile(std::shared_ptr<const char>(std::move(file), data), size, sourceKey);
+}
+
+DataFileCacheStats GetDataFileCacheStats()
+{
+	return DataFileCacheStats { Hits, Misses };
+}
+
+} // namespace devilution
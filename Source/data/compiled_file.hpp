@@ -0,0 +1,94 @@
+/**
+ * @file compiled_file.hpp
+ *
+ * Data files compiled ahead of time, so that they can be read without scanning for separators.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "data/file.hpp"
+
+namespace devilution {
+
+struct AssetRef;
+
+struct DataFileCacheStats {
+	size_t hits = 0;
+	size_t misses = 0;
+};
+
+/**
+ * @brief Identifies the source of a data file by the path, size and modification time of the
+ * file it is read from, so that a compiled file can be found without reading the source.
+ *
+ * For a file in an archive, this is the archive's file, along with the entry within it.
+ *
+ * An edit that keeps the size and modification time doesn't change the key, so the contents of
+ * loose files are checked too, see `HashDataFileSource`.
+ *
+ * @param ref the asset that `FindAsset(path)` returned
+ * @return std::nullopt if the file the asset is read from can't be inspected, such as on Android
+ */
+[[nodiscard]] std::optional<std::string> DataFileSourceKey(const AssetRef &ref, std::string_view path);
+
+/**
+ * @brief A hash of the contents of a text data file, stored in the files compiled from it.
+ */
+[[nodiscard]] uint64_t HashDataFileSource(const DataFile &source);
+
+/**
+ * @brief Converts a text data file to the compiled format.
+ *
+ * A compiled file is a header followed by the records of the source, header row included, with
+ * every field prefixed by its length (see `FieldEncoding::LengthPrefixed`). Field and record
+ * separators are kept, so the typed loaders read it through the same iterators as a text file.
+ *
+ * @param source a text data file, with or without its header parsed
+ * @param sourceKey `DataFileSourceKey` of the source, stored in the compiled file along with `HashDataFileSource`
+ * @return the compiled file or an error message if a field is too long to be length-prefixed
+ */
+[[nodiscard]] std::expected<std::string, std::string> CompileDataFile(const DataFile &source, std::string_view sourceKey);
+
+/**
+ * @brief Opens a compiled data file.
+ * @param sourceHash `HashDataFileSource` of the source if it has been read, std::nullopt to trust `sourceKey`
+ * @return std::nullopt if the file is malformed, was compiled by a different version, or was
+ * compiled from a source other than the one with `sourceKey` and `sourceHash`.
+ */
+std::optional<DataFile> OpenCompiledDataFile(std::shared_ptr<const char> data, size_t size, std::string_view sourceKey, std::optional<uint64_t> sourceHash = std::nullopt);
+
+/**
+ * @brief Stores data files compiled from their text in `directory`, so that they do not have
+ * to be tokenized again on the next launch.
+ *
+ * Must be called before any data files are loaded.
+ */
+void EnableDataFileCache(std::string directory);
+
+[[nodiscard]] bool IsDataFileCacheEnabled();
+
+/**
+ * @brief Returns the cached compiled form of the source with `sourceKey`.
+ * @param sourceHash see `OpenCompiledDataFile`
+ * @return std::nullopt on a miss, after which the source has to be read and `CompileAndCacheDataFile` called
+ */
+std::optional<DataFile> LoadCachedDataFile(std::string_view sourceKey, std::optional<uint64_t> sourceHash = std::nullopt);
+
+/**
+ * @brief Compiles `source` and stores it in the cache under `sourceKey`.
+ * @param path used for error messages
+ * @return std::nullopt if the source can't be compiled
+ */
+std::optional<DataFile> CompileAndCacheDataFile(const DataFile &source, std::string_view sourceKey, std::string_view path);
+
+/** @brief Lookups since startup. */
+[[nodiscard]] DataFileCacheStats GetDataFileCacheStats();
+
+} // namespace devilution
@@ -0,0 +1,142 @@
+#include "data/delimiter_scan.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "utils/cpu_features.hpp"
+
+#if DVL_SIMD_X86
+#include <emmintrin.h>
+#elif DVL_SIMD_AARCH64
+#include <arm_neon.h>
+#endif
+
+namespace devilution {
+
+namespace {
+
+constexpr bool IsDelimiter(char c)
+{
+	return c == '\t' || c == '\r' || c == '\n';
+}
+
+uint64_t ScanWordScalar(const char *data, size_t length)
+{
+	uint64_t bits = 0;
+	for (size_t i = 0; i < length; ++i)
+		bits |= static_cast<uint64_t>(IsDelimiter(data[i])) << i;
+	return bits;
+}
+
+void ScanDelimitersScalar(const char *data, size_t size, uint64_t *bits)
+{
+	for (size_t i = 0; i < size; i += 64)
+		*bits++ = ScanWordScalar(data + i, std::min<size_t>(size - i, 64));
+}
+
+#if DVL_SIMD_X86
+DVL_TARGET("sse2") void ScanDelimitersSse2(const char *data, size_t size, uint64_t *bits)
+{
+	const __m128i tab = _mm_set1_epi8('\t');
+	const __m128i cr = _mm_set1_epi8('\r');
+	const __m128i lf = _mm_set1_epi8('\n');
+	size_t i = 0;
+	for (; size - i >= 64; i += 64) {
+		uint64_t word = 0;
+		for (unsigned block = 0; block < 4; ++block) {
+			const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + (block * 16)));
+			const __m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chars, tab), _mm_cmpeq_epi8(chars, cr)), _mm_cmpeq_epi8(chars, lf));
+			word |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(matches))) << (block * 16);
+		}
+		*bits++ = word;
+	}
+	if (i != size)
+		*bits = ScanWordScalar(data + i, size - i);
+}
+#endif // DVL_SIMD_X86
+
+#if DVL_SIMD_AARCH64
+void ScanDelimitersNeon(const char *data, size_t size, uint64_t *bits)
+{
+	const uint8x16_t tab = vdupq_n_u8('\t');
+	const uint8x16_t cr = vdupq_n_u8('\r');
+	const uint8x16_t lf = vdupq_n_u8('\n');
+	// NEON has no movemask: keep one weighted bit per lane and add up each half instead.
+	static constexpr uint8_t Weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+	const uint8x16_t weights = vld1q_u8(Weights);
+	size_t i = 0;
+	for (; size - i >= 64; i += 64) {
+		uint64_t word = 0;
+		for (unsigned block = 0; block < 4; ++block) {
+			const uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t *>(data + i + (block * 16)));
+			const uint8x16_t matches = vandq_u8(vorrq_u8(vorrq_u8(vceqq_u8(chars, tab), vceqq_u8(chars, cr)), vceqq_u8(chars, lf)), weights);
+			const uint64_t mask = vaddv_u8(vget_low_u8(matches)) | (static_cast<uint64_t>(vaddv_u8(vget_high_u8(matches))) << 8);
+			word |= mask << (block * 16);
+		}
+		*bits++ = word;
+	}
+	if (i != size)
+		*bits = ScanWordScalar(data + i, size - i);
+}
+#endif // DVL_SIMD_AARCH64
+
+} // namespace
+
+DelimiterScanKernel GetDelimiterScanKernel(DelimiterScanIsa isa)
+{
+	[[maybe_unused]] const CpuFeatures &cpu = GetCpuFeatures();
+	switch (isa) {
+	case DelimiterScanIsa::Scalar:
+		return ScanDelimitersScalar;
+#if DVL_SIMD_X86
+	case DelimiterScanIsa::Sse2:
+		return cpu.sse2 ? ScanDelimitersSse2 : nullptr;
+#endif
+#if DVL_SIMD_AARCH64
+	case DelimiterScanIsa::Neon:
+		return cpu.neon ? ScanDelimitersNeon : nullptr;
+#endif
+	default:
+		return nullptr;
+	}
+}
+
+DelimiterScanIsa GetBestDelimiterScanIsa()
+{
+	if (GetDelimiterScanKernel(DelimiterScanIsa::Neon) != nullptr)
+		return DelimiterScanIsa::Neon;
+	if (GetDelimiterScanKernel(DelimiterScanIsa::Sse2) != nullptr)
+		return DelimiterScanIsa::Sse2;
+	return DelimiterScanIsa::Scalar;
+}
+
+namespace {
+
+DelimiterScanIsa CurrentIsa = GetBestDelimiterScanIsa();
+DelimiterScanKernel CurrentKernel = GetDelimiterScanKernel(CurrentIsa);
+
+} // namespace
+
+DelimiterScanIsa GetDelimiterScanIsa()
+{
+	return CurrentIsa;
+}
+
+bool SetDelimiterScanIsa(DelimiterScanIsa isa)
+{
+	const DelimiterScanKernel kernel = GetDelimiterScanKernel(isa);
+	if (kernel == nullptr)
+		return false;
+	CurrentIsa = isa;
+	CurrentKernel = kernel;
+	return true;
+}
+
+DelimiterIndex::DelimiterIndex(const char *data, size_t size)
+    : data_(data)
+    , bits_(DelimiterBitsSize(size))
+{
+	CurrentKernel(data, size, bits_.data());
+}
+
+} // namespace devilution
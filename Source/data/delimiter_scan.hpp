@@ -0,0 +1,89 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace devilution {
+
+/**
+ * @brief Implementations of the delimiter scanning kernel.
+ */
+enum class DelimiterScanIsa : uint8_t {
+	Scalar,
+	Sse2,
+	Neon,
+};
+
+/**
+ * @brief Sets bit `i % 64` of `bits[i / 64]` if `data[i]` is a tab, carriage return or newline, and clears it otherwise.
+ *
+ * `bits` must have room for `DelimiterBitsSize(size)` words, all of which are written.
+ * All implementations produce identical output.
+ */
+using DelimiterScanKernel = void (*)(const char *data, size_t size, uint64_t *bits);
+
+constexpr size_t DelimiterBitsSize(size_t size)
+{
+	return (size + 63) / 64;
+}
+
+/**
+ * @brief Returns the kernel for the given implementation,
+ * or `nullptr` if this build or the current CPU does not support it.
+ */
+DelimiterScanKernel GetDelimiterScanKernel(DelimiterScanIsa isa);
+
+/**
+ * @brief Returns the fastest implementation supported by the current CPU.
+ */
+DelimiterScanIsa GetBestDelimiterScanIsa();
+
+/**
+ * @brief Returns the implementation used by `DelimiterIndex`.
+ */
+DelimiterScanIsa GetDelimiterScanIsa();
+
+/**
+ * @brief Switches the kernel used by `DelimiterIndex`, e.g. for benchmarks.
+ * @return false if the implementation is not supported.
+ */
+bool SetDelimiterScanIsa(DelimiterScanIsa isa);
+
+/**
+ * @brief The positions of all delimiters of a text data file, one bit per character.
+ *
+ * Built in a single pass over the file, so that the parser finds the end of a field
+ * with a lookup instead of scanning the field.
+ */
+class DelimiterIndex {
+public:
+	DelimiterIndex(const char *data, size_t size);
+
+	/**
+	 * @brief Returns the first delimiter in [begin, end), or `end` if there is none.
+	 * @pre `begin` and `end` point into the indexed data
+	 */
+	[[nodiscard]] const char *find(const char *begin, const char *end) const
+	{
+		if (begin >= end)
+			return end;
+		const size_t offset = static_cast<size_t>(begin - data_);
+		size_t word = offset / 64;
+		uint64_t bits = bits_[word] & (~uint64_t { 0 } << (offset % 64));
+		while (bits == 0) {
+			if (++word == bits_.size())
+				return end;
+			bits = bits_[word];
+		}
+		const char *found = data_ + (word * 64) + std::countr_zero(bits);
+		return found < end ? found : end;
+	}
+
+private:
+	const char *data_;
+	std::vector<uint64_t> bits_;
+};
+
+} // namespace devilution
@@ -6,29 +6,77 @@
 #include <expected>
 #include <limits>
 #include <memory>
+#include <optional>
+#include <string>
 
+#include "data/compiled_file.hpp"
 #include "engine/assets.hpp"
 #include "utils/algorithm/container.hpp"
 #include "utils/format.hpp"
 #include "utils/language.h"
 
 namespace devilution {
+namespace {
+
+/** @brief Whether the data file is a file of its own on disk, rather than an entry in an archive. */
+bool IsLooseDataFile(const AssetRef &ref)
+{
+#ifdef UNPACKED_MPQS
+	(void)ref;
+	return true;
+#else
+	return !ref.directPath.empty();
+#endif
+}
+
+} // namespace
+
 std::expected<DataFile, DataFile::Error> DataFile::load(std::string_view path)
 {
 	AssetRef ref = FindAsset(path);
 	if (!ref.ok())
 		return std::unexpected { Error::NotFound };
-	const size_t size = ref.size();
-	// TODO: It should be possible to stream the data file contents instead of copying the whole thing into memory
-	std::unique_ptr<char[]> data { new char[size] };
-	{
-		AssetHandle handle = OpenIntegralAsset(std::move(ref));
-		if (!handle.ok())
-			return std::unexpected { Error::OpenFailed };
-		if (size > 0 && !handle.read(data.get(), size))
-			return std::unexpected { Error::BadRead };
+#ifndef UNPACKED_MPQS
+	// Set here rather than by `ReadIntegralAsset`, which a cache hit skips.
+	if (ref.isOverridden)
+		IsAssetIntegrityViolated = true;
+#endif
+	std::optional<std::string> sourceKey;
+	bool checkSourceHash = false;
+	if (IsDataFileCacheEnabled()) {
+		sourceKey = DataFileSourceKey(ref, path);
+		// Loose files can be edited without changing their size or modification time, and are mapped
+		// rather than copied, so their contents are hashed too. An entry in an archive is found by
+		// its key alone, so that the source doesn't even have to be read.
+		checkSourceHash = sourceKey.has_value() && IsLooseDataFile(ref);
+		if (sourceKey.has_value() && !checkSourceHash) {
+			if (std::optional<DataFile> cached = LoadCachedDataFile(*sourceKey))
+				return *std::move(cached);
+		}
 	}
-	return DataFile { std::move(data), size };
+	// Files on disk are memory-mapped rather than copied, see `ReadAsset`.
+	// Data files are parsed on worker threads at startup, see `LoadDataTables`.
+	std::expected<AssetData, std::string> data = ReadAsset(std::move(ref), path, /*threadsafe=*/true);
+	if (!data.has_value())
+		return std::unexpected { Error::BadRead };
+	DataFile dataFile { data->share(), data->size() };
+	if (sourceKey.has_value()) {
+		if (checkSourceHash) {
+			if (std::optional<DataFile> cached = LoadCachedDataFile(*sourceKey, HashDataFileSource(dataFile)))
+				return *std::move(cached);
+		}
+		if (std::optional<DataFile> compiled = CompileAndCacheDataFile(dataFile, *sourceKey, path))
+			return *std::move(compiled);
+	}
+	dataFile.buildIndex();
+	return dataFile;
+}
+
+void DataFile::buildIndex()
+{
+	if (encoding_ != FieldEncoding::Text || index_ != nullptr || GetDelimiterScanIsa() == DelimiterScanIsa::Scalar)
+		return;
+	index_ = std::make_shared<const DelimiterIndex>(data(), size());
 }
 
 DataFile DataFile::loadOrDie(std::string_view path)
@@ -96,7 +144,7 @@ std::expected<void, DataFile::Error> DataFile::parseHeader(ColumnDefinition *beg
 	std::bitset<std::numeric_limits<uint8_t>::max()> seenColumns;
 	unsigned lastColumn = 0;
 
-	RecordIterator firstRecord { data(), data() + size(), false };
+	RecordIterator firstRecord { data(), data() + size(), false, encoding_, index_.get() };
 	for (DataFileField field : *firstRecord) {
 		if (begin == end) {
 			// All key columns have been identified
@@ -141,7 +189,7 @@ std::expected<void, DataFile::Error> DataFile::parseHeader(ColumnDefinition *beg
 
 std::expected<void, DataFile::Error> DataFile::skipHeader()
 {
-	RecordIterator it { data(), data() + size(), false };
+	RecordIterator it { data(), data() + size(), false, encoding_, index_.get() };
 	++it;
 	if (it == this->end()) {
 		return std::unexpected { Error::NoContent };
@@ -159,6 +207,7 @@ void DataFile::skipHeaderOrDie(std::string_view path)
 
 [[nodiscard]] size_t DataFile::numRecords() const
 {
+	if (encoding_ != FieldEncoding::Text) return numRecords_;
 	if (content_.empty()) return 0;
 	const auto numNewlines = static_cast<size_t>(c_count(content_, '\n') + (content_.back() == '\n' ? 0 : 1));
 	if (numNewlines < 2) return 0;
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <expected>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string_view>
 
 #include <function_ref.hpp>
@@ -31,23 +33,37 @@ struct ColumnDefinition {
 	}
 };
 
+class DataFile;
+
+std::optional<DataFile> OpenCompiledDataFile(std::shared_ptr<const char> data, size_t size, std::string_view sourceKey, std::optional<uint64_t> sourceHash);
+
 /**
  * @brief Container for a tab-delimited file following the TSV-like format described in txtdata/Readme.md
+ *
+ * The file may also have been compiled ahead of time, see compiled_file.hpp. Both are read
+ * through the same iterators.
  */
 class DataFile {
-	std::unique_ptr<const char[]> data_;
+	std::shared_ptr<const char> data_;
 	std::string_view content_;
 
 	const char *body_;
 
+	FieldEncoding encoding_ = FieldEncoding::Text;
+	/** @brief Only set for compiled files, text files are counted on demand. */
+	size_t numRecords_ = 0;
+
+	/** @brief Delimiters of a text file, see `buildIndex()`. */
+	std::shared_ptr<const DelimiterIndex> index_;
+
 	DataFile() = delete;
 
 	/**
 	 * @brief Creates a view over a sequence of utf8 code units, skipping over the BOM if present
-	 * @param data pointer to the raw data backing the view (this container will take ownership to ensure the lifetime of the view)
+	 * @param data pointer to the raw data backing the view (this container shares ownership to ensure the lifetime of the view)
 	 * @param size total number of bytes/code units including the BOM if present
 	 */
-	DataFile(std::unique_ptr<const char[]> &&data, size_t size)
+	DataFile(std::shared_ptr<const char> &&data, size_t size)
 	    : data_(std::move(data))
 	    , content_(data_.get(), size)
 	{
@@ -58,6 +74,22 @@ class DataFile {
 		body_ = this->content_.data();
 	}
 
+	/**
+	 * @brief Creates a view over the records of a compiled data file
+	 * @param data pointer to the raw data backing the view
+	 * @param content the records, header row included
+	 */
+	DataFile(std::shared_ptr<const char> &&data, std::string_view content, FieldEncoding encoding, size_t numRecords)
+	    : data_(std::move(data))
+	    , content_(content)
+	    , body_(content.data())
+	    , encoding_(encoding)
+	    , numRecords_(numRecords)
+	{
+	}
+
+	friend std::optional<DataFile> OpenCompiledDataFile(std::shared_ptr<const char> data, size_t size, std::string_view sourceKey, std::optional<uint64_t> sourceHash);
+
 public:
 	enum class Error {
 		NotFound,
@@ -70,6 +102,10 @@ public:
 	/**
 	 * @brief Attempts to load a data file (using the same mechanism as other runtime assets)
 	 *
+	 * If the data file cache is enabled (see `EnableDataFileCache`), the compiled form of the file
+	 * is returned instead. A loose file is checked against a hash of its contents, an entry in an
+	 * archive only against the archive's size and modification time (see `DataFileSourceKey`).
+	 *
 	 * @param path file to load including the /txtdata/ prefix
 	 * @return an object containing an owned pointer to an in-memory copy of the file
 	 *         or an error code describing the reason for failure.
@@ -86,6 +122,15 @@ public:
 		body_ = content_.data();
 	}
 
+	/**
+	 * @brief Finds all delimiters of a text file in a single pass, so that the iterators look up
+	 * where each field ends instead of scanning it.
+	 *
+	 * Called by `load()`. Compiled files are never indexed, as they don't need it. Without SIMD,
+	 * building the index costs more than it saves, so the file is left to be scanned.
+	 */
+	void buildIndex();
+
 	/**
 	 * @brief Attempts to parse the first row/record in the file, populating the range defined by [begin, end) using the provided mapping function
 	 *
@@ -117,7 +162,7 @@ public:
 
 	[[nodiscard]] RecordIterator begin() const
 	{
-		return { body_, data() + size(), body_ != data() };
+		return { body_, data() + size(), body_ != data(), encoding_, index_.get() };
 	}
 
 	[[nodiscard]] RecordIterator end() const
@@ -128,6 +173,11 @@ public:
 	// Assumes a header
 	[[nodiscard]] size_t numRecords() const;
 
+	[[nodiscard]] FieldEncoding encoding() const
+	{
+		return encoding_;
+	}
+
 	[[nodiscard]] const char *data() const
 	{
 		return content_.data();
@@ -17,6 +17,8 @@ class DataFileField {
 	const char *end_;
 	unsigned row_;
 	unsigned column_;
+	FieldEncoding encoding_;
+	const DelimiterIndex *index_;
 
 public:
 	enum class Error {
@@ -51,11 +53,13 @@ public:
 		}
 	}
 
-	DataFileField(GetFieldResult *state, const char *end, unsigned row, unsigned column)
+	DataFileField(GetFieldResult *state, const char *end, unsigned row, unsigned column, FieldEncoding encoding = FieldEncoding::Text, const DelimiterIndex *index = nullptr)
 	    : state_(state)
 	    , end_(end)
 	    , row_(row)
 	    , column_(column)
+	    , encoding_(encoding)
+	    , index_(index)
 	{
 	}
 
@@ -70,7 +74,7 @@ public:
 	[[nodiscard]] std::string_view value()
 	{
 		if (state_->status == GetFieldResult::Status::ReadyToRead) {
-			*state_ = GetNextField(state_->next, end_);
+			*state_ = GetNextField(state_->next, end_, encoding_, index_);
 		}
 		return state_->value;
 	}
@@ -97,12 +101,17 @@ public:
 	[[nodiscard]] std::expected<void, Error> parseInt(T &destination)
 	{
 		std::from_chars_result result {};
-		if (state_->status == GetFieldResult::Status::ReadyToRead) {
+		if (encoding_ == FieldEncoding::LengthPrefixed) {
+			// The length of the field is known up front, so there is nothing to gain from parsing
+			// while scanning. Parse within the field instead.
+			const std::string_view str = value();
+			result = std::from_chars(str.data(), str.data() + str.size(), destination);
+		} else if (state_->status == GetFieldResult::Status::ReadyToRead) {
 			const char *begin = state_->next;
 			result = std::from_chars(begin, end_, destination);
 			if (result.ec != std::errc::invalid_argument) {
 				// from_chars was able to consume at least one character, consume the rest of the field
-				*state_ = GetNextField(result.ptr, end_);
+				*state_ = GetNextField(result.ptr, end_, encoding_, index_);
 				// and prepend what was already parsed
 				state_->value = { begin, (state_->value.data() - begin) + state_->value.size() };
 			}
@@ -233,12 +242,14 @@ public:
 	[[nodiscard]] std::expected<void, Error> parseFixed6(T &destination)
 	{
 		ParseIntResult<T> parseResult;
-		if (state_->status == GetFieldResult::Status::ReadyToRead) {
+		if (encoding_ == FieldEncoding::LengthPrefixed) {
+			parseResult = ParseFixed6<T>(value());
+		} else if (state_->status == GetFieldResult::Status::ReadyToRead) {
 			const char *begin = state_->next;
 			// first read, consume digits
 			parseResult = ParseFixed6<T>({ begin, static_cast<size_t>(end_ - begin) }, &state_->next);
 			// then read the remainder of the field
-			*state_ = GetNextField(state_->next, end_);
+			*state_ = GetNextField(state_->next, end_, encoding_, index_);
 			// and prepend what was already parsed
 			state_->value = { begin, (state_->value.data() - begin) + state_->value.size() };
 		} else {
@@ -304,6 +315,8 @@ class FieldIterator {
 	const char *const end_;
 	const unsigned row_;
 	unsigned column_ = 0;
+	const FieldEncoding encoding_ = FieldEncoding::Text;
+	const DelimiterIndex *const index_ = nullptr;
 
 public:
 	using iterator_category = std::input_iterator_tag;
@@ -316,10 +329,12 @@ public:
 	{
 	}
 
-	FieldIterator(GetFieldResult *state, const char *end, unsigned row)
+	FieldIterator(GetFieldResult *state, const char *end, unsigned row, FieldEncoding encoding = FieldEncoding::Text, const DelimiterIndex *index = nullptr)
 	    : state_(state)
 	    , end_(end)
 	    , row_(row)
+	    , encoding_(encoding)
+	    , index_(index)
 	{
 		state_->status = GetFieldResult::Status::ReadyToRead;
 	}
@@ -362,7 +377,7 @@ public:
 		if (state_->status == GetFieldResult::Status::ReadyToRead) {
 			// We never read the value and no longer need it, discard it so that we end up
 			//  advancing past the field delimiter (as if a value access had happened)
-			*state_ = DiscardField(state_->next, end_);
+			*state_ = DiscardField(state_->next, end_, encoding_, index_);
 		}
 
 		if (state_->endOfRecord()) {
@@ -373,7 +388,7 @@ public:
 			//  last value access found the end of the field by necessity or we discarded it a few
 			//  lines up), so we only need to advance further if an increment greater than 1 was
 			//  provided.
-			*state_ = DiscardMultipleFields(state_->next, end_, increment - 1, &fieldsSkipped);
+			*state_ = DiscardMultipleFields(state_->next, end_, increment - 1, &fieldsSkipped, encoding_, index_);
 			// As we've consumed the current field by this point we need to increment the internal
 			//  column counter one extra time so we have an accurate value.
 			column_ += fieldsSkipped + 1;
@@ -393,7 +408,7 @@ public:
 	 */
 	[[nodiscard]] value_type operator*()
 	{
-		return { state_, end_, row_, column_ };
+		return { state_, end_, row_, column_, encoding_, index_ };
 	}
 
 	/**
@@ -416,18 +431,22 @@ class DataFileRecord {
 	GetFieldResult *state_;
 	const char *const end_;
 	const unsigned row_;
+	const FieldEncoding encoding_;
+	const DelimiterIndex *const index_;
 
 public:
-	DataFileRecord(GetFieldResult *state, const char *end, unsigned row)
+	DataFileRecord(GetFieldResult *state, const char *end, unsigned row, FieldEncoding encoding = FieldEncoding::Text, const DelimiterIndex *index = nullptr)
 	    : state_(state)
 	    , end_(end)
 	    , row_(row)
+	    , encoding_(encoding)
+	    , index_(index)
 	{
 	}
 
 	[[nodiscard]] FieldIterator begin()
 	{
-		return { state_, end_, row_ };
+		return { state_, end_, row_, encoding_, index_ };
 	}
 
 	[[nodiscard]] FieldIterator end() const
@@ -445,6 +464,8 @@ class RecordIterator {
 	GetFieldResult state_;
 	const char *const end_;
 	unsigned row_ = 0;
+	const FieldEncoding encoding_ = FieldEncoding::Text;
+	const DelimiterIndex *const index_ = nullptr;
 
 public:
 	using iterator_category = std::forward_iterator_tag;
@@ -456,10 +477,12 @@ public:
 	{
 	}
 
-	RecordIterator(const char *begin, const char *end, bool skippedHeader)
+	RecordIterator(const char *begin, const char *end, bool skippedHeader, FieldEncoding encoding = FieldEncoding::Text, const DelimiterIndex *index = nullptr)
 	    : state_(begin)
 	    , end_(end)
 	    , row_(skippedHeader ? 1 : 0)
+	    , encoding_(encoding)
+	    , index_(index)
 	{
 	}
 
@@ -485,7 +508,7 @@ public:
 
 		if (!state_.endOfRecord()) {
 			// The field iterator either hasn't been used or hasn't consumed the entire record
-			state_ = DiscardRemainingFields(state_.next, end_);
+			state_ = DiscardRemainingFields(state_.next, end_, encoding_, index_);
 		}
 
 		if (state_.endOfFile()) {
@@ -496,7 +519,7 @@ public:
 			//  last value access found the end of the record by necessity or we discarded any
 			//  leftovers a few lines up), so we only need to advance further if an increment
 			//  greater than 1 was provided.
-			state_ = DiscardMultipleRecords(state_.next, end_, increment - 1, &recordsSkipped);
+			state_ = DiscardMultipleRecords(state_.next, end_, increment - 1, &recordsSkipped, encoding_, index_);
 			// As we've consumed the current record by this point we need to increment the internal
 			//  row counter one extra time so we have an accurate value.
 			row_ += recordsSkipped + 1;
@@ -509,7 +532,7 @@ public:
 
 	[[nodiscard]] DataFileRecord operator*()
 	{
-		return { &state_, end_, row_ };
+		return { &state_, end_, row_, encoding_, index_ };
 	}
 
 	/**
@@ -26,13 +26,13 @@ GetFieldResult HandleRecordTerminator(const char *begin, const char *end)
 	return { begin, GetFieldResult::Status::BadRecordTerminator };
 }
 
-GetFieldResult DiscardMultipleFields(const char *begin, const char *end, unsigned skipLength, unsigned *fieldsSkipped)
+GetFieldResult DiscardMultipleFields(const char *begin, const char *end, unsigned skipLength, unsigned *fieldsSkipped, FieldEncoding encoding, const DelimiterIndex *index)
 {
 	GetFieldResult result { begin };
 	unsigned skipCount = 0;
 	while (skipCount < skipLength) {
 		++skipCount;
-		result = DiscardField(result.next, end);
+		result = DiscardField(result.next, end, encoding, index);
 		if (result.endOfRecord()) {
 			// Found the end of record early
 			break;
@@ -44,13 +44,13 @@ GetFieldResult DiscardMultipleFields(const char *begin, const char *end, unsigne
 	return result;
 }
 
-GetFieldResult DiscardMultipleRecords(const char *begin, const char *end, unsigned skipLength, unsigned *recordsSkipped)
+GetFieldResult DiscardMultipleRecords(const char *begin, const char *end, unsigned skipLength, unsigned *recordsSkipped, FieldEncoding encoding, const DelimiterIndex *index)
 {
 	GetFieldResult result { begin };
 	unsigned skipCount = 0;
 	while (skipCount < skipLength) {
 		++skipCount;
-		result = DiscardRemainingFields(result.next, end);
+		result = DiscardRemainingFields(result.next, end, encoding, index);
 		if (result.endOfFile()) {
 			// Found the end of file early
 			break;
@@ -1,12 +1,29 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <string_view>
 
+#include "data/delimiter_scan.hpp"
+#include "utils/endian_read.hpp"
 #include "utils/is_of.hpp"
 
 namespace devilution {
 
+/**
+ * @brief How the fields of a data file are stored.
+ *
+ * Compiled data files (see compiled_file.hpp) prefix each field with its length, so a field can
+ * be found without scanning it. The separators are kept, so records end the same way in both.
+ */
+enum class FieldEncoding : uint8_t {
+	Text,
+	/** @brief Each field starts with its size as a 16-bit little-endian integer. */
+	LengthPrefixed,
+};
+
+constexpr size_t FieldLengthPrefixSize = 2;
+
 struct GetFieldResult {
 	std::string_view value;
 
@@ -129,18 +146,45 @@ inline GetFieldResult HandleFieldSeparator(const char *begin, const char *end)
 	return HandleRecordTerminator(begin, end);
 }
 
+/**
+ * @brief Returns where the value of the field at `begin` starts.
+ */
+inline const char *FieldValueBegin(const char *begin, const char *end, FieldEncoding encoding)
+{
+	if (encoding == FieldEncoding::LengthPrefixed)
+		return std::min(begin + FieldLengthPrefixSize, end);
+	return begin;
+}
+
+/**
+ * @brief Returns the separator following the field at `begin`.
+ * @param index if set, text fields are looked up in the index instead of being scanned
+ */
+inline const char *FindFieldSeparator(const char *begin, const char *end, FieldEncoding encoding, const DelimiterIndex *index = nullptr)
+{
+	if (encoding == FieldEncoding::LengthPrefixed) {
+		if (end - begin < static_cast<std::ptrdiff_t>(FieldLengthPrefixSize))
+			return end;
+		const char *valueBegin = begin + FieldLengthPrefixSize;
+		return std::min(valueBegin + LoadLE16(begin), end);
+	}
+	if (index != nullptr)
+		return index->find(begin, end);
+	return std::find_if(begin, end, IsFieldSeparator);
+}
+
 /**
  * @brief Advances to the next field separator without saving any characters
  * @param begin first character of the stream
  * @param end one past the last character in the stream
+ * @param encoding how the fields are stored
+ * @param index delimiters of a text stream, if indexed
  * @return a GetFieldResult struct containing an empty value, a pointer to the start of the next
  *          field/record, and a status code describing what type of separator was found
  */
-inline GetFieldResult DiscardField(const char *begin, const char *end)
+inline GetFieldResult DiscardField(const char *begin, const char *end, FieldEncoding encoding = FieldEncoding::Text, const DelimiterIndex *index = nullptr)
 {
-	const char *nextSeparator = std::find_if(begin, end, IsFieldSeparator);
-
-	return HandleFieldSeparator(nextSeparator, end);
+	return HandleFieldSeparator(FindFieldSeparator(begin, end, encoding, index), end);
 }
 
 /**
@@ -153,7 +197,7 @@ inline GetFieldResult DiscardField(const char *begin, const char *end)
  * @return a GetFieldResult struct containing an empty value, a pointer to the start of the next
  *          field/record, and a status code describing what type of separator was found
  */
-GetFieldResult DiscardMultipleFields(const char *begin, const char *end, unsigned skipLength, unsigned *fieldsSkipped = nullptr);
+GetFieldResult DiscardMultipleFields(const char *begin, const char *end, unsigned skipLength, unsigned *fieldsSkipped = nullptr, FieldEncoding encoding = FieldEncoding::Text, const DelimiterIndex *index = nullptr);
 
 /**
  * @brief Advances by the specified number of records or until the end of the file, whichever occurs first
@@ -165,17 +209,28 @@ GetFieldResult DiscardMultipleFields(const char *begin, const char *end, unsigne
  * @return a GetFieldResult struct containing an empty value, a pointer to the start of the next
  *          record, and a status code describing what type of separator was found
  */
-GetFieldResult DiscardMultipleRecords(const char *begin, const char *end, unsigned skipLength, unsigned *recordsSkipped = nullptr);
+GetFieldResult DiscardMultipleRecords(const char *begin, const char *end, unsigned skipLength, unsigned *recordsSkipped = nullptr, FieldEncoding encoding = FieldEncoding::Text, const DelimiterIndex *index = nullptr);
 
 /**
  * @brief Discard any remaining fields in the current record
  * @param begin pointer to the current character in the stream
  * @param end one past the last character in the stream
+ * @param encoding how the fields are stored
+ * @param index delimiters of a text stream, if indexed
  * @return a GetFieldResult struct containing an empty value, the start of the next record (or
  *          `end`), and a status describing whether more records are available
  */
-inline GetFieldResult DiscardRemainingFields(const char *begin, const char *end)
+inline GetFieldResult DiscardRemainingFields(const char *begin, const char *end, FieldEncoding encoding = FieldEncoding::Text, const DelimiterIndex *index = nullptr)
 {
+	if (encoding == FieldEncoding::LengthPrefixed || index != nullptr) {
+		// Field values can't be searched for the terminator, or don't have to be, so hop from
+		// field to field instead.
+		GetFieldResult result = DiscardField(begin, end, encoding, index);
+		while (!result.endOfRecord())
+			result = DiscardField(result.next, end, encoding, index);
+		return result;
+	}
+
 	const char *nextSeparator = std::find_if(begin, end, IsRecordTerminator);
 
 	return HandleRecordTerminator(nextSeparator, end);
@@ -196,11 +251,12 @@ inline GetFieldResult DiscardRemainingFields(const char *begin, const char *end)
  * @return a GetFieldResult struct containing a string_view of the field, the start of the next
  *          field/record, and a status code describing what type of separator was found
  */
-inline GetFieldResult GetNextField(const char *begin, const char *end)
+inline GetFieldResult GetNextField(const char *begin, const char *end, FieldEncoding encoding = FieldEncoding::Text, const DelimiterIndex *index = nullptr)
 {
-	const char *nextSeparator = std::find_if(begin, end, IsFieldSeparator);
+	const char *valueBegin = FieldValueBegin(begin, end, encoding);
+	const char *nextSeparator = FindFieldSeparator(begin, end, encoding, index);
 
 	// Can't use the string_view(It, It) constructor since that was only added in C++20...
-	return { { begin, static_cast<size_t>(nextSeparator - begin) }, HandleFieldSeparator(nextSeparator, end) };
+	return { { valueBegin, static_cast<size_t>(nextSeparator - valueBegin) }, HandleFieldSeparator(nextSeparator, end) };
 }
 } // namespace devilution
@@ -5,6 +5,9 @@
  */
 #include <array>
 #include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
 #include <string_view>
 
 #ifdef USE_SDL3
@@ -36,12 +39,15 @@
 #include "controls/keymapper.hpp"
 #include "controls/plrctrls.h"
 #include "controls/remap_keyboard.h"
+#include "data/compiled_file.hpp"
 #include "diablo.h"
 #include "diablo_msg.hpp"
 #include "discord/discord.h"
 #include "doom.h"
 #include "encrypt.h"
+#include "engine/asset_prefetch.hpp"
 #include "engine/backbuffer_state.hpp"
+#include "engine/clx_cache.hpp"
 #include "engine/clx_sprite.hpp"
 #include "engine/demomode.h"
 #include "engine/dx.h"
@@ -50,6 +56,8 @@
 #include "engine/load_file.hpp"
 #include "engine/random.hpp"
 #include "engine/render/clx_render.hpp"
+#include "engine/render/scrollrt.h"
+#include "engine/render/world_snapshot.hpp"
 #include "engine/sound.h"
 #include "game_mode.hpp"
 #include "gamemenu.h"
@@ -58,6 +66,7 @@
 #include "help.h"
 #include "hwcursor.hpp"
 #include "init.hpp"
+#include "interfac.h"
 #include "inv.h"
 #include "levels/drlg_l1.h"
 #include "levels/drlg_l2.h"
@@ -100,6 +109,7 @@
 #include "stores.h"
 #include "storm/storm_net.hpp"
 #include "storm/storm_svid.h"
+#include "tables/load_tables.hpp"
 #include "tables/monstdat.h"
 #include "tables/playerdat.hpp"
 #include "towners.h"
@@ -107,8 +117,10 @@
 #include "utils/console.h"
 #include "utils/display.h"
 #include "utils/format.hpp"
+#include "utils/frame_profiler.hpp"
 #include "utils/is_of.hpp"
 #include "utils/language.h"
+#include "utils/log.hpp"
 #include "utils/parse_int.hpp"
 #include "utils/paths.h"
 #include "utils/screen_reader.hpp"
@@ -936,16 +948,26 @@ void RunGameLoop(interface_mode uMsg)
 			if (!drawGame)
 				continue;
 			RedrawViewport();
+			demo::NotifyRenderStart();
 			DrawAndBlit();
+			demo::NotifyRenderEnd();
 			continue;
 		}
 
 		ProcessGameMessagePackets();
-		if (game_loop(gbGameLoopStartup))
+		demo::NotifyLogicStart();
+		if (game_loop(gbGameLoopStartup)) {
 			diablo_color_cyc_logic();
+			if (!HeadlessMode)
+				PublishWorldSnapshot();
+		}
+		demo::NotifyLogicEnd();
 		gbGameLoopStartup = false;
-		if (drawGame)
+		if (drawGame) {
+			demo::NotifyRenderStart();
 			DrawAndBlit();
+			demo::NotifyRenderEnd();
+		}
 #ifdef GPERF_HEAP_FIRST_GAME_ITERATION
 		if (run_game_iteration++ == 0)
 			HeapProfilerDump("first_game_iteration");
@@ -991,6 +1013,11 @@ void PrintHelpOption(std::string_view flags, std::string_view description)
 	printNewlineInConsole();
 }
 
+#ifndef DISABLE_FRAME_PROFILER
+/** @brief Where to write the frame profiler trace on exit, empty if the profiler wasn't started from the command line. */
+std::string ProfileTracePath;
+#endif
+
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 FILE *SdlLogFile = nullptr;
 
@@ -1027,10 +1054,18 @@ extern "C" void SdlLogToFile(void *userdata, int /*category*/, SDL_LogPriority p
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 	PrintHelpOption("--log-to-file <path>", _(/* TRANSLATORS: Commandline Option */ "Log to a file instead of stderr"));
 #endif
+#ifndef UNPACKED_MPQS
+	PrintHelpOption("--clx-cache <path>", _(/* TRANSLATORS: Commandline Option */ "Keep converted graphics in a folder to speed up loading"));
+#endif
+	PrintHelpOption("--data-cache <path>", _(/* TRANSLATORS: Commandline Option */ "Keep compiled data tables in a folder to speed up loading"));
 #ifndef DISABLE_DEMOMODE
 	PrintHelpOption("--record <#>", _(/* TRANSLATORS: Commandline Option */ "Record a demo file"));
 	PrintHelpOption("--demo <#>", _(/* TRANSLATORS: Commandline Option */ "Play a demo file"));
 	PrintHelpOption("--timedemo", _(/* TRANSLATORS: Commandline Option */ "Disable all frame limiting during demo playback"));
+	PrintHelpOption("--headless", _(/* TRANSLATORS: Commandline Option */ "Play a demo without window, audio or rendering and report the simulation speed"));
+#endif
+#ifndef DISABLE_FRAME_PROFILER
+	PrintHelpOption("--profile-trace <path>", _(/* TRANSLATORS: Commandline Option */ "Record frame timings and write them to a Chrome trace file on exit"));
 #endif
 	printNewlineInConsole();
 	printInConsole(_(/* TRANSLATORS: Commandline Option */ "Game selection:"));
@@ -1126,6 +1161,8 @@ void DiabloParseFlags(int argc, char **argv)
 			gbShowIntro = false;
 		} else if (arg == "--timedemo") {
 			timedemo = true;
+		} else if (arg == "--headless") {
+			HeadlessMode = true;
 		} else if (arg == "--record") {
 			if (i + 1 == argc) {
 				PrintFlagRequiresArgument("--record");
@@ -1140,11 +1177,39 @@ void DiabloParseFlags(int argc, char **argv)
 		} else if (arg == "--create-reference") {
 			createDemoReference = true;
 #else
-		} else if (arg == "--demo" || arg == "--timedemo" || arg == "--record" || arg == "--create-reference") {
+		} else if (arg == "--demo" || arg == "--timedemo" || arg == "--headless" || arg == "--record" || arg == "--create-reference") {
 			printInConsole("Binary compiled without demo mode support.");
 			printNewlineInConsole();
 			diablo_quit(1);
 #endif
+#ifndef DISABLE_FRAME_PROFILER
+		} else if (arg == "--profile-trace") {
+			if (i + 1 == argc) {
+				PrintFlagRequiresArgument("--profile-trace");
+				diablo_quit(64);
+			}
+			ProfileTracePath = argv[++i];
+			StartFrameProfiler();
+#else
+		} else if (arg == "--profile-trace") {
+			printInConsole("Binary compiled without frame profiler support.");
+			printNewlineInConsole();
+			diablo_quit(1);
+#endif
+#ifndef UNPACKED_MPQS
+		} else if (arg == "--clx-cache") {
+			if (i + 1 == argc) {
+				PrintFlagRequiresArgument("--clx-cache");
+				diablo_quit(64);
+			}
+			EnableClxCache(argv[++i]);
+#endif
+		} else if (arg == "--data-cache") {
+			if (i + 1 == argc) {
+				PrintFlagRequiresArgument("--data-cache");
+				diablo_quit(64);
+			}
+			EnableDataFileCache(argv[++i]);
 		} else if (arg == "-n") {
 			gbShowIntro = false;
 		} else if (arg == "-f") {
@@ -1200,8 +1265,12 @@ void DiabloParseFlags(int argc, char **argv)
 #endif
 
 #ifndef DISABLE_DEMOMODE
+	if (HeadlessMode && demoNumber == -1) {
+		PrintFlagMessage("--headless", " requires --demo");
+		diablo_quit(64);
+	}
 	if (demoNumber != -1)
-		demo::InitPlayBack(demoNumber, timedemo);
+		demo::InitPlayBack(demoNumber, timedemo || HeadlessMode, /*headless=*/HeadlessMode);
 	if (recordNumber != -1)
 		demo::InitRecording(recordNumber, createDemoReference);
 #endif
@@ -1243,8 +1312,25 @@ void ApplicationInit()
 	if (*GetOptions().Graphics.showFPS)
 		EnableFrameCount();
 
-	init_create_window();
-	was_window_init = true;
+	if (HeadlessMode) {
+		// Demo playback still needs the event queue, but nothing is ever shown.
+		if (
+#ifdef USE_SDL3
+		    !SDL_Init(SDL_INIT_EVENTS)
+#elif !defined(USE_SDL1)
+		    SDL_Init(SDL_INIT_EVENTS) < 0
+#else
+		    SDL_Init(0) < 0
+#endif
+		) {
+			ErrSdl();
+		}
+		RegisterCustomEvents();
+		AdjustToScreenGeometry(forceResolution);
+	} else {
+		init_create_window();
+		was_window_init = true;
+	}
 
 	InitializeScreenReader();
 	LanguageInitialize();
@@ -1280,6 +1366,13 @@ void DiabloInit()
 		}
 	}
 
+	if (HeadlessMode) {
+		gbMusicOn = false;
+		gbSoundOn = false;
+		CheckArchivesUpToDate();
+		return;
+	}
+
 #ifndef USE_SDL1
 	InitializeVirtualGamepad();
 #endif
@@ -1315,7 +1408,7 @@ void DiabloInit()
 
 void DiabloSplash()
 {
-	if (!gbShowIntro)
+	if (!gbShowIntro || HeadlessMode)
 		return;
 
 	if (*GetOptions().StartUp.splash == StartUpSplash::LogoAndTitleDialog)
@@ -1340,6 +1433,14 @@ void DiabloSplash()
 
 void DiabloDeinit()
 {
+#ifndef DISABLE_FRAME_PROFILER
+	if (!ProfileTracePath.empty()) {
+		StopFrameProfiler();
+		if (!WriteFrameProfilerTrace(ProfileTracePath.c_str()))
+			LogError("Failed to write profiler trace to {}", ProfileTracePath);
+		ProfileTracePath.clear();
+	}
+#endif
 	FreeItemGFX();
 
 	LuaShutdown();
@@ -1359,34 +1460,46 @@ void DiabloDeinit()
 		SDL_Quit();
 }
 
-std::expected<void, std::string> LoadLvlGFX()
+struct LevelGFX {
+	std::unique_ptr<std::byte[]> dungeonCels;
+	std::unique_ptr<MegaTile[]> megaTiles;
+	OptionalOwnedClxSpriteList specialCels;
+};
+
+/** @brief Tilesets that are being loaded in the background, keyed by dungeon type. */
+AssetPrefetcher<std::expected<LevelGFX, std::string>> LevelGFXPrefetcher;
+
+/**
+ * @param threadsafe Load from a worker thread
+ */
+std::expected<LevelGFX, std::string> LoadLevelGFX(dungeon_type levelType, bool threadsafe)
 {
-	assert(pDungeonCels == nullptr);
 	constexpr int SpecialCelWidth = 64;
 
-	const auto loadAll = [](const char *cel, const char *til, const char *special) -> std::expected<void, std::string> {
-		ASSIGN_OR_RETURN(pDungeonCels, LoadFileInMemWithStatus(cel));
-		ASSIGN_OR_RETURN(pMegaTiles, LoadFileInMemWithStatus<MegaTile>(til));
-		ASSIGN_OR_RETURN(pSpecialCels, LoadCelWithStatus(special, SpecialCelWidth));
-		return {};
+	LevelGFX gfx;
+	const auto loadAll = [&gfx, threadsafe](const char *cel, const char *til, const char *special) -> std::expected<LevelGFX, std::string> {
+		ASSIGN_OR_RETURN(gfx.dungeonCels, LoadFileInMemWithStatus(cel, nullptr, threadsafe));
+		ASSIGN_OR_RETURN(gfx.megaTiles, LoadFileInMemWithStatus<MegaTile>(til, nullptr, threadsafe));
+		ASSIGN_OR_RETURN(gfx.specialCels, LoadCelWithStatus(special, SpecialCelWidth, threadsafe));
+		return std::move(gfx);
 	};
 
-	switch (leveltype) {
+	switch (levelType) {
 	case DTYPE_TOWN: {
-		auto cel = LoadFileInMemWithStatus("nlevels\\towndata\\town.cel");
+		auto cel = LoadFileInMemWithStatus("nlevels\\towndata\\town.cel", nullptr, threadsafe);
 		if (!cel.has_value()) {
-			ASSIGN_OR_RETURN(pDungeonCels, LoadFileInMemWithStatus("levels\\towndata\\town.cel"));
+			ASSIGN_OR_RETURN(gfx.dungeonCels, LoadFileInMemWithStatus("levels\\towndata\\town.cel", nullptr, threadsafe));
 		} else {
-			pDungeonCels = std::move(*cel);
+			gfx.dungeonCels = std::move(*cel);
 		}
-		auto til = LoadFileInMemWithStatus<MegaTile>("nlevels\\towndata\\town.til");
+		auto til = LoadFileInMemWithStatus<MegaTile>("nlevels\\towndata\\town.til", nullptr, threadsafe);
 		if (!til.has_value()) {
-			ASSIGN_OR_RETURN(pMegaTiles, LoadFileInMemWithStatus<MegaTile>("levels\\towndata\\town.til"));
+			ASSIGN_OR_RETURN(gfx.megaTiles, LoadFileInMemWithStatus<MegaTile>("levels\\towndata\\town.til", nullptr, threadsafe));
 		} else {
-			pMegaTiles = std::move(*til);
+			gfx.megaTiles = std::move(*til);
 		}
-		ASSIGN_OR_RETURN(pSpecialCels, LoadCelWithStatus("levels\\towndata\\towns", SpecialCelWidth));
-		return {};
+		ASSIGN_OR_RETURN(gfx.specialCels, LoadCelWithStatus("levels\\towndata\\towns", SpecialCelWidth, threadsafe));
+		return gfx;
 	}
 	case DTYPE_CATHEDRAL:
 		return loadAll(
@@ -1423,6 +1536,26 @@ std::expected<void, std::string> LoadLvlGFX()
 	}
 }
 
+std::expected<void, std::string> LoadLvlGFX()
+{
+	assert(pDungeonCels == nullptr);
+
+	std::optional<std::expected<LevelGFX, std::string>> prefetched = LevelGFXPrefetcher.take(static_cast<size_t>(leveltype));
+	LevelGFXPrefetcher.clear();
+	LevelGFX gfx;
+	if (prefetched && prefetched->has_value()) {
+		gfx = **std::move(prefetched);
+		LevelAssetPrefetchStats.prefetched++;
+	} else {
+		ASSIGN_OR_RETURN(gfx, LoadLevelGFX(leveltype, /*threadsafe=*/false));
+		LevelAssetPrefetchStats.loadedOnDemand++;
+	}
+	pDungeonCels = std::move(gfx.dungeonCels);
+	pMegaTiles = std::move(gfx.megaTiles);
+	pSpecialCels = std::move(gfx.specialCels);
+	return {};
+}
+
 std::expected<void, std::string> LoadAllGFX()
 {
 	IncProgress();
@@ -1524,34 +1657,63 @@ void UpdateMonsterLights()
 
 void GameLogic()
 {
+	DVL_PROFILE_SCOPE("GameLogic");
 	if (!ProcessInput()) {
 		return;
 	}
 	if (gbProcessPlayers) {
 		gGameLogicStep = GameLogicStep::ProcessPlayers;
+		DVL_PROFILE_SCOPE("ProcessPlayers");
 		ProcessPlayers();
 	}
 	if (leveltype != DTYPE_TOWN) {
 		gGameLogicStep = GameLogicStep::ProcessMonsters;
+		{
+			DVL_PROFILE_SCOPE("ProcessMonsters");
 #ifdef _DEBUG
-		if (!DebugInvisible)
+			if (!DebugInvisible)
 #endif
-			ProcessMonsters();
+				ProcessMonsters();
+		}
 		gGameLogicStep = GameLogicStep::ProcessObjects;
-		ProcessObjects();
+		{
+			DVL_PROFILE_SCOPE("ProcessObjects");
+			ProcessObjects();
+		}
 		gGameLogicStep = GameLogicStep::ProcessMissiles;
-		ProcessMissiles();
+		{
+			DVL_PROFILE_SCOPE("ProcessMissiles");
+			ProcessMissiles();
+		}
 		gGameLogicStep = GameLogicStep::ProcessItems;
-		ProcessItems();
-		ProcessLightList();
-		ProcessVisionList();
+		{
+			DVL_PROFILE_SCOPE("ProcessItems");
+			ProcessItems();
+		}
+		{
+			DVL_PROFILE_SCOPE("ProcessLightList");
+			ProcessLightList();
+		}
+		{
+			DVL_PROFILE_SCOPE("ProcessVisionList");
+			ProcessVisionList();
+		}
 	} else {
 		gGameLogicStep = GameLogicStep::ProcessTowners;
-		ProcessTowners();
+		{
+			DVL_PROFILE_SCOPE("ProcessTowners");
+			ProcessTowners();
+		}
 		gGameLogicStep = GameLogicStep::ProcessItemsTown;
-		ProcessItems();
+		{
+			DVL_PROFILE_SCOPE("ProcessItems");
+			ProcessItems();
+		}
 		gGameLogicStep = GameLogicStep::ProcessMissilesTown;
-		ProcessMissiles();
+		{
+			DVL_PROFILE_SCOPE("ProcessMissiles");
+			ProcessMissiles();
+		}
 	}
 	gGameLogicStep = GameLogicStep::None;
 
@@ -2670,8 +2832,10 @@ void SetCursorPos(Point position)
 void FreeGameMem()
 {
 	pDungeonCels = nullptr;
+	pDungeonCelSpans = nullptr;
 	pMegaTiles = nullptr;
 	pSpecialCels = std::nullopt;
+	DiscardWorldSnapshots();
 
 	FreeMonsters();
 	FreeMissileGFX();
@@ -2782,18 +2946,9 @@ int DiabloMain(int argc, char **argv)
 	// Finally load game data
 	LoadGameArchives();
 
-	LoadTextData();
-
 	// Load dynamic data before we go into the menu as we need to initialise player characters in memory pretty early.
-	LoadPlayerDataFiles();
-
-	// TODO: We can probably load this much later (when the game is starting).
-	LoadSpellData();
-	LoadMissileData();
-	LoadMonsterData();
-	LoadItemData();
-	LoadObjectData();
-	LoadQuestData();
+	// TODO: We can probably load most of this much later (when the game is starting).
+	LoadDataTables();
 
 	DiabloInit();
 #ifdef __UWP__
@@ -3395,9 +3550,19 @@ void LoadGameLevelCalculateCursor()
 	CheckCursMove();
 }
 
+void PrefetchLvlGFX(dungeon_type levelType)
+{
+	if (HeadlessMode)
+		return;
+	LevelGFXPrefetcher.prefetch(static_cast<size_t>(levelType), [levelType]() {
+		return LoadLevelGFX(levelType, /*threadsafe=*/true);
+	});
+}
+
 std::expected<void, std::string> LoadGameLevel(bool firstflag, lvl_entry lvldir)
 {
 	const _music_id neededTrack = GetLevelMusic(leveltype);
+	LevelAssetPrefetchStats = {};
 
 	ClearFloatingNumbers();
 	LoadGameLevelStopMusic(neededTrack);
@@ -3414,8 +3579,11 @@ std::expected<void, std::string> LoadGameLevel(bool firstflag, lvl_entry lvldir)
 	IncProgress();
 
 	RETURN_IF_ERROR(LoadLvlGFX());
-	SetDungeonMicros(pDungeonCels, MicroTileLen);
+	SetDungeonMicros(pDungeonCels, pDungeonCelSpans, MicroTileLen);
 	ClearClxDrawCache();
+	InvalidateFloorCache();
+	DiscardWorldSnapshots();
+	DirtyLightTiles.set();
 
 	IncProgress();
 
@@ -3480,6 +3648,14 @@ std::expected<void, std::string> LoadGameLevel(bool firstflag, lvl_entry lvldir)
 	CompleteProgress();
 
 	LoadGameLevelCalculateCursor();
+	LogVerbose("{} of {} level assets served from prefetch", LevelAssetPrefetchStats.prefetched,
+	    LevelAssetPrefetchStats.prefetched + LevelAssetPrefetchStats.loadedOnDemand);
+#ifndef UNPACKED_MPQS
+	if (IsClxCacheEnabled()) {
+		const ClxCacheStats clxCacheStats = GetClxCacheStats();
+		LogVerbose("CLX cache: {} hits, {} misses since startup", clxCacheStats.hits, clxCacheStats.misses);
+	}
+#endif
 	return {};
 }
 
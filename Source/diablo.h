@@ -75,7 +75,7 @@ enum class PlayerActionType : uint8_t {
 	OperateObject,
 };
 
-extern uint32_t DungeonSeeds[NUMLEVELS];
+extern DVL_API_FOR_TEST uint32_t DungeonSeeds[NUMLEVELS];
 extern DVL_API_FOR_TEST std::optional<uint32_t> LevelSeeds[NUMLEVELS];
 extern DVL_API_FOR_TEST Point MousePosition;
 
@@ -106,6 +106,10 @@ void diablo_focus_pause();
 void diablo_focus_unpause();
 bool PressEscKey();
 void DisableInputEventHandler(const SDL_Event &event, uint16_t modState);
+/**
+ * @brief Starts loading the tileset of the given level type in the background, for use by the next `LoadGameLevel`.
+ */
+void PrefetchLvlGFX(dungeon_type levelType);
 std::expected<void, std::string> LoadGameLevel(bool firstflag, lvl_entry lvldir);
 bool IsDiabloAlive(bool playSFX);
 void PrintScreen(SDL_Keycode vkey);
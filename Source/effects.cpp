@@ -42,6 +42,42 @@ TSFX *sgpStreamSFX = nullptr;
 /** List of all sounds, except monsters and music */
 std::vector<TSFX> sgSFX;
 
+SoundCache<TSnd>::Key GetSfxKey(const TSFX &sfx)
+{
+	return static_cast<SoundCache<TSnd>::Key>(&sfx - sgSFX.data());
+}
+
+SoundCategory GetSfxCategory(const TSFX &sfx)
+{
+	if ((sfx.bFlags & sfx_UI) != 0)
+		return SoundCategory::Ui;
+	if ((sfx.bFlags & (sfx_WARRIOR | sfx_ROGUE | sfx_SORCERER | sfx_MONK)) != 0)
+		return SoundCategory::Hero;
+	return SoundCategory::Effect;
+}
+
+/** @brief Returns a sound that is not streamed, loading it if needed. */
+TSnd *GetSfxSound(TSFX &sfx)
+{
+	assert((sfx.bFlags & sfx_STREAM) == 0);
+	return GetCachedSound(GetSfxKey(sfx), GetSfxCategory(sfx), sfx.pszName.c_str());
+}
+
+/** @brief Returns a sound that is not streamed if it is loaded. */
+TSnd *PeekSfxSound(const TSFX &sfx)
+{
+	return GetSoundCache().peek(GetSfxKey(sfx));
+}
+
+void ReleaseSfxSounds()
+{
+	for (auto &sfx : sgSFX)
+		sfx.pSnd = nullptr;
+	ReleaseCachedSounds(SoundCategory::Effect);
+	ReleaseCachedSounds(SoundCategory::Ui);
+	ReleaseCachedSounds(SoundCategory::Hero);
+}
+
 void StreamPlay(TSFX *pSFX, int lVolume, int lPan)
 {
 	assert(pSFX);
@@ -75,8 +111,10 @@ void PlaySfxPriv(TSFX *pSFX, bool loc, Point position)
 		return;
 	}
 
-	if ((pSFX->bFlags & (sfx_STREAM | sfx_MISC)) == 0 && pSFX->pSnd != nullptr && pSFX->pSnd->isPlaying()) {
-		return;
+	if ((pSFX->bFlags & (sfx_STREAM | sfx_MISC)) == 0) {
+		TSnd *loaded = PeekSfxSound(*pSFX);
+		if (loaded != nullptr && loaded->isPlaying())
+			return;
 	}
 
 	int lVolume = 0;
@@ -90,16 +128,14 @@ void PlaySfxPriv(TSFX *pSFX, bool loc, Point position)
 		return;
 	}
 
-	if (pSFX->pSnd == nullptr)
-		pSFX->pSnd = sound_file_load(pSFX->pszName.c_str());
-
-	if (pSFX->pSnd == nullptr || !pSFX->pSnd->DSB.IsLoaded())
+	TSnd *snd = GetSfxSound(*pSFX);
+	if (snd == nullptr || !snd->DSB.IsLoaded())
 		return;
 
 	const auto id = static_cast<SfxID>(pSFX - sgSFX.data());
 	const bool useCuesVolume = (id >= SfxID::AccessibilityWeapon && id <= SfxID::AccessibilityInteract);
 	const int userVolume = useCuesVolume ? *GetOptions().Audio.audioCuesVolume : *GetOptions().Audio.soundVolume;
-	snd_play_snd(pSFX->pSnd.get(), lVolume, lPan, userVolume);
+	snd_play_snd(snd, lVolume, lPan, userVolume);
 }
 
 SfxID RndSFX(SfxID psfx)
@@ -164,8 +200,10 @@ void PrivSoundInit(uint8_t bLoadMask)
 
 	if (sgSFX.empty()) LoadEffectsData();
 
+	// The sounds are only prefetched. Any that are played before they have been loaded,
+	// or that did not fit in the sound cache, are loaded when they are played.
 	for (auto &sfx : sgSFX) {
-		if (sfx.bFlags == 0 || sfx.pSnd != nullptr) {
+		if (sfx.bFlags == 0) {
 			continue;
 		}
 
@@ -177,7 +215,7 @@ void PrivSoundInit(uint8_t bLoadMask)
 			continue;
 		}
 
-		sfx.pSnd = sound_file_load(sfx.pszName.c_str());
+		PrefetchSound(GetSfxKey(sfx), GetSfxCategory(sfx), sfx.pszName);
 	}
 }
 
@@ -188,13 +226,14 @@ bool effect_is_playing(SfxID nSFX)
 	if (!gbSndInited) return false;
 
 	TSFX *sfx = &sgSFX[static_cast<int16_t>(nSFX)];
-	if (sfx->pSnd != nullptr)
-		return sfx->pSnd->isPlaying();
-
-	if ((sfx->bFlags & sfx_STREAM) != 0)
+	if ((sfx->bFlags & sfx_STREAM) != 0) {
+		if (sfx->pSnd != nullptr)
+			return sfx->pSnd->isPlaying();
 		return sfx == sgpStreamSFX;
+	}
 
-	return false;
+	TSnd *snd = PeekSfxSound(*sfx);
+	return snd != nullptr && snd->isPlaying();
 }
 
 void stream_stop()
@@ -223,7 +262,7 @@ void PlaySfxLoc(SfxID psfx, Point position, bool randomizeByCategory)
 	if (!gbSndInited) return;
 
 	if (IsAnyOf(psfx, SfxID::Walk, SfxID::ShootBow, SfxID::CastSpell, SfxID::Swing)) {
-		TSnd *pSnd = sgSFX[static_cast<int16_t>(psfx)].pSnd.get();
+		TSnd *pSnd = PeekSfxSound(sgSFX[static_cast<int16_t>(psfx)]);
 		if (pSnd != nullptr)
 			pSnd->start_tc = 0;
 	}
@@ -241,6 +280,10 @@ void sound_stop()
 			sfx.pSnd->DSB.Stop();
 		}
 	}
+	GetSoundCache().forEach([](TSnd &snd) {
+		if (snd.DSB.IsLoaded())
+			snd.DSB.Stop();
+	});
 }
 
 void sound_update()
@@ -250,19 +293,16 @@ void sound_update()
 	}
 
 	StreamUpdate();
+	UpdateSoundCache();
 }
 
 void effects_cleanup_sfx(bool fullUnload)
 {
 	sound_stop();
 
-	if (fullUnload) {
+	ReleaseSfxSounds();
+	if (fullUnload)
 		sgSFX.clear();
-		return;
-	}
-
-	for (auto &sfx : sgSFX)
-		sfx.pSnd = nullptr;
 }
 
 void sound_init()
@@ -315,17 +355,21 @@ void effects_play_sound(SfxID id)
 	}
 
 	TSFX &sfx = sgSFX[static_cast<int16_t>(id)];
-	if (sfx.pSnd != nullptr && !sfx.pSnd->isPlaying()) {
-		snd_play_snd(sfx.pSnd.get(), 0, 0, *GetOptions().Audio.soundVolume);
+	TSnd *snd = (sfx.bFlags & sfx_STREAM) != 0 ? sfx.pSnd.get() : GetSfxSound(sfx);
+	if (snd != nullptr && !snd->isPlaying()) {
+		snd_play_snd(snd, 0, 0, *GetOptions().Audio.soundVolume);
 	}
 }
 
 int GetSFXLength(SfxID nSFX)
 {
 	TSFX &sfx = sgSFX[static_cast<int16_t>(nSFX)];
+	if ((sfx.bFlags & sfx_STREAM) == 0) {
+		TSnd *snd = GetSfxSound(sfx);
+		return snd != nullptr ? snd->DSB.GetLength() : 0;
+	}
 	if (sfx.pSnd == nullptr)
-		sfx.pSnd = sound_file_load(sfx.pszName.c_str(),
-		    /*stream=*/AllowStreaming && (sfx.bFlags & sfx_STREAM) != 0);
+		sfx.pSnd = sound_file_load(sfx.pszName.c_str(), AllowStreaming);
 	return sfx.pSnd->DSB.GetLength();
 }
 
@@ -18,6 +18,7 @@ namespace devilution {
 struct TSFX {
 	uint8_t bFlags;
 	std::string pszName;
+	/** @brief Only set for streamed sounds, the others are kept in `GetSoundCache()`. */
 	std::unique_ptr<TSnd> pSnd;
 };
 
@@ -16,6 +16,11 @@
 namespace devilution {
 
 int8_t AnimationInfo::getFrameToUseForRendering() const
+{
+	return getFrameToUseForRendering(ProgressToNextGameTick);
+}
+
+int8_t AnimationInfo::getFrameToUseForRendering(uint8_t progressToNextGameTick) const
 {
 	// Normal logic is used,
 	// - if no frame-skipping is required and so we have exactly one Animationframe per game tick
@@ -34,7 +39,7 @@ int8_t AnimationInfo::getFrameToUseForRendering() const
 	}
 
 	// we don't use the processed game ticks alone but also the fraction of the next game tick (if a rendering happens between game ticks). This helps to smooth the animations.
-	const int32_t totalTicksForCurrentAnimationSequence = getProgressToNextGameTick() + ticksSinceSequenceStarted;
+	const int32_t totalTicksForCurrentAnimationSequence = getProgressToNextGameTick(progressToNextGameTick) + ticksSinceSequenceStarted;
 
 	auto absoluteAnimationFrame = static_cast<int8_t>(totalTicksForCurrentAnimationSequence * tickModifier_ / baseValueFraction / baseValueFraction);
 	if (skippedFramesFromPreviousAnimation_ > 0) {
@@ -60,6 +65,11 @@ int8_t AnimationInfo::getFrameToUseForRendering() const
 }
 
 uint8_t AnimationInfo::getAnimationProgress() const
+{
+	return getAnimationProgress(ProgressToNextGameTick);
+}
+
+uint8_t AnimationInfo::getAnimationProgress(uint8_t progressToNextGameTick) const
 {
 	int16_t ticksSinceSequenceStarted = std::max<int16_t>(0, ticksSinceSequenceStarted_);
 	int32_t tickModifier = tickModifier_;
@@ -75,7 +85,7 @@ uint8_t AnimationInfo::getAnimationProgress() const
 		tickModifier = baseValueFraction / ticksPerFrame;
 	}
 
-	const int32_t totalTicksForCurrentAnimationSequence = getProgressToNextGameTick() + ticksSinceSequenceStarted;
+	const int32_t totalTicksForCurrentAnimationSequence = getProgressToNextGameTick(progressToNextGameTick) + ticksSinceSequenceStarted;
 	const int32_t progressInAnimationFrames = totalTicksForCurrentAnimationSequence * tickModifier;
 	const int32_t animationFraction = progressInAnimationFrames / numberOfFrames / baseValueFraction;
 	assert(animationFraction <= baseValueFraction);
@@ -221,11 +231,11 @@ void AnimationInfo::processAnimation(bool reverseAnimation /*= false*/)
 	}
 }
 
-uint8_t AnimationInfo::getProgressToNextGameTick() const
+uint8_t AnimationInfo::getProgressToNextGameTick(uint8_t progressToNextGameTick) const
 {
 	if (isPetrified)
 		return 0;
-	return ProgressToNextGameTick;
+	return progressToNextGameTick;
 }
 
 } // namespace devilution
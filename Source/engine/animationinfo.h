@@ -66,6 +66,15 @@ public:
 		return (*sprites)[getFrameToUseForRendering()];
 	}
 
+	/**
+	 * @brief Returns the sprite to render when the given fraction of the next game tick has passed
+	 * @param progressToNextGameTick Progress to the next game tick (see baseValueFraction)
+	 */
+	[[nodiscard]] ClxSprite currentSprite(uint8_t progressToNextGameTick) const
+	{
+		return (*sprites)[getFrameToUseForRendering(progressToNextGameTick)];
+	}
+
 	[[nodiscard]] bool isLastFrame() const
 	{
 		return currentFrame >= (numberOfFrames - 1);
@@ -77,11 +86,24 @@ public:
 	 */
 	[[nodiscard]] int8_t getFrameToUseForRendering() const;
 
+	/**
+	 * @brief Calculates the Frame to use for the Animation rendering when the given fraction of the next game tick has passed
+	 * @param progressToNextGameTick Progress to the next game tick (see baseValueFraction), ignored while petrified
+	 * @return The Frame to use for rendering
+	 */
+	[[nodiscard]] int8_t getFrameToUseForRendering(uint8_t progressToNextGameTick) const;
+
 	/**
 	 * @brief Calculates the progress of the current animation as a fraction (see baseValueFraction)
 	 */
 	[[nodiscard]] uint8_t getAnimationProgress() const;
 
+	/**
+	 * @brief Calculates the progress of the current animation as a fraction (see baseValueFraction) when the given fraction of the next game tick has passed
+	 * @param progressToNextGameTick Progress to the next game tick (see baseValueFraction), ignored while petrified
+	 */
+	[[nodiscard]] uint8_t getAnimationProgress(uint8_t progressToNextGameTick) const;
+
 	/**
 	 * @brief Sets the new Animation with all relevant information for rendering
 	 * @param sprites Animation sprites
@@ -117,7 +139,7 @@ private:
 	/**
 	 * @brief returns the progress as a fraction in time to the next game tick or no progress if the animation is frozen (see baseValueFraction)
 	 */
-	[[nodiscard]] uint8_t getProgressToNextGameTick() const;
+	[[nodiscard]] uint8_t getProgressToNextGameTick(uint8_t progressToNextGameTick) const;
 
 	/**
 	 * @brief Animation Frames that will be adjusted for the skipped Frames/game ticks
@@ -0,0 +1,7 @@
+#include "engine/asset_prefetch.hpp"
+
+namespace devilution {
+
+AssetPrefetchStats LevelAssetPrefetchStats;
+
+} // namespace devilution
@@ -0,0 +1,110 @@
+/**
+ * @file asset_prefetch.hpp
+ *
+ * Loading level assets on worker threads before the main thread needs them.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/thread_pool.hpp"
+
+namespace devilution {
+
+struct AssetPrefetchStats {
+	/** @brief Assets that were taken from a prefetch. */
+	size_t prefetched = 0;
+	/** @brief Assets that had to be loaded on the main thread. */
+	size_t loadedOnDemand = 0;
+};
+
+/** @brief Counts for the level that is currently being loaded. */
+extern AssetPrefetchStats LevelAssetPrefetchStats;
+
+/**
+ * @brief Loads assets on the worker pool, to be picked up later by the main thread.
+ *
+ * The main thread starts a load with `prefetch()` as soon as it knows which asset will be
+ * needed and adopts the result with `take()`, which only blocks if the load is still running.
+ *
+ * @tparam T The loaded asset
+ */
+template <typename T>
+class AssetPrefetcher {
+public:
+	/**
+	 * @brief Runs `load` on a worker thread, unless `key` has already been prefetched.
+	 *
+	 * `load` must only open assets with `threadsafe` set and must not capture anything
+	 * that can go away before it has run.
+	 */
+	void prefetch(size_t key, std::function<T()> load)
+	{
+		if (find(key) != entries_.end())
+			return;
+		auto slot = std::make_shared<Slot>();
+		entries_.push_back(Entry { key, slot });
+		GetWorkerPool().submit([slot, load = std::move(load)]() {
+			T value = load();
+			const std::lock_guard<SdlMutex> lock(slot->mutex);
+			slot->value = std::move(value);
+			slot->ready.broadcast();
+		});
+	}
+
+	/**
+	 * @brief Returns the asset prefetched for `key`, waiting for it if necessary.
+	 * @return `std::nullopt` if `key` was not prefetched
+	 */
+	std::optional<T> take(size_t key)
+	{
+		auto it = find(key);
+		if (it == entries_.end())
+			return std::nullopt;
+		const std::shared_ptr<Slot> slot = std::move(it->slot);
+		entries_.erase(it);
+
+		std::unique_lock<SdlMutex> lock(slot->mutex);
+		while (!slot->value)
+			slot->ready.wait(slot->mutex);
+		return std::move(slot->value);
+	}
+
+	/**
+	 * @brief Drops all prefetched assets. Loads that are still running are discarded when they finish.
+	 */
+	void clear()
+	{
+		entries_.clear();
+	}
+
+private:
+	struct Slot {
+		SdlMutex mutex;
+		SdlCond ready;
+		std::optional<T> value;
+	};
+
+	struct Entry {
+		size_t key;
+		std::shared_ptr<Slot> slot;
+	};
+
+	typename std::vector<Entry>::iterator find(size_t key)
+	{
+		return std::find_if(entries_.begin(), entries_.end(), [key](const Entry &entry) { return entry.key == key; });
+	}
+
+	std::vector<Entry> entries_;
+};
+
+} // namespace devilution
@@ -7,6 +7,9 @@
 #include <expected>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -23,6 +26,7 @@
 #include "utils/file_util.h"
 #include "utils/format.hpp"
 #include "utils/log.hpp"
+#include "utils/mapped_file.hpp"
 #include "utils/paths.h"
 #include "utils/sdl_compat.h"
 #include "utils/str_case.hpp"
@@ -34,7 +38,11 @@
 #endif
 
 #ifndef UNPACKED_MPQS
+#include <ankerl/unordered_dense.h>
+
 #include "mpq/mpq_sdl_rwops.hpp"
+#include "utils/sdl_mutex.h"
+#include "utils/string_view_hash.hpp"
 #endif
 
 namespace devilution {
@@ -42,7 +50,7 @@ namespace devilution {
 std::vector<std::string> OverridePaths;
 std::map<int, MpqArchiveT, std::greater<>> MpqArchives;
 bool HasHellfireMpq;
-bool IsAssetIntegrityViolated = false;
+std::atomic<bool> IsAssetIntegrityViolated = false;
 
 namespace {
 
@@ -87,6 +95,165 @@ bool FindMpqFile(std::string_view filename, MpqArchive **archive, uint32_t *hash
 	return false;
 }
 
+#if (defined(__ANDROID__) && !defined(TERMUX)) || defined(__APPLE__)
+#define DEVILUTIONX_HAS_BUNDLED_ASSETS
+#endif
+
+/**
+ * @brief Where `FindAsset` found a file.
+ */
+struct AssetSource {
+	enum class Kind : uint8_t {
+		NotFound,
+		/** @brief A loose file in `OverridePaths[index]`. */
+		Override,
+		/** @brief Entry `index` of the hash table of `archive`. */
+		Mpq,
+		/** @brief A file in `paths::AssetsPath()`. */
+		AssetsDir,
+#ifdef DEVILUTIONX_HAS_BUNDLED_ASSETS
+		/** @brief Possibly an asset bundled with the app, only known once opened. */
+		Bundled,
+#endif
+	};
+
+	Kind kind = Kind::NotFound;
+	uint32_t index = 0;
+	MpqArchive *archive = nullptr;
+};
+
+/**
+ * @brief Maps the files of the mod override directories to the `OverridePaths` index that wins for them.
+ *
+ * Only changes when `OverridePaths` does. `PrefPath()` isn't listed because it also holds the
+ * saves and the config, its files are looked up one path at a time instead.
+ *
+ * Keys are relative paths with native directory separators, lowercased where the
+ * filesystem is case-insensitive.
+ */
+ankerl::unordered_dense::map<std::string, uint32_t, StringViewHash, StringViewEquals> OverrideIndex;
+/** @brief The `OverridePaths` index of `PrefPath()`, or `UINT32_MAX` if it isn't an override path. */
+uint32_t PrefPathOverrideIndex = UINT32_MAX;
+
+/**
+ * @brief Remembers the source that wins for each path looked up, so that each lookup is a single probe.
+ *
+ * MPQ archives can't be listed without a listfile, so the sources are resolved on the first lookup
+ * of each path. Cleared whenever `MpqArchives` changes.
+ */
+ankerl::unordered_dense::map<std::string, AssetSource, StringViewHash, StringViewEquals> AssetIndex;
+// `FindAsset` is also called from the worker threads that prefetch assets.
+SdlMutex AssetIndexMutex;
+
+void NormalizeAssetIndexKey(std::string &path)
+{
+#if defined(_WIN32) || defined(__APPLE__)
+	AsciiStrToLower(path);
+#else
+	(void)path;
+#endif
+}
+
+void IndexOverrideFiles(uint32_t overrideIndex, const std::string &rootPath, const std::string &relativeDir, unsigned depth)
+{
+	constexpr unsigned MaxScanDepth = 16;
+	if (depth > MaxScanDepth)
+		return;
+	const std::string dirPath = rootPath + relativeDir;
+	for (const std::string &filename : ListFiles(dirPath.c_str())) {
+		std::string key = relativeDir + filename;
+		NormalizeAssetIndexKey(key);
+		// Earlier override paths take precedence.
+		OverrideIndex.try_emplace(std::move(key), overrideIndex);
+	}
+	for (const std::string &subdirName : ListDirectories(dirPath.c_str())) {
+		IndexOverrideFiles(overrideIndex, rootPath, StrCat(relativeDir, subdirName, DIRECTORY_SEPARATOR_STR), depth + 1);
+	}
+}
+
+/**
+ * @brief Finds the source of a file that isn't overridden by a loose file.
+ */
+AssetSource ResolvePackedAssetSource(std::string_view filename, const std::string &relativePath)
+{
+	AssetSource source;
+	if (FindMpqFile(filename, &source.archive, &source.index)) {
+		source.kind = AssetSource::Kind::Mpq;
+	} else if (FileExists(paths::AssetsPath() + relativePath)) {
+		source.kind = AssetSource::Kind::AssetsDir;
+#ifdef DEVILUTIONX_HAS_BUNDLED_ASSETS
+	} else if (!paths::AssetsPath().empty()) {
+		source.kind = AssetSource::Kind::Bundled;
+#endif
+	}
+	return source;
+}
+
+/** @pre `AssetIndexMutex` is locked */
+AssetSource ResolveAssetSource(std::string_view filename, const std::string &relativePath, const std::string &key)
+{
+	if (const auto it = OverrideIndex.find(key); it != OverrideIndex.end())
+		return AssetSource { AssetSource::Kind::Override, it->second, nullptr };
+	// `PrefPath()` comes after the mod directories, so it's only checked once none of them has the file.
+	if (PrefPathOverrideIndex != UINT32_MAX && FileExists(OverridePaths[PrefPathOverrideIndex] + relativePath))
+		return AssetSource { AssetSource::Kind::Override, PrefPathOverrideIndex, nullptr };
+	return ResolvePackedAssetSource(filename, relativePath);
+}
+
+AssetSource FindAssetSource(std::string_view filename, const std::string &relativePath)
+{
+	std::string key = relativePath;
+	NormalizeAssetIndexKey(key);
+
+	const std::lock_guard<SdlMutex> lock(AssetIndexMutex);
+	if (const auto it = AssetIndex.find(key); it != AssetIndex.end())
+		return it->second;
+	const AssetSource source = ResolveAssetSource(filename, relativePath, key);
+	AssetIndex.emplace(std::move(key), source);
+	return source;
+}
+
+/**
+ * @brief Opens `source` into `result`.
+ * @return false if `source` is an override that can no longer be opened
+ */
+bool OpenAssetSource(const AssetSource &source, std::string_view filename, const std::string &relativePath, AssetRef &result)
+{
+	switch (source.kind) {
+	case AssetSource::Kind::Override: {
+		// Files in the `PrefPath()` directory can override MPQ contents.
+		std::string path = OverridePaths[source.index] + relativePath;
+		result.directHandle = OpenOptionalRWops(path);
+		if (result.directHandle == nullptr)
+			return false;
+		LogVerbose("Loaded MPQ file override: {}", path);
+		result.isOverridden = true;
+		result.directPath = std::move(path);
+		break;
+	}
+	case AssetSource::Kind::Mpq:
+		result.archive = source.archive;
+		result.hashIndex = source.index;
+		result.filename = filename;
+		break;
+	case AssetSource::Kind::AssetsDir:
+		// Load from the `/assets` directory next to the devilutionx binary.
+		result.directPath = paths::AssetsPath() + relativePath;
+		result.directHandle = OpenOptionalRWops(result.directPath);
+		break;
+#ifdef DEVILUTIONX_HAS_BUNDLED_ASSETS
+	case AssetSource::Kind::Bundled:
+		// Fall back to the bundled assets on supported systems.
+		// This is handled by SDL when we pass a relative path.
+		result.directHandle = SDL_IOFromFile(relativePath.c_str(), "rb");
+		break;
+#endif
+	case AssetSource::Kind::NotFound:
+		break;
+	}
+	return true;
+}
+
 bool HasLogicAssetExtension(std::string_view filename)
 {
 	if (filename.size() < 4)
@@ -182,6 +349,14 @@ AssetRef FindAsset(std::string_view filename)
 	}
 	return result;
 }
+
+void RebuildAssetIndex()
+{
+}
+
+void InvalidateAssetIndex()
+{
+}
 #else
 AssetRef FindAsset(std::string_view filename)
 {
@@ -201,41 +376,34 @@ AssetRef FindAsset(std::string_view filename)
 		}
 	}
 
-	// Files in the `PrefPath()` directory can override MPQ contents.
-	{
-		for (const auto &overridePath : OverridePaths) {
-			const std::string path = overridePath + relativePath;
-			result.directHandle = OpenOptionalRWops(path);
-			if (result.directHandle != nullptr) {
-				LogVerbose("Loaded MPQ file override: {}", path);
-				result.isOverridden = true;
-				return result;
-			}
-		}
+	const AssetSource source = FindAssetSource(filename, relativePath);
+	if (!OpenAssetSource(source, filename, relativePath, result)) {
+		// The override was removed or can't be read, so use the file it was overriding.
+		LogVerbose("Failed to open MPQ file override: {}{}", OverridePaths[source.index], relativePath);
+		OpenAssetSource(ResolvePackedAssetSource(filename, relativePath), filename, relativePath, result);
 	}
+	return result;
+}
 
-	// Look for the file in all the MPQ archives:
-	if (FindMpqFile(filename, &result.archive, &result.hashIndex)) {
-		result.filename = filename;
-		return result;
-	}
-
-	// Load from the `/assets` directory next to the devilutionx binary.
-	result.directHandle = OpenOptionalRWops(paths::AssetsPath() + relativePath);
-	if (result.directHandle != nullptr)
-		return result;
-
-#if (defined(__ANDROID__) && !defined(TERMUX)) || defined(__APPLE__)
-	// Fall back to the bundled assets on supported systems.
-	// This is handled by SDL when we pass a relative path.
-	if (!paths::AssetsPath().empty()) {
-		result.directHandle = SDL_IOFromFile(relativePath.c_str(), "rb");
-		if (result.directHandle != nullptr)
-			return result;
+void RebuildAssetIndex()
+{
+	const std::lock_guard<SdlMutex> lock(AssetIndexMutex);
+	OverrideIndex.clear();
+	PrefPathOverrideIndex = UINT32_MAX;
+	for (size_t i = 0; i < OverridePaths.size(); ++i) {
+		if (OverridePaths[i] == paths::PrefPath()) {
+			PrefPathOverrideIndex = static_cast<uint32_t>(i);
+			continue;
+		}
+		IndexOverrideFiles(static_cast<uint32_t>(i), OverridePaths[i], /*relativeDir=*/ {}, /*depth=*/0);
 	}
-#endif
+	AssetIndex.clear();
+}
 
-	return result;
+void InvalidateAssetIndex()
+{
+	const std::lock_guard<SdlMutex> lock(AssetIndexMutex);
+	AssetIndex.clear();
 }
 #endif
 
@@ -311,17 +479,64 @@ SDL_IOStream *OpenAssetAsSdlRwOps(std::string_view filename, bool threadsafe)
 #endif
 }
 
-std::expected<AssetData, std::string> LoadAsset(std::string_view path)
+namespace {
+
+std::optional<AssetData> MapAssetFile(const char *path)
 {
-	AssetRef ref = FindAsset(path);
-	if (!ref.ok()) {
-		return std::unexpected(StrCat("Asset not found: ", path));
+	std::optional<MappedFile> file = MappedFile::Open(path);
+	if (!file)
+		return std::nullopt;
+	auto owner = std::make_shared<const MappedFile>(*std::move(file));
+	return AssetData { owner, owner->data(), owner->size() };
+}
+
+} // namespace
+
+std::expected<AssetData, std::string> ReadAsset(AssetRef &&ref, std::string_view path, bool threadsafe)
+{
+	// Files on disk and files stored uncompressed in MPQs are mapped.
+	// Anything else, such as compressed or bundled files, is copied.
+#ifdef UNPACKED_MPQS
+	// Unpacked files are opened with their own handles, which is always thread-safe.
+	(void)threadsafe;
+	if (std::optional<AssetData> mapped = MapAssetFile(ref.path))
+		return *std::move(mapped);
+#else
+	if (!ref.directPath.empty()) {
+		if (std::optional<AssetData> mapped = MapAssetFile(ref.directPath.c_str()))
+			return *std::move(mapped);
+	} else if (ref.archive != nullptr) {
+		size_t size;
+		// Mapped files are read without the archive handle, so they don't need a clone either.
+		if (std::shared_ptr<const std::byte[]> mapped = ref.archive->MapFile(ref.filename, size); mapped != nullptr) {
+			const char *bytes = reinterpret_cast<const char *>(mapped.get());
+			return AssetData { std::move(mapped), bytes, size };
+		}
+		MpqArchive *archive = ref.archive;
+		std::optional<MpqArchive> clone;
+		if (threadsafe) {
+			std::expected<MpqArchive, std::string> result = archive->Clone();
+			if (!result.has_value()) {
+				return std::unexpected(StrCat("Failed to open asset: ", path, "\n", result.error()));
+			}
+			clone.emplace(*std::move(result));
+			archive = &*clone;
+		}
+		int32_t error;
+		// A copy rather than the file cache's buffer, so that the cache can free it once evicted.
+		std::shared_ptr<const std::byte[]> data = archive->ReadFile(ref.filename, size, error);
+		if (data == nullptr) {
+			return std::unexpected(StrCat("Read failed: ", path, "\nMPQ error ", error));
+		}
+		const char *bytes = reinterpret_cast<const char *>(data.get());
+		return AssetData { std::move(data), bytes, size };
 	}
+#endif
 
 	const size_t size = ref.size();
 	std::unique_ptr<char[]> data { new char[size] };
 
-	AssetHandle handle = OpenAsset(std::move(ref));
+	AssetHandle handle = OpenAsset(std::move(ref), threadsafe);
 	if (!handle.ok()) {
 		return std::unexpected(StrCat("Failed to open asset: ", path, "\n", handle.error()));
 	}
@@ -333,26 +548,31 @@ std::expected<AssetData, std::string> LoadAsset(std::string_view path)
 	return AssetData { std::move(data), size };
 }
 
-std::expected<AssetData, std::string> LoadIntegralAsset(std::string_view path)
+std::expected<AssetData, std::string> ReadIntegralAsset(AssetRef &&ref, std::string_view path, bool threadsafe)
+{
+#ifndef UNPACKED_MPQS
+	if (ref.isOverridden)
+		IsAssetIntegrityViolated = true;
+#endif
+	return ReadAsset(std::move(ref), path, threadsafe);
+}
+
+std::expected<AssetData, std::string> LoadAsset(std::string_view path)
 {
 	AssetRef ref = FindAsset(path);
 	if (!ref.ok()) {
 		return std::unexpected(StrCat("Asset not found: ", path));
 	}
+	return ReadAsset(std::move(ref), path);
+}
 
-	const size_t size = ref.size();
-	std::unique_ptr<char[]> data { new char[size] };
-
-	AssetHandle handle = OpenIntegralAsset(std::move(ref));
-	if (!handle.ok()) {
-		return std::unexpected(StrCat("Failed to open asset: ", path, "\n", handle.error()));
-	}
-
-	if (size > 0 && !handle.read(data.get(), size)) {
-		return std::unexpected(StrCat("Read failed: ", path, "\n", handle.error()));
+std::expected<AssetData, std::string> LoadIntegralAsset(std::string_view path)
+{
+	AssetRef ref = FindAsset(path);
+	if (!ref.ok()) {
+		return std::unexpected(StrCat("Asset not found: ", path));
 	}
-
-	return AssetData { std::move(data), size };
+	return ReadIntegralAsset(std::move(ref), path);
 }
 
 std::string FailedToOpenFileErrorMessage(std::string_view path, std::string_view error)
@@ -422,10 +642,12 @@ bool LoadMPQ(std::span<const std::string> paths, std::string_view mpqName, int p
 			continue;
 		}
 		LogVerbose("  Found: {} in {}", mpqName, path);
+		archive->EnableFileCache();
 		auto [it, inserted] = MpqArchives.emplace(priority, *std::move(archive));
 		if (!inserted) {
 			LogError("MPQ with priority {} is already registered, skipping {}", priority, mpqName);
 		}
+		InvalidateAssetIndex();
 		if (loadedPath != nullptr)
 			*loadedPath = mpqAbsPath;
 		return true;
@@ -521,6 +743,7 @@ void LoadCoreArchives()
 void LoadLanguageArchive()
 {
 	MpqArchives.erase(LangMpqPriority);
+	InvalidateAssetIndex();
 	const std::string_view code = GetLanguageCode();
 	if (code != "en") {
 		LoadMPQ(GetMPQSearchPaths(), code, LangMpqPriority);
@@ -602,6 +825,7 @@ void UnloadModArchives()
 		}
 	}
 #endif
+	RebuildAssetIndex();
 }
 
 #ifndef UNPACKED_MPQS
@@ -767,6 +991,8 @@ void LoadModArchives(std::span<const std::string_view> modnames)
 #endif
 		priority++;
 	}
+
+	RebuildAssetIndex();
 }
 
 bool HasLooseLogicAssets()
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <expected>
 #include <functional>
 #include <map>
+#include <memory>
 #include <span>
 #include <string>
 #include <string_view>
@@ -123,6 +125,8 @@ struct AssetRef {
 
 	// Alternatively, a direct SDL_IOStream handle:
 	SDL_IOStream *directHandle = nullptr;
+	// The file that `directHandle` was opened from, if it is a file on disk.
+	std::string directPath;
 
 	AssetRef() = default;
 
@@ -131,6 +135,7 @@ struct AssetRef {
 	    , hashIndex(other.hashIndex)
 	    , filename(other.filename)
 	    , directHandle(other.directHandle)
+	    , directPath(std::move(other.directPath))
 	{
 		other.directHandle = nullptr;
 	}
@@ -142,6 +147,7 @@ struct AssetRef {
 		hashIndex = other.hashIndex;
 		filename = other.filename;
 		directHandle = other.directHandle;
+		directPath = std::move(other.directPath);
 		other.directHandle = nullptr;
 		return *this;
 	}
@@ -285,19 +291,67 @@ AssetHandle OpenIntegralAsset(std::string_view filename, size_t &fileSize, bool
 
 SDL_IOStream *OpenAssetAsSdlRwOps(std::string_view filename, bool threadsafe = false);
 
-struct AssetData {
-	std::unique_ptr<char[]> data;
-	size_t size;
+/**
+ * @brief The read-only contents of an asset.
+ *
+ * Depending on where the asset is stored, the bytes are a copy, the buffer of the MPQ file
+ * cache, or a memory-mapped view of the file on disk.
+ */
+class AssetData {
+public:
+	AssetData(std::unique_ptr<char[]> &&data, size_t size)
+	    : data_(data.get())
+	    , size_(size)
+	{
+		owner_ = std::shared_ptr<const char[]>(std::move(data));
+	}
+
+	/**
+	 * @param owner Keeps `data` alive
+	 */
+	AssetData(std::shared_ptr<const void> owner, const char *data, size_t size)
+	    : owner_(std::move(owner))
+	    , data_(data)
+	    , size_(size)
+	{
+	}
+
+	[[nodiscard]] const char *data() const { return data_; }
+	[[nodiscard]] size_t size() const { return size_; }
+
+	/** @brief Returns a pointer to the data that keeps it alive. */
+	[[nodiscard]] std::shared_ptr<const char> share() const
+	{
+		return std::shared_ptr<const char>(owner_, data_);
+	}
 
 	explicit operator std::string_view() const
 	{
-		return std::string_view(data.get(), size);
+		return std::string_view(data_, size_);
 	}
+
+private:
+	std::shared_ptr<const void> owner_;
+	const char *data_;
+	size_t size_;
 };
 
 std::expected<AssetData, std::string> LoadAsset(std::string_view path);
 std::expected<AssetData, std::string> LoadIntegralAsset(std::string_view path);
 
+/**
+ * @brief Reads the whole asset found by `FindAsset`, avoiding a copy where possible.
+ *
+ * @param path The path that `ref` was found with, for error messages
+ * @param threadsafe Read MPQ files through a handle of their own, for reading off the main thread
+ */
+std::expected<AssetData, std::string> ReadAsset(AssetRef &&ref, std::string_view path, bool threadsafe = false);
+
+/**
+ * @brief Like `ReadAsset`, but for assets that affect game logic. See `OpenIntegralAsset`.
+ */
+std::expected<AssetData, std::string> ReadIntegralAsset(AssetRef &&ref, std::string_view path, bool threadsafe = false);
+
 #ifdef UNPACKED_MPQS
 using MpqArchiveT = std::string;
 #else
@@ -311,7 +365,7 @@ constexpr int DevilutionXMpqPriority = 9000;
 constexpr int LangMpqPriority = 9100;
 constexpr int FontMpqPriority = 9200;
 extern bool HasHellfireMpq;
-extern bool IsAssetIntegrityViolated;
+extern std::atomic<bool> IsAssetIntegrityViolated;
 
 /**
  * @brief Returns true if any loose-file override root contains loadable logic assets (*.lua, *.tsv, *.sol).
@@ -329,6 +383,23 @@ void LoadHellfireArchives();
 void UnloadModArchives();
 void LoadModArchives(std::span<const std::string_view> modnames);
 
+/**
+ * @brief Rebuilds the index that `FindAsset` resolves asset paths with.
+ *
+ * The index lists the files of the mod override directories and remembers which override directory
+ * or archive won for each path looked up, so that a lookup does not have to probe every one of them.
+ * It is rebuilt automatically when mods are loaded or unloaded and must be rebuilt when `OverridePaths`
+ * changes or files are added to or removed from the mod directories.
+ */
+void RebuildAssetIndex();
+
+/**
+ * @brief Forgets the sources remembered for the paths looked up so far, without listing the override directories again.
+ *
+ * Must be called whenever `MpqArchives` changes.
+ */
+void InvalidateAssetIndex();
+
 /**
  * @brief Reads the `manifest.ini` of a discovered (not necessarily active) mod by name.
  *
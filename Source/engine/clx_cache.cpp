@@ -0,0 +1,217 @@
+#include "engine/clx_cache.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <utility>
+
+#include <ankerl/unordered_dense.h>
+
+#include "engine/assets.hpp"
+#include "utils/file_util.h"
+#include "utils/log.hpp"
+#include "utils/sdl_mutex.h"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+
+namespace {
+
+/** @brief Bump this whenever the CLX format or the converters change. */
+constexpr uint32_t ClxCacheVersion = 1;
+
+constexpr char ClxCacheMagic[4] = { 'D', 'X', 'C', 'C' };
+
+/** @brief Larger than any converted sprite, so that a corrupt header can't request an absurd allocation. */
+constexpr uint32_t MaxClxCacheDataSize = 64 << 20;
+
+/**
+ * @brief The header of a cache file, followed by the key and then the CLX data.
+ *
+ * Cache files are never shared between systems, so they are stored in native byte order.
+ */
+struct ClxCacheFileHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t keySize;
+	uint32_t dataSize;
+	uint16_t numLists;
+	uint16_t reserved;
+};
+
+std::string CacheDirectory;
+
+std::atomic<size_t> Hits;
+std::atomic<size_t> Misses;
+std::atomic<uint32_t> NextTempFileId;
+
+SdlMutex ArchiveIdentitiesMutex;
+/** @brief Maps `MpqArchive::id()` to the part of the key that identifies the archive's file. */
+ankerl::unordered_dense::map<uint32_t, std::string> ArchiveIdentities;
+
+/** @return An empty string if the archive's file can't be inspected. */
+std::string GetArchiveIdentity(const MpqArchive &archive)
+{
+	const std::lock_guard<SdlMutex> lock(ArchiveIdentitiesMutex);
+	auto it = ArchiveIdentities.find(archive.id());
+	if (it == ArchiveIdentities.end()) {
+		std::uintmax_t size;
+		std::int64_t mtime;
+		std::string identity;
+		if (GetFileSize(archive.path().c_str(), &size) && GetFileModificationTime(archive.path().c_str(), &mtime))
+			identity = StrCat(archive.path(), "|", size, "|", mtime);
+		it = ArchiveIdentities.emplace(archive.id(), std::move(identity)).first;
+	}
+	return it->second;
+}
+
+uint64_t HashKey(std::string_view key)
+{
+	// 64-bit FNV-1a, stable across platforms and runs.
+	uint64_t hash = 0xcbf29ce484222325;
+	for (const char c : key) {
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 0x100000001b3;
+	}
+	return hash;
+}
+
+std::string CacheFilePath(std::string_view key)
+{
+	char name[17];
+	std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(HashKey(key)));
+	return StrCat(CacheDirectory, name, ".clx");
+}
+
+} // namespace
+
+void EnableClxCache(std::string directory)
+{
+	if (!directory.empty() && directory.back() != DirectorySeparator && directory.back() != '/')
+		directory += DIRECTORY_SEPARATOR_STR;
+	RecursivelyCreateDir(directory.c_str());
+	CacheDirectory = std::move(directory);
+	LogVerbose("Caching converted sprites in {}", CacheDirectory);
+}
+
+bool IsClxCacheEnabled()
+{
+	return !CacheDirectory.empty();
+}
+
+bool AppendClxCacheKey(std::string &key, std::string_view path)
+{
+	if (!IsClxCacheEnabled())
+		return false;
+	const AssetRef ref = FindAsset(path);
+	if (ref.archive == nullptr)
+		return false;
+	const std::string archiveIdentity = GetArchiveIdentity(*ref.archive);
+	if (archiveIdentity.empty())
+		return false;
+	StrAppend(key, archiveIdentity, "|", ref.hashIndex, "|", ref.size(), "|", path, "|");
+	return true;
+}
+
+std::optional<std::string> ClxCacheKey(std::string_view path, PointerOrValue<uint16_t> widthOrWidths)
+{
+	// The number of widths is only known once the file has been parsed.
+	if (widthOrWidths.HoldsPointer())
+		return std::nullopt;
+	std::string key;
+	if (!AppendClxCacheKey(key, path))
+		return std::nullopt;
+	StrAppend(key, widthOrWidths.AsValue());
+	return key;
+}
+
+std::optional<CachedClxData> LoadCachedClxData(std::string_view key)
+{
+	const std::string path = CacheFilePath(key);
+	std::uintmax_t fileSize;
+	FILE *file = GetFileSize(path.c_str(), &fileSize) ? OpenFile(path.c_str(), "rb") : nullptr;
+	if (file == nullptr) {
+		++Misses;
+		return std::nullopt;
+	}
+
+	std::optional<CachedClxData> result;
+	ClxCacheFileHeader header;
+	std::string storedKey;
+	if (std::fread(&header, sizeof(header), 1, file) == 1
+	    && std::memcmp(header.magic, ClxCacheMagic, sizeof(ClxCacheMagic)) == 0
+	    && header.version == ClxCacheVersion
+	    && header.keySize == key.size()
+	    && header.dataSize <= MaxClxCacheDataSize
+	    // A file that was cut short or written past its end is as good as corrupt.
+	    && fileSize == sizeof(header) + header.keySize + static_cast<std::uintmax_t>(header.dataSize)) {
+		storedKey.resize(header.keySize);
+		// The file name is only a hash of the key, so the key itself is compared too.
+		if (std::fread(storedKey.data(), header.keySize, 1, file) == 1 && storedKey == key) {
+			std::unique_ptr<uint8_t[]> data { new uint8_t[header.dataSize] };
+			if (std::fread(data.get(), header.dataSize, 1, file) == 1)
+				result = CachedClxData { std::move(data), header.dataSize, header.numLists };
+		}
+	}
+	std::fclose(file);
+
+	if (result)
+		++Hits;
+	else
+		++Misses;
+	return result;
+}
+
+void StoreCachedClxData(std::string_view key, const uint8_t *data, size_t size, uint16_t numLists)
+{
+	const std::string path = CacheFilePath(key);
+	// Written under a unique name and then renamed, so that a partially written file is never
+	// read, even if several threads convert the same sprite.
+	const std::string tempPath = StrCat(path, ".", NextTempFileId++, ".tmp");
+	FILE *file = OpenFile(tempPath.c_str(), "wb");
+	if (file == nullptr) {
+		LogError("Failed to write CLX cache file {}", tempPath);
+		return;
+	}
+
+	ClxCacheFileHeader header {};
+	std::memcpy(header.magic, ClxCacheMagic, sizeof(ClxCacheMagic));
+	header.version = ClxCacheVersion;
+	header.keySize = static_cast<uint32_t>(key.size());
+	header.dataSize = static_cast<uint32_t>(size);
+	header.numLists = numLists;
+	const bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1
+	    && std::fwrite(key.data(), key.size(), 1, file) == 1
+	    && std::fwrite(data, size, 1, file) == 1;
+	if (std::fclose(file) != 0 || !ok) {
+		LogError("Failed to write CLX cache file {}", tempPath);
+		RemoveFile(tempPath.c_str());
+		return;
+	}
+	RenameFile(tempPath.c_str(), path.c_str());
+	// The rename fails on some systems if another thread got there first.
+	if (FileExists(tempPath))
+		RemoveFile(tempPath.c_str());
+}
+
+std::optional<OwnedClxSpriteListOrSheet> LoadCachedClx(std::string_view key)
+{
+	std::optional<CachedClxData> cached = LoadCachedClxData(key);
+	if (!cached)
+		return std::nullopt;
+	return OwnedClxSpriteListOrSheet { std::move(cached->data), cached->numLists };
+}
+
+void StoreCachedClx(std::string_view key, const OwnedClxSpriteListOrSheet &clx)
+{
+	const uint8_t *data = clx.isSheet() ? clx.sheet().data() : clx.list().data();
+	StoreCachedClxData(key, data, clx.dataSize(), clx.numLists());
+}
+
+ClxCacheStats GetClxCacheStats()
+{
+	return ClxCacheStats { Hits, Misses };
+}
+
+} // namespace devilution
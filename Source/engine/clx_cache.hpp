@@ -0,0 +1,76 @@
+/**
+ * @file clx_cache.hpp
+ *
+ * On-disk cache of sprites converted to CLX.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "engine/clx_sprite.hpp"
+#include "utils/pointer_value_union.hpp"
+
+namespace devilution {
+
+struct ClxCacheStats {
+	size_t hits = 0;
+	size_t misses = 0;
+};
+
+/**
+ * @brief The contents of a cache entry.
+ */
+struct CachedClxData {
+	std::unique_ptr<uint8_t[]> data;
+	size_t size;
+	/** @brief The number of lists if `data` is a sheet, 0 otherwise. */
+	uint16_t numLists;
+};
+
+/**
+ * @brief Stores the sprites converted from CEL, CL2 and PCX files in `directory`, so that they
+ * do not have to be converted again on the next launch.
+ *
+ * Must be called before any sprites are loaded.
+ */
+void EnableClxCache(std::string directory);
+
+[[nodiscard]] bool IsClxCacheEnabled();
+
+/**
+ * @brief Appends the identity of the asset at `path` to `key`.
+ *
+ * The identity covers the archive the asset is read from (path, size and modification time)
+ * and the asset's entry in that archive, so that keys change whenever the game data or the
+ * active mods do.
+ *
+ * @return false if the cache is disabled or the asset can't be cached, such as a loose
+ * override file that may change at any time.
+ */
+bool AppendClxCacheKey(std::string &key, std::string_view path);
+
+/**
+ * @brief Returns the cache key for converting the asset at `path` with the given frame widths.
+ * @return std::nullopt if the asset can't be cached, see `AppendClxCacheKey`.
+ */
+std::optional<std::string> ClxCacheKey(std::string_view path, PointerOrValue<uint16_t> widthOrWidths);
+
+/** @return std::nullopt on a miss */
+std::optional<CachedClxData> LoadCachedClxData(std::string_view key);
+
+void StoreCachedClxData(std::string_view key, const uint8_t *data, size_t size, uint16_t numLists);
+
+/** @return std::nullopt on a miss */
+std::optional<OwnedClxSpriteListOrSheet> LoadCachedClx(std::string_view key);
+
+void StoreCachedClx(std::string_view key, const OwnedClxSpriteListOrSheet &clx);
+
+/** @brief Lookups since startup. */
+[[nodiscard]] ClxCacheStats GetClxCacheStats();
+
+} // namespace devilution
@@ -1,5 +1,6 @@
 #include "engine/demomode.h"
 
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <limits>
@@ -31,6 +32,7 @@
 #include "utils/display.h"
 #include "utils/endian_stream.hpp"
 #include "utils/file_util.h"
+#include "utils/frame_time_stats.hpp"
 #include "utils/is_of.hpp"
 #include "utils/paths.h"
 #include "utils/str_cat.hpp"
@@ -115,6 +117,8 @@ int DemoNumber = -1;
 std::optional<DemoMsg> CurrentDemoMessage;
 
 bool Timedemo = false;
+/** @brief Playback started with `--headless`, which reports and checks its outcome like a windowed timedemo. */
+bool HeadlessPlayback = false;
 int RecordNumber = -1;
 bool CreateDemoReference = false;
 
@@ -151,6 +155,11 @@ uint32_t DemoModeLastTick = 0;
 int LogicTick = 0;
 uint32_t StartTime = 0;
 
+/** @brief Frame, logic and render durations of the current playback. */
+FrameTimeStats PlaybackTimings;
+std::chrono::steady_clock::time_point PhaseStartTime;
+std::chrono::steady_clock::time_point LastFrameEndTime;
+
 uint16_t DemoGraphicsWidth = 640;
 uint16_t DemoGraphicsHeight = 480;
 
@@ -599,13 +608,19 @@ void WriteDemoMsgHeader(DemoMsg::EventType type)
 	WriteByte(DemoRecording, ProgressToNextGameTick);
 }
 
+uint64_t NanosecondsSince(std::chrono::steady_clock::time_point start)
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
 } // namespace
 
 namespace demo {
 
-void InitPlayBack(int demoNumber, bool timedemo)
+void InitPlayBack(int demoNumber, bool timedemo, bool headless)
 {
 	Timedemo = timedemo;
+	HeadlessPlayback = headless;
 	ControlMode = ControlTypes::KeyboardAndMouse;
 
 	const LoadingStatus status = OpenDemoFile(demoNumber);
@@ -933,6 +948,8 @@ void NotifyGameLoopStart()
 
 	if (IsRunning()) {
 		StartTime = SDL_GetTicks();
+		PlaybackTimings.clear();
+		LastFrameEndTime = std::chrono::steady_clock::now();
 	}
 
 	if (IsRecording()) {
@@ -961,9 +978,14 @@ void NotifyGameLoopEnd()
 		CreateDemoReference = false;
 	}
 
-	if (IsRunning() && !HeadlessMode) {
+	// Other headless users, such as the tests, end the game and check its outcome themselves.
+	if (IsRunning() && (!HeadlessMode || HeadlessPlayback)) {
 		const float seconds = (SDL_GetTicks() - StartTime) / 1000.0F;
-		Log("{} frames, {:.2f} seconds: {:.1f} fps", LogicTick, seconds, LogicTick / seconds);
+		if (HeadlessMode)
+			Log("{} ticks, {:.2f} seconds: {:.1f} ticks per second", LogicTick, seconds, LogicTick / seconds);
+		else
+			Log("{} frames, {:.2f} seconds: {:.1f} fps", LogicTick, seconds, LogicTick / seconds);
+		Log("Timedemo report: {}", PlaybackTimings.toJson(seconds));
 		gbRunGameResult = false;
 		gbRunGame = false;
 
@@ -982,6 +1004,34 @@ void NotifyGameLoopEnd()
 	}
 }
 
+void NotifyLogicStart()
+{
+	if (IsRunning())
+		PhaseStartTime = std::chrono::steady_clock::now();
+}
+
+void NotifyLogicEnd()
+{
+	if (IsRunning())
+		PlaybackTimings.addLogic(NanosecondsSince(PhaseStartTime));
+}
+
+void NotifyRenderStart()
+{
+	if (IsRunning())
+		PhaseStartTime = std::chrono::steady_clock::now();
+}
+
+void NotifyRenderEnd()
+{
+	if (!IsRunning())
+		return;
+	PlaybackTimings.addRender(NanosecondsSince(PhaseStartTime));
+	// A frame spans everything since the previous one was presented: input, logic and rendering.
+	PlaybackTimings.addFrame(NanosecondsSince(LastFrameEndTime));
+	LastFrameEndTime = std::chrono::steady_clock::now();
+}
+
 uint32_t SimulateMillisecondsSinceStartup()
 {
 	return LogicTick * 50;
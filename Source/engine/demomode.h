@@ -18,7 +18,7 @@ namespace devilution {
 namespace demo {
 
 #ifndef DISABLE_DEMOMODE
-void InitPlayBack(int demoNumber, bool timedemo);
+void InitPlayBack(int demoNumber, bool timedemo, bool headless = false);
 void InitRecording(int recordNumber, bool createDemoReference);
 void OverrideOptions();
 
@@ -33,6 +33,13 @@ void RecordMessage(const SDL_Event &event, uint16_t modState);
 void NotifyGameLoopStart();
 void NotifyGameLoopEnd();
 
+/** @brief Bracket the game logic of one loop iteration, timed during demo playback. */
+void NotifyLogicStart();
+void NotifyLogicEnd();
+/** @brief Bracket the rendering of one frame, timed during demo playback. */
+void NotifyRenderStart();
+void NotifyRenderEnd();
+
 uint32_t SimulateMillisecondsSinceStartup();
 #else
 inline void OverrideOptions()
@@ -66,6 +73,18 @@ inline void NotifyGameLoopStart()
 inline void NotifyGameLoopEnd()
 {
 }
+inline void NotifyLogicStart()
+{
+}
+inline void NotifyLogicEnd()
+{
+}
+inline void NotifyRenderStart()
+{
+}
+inline void NotifyRenderEnd()
+{
+}
 inline uint32_t SimulateMillisecondsSinceStartup()
 {
 	return 0;
@@ -28,6 +28,7 @@
 #include "init.hpp"
 #include "options.h"
 #include "utils/display.h"
+#include "utils/frame_profiler.hpp"
 #include "utils/log.hpp"
 #include "utils/sdl_wrap.h"
 
@@ -236,6 +237,7 @@ void RenderPresent()
 {
 	if (HeadlessMode)
 		return;
+	DVL_PROFILE_SCOPE("RenderPresent");
 
 	SDL_Surface *surface = GetOutputSurface();
 
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <expected>
 #include <memory>
+#include <optional>
 #include <string>
 
 #ifdef DEBUG_CEL_TO_CL2_SIZE
@@ -18,25 +19,36 @@
 #ifdef UNPACKED_MPQS
 #include "engine/load_clx.hpp"
 #else
+#include "engine/clx_cache.hpp"
 #include "engine/load_file.hpp"
 #include "utils/cel_to_clx.hpp"
 #endif
 
 namespace devilution {
 
-std::expected<OwnedClxSpriteListOrSheet, std::string> LoadCelListOrSheetWithStatus(const char *pszName, PointerOrValue<uint16_t> widthOrWidths)
+std::expected<OwnedClxSpriteListOrSheet, std::string> LoadCelListOrSheetWithStatus(const char *pszName, PointerOrValue<uint16_t> widthOrWidths, bool threadsafe)
 {
 	char path[MaxMpqPathSize];
 	*BufCopy(path, pszName, DEVILUTIONX_CEL_EXT) = '\0';
 #ifdef UNPACKED_MPQS
+	// Unpacked files are opened with their own handles, which is always thread-safe.
+	(void)threadsafe;
 	return LoadClxListOrSheetWithStatus(path);
 #else
+	const std::optional<std::string> cacheKey = ClxCacheKey(path, widthOrWidths);
+	if (cacheKey) {
+		if (std::optional<OwnedClxSpriteListOrSheet> cached = LoadCachedClx(*cacheKey))
+			return *std::move(cached);
+	}
 	size_t size;
-	ASSIGN_OR_RETURN(std::unique_ptr<uint8_t[]> data, LoadFileInMemWithStatus<uint8_t>(path, &size));
+	ASSIGN_OR_RETURN(std::unique_ptr<uint8_t[]> data, LoadFileInMemWithStatus<uint8_t>(path, &size, threadsafe));
 #ifdef DEBUG_CEL_TO_CL2_SIZE
 	std::cout << path;
 #endif
-	return CelToClx(data.get(), size, widthOrWidths);
+	OwnedClxSpriteListOrSheet result = CelToClx(data.get(), size, widthOrWidths);
+	if (cacheKey)
+		StoreCachedClx(*cacheKey, result);
+	return result;
 #endif
 }
 
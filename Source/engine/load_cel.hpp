@@ -16,7 +16,10 @@
 
 namespace devilution {
 
-std::expected<OwnedClxSpriteListOrSheet, std::string> LoadCelListOrSheetWithStatus(const char *pszName, PointerOrValue<uint16_t> widthOrWidths);
+/**
+ * @param threadsafe Open the file with a thread-safe handle, for loading off the main thread
+ */
+std::expected<OwnedClxSpriteListOrSheet, std::string> LoadCelListOrSheetWithStatus(const char *pszName, PointerOrValue<uint16_t> widthOrWidths, bool threadsafe = false);
 
 OwnedClxSpriteListOrSheet LoadCelListOrSheet(const char *pszName, PointerOrValue<uint16_t> widthOrWidths);
 
@@ -33,9 +36,9 @@ inline OptionalOwnedClxSpriteList LoadOptionalCel(const char *pszName, uint16_t
 	return (*std::move(result)).list();
 }
 
-inline std::expected<OwnedClxSpriteList, std::string> LoadCelWithStatus(const char *pszName, uint16_t width)
+inline std::expected<OwnedClxSpriteList, std::string> LoadCelWithStatus(const char *pszName, uint16_t width, bool threadsafe = false)
 {
-	ASSIGN_OR_RETURN(OwnedClxSpriteListOrSheet result, LoadCelListOrSheetWithStatus(pszName, PointerOrValue<uint16_t> { width }));
+	ASSIGN_OR_RETURN(OwnedClxSpriteListOrSheet result, LoadCelListOrSheetWithStatus(pszName, PointerOrValue<uint16_t> { width }, threadsafe));
 	return std::move(result).list();
 }
 
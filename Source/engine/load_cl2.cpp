@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <expected>
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
 
 #include "mpq/mpq_common.hpp"
@@ -12,6 +14,7 @@
 #ifdef UNPACKED_MPQS
 #include "engine/load_clx.hpp"
 #else
+#include "engine/clx_cache.hpp"
 #include "engine/load_file.hpp"
 #include "utils/cl2_to_clx.hpp"
 #endif
@@ -25,9 +28,17 @@ std::expected<OwnedClxSpriteListOrSheet, std::string> LoadCl2ListOrSheetWithStat
 #ifdef UNPACKED_MPQS
 	return LoadClxListOrSheetWithStatus(path);
 #else
+	const std::optional<std::string> cacheKey = ClxCacheKey(path, widthOrWidths);
+	if (cacheKey) {
+		if (std::optional<OwnedClxSpriteListOrSheet> cached = LoadCachedClx(*cacheKey))
+			return *std::move(cached);
+	}
 	size_t size;
 	ASSIGN_OR_RETURN(std::unique_ptr<uint8_t[]> data, LoadFileInMemWithStatus<uint8_t>(path, &size));
-	return Cl2ToClx(std::move(data), size, widthOrWidths);
+	OwnedClxSpriteListOrSheet result = Cl2ToClx(std::move(data), size, widthOrWidths);
+	if (cacheKey)
+		StoreCachedClx(*cacheKey, result);
+	return result;
 #endif
 }
 
@@ -96,10 +96,10 @@ void LoadFileInMem(const char *path, std::array<T, N> &data)
 }
 
 template <typename T = std::byte>
-std::expected<std::unique_ptr<T[]>, std::string> LoadFileInMemWithStatus(const char *path, std::size_t *numRead = nullptr)
+std::expected<std::unique_ptr<T[]>, std::string> LoadFileInMemWithStatus(const char *path, std::size_t *numRead = nullptr, bool threadsafe = false)
 {
 	size_t size;
-	AssetHandle handle = OpenAsset(path, size);
+	AssetHandle handle = OpenAsset(path, size, threadsafe);
 	if (!handle.ok()) {
 		return std::unexpected(FailedToOpenFileErrorMessage(path, handle.error()));
 	}
@@ -145,6 +145,13 @@ struct MultiFileLoader {
 		}
 	};
 
+	/**
+	 * @brief Use thread-safe asset handles, for loading off the main thread.
+	 *
+	 * Missing or unreadable files then make the loader return `nullptr` instead of raising an error.
+	 */
+	bool threadsafe = false;
+
 	/**
 	 * @param numFiles number of files to read
 	 * @param pathFn a function that returns the path for the given index
@@ -170,7 +177,7 @@ struct MultiFileLoader {
 			}
 			const char *path = paths.back().data();
 			files.emplace_back(FindAsset(path));
-			if (!ValidatAssetRef(path, files.back()))
+			if (threadsafe ? !files.back().ok() : !ValidatAssetRef(path, files.back()))
 				return nullptr;
 
 			const size_t size = files.back().size();
@@ -184,8 +191,10 @@ struct MultiFileLoader {
 		for (size_t i = 0, j = 0; i < numFiles; ++i) {
 			if (!filterFn(i))
 				continue;
-			AssetHandle handle = OpenAsset(std::move(files[j]));
+			AssetHandle handle = OpenAsset(std::move(files[j]), threadsafe);
 			if (!handle.ok() || !handle.read(&buf[outOffsets[j]], sizes[j])) {
+				if (threadsafe)
+					return nullptr;
 				FailedToOpenFileError(paths[j].data(), handle.error());
 			}
 			++j;
@@ -4,6 +4,8 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
 
 #ifdef DEBUG_PCX_TO_CL2_SIZE
@@ -25,6 +27,7 @@
 #include "engine/load_file.hpp"
 #else
 #include "engine/assets.hpp"
+#include "engine/clx_cache.hpp"
 #include "utils/pcx.hpp"
 #include "utils/pcx_to_clx.hpp"
 #endif
@@ -62,6 +65,18 @@ OptionalOwnedClxSpriteList LoadPcxSpriteList(const char *filename, int numFrames
 	}
 	return result;
 #else
+	// The palette is not cached, so sprites that need it are always converted.
+	std::optional<std::string> cacheKey;
+	if (outPalette == nullptr && IsClxCacheEnabled()) {
+		cacheKey = StrCat(numFramesOrFrameHeight, "|", transparentColor.has_value() ? static_cast<int>(*transparentColor) : -1, "|");
+		if (!AppendClxCacheKey(*cacheKey, path))
+			cacheKey = std::nullopt;
+	}
+	if (cacheKey) {
+		if (std::optional<OwnedClxSpriteListOrSheet> cached = LoadCachedClx(*cacheKey))
+			return std::move(*cached).list();
+	}
+
 	size_t fileSize;
 	AssetHandle handle = OpenAsset(path, fileSize);
 	if (!handle.ok()) {
@@ -75,6 +90,10 @@ OptionalOwnedClxSpriteList LoadPcxSpriteList(const char *filename, int numFrames
 	OptionalOwnedClxSpriteList result = PcxToClx(handle, fileSize, numFramesOrFrameHeight, transparentColor, outPalette);
 	if (!result)
 		return std::nullopt;
+	if (cacheKey) {
+		const ClxSpriteList list { *result };
+		StoreCachedClxData(*cacheKey, list.data(), list.dataSize(), /*numLists=*/0);
+	}
 	return result;
 #endif
 }
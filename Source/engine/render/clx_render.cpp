@@ -6,6 +6,7 @@
 #include "clx_render.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <format>
 
@@ -242,9 +243,15 @@ using OutlineRowSolidRuns = StaticVector<std::pair<uint8_t, uint8_t>, (MaxOutlin
 struct OutlinePixelsCacheEntry {
 	OutlinePixels outlinePixels;
 	const void *spriteData = nullptr;
+	uint32_t generation = 0;
 	bool skipColorIndexZero;
 };
-OutlinePixelsCacheEntry OutlinePixelsCache;
+
+/** @brief Bumped by ClearClxDrawCache, so that every thread's cache is dropped once the sprites it points into are freed. */
+std::atomic<uint32_t> OutlinePixelsCacheGeneration;
+
+/** @brief One per thread, as the world view may be drawn on a render thread while the UI draws its own outlines. */
+thread_local OutlinePixelsCacheEntry OutlinePixelsCache;
 
 void PopulateOutlinePixelsForRow(
     const OutlineRowSolidRuns &runs,
@@ -392,12 +399,15 @@ void GetOutline(ClxSprite sprite, OutlinePixels &result) // NOLINT(readability-f
 template <bool SkipColorIndexZero>
 void UpdateOutlinePixelsCache(ClxSprite sprite)
 {
+	const uint32_t generation = OutlinePixelsCacheGeneration.load(std::memory_order_relaxed);
 	if (OutlinePixelsCache.spriteData == sprite.pixelData()
+	    && OutlinePixelsCache.generation == generation
 	    && OutlinePixelsCache.skipColorIndexZero == SkipColorIndexZero) {
 		return;
 	}
 	OutlinePixelsCache.skipColorIndexZero = SkipColorIndexZero;
 	OutlinePixelsCache.spriteData = sprite.pixelData();
+	OutlinePixelsCache.generation = generation;
 	OutlinePixelsCache.outlinePixels.clear();
 	GetOutline<SkipColorIndexZero>(sprite, OutlinePixelsCache.outlinePixels);
 }
@@ -627,6 +637,7 @@ void ClxDrawOutlineSkipColorZero(const Surface &out, uint8_t col, Point position
 void ClearClxDrawCache()
 {
 	OutlinePixelsCache.spriteData = nullptr;
+	OutlinePixelsCacheGeneration.fetch_add(1, std::memory_order_relaxed);
 }
 
 } // namespace devilution
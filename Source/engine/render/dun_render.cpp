@@ -12,12 +12,14 @@
 
 #include "engine/render/dun_render.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 
 #include "appfat.h"
 #include "engine/point.hpp"
 #include "engine/render/blit_impl.hpp"
+#include "engine/render/light_table_simd.hpp"
 #include "engine/render/overlapped_memset.hpp"
 #include "levels/dun_tile.hpp"
 #include "options.h"
@@ -116,6 +118,18 @@ enum class LightType : uint8_t {
 	PerPixel,
 };
 
+/**
+ * @brief Applies a light table to a span, using the SIMD kernel for spans long enough to benefit from it.
+ */
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsWithLightTable(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, uint_fast8_t n, const uint8_t *DVL_RESTRICT tbl)
+{
+	if (ApplyLightTable != nullptr && n >= LightTableSimdMinLength) {
+		ApplyLightTable(dst, src, n, tbl);
+	} else {
+		BlitPixelsWithMap(dst, src, n, tbl);
+	}
+}
+
 template <LightType Light>
 DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderLineOpaque(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, uint_fast8_t n, const uint8_t *DVL_RESTRICT tbl, const Lightmap *lightmap);
 
@@ -139,7 +153,7 @@ template <>
 DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderLineOpaque<LightType::PartiallyLit>(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, uint_fast8_t n, const uint8_t *DVL_RESTRICT tbl, [[maybe_unused]] const Lightmap *lightmap)
 {
 #ifndef DEBUG_RENDER_COLOR
-	BlitPixelsWithMap(dst, src, n, tbl);
+	BlitPixelsWithLightTable(dst, src, n, tbl);
 #else
 	BlitFillDirect(dst, n, tbl[DBGCOLOR]);
 #endif
@@ -174,7 +188,18 @@ DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderLineTransparent<LightType::FullyL
 template <>
 DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderLineTransparent<LightType::PartiallyLit>(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, uint_fast8_t n, const uint8_t *DVL_RESTRICT tbl, [[maybe_unused]] const Lightmap *lightmap)
 {
-	BlitPixelsBlendedWithMap(dst, src, n, tbl);
+	if (ApplyLightTable == nullptr || n < LightTableSimdMinLength) {
+		BlitPixelsBlendedWithMap(dst, src, n, tbl);
+		return;
+	}
+	// The blend itself is a lookup into a 64 KiB table, which has no gather-free SIMD form.
+	// Light the source span with the SIMD kernel first, then blend.
+	DVL_ASSUME(n <= Width);
+	uint8_t litSrc[Width];
+	ApplyLightTable(litSrc, src, n, tbl);
+	for (uint_fast8_t i = 0; i < n; ++i) {
+		dst[i] = paletteTransparencyLookup[dst[i]][litSrc[i]];
+	}
 }
 
 template <>
@@ -1001,8 +1026,77 @@ DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderTileDispatch(TileType tile, uint8
 	}
 }
 
+template <LightType Light, MaskType Mask>
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderSpan(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, uint_fast8_t n, const DunFrameSpan &span, const uint8_t *DVL_RESTRICT tbl, const Lightmap &lightmap)
+{
+	if (Mask == MaskType::Transparent
+	    || (Mask == MaskType::Left && span.blendedWithLeftMask)
+	    || (Mask == MaskType::Right && span.blendedWithRightMask)) {
+		if (n == Width) {
+			RenderLineTransparentOrOpaqueN<Light, /*Transparent=*/true, Width>(dst, src, tbl, &lightmap);
+		} else {
+			RenderLineTransparent<Light>(dst, src, n, tbl, &lightmap);
+		}
+	} else if (n == Width) {
+		RenderLineTransparentOrOpaqueN<Light, /*Transparent=*/false, Width>(dst, src, tbl, &lightmap);
+	} else {
+		RenderLineOpaque<Light>(dst, src, n, tbl, &lightmap);
+	}
+}
+
+template <LightType Light, MaskType Mask>
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderSpansFull(uint8_t *DVL_RESTRICT dst, uint16_t dstPitch, DunFrameSpans spans, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT tbl, const Lightmap &lightmap)
+{
+	for (int_fast16_t y = 0, height = spans.height(); y < height; ++y, dst -= dstPitch) {
+		for (const DunFrameSpan &span : spans.row(y)) {
+			RenderSpan<Light, Mask>(dst + span.x, src + span.srcOffset, span.width, span, tbl, lightmap);
+		}
+	}
+}
+
+template <LightType Light, MaskType Mask>
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderSpansClipped(uint8_t *DVL_RESTRICT dst, uint16_t dstPitch, DunFrameSpans spans, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT tbl, const Lightmap &lightmap, Clip clip)
+{
+	const int_fast16_t clipEnd = Width - clip.right;
+	for (int_fast16_t y = clip.bottom, yEnd = clip.bottom + clip.height; y < yEnd; ++y, dst -= dstPitch) {
+		for (const DunFrameSpan &span : spans.row(y)) {
+			const int_fast16_t begin = std::max<int_fast16_t>(span.x, clip.left);
+			const int_fast16_t end = std::min<int_fast16_t>(span.x + span.width, clipEnd);
+			if (begin >= end) continue;
+			RenderSpan<Light, Mask>(dst + (begin - clip.left), src + span.srcOffset + (begin - span.x),
+			    static_cast<uint_fast8_t>(end - begin), span, tbl, lightmap);
+		}
+	}
+}
+
+template <LightType Light, MaskType Mask>
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderSpans(uint8_t *DVL_RESTRICT dst, uint16_t dstPitch, DunFrameSpans spans, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT tbl, const Lightmap &lightmap, Clip clip)
+{
+	if (clip.width == Width && clip.height == spans.height()) {
+		RenderSpansFull<Light, Mask>(dst, dstPitch, spans, src, tbl, lightmap);
+	} else {
+		RenderSpansClipped<Light, Mask>(dst, dstPitch, spans, src, tbl, lightmap, clip);
+	}
+}
+
+template <MaskType Mask>
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderSpansDispatch(uint8_t *DVL_RESTRICT dst, uint16_t dstPitch, DunFrameSpans spans, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT tbl, const Lightmap &lightmap, Clip clip)
+{
+	if (*GetOptions().Graphics.perPixelLighting) {
+		RenderSpans<LightType::PerPixel, Mask>(dst, dstPitch, spans, src, tbl, lightmap, clip);
+	} else if (lightmap.isFullyDarkLightTable(tbl)) {
+		RenderSpans<LightType::FullyDark, Mask>(dst, dstPitch, spans, src, tbl, lightmap, clip);
+	} else if (lightmap.isFullyLitLightTable(tbl)) {
+		RenderSpans<LightType::FullyLit, Mask>(dst, dstPitch, spans, src, tbl, lightmap, clip);
+	} else {
+		RenderSpans<LightType::PartiallyLit, Mask>(dst, dstPitch, spans, src, tbl, lightmap, clip);
+	}
+}
+
 } // namespace
 
+bool UseDunFrameSpans = true;
+
 #ifdef DUN_RENDER_STATS
 ankerl::unordered_dense::map<DunRenderType, size_t, DunRenderTypeHash> DunRenderStats;
 
@@ -1077,6 +1171,38 @@ DVL_ATTRIBUTE_HOT void RenderTileFrame(const Surface &out, const Lightmap &light
 #endif
 }
 
+DVL_ATTRIBUTE_HOT bool RenderTileFrameSpans(const Surface &out, const Lightmap &lightmap, const Point &position, DunFrameSpans spans, const uint8_t *src,
+    MaskType maskType, const uint8_t *tbl)
+{
+	const Clip clip = CalculateClip(position.x, position.y, DunFrameWidth, spans.height(), out);
+	if (clip.width <= 0 || clip.height <= 0) return true;
+	// The decoding path moves the edge of the Left and Right masks with the clipped rows and columns,
+	// which the spans can't reproduce.
+	if ((maskType == MaskType::Left || maskType == MaskType::Right)
+	    && (clip.width != DunFrameWidth || clip.height != spans.height())) {
+		return false;
+	}
+
+	uint8_t *dst = out.at(static_cast<int>(position.x + clip.left), static_cast<int>(position.y - clip.bottom));
+	const uint16_t dstPitch = out.pitch();
+
+	switch (maskType) {
+	case MaskType::Solid:
+		RenderSpansDispatch<MaskType::Solid>(dst, dstPitch, spans, src, tbl, lightmap, clip);
+		break;
+	case MaskType::Transparent:
+		RenderSpansDispatch<MaskType::Transparent>(dst, dstPitch, spans, src, tbl, lightmap, clip);
+		break;
+	case MaskType::Left:
+		RenderSpansDispatch<MaskType::Left>(dst, dstPitch, spans, src, tbl, lightmap, clip);
+		break;
+	case MaskType::Right:
+		RenderSpansDispatch<MaskType::Right>(dst, dstPitch, spans, src, tbl, lightmap, clip);
+		break;
+	}
+	return true;
+}
+
 void world_draw_black_tile(const Surface &out, int sx, int sy)
 {
 #ifdef DEBUG_RENDER_OFFSET_X
@@ -111,12 +111,29 @@ std::string_view TileTypeToString(TileType tileType);
 std::string_view MaskTypeToString(MaskType maskType);
 #endif
 
+/**
+ * @brief Whether tiles are drawn from the spans built by `ReencodeDungeonCels`
+ * instead of decoding the frame on every draw.
+ *
+ * The decoding path is kept for comparison, and is always used with `DUN_RENDER_STATS`.
+ */
+extern DVL_API_FOR_TEST bool UseDunFrameSpans;
+
 /**
  * @brief Low-level tile rendering function.
  */
 void RenderTileFrame(const Surface &out, const Lightmap &lightmap, const Point &position, TileType tile, const uint8_t *src, int_fast16_t height,
     MaskType maskType, const uint8_t *tbl);
 
+/**
+ * @brief Low-level tile rendering function for pre-decoded spans.
+ * @param src The re-encoded frame data that the spans point into.
+ * @return false without drawing anything if the tile is masked with `MaskType::Left` or `MaskType::Right`
+ * and clipped, which only `RenderTileFrame` draws the same as before.
+ */
+bool RenderTileFrameSpans(const Surface &out, const Lightmap &lightmap, const Point &position, DunFrameSpans spans, const uint8_t *src,
+    MaskType maskType, const uint8_t *tbl);
+
 /**
  * @brief Returns the raw data for the given dungeon frame.
  */
@@ -134,19 +151,52 @@ DVL_ALWAYS_INLINE const uint8_t *GetDunFrameFoliage(const std::byte *dungeonCelD
 	return GetDunFrame(dungeonCelData, frame) + ReencodedTriangleFrameSize;
 }
 
+/**
+ * @brief Returns the pre-decoded spans for the given dungeon frame.
+ */
+DVL_ALWAYS_INLINE DunFrameSpans GetDunFrameSpans(const std::byte *dungeonCelSpans, uint32_t frame)
+{
+	const auto *frameTable = reinterpret_cast<const uint32_t *>(dungeonCelSpans);
+	return DunFrameSpans { &dungeonCelSpans[frameTable[2 * frame]] };
+}
+
+/**
+ * @brief Returns the pre-decoded spans for the given dungeon frame's foliage.
+ */
+DVL_ALWAYS_INLINE DunFrameSpans GetDunFrameFoliageSpans(const std::byte *dungeonCelSpans, uint32_t frame)
+{
+	const auto *frameTable = reinterpret_cast<const uint32_t *>(dungeonCelSpans);
+	return DunFrameSpans { &dungeonCelSpans[frameTable[(2 * frame) + 1]] };
+}
+
+DVL_ALWAYS_INLINE bool ShouldRenderDunFrameSpans([[maybe_unused]] const std::byte *dungeonCelSpans)
+{
+#ifdef DUN_RENDER_STATS
+	return false;
+#else
+	return UseDunFrameSpans && dungeonCelSpans != nullptr;
+#endif
+}
+
 /**
  * @brief Blit current world CEL to the given buffer
  * @param out Target buffer
  * @param lightmap Per-pixel light buffer
  * @param position Target buffer coordinates
  * @param dungeonCelData Dungeon CEL data.
+ * @param dungeonCelSpans Pre-decoded spans of the dungeon CEL data, may be null.
  * @param levelCelBlock The MIN block of the level CEL file.
  * @param maskType The mask to use,
  * @param tbl LightTable or TRN for a tile.
  */
 DVL_ALWAYS_INLINE void RenderTile(const Surface &out, const Lightmap &lightmap, const Point &position,
-    const std::byte *dungeonCelData, LevelCelBlock levelCelBlock, MaskType maskType, const uint8_t *tbl)
+    const std::byte *dungeonCelData, const std::byte *dungeonCelSpans, LevelCelBlock levelCelBlock, MaskType maskType, const uint8_t *tbl)
 {
+	if (ShouldRenderDunFrameSpans(dungeonCelSpans)
+	    && RenderTileFrameSpans(out, lightmap, position, GetDunFrameSpans(dungeonCelSpans, levelCelBlock.frame()),
+	        GetDunFrame(dungeonCelData, levelCelBlock.frame()), maskType, tbl)) {
+		return;
+	}
 	const TileType tileType = levelCelBlock.type();
 	RenderTileFrame(out, lightmap, position, tileType,
 	    GetDunFrame(dungeonCelData, levelCelBlock.frame()),
@@ -160,12 +210,32 @@ DVL_ALWAYS_INLINE void RenderTile(const Surface &out, const Lightmap &lightmap,
  * @brief Renders a floor foliage tile.
  */
 DVL_ALWAYS_INLINE void RenderTileFoliage(const Surface &out, const Lightmap &lightmap, const Point &position,
-    const std::byte *dungeonCelData, LevelCelBlock levelCelBlock, const uint8_t *tbl)
+    const std::byte *dungeonCelData, const std::byte *dungeonCelSpans, LevelCelBlock levelCelBlock, const uint8_t *tbl)
 {
+	if (ShouldRenderDunFrameSpans(dungeonCelSpans)) {
+		RenderTileFrameSpans(out, lightmap, Point { position.x, position.y - 16 }, GetDunFrameFoliageSpans(dungeonCelSpans, levelCelBlock.frame()),
+		    GetDunFrame(dungeonCelData, levelCelBlock.frame()), MaskType::Solid, tbl);
+		return;
+	}
 	RenderTileFrame(out, lightmap, Point { position.x, position.y - 16 }, TileType::TransparentSquare,
 	    GetDunFrameFoliage(dungeonCelData, levelCelBlock.frame()), /*height=*/16, MaskType::Solid, tbl);
 }
 
+/**
+ * @brief Renders the floor triangle of a floor tile, without any foliage it may have.
+ */
+DVL_ALWAYS_INLINE void RenderTileFloor(const Surface &out, const Lightmap &lightmap, const Point &position,
+    const std::byte *dungeonCelData, const std::byte *dungeonCelSpans, LevelCelBlock levelCelBlock, TileType triangleType, const uint8_t *tbl)
+{
+	if (ShouldRenderDunFrameSpans(dungeonCelSpans)) {
+		RenderTileFrameSpans(out, lightmap, position, GetDunFrameSpans(dungeonCelSpans, levelCelBlock.frame()),
+		    GetDunFrame(dungeonCelData, levelCelBlock.frame()), MaskType::Solid, tbl);
+		return;
+	}
+	RenderTileFrame(out, lightmap, position, triangleType,
+	    GetDunFrame(dungeonCelData, levelCelBlock.frame()), DunFrameTriangleHeight, MaskType::Solid, tbl);
+}
+
 /**
  * @brief Render a black 64x31 tile ◆
  * @param out Target buffer
@@ -1,18 +1,31 @@
 #include "engine/render/light_render.hpp"
 
 #include <algorithm>
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <span>
 #include <vector>
 
 #include "engine/displacement.hpp"
 #include "engine/lighting_defs.hpp"
 #include "engine/point.hpp"
+#include "engine/rectangle.hpp"
 #include "engine/render/overlapped_memset.hpp"
+#include "engine/size.hpp"
 #include "levels/dun_tile.hpp"
 #include "levels/gendung_defs.hpp"
 #include "utils/attributes.h"
+#include "utils/bitset2d.hpp"
+#include "utils/cpu_features.hpp"
+
+#if DVL_SIMD_X86
+#include <emmintrin.h>
+#elif DVL_SIMD_AARCH64
+#include <arm_neon.h>
+#endif
 
 namespace devilution {
 
@@ -20,6 +33,31 @@ namespace {
 
 std::vector<uint8_t> LightmapBuffer;
 
+/** @brief Scratch space for rendering part of the lightmap. */
+std::vector<uint8_t> LightmapRegionBuffer;
+
+/**
+ * @brief Position of the lightmap's top-left pixel relative to the top corner of the dungeon.
+ *
+ * Used to scroll the previous lightmap into place instead of building it from scratch.
+ */
+Point LightmapOrigin;
+uint16_t LightmapWidth;
+uint16_t LightmapHeight;
+/** @brief Rows and columns of tiles the lightmap was built for, which change while the view scrolls by part of a tile. */
+int LightmapRows;
+int LightmapColumns;
+/** @brief Whether the lightmap buffer is up to date apart from the tiles marked as dirty since. */
+bool LightmapValid;
+
+/**
+ * @brief Returns the position of a tile's base in screen space, relative to the top corner of the dungeon.
+ */
+Point GetDungeonPixelPosition(Point tilePosition)
+{
+	return { (tilePosition.x - tilePosition.y) * TILE_WIDTH / 2, (tilePosition.x + tilePosition.y) * TILE_HEIGHT / 2 };
+}
+
 void RenderFullTile(Point position, uint8_t lightLevel, uint8_t *lightmap, uint16_t pitch)
 {
 	uint8_t *top = lightmap + ((position.y + 1) * pitch) + position.x - (TILE_WIDTH / 2);
@@ -39,6 +77,183 @@ int DecrementTowardZero(int num)
 	return num - ((num >> 31) | 1);
 }
 
+/**
+ * @brief An edge function of a triangle, evaluated along the left side of its bounding rectangle.
+ *
+ * A pixel is on the inner side of the edge while the function is positive.
+ */
+struct TriangleEdge {
+	/** Value at the top-left pixel of the bounding rectangle. */
+	int cy;
+	/** Change from one row to the next. */
+	int fdx;
+	/** Change from one column to the next, with the opposite sign. */
+	int fdy;
+};
+
+/** @brief A triangle rendered into the lightmap never spans more rows than a cell. */
+constexpr int MaxTriangleRows = TILE_HEIGHT;
+
+/**
+ * @brief Computes the covered columns `[startX, endX)` of each row of a triangle's bounding rectangle
+ *
+ * The output arrays need room for `rowCount` rounded up to a multiple of 4.
+ */
+using TriangleSpansFn = void (*)(const TriangleEdge edges[3], int xlen, int rowCount, int *startX, int *endX);
+
+void ComputeTriangleSpansScalar(const TriangleEdge edges[3], int xlen, int rowCount, int *startX, int *endX)
+{
+	for (int y = 0; y < rowCount; y++) {
+		int start = 0;
+		int end = xlen;
+		for (int i = 0; i < 3; i++) {
+			const TriangleEdge &edge = edges[i];
+			const int cx = edge.cy + (y * edge.fdx);
+			const int cxe = cx - (edge.fdy * xlen);
+			// Only needed when the edge crosses the row, which means fdy is not 0
+			const auto crossing = [&]() { return (cx + DecrementTowardZero(edge.fdy)) / edge.fdy; };
+
+			if (cx <= 0)
+				start = std::max(start, cxe <= 0 ? xlen : crossing());
+			if (cxe <= 0)
+				end = std::min(end, cx <= 0 ? 0 : crossing());
+		}
+		startX[y] = start;
+		endX[y] = end;
+	}
+}
+
+// The SIMD versions compute 4 rows at a time. There is no integer division,
+// but dividing in double precision and truncating is exact for 32-bit integers.
+
+#if DVL_SIMD_X86
+DVL_TARGET("sse2") DVL_ALWAYS_INLINE __m128i MaxEpi32(__m128i a, __m128i b)
+{
+	const __m128i greater = _mm_cmpgt_epi32(a, b);
+	return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, b));
+}
+
+DVL_TARGET("sse2") DVL_ALWAYS_INLINE __m128i MinEpi32(__m128i a, __m128i b)
+{
+	const __m128i greater = _mm_cmpgt_epi32(a, b);
+	return _mm_or_si128(_mm_and_si128(greater, b), _mm_andnot_si128(greater, a));
+}
+
+DVL_TARGET("sse2") DVL_ALWAYS_INLINE __m128i Select(__m128i mask, __m128i a, __m128i b)
+{
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+DVL_TARGET("sse2") void ComputeTriangleSpansSse2(const TriangleEdge edges[3], int xlen, int rowCount, int *startX, int *endX)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i xlenV = _mm_set1_epi32(xlen);
+	__m128i cx[3];
+	__m128i cxStep[3];
+	__m128i edgeOffset[3];
+	__m128i rounding[3];
+	__m128d divisor[3];
+	for (int i = 0; i < 3; i++) {
+		const TriangleEdge &edge = edges[i];
+		cx[i] = _mm_setr_epi32(edge.cy, edge.cy + edge.fdx, edge.cy + (2 * edge.fdx), edge.cy + (3 * edge.fdx));
+		cxStep[i] = _mm_set1_epi32(4 * edge.fdx);
+		edgeOffset[i] = _mm_set1_epi32(edge.fdy * xlen);
+		rounding[i] = _mm_set1_epi32(DecrementTowardZero(edge.fdy));
+		divisor[i] = _mm_set1_pd(edge.fdy);
+	}
+
+	for (int y = 0; y < rowCount; y += 4) {
+		__m128i start = zero;
+		__m128i end = xlenV;
+		for (int i = 0; i < 3; i++) {
+			const __m128i cxe = _mm_sub_epi32(cx[i], edgeOffset[i]);
+			const __m128i numerator = _mm_add_epi32(cx[i], rounding[i]);
+			const __m128i low = _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(numerator), divisor[i]));
+			const __m128i high = _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(numerator, _MM_SHUFFLE(1, 0, 3, 2))), divisor[i]));
+			const __m128i crossing = _mm_unpacklo_epi64(low, high);
+
+			const __m128i cxPositive = _mm_cmpgt_epi32(cx[i], zero);
+			const __m128i cxePositive = _mm_cmpgt_epi32(cxe, zero);
+			start = MaxEpi32(start, _mm_andnot_si128(cxPositive, Select(cxePositive, crossing, xlenV)));
+			end = MinEpi32(end, Select(cxePositive, xlenV, _mm_and_si128(cxPositive, crossing)));
+
+			cx[i] = _mm_add_epi32(cx[i], cxStep[i]);
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(startX + y), start);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(endX + y), end);
+	}
+}
+#endif // DVL_SIMD_X86
+
+#if DVL_SIMD_AARCH64
+DVL_ALWAYS_INLINE int32x2_t DivideTruncated(int32x2_t numerator, float64x2_t divisor)
+{
+	return vmovn_s64(vcvtq_s64_f64(vdivq_f64(vcvtq_f64_s64(vmovl_s32(numerator)), divisor)));
+}
+
+void ComputeTriangleSpansNeon(const TriangleEdge edges[3], int xlen, int rowCount, int *startX, int *endX)
+{
+	const int32x4_t zero = vdupq_n_s32(0);
+	const int32x4_t xlenV = vdupq_n_s32(xlen);
+	int32x4_t cx[3];
+	int32x4_t cxStep[3];
+	int32x4_t edgeOffset[3];
+	int32x4_t rounding[3];
+	float64x2_t divisor[3];
+	for (int i = 0; i < 3; i++) {
+		const TriangleEdge &edge = edges[i];
+		const int32_t rows[4] = { edge.cy, edge.cy + edge.fdx, edge.cy + (2 * edge.fdx), edge.cy + (3 * edge.fdx) };
+		cx[i] = vld1q_s32(rows);
+		cxStep[i] = vdupq_n_s32(4 * edge.fdx);
+		edgeOffset[i] = vdupq_n_s32(edge.fdy * xlen);
+		rounding[i] = vdupq_n_s32(DecrementTowardZero(edge.fdy));
+		divisor[i] = vdupq_n_f64(edge.fdy);
+	}
+
+	for (int y = 0; y < rowCount; y += 4) {
+		int32x4_t start = zero;
+		int32x4_t end = xlenV;
+		for (int i = 0; i < 3; i++) {
+			const int32x4_t cxe = vsubq_s32(cx[i], edgeOffset[i]);
+			const int32x4_t numerator = vaddq_s32(cx[i], rounding[i]);
+			const int32x4_t crossing = vcombine_s32(
+			    DivideTruncated(vget_low_s32(numerator), divisor[i]),
+			    DivideTruncated(vget_high_s32(numerator), divisor[i]));
+
+			const uint32x4_t cxPositive = vcgtq_s32(cx[i], zero);
+			const uint32x4_t cxePositive = vcgtq_s32(cxe, zero);
+			start = vmaxq_s32(start, vbslq_s32(cxPositive, zero, vbslq_s32(cxePositive, crossing, xlenV)));
+			end = vminq_s32(end, vbslq_s32(cxePositive, xlenV, vbslq_s32(cxPositive, crossing, zero)));
+
+			cx[i] = vaddq_s32(cx[i], cxStep[i]);
+		}
+		vst1q_s32(startX + y, start);
+		vst1q_s32(endX + y, end);
+	}
+}
+#endif // DVL_SIMD_AARCH64
+
+TriangleSpansFn GetTriangleSpansFn(LightmapIsa isa)
+{
+	[[maybe_unused]] const CpuFeatures &cpu = GetCpuFeatures();
+	switch (isa) {
+	case LightmapIsa::Scalar:
+		return ComputeTriangleSpansScalar;
+#if DVL_SIMD_X86
+	case LightmapIsa::Sse2:
+		return cpu.sse2 ? ComputeTriangleSpansSse2 : nullptr;
+#endif
+#if DVL_SIMD_AARCH64
+	case LightmapIsa::Neon:
+		return cpu.neon ? ComputeTriangleSpansNeon : nullptr;
+#endif
+	default:
+		return nullptr;
+	}
+}
+
+TriangleSpansFn ComputeTriangleSpans = GetTriangleSpansFn(GetBestLightmapIsa());
+
 // Half-space method for drawing triangles
 // Points must be provided using counter-clockwise rotation
 // https://web.archive.org/web/20050408192410/http://sw-shader.sourceforge.net/rasterizer.html
@@ -87,46 +302,21 @@ void RenderTriangle(Point p1, Point p2, Point p3, uint8_t lightLevel, uint8_t *l
 		return (dx * (miny << 4)) - (dy * (minx << 4));
 	};
 
-	int cy1 = c1 + CalcCy(minx, miny, dx12, dy12);
-	int cy2 = c2 + CalcCy(minx, miny, dx23, dy23);
-	int cy3 = c3 + CalcCy(minx, miny, dx31, dy31);
-
-	for (int y = miny; y < maxy; y++) {
-		const int cxe1 = cy1 - (fdy12 * xlen);
-		const int cxe2 = cy2 - (fdy23 * xlen);
-		const int cxe3 = cy3 - (fdy31 * xlen);
-
-		constexpr auto CalcStartX = [](int xlen, int cx, int cxe, int fdy) -> int {
-			if (cx > 0) return 0;
-			if (cxe <= 0) return xlen;
-			return (cx + DecrementTowardZero(fdy)) / fdy;
-		};
-
-		const int startx = minx + std::max({
-		                       CalcStartX(xlen, cy1, cxe1, fdy12),
-		                       CalcStartX(xlen, cy2, cxe2, fdy23),
-		                       CalcStartX(xlen, cy3, cxe3, fdy31),
-		                   });
-
-		constexpr auto CalcEndX = [](int xlen, int cx, int cxe, int fdy) -> int {
-			if (cxe > 0) return xlen;
-			if (cx <= 0) return 0;
-			return (cx + DecrementTowardZero(fdy)) / fdy;
-		};
-
-		const int endx = minx + std::min({
-		                     CalcEndX(xlen, cy1, cxe1, fdy12),
-		                     CalcEndX(xlen, cy2, cxe2, fdy23),
-		                     CalcEndX(xlen, cy3, cxe3, fdy31),
-		                 });
-
-		if (startx < endx)
-			FillBytesUpTo64(&dst[startx], endx - startx, lightLevel);
-
-		cy1 += fdx12;
-		cy2 += fdx23;
-		cy3 += fdx31;
+	const TriangleEdge edges[3] = {
+		{ c1 + CalcCy(minx, miny, dx12, dy12), fdx12, fdy12 },
+		{ c2 + CalcCy(minx, miny, dx23, dy23), fdx23, fdy23 },
+		{ c3 + CalcCy(minx, miny, dx31, dy31), fdx31, fdy31 },
+	};
 
+	const int rowCount = maxy - miny;
+	assert(rowCount <= MaxTriangleRows);
+	int startX[MaxTriangleRows + 3];
+	int endX[MaxTriangleRows + 3];
+	ComputeTriangleSpans(edges, xlen, rowCount, startX, endX);
+
+	for (int y = 0; y < rowCount; y++) {
+		if (startX[y] < endX[y])
+			FillBytesUpTo64(&dst[minx + startX[y]], endX[y] - startX[y], lightLevel);
 		dst += pitch;
 	}
 }
@@ -428,26 +618,19 @@ void RenderCell(uint8_t quad[4], Point position, uint8_t lightLevel, uint8_t *li
 	}
 }
 
-void BuildLightmap(Point tilePosition, Point targetBufferPosition, uint16_t viewportWidth, uint16_t viewportHeight,
-    int rows, int columns, const uint8_t tileLights[MAXDUNX][MAXDUNY], uint_fast8_t microTileLen)
+/**
+ * @brief Renders the cells that overlap the given region of the lightmap
+ * @param region Area of the lightmap to render, cells are clipped to it
+ * @param lightmap Output for the region, with a pitch of the region's width
+ */
+void RenderCells(Point tilePosition, Point targetBufferPosition, int rows, int columns,
+    const uint8_t tileLights[MAXDUNX][MAXDUNY], Rectangle region, uint8_t *lightmap)
 {
-	// Since light may need to bleed up to the top of wall tiles,
-	// expand the buffer space to include the full base diamond of the tallest tile graphics
-	const uint16_t bufferHeight = viewportHeight + (TILE_HEIGHT * (microTileLen / 2 + 1));
-	rows += microTileLen + 2;
+	const auto pitch = static_cast<uint16_t>(region.size.width);
+	const auto scanLines = static_cast<uint16_t>(region.size.height);
+	memset(lightmap, LightsMax, static_cast<size_t>(pitch) * scanLines);
+	targetBufferPosition -= Displacement { region.position.x, region.position.y };
 
-	const size_t totalPixels = static_cast<size_t>(viewportWidth) * bufferHeight;
-	LightmapBuffer.resize(totalPixels);
-
-	// Since rendering occurs in cells between quads,
-	// expand the rendering space to include tiles outside the viewport
-	tilePosition += Displacement(Direction::NorthWest) * 2;
-	targetBufferPosition -= Displacement { TILE_WIDTH, TILE_HEIGHT };
-	rows += 3;
-	columns++;
-
-	uint8_t *lightmap = LightmapBuffer.data();
-	memset(lightmap, LightsMax, totalPixels);
 	for (int i = 0; i < rows; i++) {
 		// Seed q3 for the first cell; subsequent cells reuse the previous q1 as q3.
 		// (Moving East by {+1,-1} shifts the quad: only the old NE corner (q1) is shared as the new SW corner (q3).)
@@ -455,8 +638,16 @@ void BuildLightmap(Point tilePosition, Point targetBufferPosition, uint16_t view
 		for (int j = 0; j < columns; j++, tilePosition += Direction::East, targetBufferPosition.x += TILE_WIDTH) {
 			const Point center0 = targetBufferPosition + Displacement { TILE_WIDTH / 2, -TILE_HEIGHT / 2 };
 
-			const uint8_t q0 = GetLightLevel(tileLights, tilePosition);
 			const uint8_t q1 = GetLightLevel(tileLights, tilePosition + Displacement { 1, 0 });
+
+			// Skip cells outside of the region, the cell only covers the diamond below center0
+			if (center0.x + TILE_WIDTH / 2 <= 0 || center0.x - TILE_WIDTH / 2 >= pitch
+			    || center0.y + TILE_HEIGHT <= 0 || center0.y >= scanLines) {
+				q3 = q1;
+				continue;
+			}
+
+			const uint8_t q0 = GetLightLevel(tileLights, tilePosition);
 			const uint8_t q2 = GetLightLevel(tileLights, tilePosition + Displacement { 1, 1 });
 			uint8_t quad[] = { q0, q1, q2, q3 };
 
@@ -468,7 +659,7 @@ void BuildLightmap(Point tilePosition, Point targetBufferPosition, uint16_t view
 			if (minLight < static_cast<uint8_t>(LightsMax)) {
 				const uint8_t startLevel = std::min(maxLight, static_cast<uint8_t>(LightsMax - 1));
 				for (uint8_t lightLevel = startLevel;; --lightLevel) {
-					RenderCell(quad, center0, lightLevel, lightmap, viewportWidth, bufferHeight);
+					RenderCell(quad, center0, lightLevel, lightmap, pitch, scanLines);
 					if (lightLevel == minLight) break;
 				}
 			}
@@ -494,8 +685,182 @@ void BuildLightmap(Point tilePosition, Point targetBufferPosition, uint16_t view
 	}
 }
 
+/**
+ * @brief Renders a region of the lightmap in place, leaving the rest of it untouched
+ */
+void RenderRegion(Point tilePosition, Point targetBufferPosition, int rows, int columns,
+    const uint8_t tileLights[MAXDUNX][MAXDUNY], Rectangle region, uint16_t pitch)
+{
+	const size_t width = region.size.width;
+	LightmapRegionBuffer.resize(width * region.size.height);
+	RenderCells(tilePosition, targetBufferPosition, rows, columns, tileLights, region, LightmapRegionBuffer.data());
+
+	const uint8_t *src = LightmapRegionBuffer.data();
+	uint8_t *dst = &LightmapBuffer[(static_cast<size_t>(region.position.y) * pitch) + region.position.x];
+	for (int y = 0; y < region.size.height; y++, src += width, dst += pitch)
+		memcpy(dst, src, width);
+}
+
+bool IsTileDirty(const Bitset2d<MAXDUNX, MAXDUNY> &dirtyTiles, Point tile)
+{
+	const int x = std::clamp(tile.x, 0, MAXDUNX - 1);
+	const int y = std::clamp(tile.y, 0, MAXDUNY - 1);
+	return dirtyTiles.test(x, y);
+}
+
+/**
+ * @brief Returns the bounding box of all cells that use the light of a dirty tile
+ * @return An empty rectangle if no visible cell is affected
+ */
+Rectangle FindDirtyRegion(Point tilePosition, Point targetBufferPosition, int rows, int columns,
+    const Bitset2d<MAXDUNX, MAXDUNY> &dirtyTiles, uint16_t width, uint16_t height)
+{
+	int minX = width;
+	int minY = height;
+	int maxX = 0;
+	int maxY = 0;
+	for (int i = 0; i < rows; i++) {
+		for (int j = 0; j < columns; j++, tilePosition += Direction::East, targetBufferPosition.x += TILE_WIDTH) {
+			if (!IsTileDirty(dirtyTiles, tilePosition) && !IsTileDirty(dirtyTiles, tilePosition + Displacement { 1, 0 })
+			    && !IsTileDirty(dirtyTiles, tilePosition + Displacement { 1, 1 }) && !IsTileDirty(dirtyTiles, tilePosition + Displacement { 0, 1 }))
+				continue;
+			const Point center0 = targetBufferPosition + Displacement { TILE_WIDTH / 2, -TILE_HEIGHT / 2 };
+			minX = std::min(minX, center0.x - TILE_WIDTH / 2);
+			maxX = std::max(maxX, center0.x + TILE_WIDTH / 2);
+			minY = std::min(minY, center0.y);
+			maxY = std::max(maxY, center0.y + TILE_HEIGHT);
+		}
+
+		tilePosition += Displacement(Direction::West) * columns;
+		targetBufferPosition.x -= columns * TILE_WIDTH;
+
+		targetBufferPosition.y += TILE_HEIGHT / 2;
+		if ((i & 1) != 0) {
+			tilePosition.x++;
+			columns--;
+			targetBufferPosition.x += TILE_WIDTH / 2;
+		} else {
+			tilePosition.y++;
+			columns++;
+			targetBufferPosition.x -= TILE_WIDTH / 2;
+		}
+	}
+
+	minX = std::max(minX, 0);
+	minY = std::max(minY, 0);
+	maxX = std::min<int>(maxX, width);
+	maxY = std::min<int>(maxY, height);
+	if (minX >= maxX || minY >= maxY)
+		return { { 0, 0 }, Size { 0, 0 } };
+	return { { minX, minY }, Size { maxX - minX, maxY - minY } };
+}
+
+/**
+ * @brief Moves the contents of the lightmap so that the pixel at `position + delta` ends up at `position`
+ *
+ * Pixels that are scrolled in keep stale values and have to be rendered again.
+ */
+void ScrollLightmap(Displacement delta, uint16_t width, uint16_t height)
+{
+	const size_t rowLength = width - std::abs(delta.deltaX);
+	const int srcX = std::max(delta.deltaX, 0);
+	const int dstX = std::max(-delta.deltaX, 0);
+	const auto moveRow = [&](int y) {
+		memmove(&LightmapBuffer[(static_cast<size_t>(y) * width) + dstX],
+		    &LightmapBuffer[(static_cast<size_t>(y + delta.deltaY) * width) + srcX], rowLength);
+	};
+	if (delta.deltaY >= 0) {
+		for (int y = 0; y < height - delta.deltaY; y++)
+			moveRow(y);
+	} else {
+		for (int y = height - 1; y >= -delta.deltaY; y--)
+			moveRow(y);
+	}
+}
+
+void BuildLightmap(Point tilePosition, Point targetBufferPosition, uint16_t viewportWidth, uint16_t viewportHeight,
+    int rows, int columns, const uint8_t tileLights[MAXDUNX][MAXDUNY], Bitset2d<MAXDUNX, MAXDUNY> *dirtyTiles,
+    uint_fast8_t microTileLen)
+{
+	// Since light may need to bleed up to the top of wall tiles,
+	// expand the buffer space to include the full base diamond of the tallest tile graphics
+	const uint16_t bufferHeight = viewportHeight + (TILE_HEIGHT * (microTileLen / 2 + 1));
+	rows += microTileLen + 2;
+
+	const size_t totalPixels = static_cast<size_t>(viewportWidth) * bufferHeight;
+	LightmapBuffer.resize(totalPixels);
+
+	const Point origin = GetDungeonPixelPosition(tilePosition) - (targetBufferPosition - Point {});
+	const Displacement scroll = origin - LightmapOrigin;
+	// Scrolling keeps the edges rendered for the previous rows and columns,
+	// so any change to the geometry needs a full rebuild to match one.
+	const bool canUpdate = dirtyTiles != nullptr && LightmapValid
+	    && LightmapWidth == viewportWidth && LightmapHeight == bufferHeight
+	    && LightmapRows == rows && LightmapColumns == columns
+	    && std::abs(scroll.deltaX) < viewportWidth && std::abs(scroll.deltaY) < bufferHeight;
+	LightmapOrigin = origin;
+	LightmapWidth = viewportWidth;
+	LightmapHeight = bufferHeight;
+	LightmapRows = rows;
+	LightmapColumns = columns;
+	// Without dirty tiles, the next build can't tell what changed
+	LightmapValid = dirtyTiles != nullptr;
+
+	// Since rendering occurs in cells between quads,
+	// expand the rendering space to include tiles outside the viewport
+	tilePosition += Displacement(Direction::NorthWest) * 2;
+	targetBufferPosition -= Displacement { TILE_WIDTH, TILE_HEIGHT };
+	rows += 3;
+	columns++;
+
+	if (!canUpdate) {
+		RenderCells(tilePosition, targetBufferPosition, rows, columns, tileLights,
+		    { { 0, 0 }, Size { viewportWidth, bufferHeight } }, LightmapBuffer.data());
+	} else {
+		if (scroll != Displacement {}) {
+			ScrollLightmap(scroll, viewportWidth, bufferHeight);
+			if (scroll.deltaX != 0) {
+				const int x = scroll.deltaX > 0 ? viewportWidth - scroll.deltaX : 0;
+				RenderRegion(tilePosition, targetBufferPosition, rows, columns, tileLights,
+				    { { x, 0 }, Size { std::abs(scroll.deltaX), bufferHeight } }, viewportWidth);
+			}
+			if (scroll.deltaY != 0) {
+				const int y = scroll.deltaY > 0 ? bufferHeight - scroll.deltaY : 0;
+				RenderRegion(tilePosition, targetBufferPosition, rows, columns, tileLights,
+				    { { 0, y }, Size { viewportWidth, std::abs(scroll.deltaY) } }, viewportWidth);
+			}
+		}
+		if (dirtyTiles->any()) {
+			const Rectangle region = FindDirtyRegion(tilePosition, targetBufferPosition, rows, columns, *dirtyTiles, viewportWidth, bufferHeight);
+			if (region.size.width > 0)
+				RenderRegion(tilePosition, targetBufferPosition, rows, columns, tileLights, region, viewportWidth);
+		}
+	}
+
+	if (dirtyTiles != nullptr)
+		dirtyTiles->reset();
+}
+
 } // namespace
 
+LightmapIsa GetBestLightmapIsa()
+{
+	if (GetTriangleSpansFn(LightmapIsa::Neon) != nullptr)
+		return LightmapIsa::Neon;
+	if (GetTriangleSpansFn(LightmapIsa::Sse2) != nullptr)
+		return LightmapIsa::Sse2;
+	return LightmapIsa::Scalar;
+}
+
+bool SetLightmapIsa(LightmapIsa isa)
+{
+	const TriangleSpansFn fn = GetTriangleSpansFn(isa);
+	if (fn == nullptr)
+		return false;
+	ComputeTriangleSpans = fn;
+	return true;
+}
+
 Lightmap::Lightmap(const uint8_t *outBuffer, uint16_t outPitch,
     std::span<const uint8_t> lightmapBuffer, uint16_t lightmapPitch,
     std::span<const std::array<uint8_t, LightTableSize>, NumLightingLevels> lightTables,
@@ -515,11 +880,13 @@ Lightmap Lightmap::build(bool perPixelLighting, Point tilePosition, Point target
     const uint8_t *outBuffer, uint16_t outPitch,
     std::span<const std::array<uint8_t, LightTableSize>, NumLightingLevels> lightTables,
     const uint8_t *fullyLitLightTable, const uint8_t *fullyDarkLightTable,
-    const uint8_t tileLights[MAXDUNX][MAXDUNY],
+    const uint8_t tileLights[MAXDUNX][MAXDUNY], Bitset2d<MAXDUNX, MAXDUNY> *dirtyTiles,
     uint_fast8_t microTileLen)
 {
 	if (perPixelLighting) {
-		BuildLightmap(tilePosition, targetBufferPosition, viewportWidth, viewportHeight, rows, columns, tileLights, microTileLen);
+		BuildLightmap(tilePosition, targetBufferPosition, viewportWidth, viewportHeight, rows, columns, tileLights, dirtyTiles, microTileLen);
+	} else {
+		LightmapValid = false;
 	}
 	return Lightmap(outBuffer, outPitch, LightmapBuffer, viewportWidth, lightTables, fullyLitLightTable, fullyDarkLightTable);
 }
@@ -8,9 +8,32 @@
 #include "engine/lighting_defs.hpp"
 #include "engine/point.hpp"
 #include "levels/gendung_defs.hpp"
+#include "utils/bitset2d.hpp"
 
 namespace devilution {
 
+/**
+ * @brief Instruction sets that the lightmap can be rendered with.
+ *
+ * All of them produce identical lightmaps.
+ */
+enum class LightmapIsa : uint8_t {
+	Scalar,
+	Sse2,
+	Neon,
+};
+
+/**
+ * @brief Returns the fastest instruction set supported by this CPU, which is used by default.
+ */
+LightmapIsa GetBestLightmapIsa();
+
+/**
+ * @brief Selects the instruction set used to render the lightmap.
+ * @return false if the CPU does not support it, in which case the selection is unchanged
+ */
+bool SetLightmapIsa(LightmapIsa isa);
+
 class Lightmap {
 public:
 	explicit Lightmap(const uint8_t *outBuffer, std::span<const uint8_t> lightmapBuffer, uint16_t pitch,
@@ -49,12 +72,21 @@ public:
 	[[nodiscard]] bool isFullyLitLightTable(const uint8_t *lightTable) const { return lightTable == fullyLitLightTable_; }
 	[[nodiscard]] bool isFullyDarkLightTable(const uint8_t *lightTable) const { return lightTable == fullyDarkLightTable_; }
 
+	/**
+	 * @brief Builds the per-pixel lightmap for the viewport
+	 *
+	 * The previous lightmap is reused where possible: it is scrolled into place,
+	 * and only the cells around dirty tiles and the newly scrolled-in pixels are rendered again.
+	 * @param tileLights Light level of each tile
+	 * @param dirtyTiles Tiles whose light level changed since the previous build, cleared by the build.
+	 *                   If null, the whole lightmap is rendered.
+	 */
 	static Lightmap build(bool perPixelLighting, Point tilePosition, Point targetBufferPosition,
 	    int viewportWidth, int viewportHeight, int rows, int columns,
 	    const uint8_t *outBuffer, uint16_t outPitch,
 	    std::span<const std::array<uint8_t, LightTableSize>, NumLightingLevels> lightTables,
 	    const uint8_t *fullyLitLightTable, const uint8_t *fullyDarkLightTable,
-	    const uint8_t tileLights[MAXDUNX][MAXDUNY],
+	    const uint8_t tileLights[MAXDUNX][MAXDUNY], Bitset2d<MAXDUNX, MAXDUNY> *dirtyTiles,
 	    uint_fast8_t microTileLen);
 
 	static Lightmap bleedUp(bool perPixelLighting, const Lightmap &source, Point targetBufferPosition, std::span<uint8_t> lightmapBuffer);
@@ -0,0 +1,93 @@
+#include "engine/render/light_table_simd.hpp"
+
+#include <cstdint>
+
+#include "utils/cpu_features.hpp"
+
+#if DVL_SIMD_AARCH64
+#include <arm_neon.h>
+#endif
+
+namespace devilution {
+
+namespace {
+
+void ApplyLightTableScalar(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, unsigned length, const uint8_t *DVL_RESTRICT colorMap)
+{
+	for (unsigned i = 0; i < length; ++i)
+		dst[i] = colorMap[src[i]];
+}
+
+#if DVL_SIMD_AARCH64
+DVL_ALWAYS_INLINE uint8x16_t LookUp16(const uint8x16x4_t table[4], uint8x16_t colors)
+{
+	// tbl zeroes and tbx keeps lanes whose index is out of range for the 64-entry quarter,
+	// so subtracting 64 per quarter moves each color into range exactly once.
+	const uint8x16_t quarter = vdupq_n_u8(64);
+	uint8x16_t result = vqtbl4q_u8(table[0], colors);
+	colors = vsubq_u8(colors, quarter);
+	result = vqtbx4q_u8(result, table[1], colors);
+	colors = vsubq_u8(colors, quarter);
+	result = vqtbx4q_u8(result, table[2], colors);
+	colors = vsubq_u8(colors, quarter);
+	return vqtbx4q_u8(result, table[3], colors);
+}
+
+void ApplyLightTableNeon(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, unsigned length, const uint8_t *DVL_RESTRICT colorMap)
+{
+	if (length < 16) {
+		ApplyLightTableScalar(dst, src, length, colorMap);
+		return;
+	}
+	uint8x16x4_t table[4];
+	for (int quarter = 0; quarter < 4; ++quarter) {
+		for (int i = 0; i < 4; ++i)
+			table[quarter].val[i] = vld1q_u8(colorMap + (quarter * 64) + (i * 16));
+	}
+
+	unsigned i = 0;
+	for (; i + 16 <= length; i += 16)
+		vst1q_u8(dst + i, LookUp16(table, vld1q_u8(src + i)));
+	if (i != length) {
+		i = length - 16;
+		vst1q_u8(dst + i, LookUp16(table, vld1q_u8(src + i)));
+	}
+}
+#endif // DVL_SIMD_AARCH64
+
+} // namespace
+
+LightTableKernel GetLightTableKernel(LightTableIsa isa)
+{
+	[[maybe_unused]] const CpuFeatures &cpu = GetCpuFeatures();
+	switch (isa) {
+	case LightTableIsa::Scalar:
+		return ApplyLightTableScalar;
+#if DVL_SIMD_AARCH64
+	case LightTableIsa::Neon:
+		return cpu.neon ? ApplyLightTableNeon : nullptr;
+#endif
+	default:
+		return nullptr;
+	}
+}
+
+LightTableIsa GetBestLightTableIsa()
+{
+	if (GetLightTableKernel(LightTableIsa::Neon) != nullptr)
+		return LightTableIsa::Neon;
+	return LightTableIsa::Scalar;
+}
+
+LightTableKernel ApplyLightTable = GetBestLightTableIsa() == LightTableIsa::Scalar ? nullptr : GetLightTableKernel(GetBestLightTableIsa());
+
+bool SetLightTableIsa(LightTableIsa isa)
+{
+	const LightTableKernel kernel = GetLightTableKernel(isa);
+	if (kernel == nullptr)
+		return false;
+	ApplyLightTable = isa == LightTableIsa::Scalar ? nullptr : kernel;
+	return true;
+}
+
+} // namespace devilution
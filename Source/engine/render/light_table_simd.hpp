@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+
+#include "utils/attributes.h"
+
+namespace devilution {
+
+/**
+ * @brief Implementations of the light table kernel.
+ */
+enum class LightTableIsa : uint8_t {
+	Scalar,
+	Neon,
+};
+
+/**
+ * @brief Sets `dst[i] = colorMap[src[i]]` for `length` pixels.
+ *
+ * `colorMap` must have 256 entries. All implementations produce identical output.
+ */
+using LightTableKernel = void (*)(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, unsigned length, const uint8_t *DVL_RESTRICT colorMap);
+
+/** @brief Spans shorter than this are faster with a plain lookup loop than with SIMD. */
+constexpr unsigned LightTableSimdMinLength = 16;
+
+/**
+ * @brief Returns the kernel for the given implementation,
+ * or `nullptr` if this build or the current CPU does not support it.
+ */
+LightTableKernel GetLightTableKernel(LightTableIsa isa);
+
+/**
+ * @brief Returns the fastest implementation supported by the current CPU.
+ *
+ * There is no x86 implementation: pshufb only looks up 16 entries at a time, and
+ * splitting the lookup into 16 shuffles is slower than a plain lookup from an
+ * L1-resident table, even with AVX2.
+ */
+LightTableIsa GetBestLightTableIsa();
+
+/**
+ * @brief The SIMD kernel used for rendering, or `nullptr` if renderers should use their inline scalar loop.
+ */
+extern DVL_API_FOR_TEST LightTableKernel ApplyLightTable;
+
+/**
+ * @brief Switches the kernel used for rendering, e.g. for benchmarks.
+ * @return false if the implementation is not supported.
+ */
+bool SetLightTableIsa(LightTableIsa isa);
+
+} // namespace devilution
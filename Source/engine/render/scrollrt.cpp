@@ -5,9 +5,15 @@
  */
 #include "engine/render/scrollrt.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_keyboard.h>
@@ -17,8 +23,6 @@
 #include <SDL.h>
 #endif
 
-#include <ankerl/unordered_dense.h>
-
 #include "DiabloUI/ui_flags.hpp"
 #include "automap.h"
 #include "controls/control_mode.hpp"
@@ -35,6 +39,7 @@
 #include "engine/render/dun_render.hpp"
 #include "engine/render/light_render.hpp"
 #include "engine/render/text_render.hpp"
+#include "engine/render/world_snapshot.hpp"
 #include "engine/trn.hpp"
 #include "engine/world_tile.hpp"
 #include "game_mode.hpp"
@@ -68,11 +73,14 @@
 #include "stores.h"
 #include "towners.h"
 #include "utils/attributes.h"
+#include "utils/bitset2d.hpp"
 #include "utils/display.h"
+#include "utils/frame_profiler.hpp"
 #include "utils/is_of.hpp"
 #include "utils/log.hpp"
 #include "utils/sdl_compat.h"
 #include "utils/str_cat.hpp"
+#include "utils/thread_pool.hpp"
 
 #ifndef USE_SDL1
 #include "controls/touch/renderers.h"
@@ -120,90 +128,56 @@ constexpr auto RightFrameDisplacement = Displacement { DunFrameWidth, 0 };
 }
 
 /**
- * @brief Contains all Missile at rendering position
+ * @brief A missile and where it is drawn in the frame being rendered.
  */
-ankerl::unordered_dense::map<WorldTilePosition, std::vector<Missile *>> MissilesAtRenderingTile;
+struct MissileOnTile {
+	WorldTilePosition tile;
+	Displacement offset;
+	/** @brief Index into WorldSnapshot::missiles. */
+	uint16_t index;
+};
 
 /**
- * @brief Could the missile (at the next game tick) collide? This method is a simplified version of CheckMissileCol (for example without random).
+ * @brief Everything a world render reads besides the level geometry, gathered on the main thread.
  */
-bool CouldMissileCollide(Point tile, bool checkPlayerAndMonster)
-{
-	if (!InDungeonBounds(tile))
-		return true;
-	if (checkPlayerAndMonster) {
-		if (dMonster[tile.x][tile.y] > 0)
-			return true;
-		if (dPlayer[tile.x][tile.y] > 0)
-			return true;
-	}
-
-	return IsMissileBlockedByTile(tile);
-}
-
-void UpdateMissilePositionForRendering(Missile &m, int progress)
-{
-	DisplacementOf<int64_t> velocity = m.position.velocity;
-	velocity *= progress;
-	velocity /= AnimationInfo::baseValueFraction;
-	const Displacement pixelsTravelled = (m.position.traveled + Displacement { static_cast<int>(velocity.deltaX), static_cast<int>(velocity.deltaY) }) >> 16;
-	const Displacement tileOffset = pixelsTravelled.screenToMissile();
+struct WorldView {
+	std::shared_ptr<const WorldSnapshot> snapshot;
+	uint8_t progressToNextGameTick;
+	/** @brief First tile of the view in dPiece coordinates. */
+	Point firstTile;
+	/** @brief Amount to offset the rendering in screen space. */
+	Displacement offset;
+
+	/** @brief Entities highlighted by the cursor, -1 for none. */
+	int monsterUnderCursor;
+	int playerUnderCursor;
+	int objectUnderCursor;
+	int itemUnderCursor;
+	/** @brief Outline every item, not only the one under the cursor. */
+	bool outlineAllItems;
+	/** @brief Item outlines are hidden while a store is open. */
+	bool hideItemOutlines;
+
+	/** @brief Missiles sorted by the tile they are drawn on. */
+	std::vector<MissileOnTile> missiles;
+
+	/** @brief Item labels found while rendering, queued on the main thread as they need the live items. */
+	std::vector<std::pair<int8_t, Point>> itemLabels;
+};
 
-	// calculate the future missile position
-	m.position.tileForRendering = m.position.start + tileOffset;
-	m.position.offsetForRendering = pixelsTravelled + tileOffset.worldToScreen();
-}
+/**
+ * @brief The view being rendered, only set during a world render.
+ */
+WorldView *View;
 
-void UpdateMissileRendererData(Missile &m)
+[[nodiscard]] DVL_ALWAYS_INLINE const WorldSnapshot &Snapshot()
 {
-	m.position.tileForRendering = m.position.tile;
-	m.position.offsetForRendering = m.position.offset;
-
-	const MissileMovementDistribution missileMovement = GetMissileData(m._mitype).movementDistribution;
-	// don't calculate missile position if they don't move
-	if (missileMovement == MissileMovementDistribution::Disabled || m.position.velocity == Displacement {})
-		return;
-
-	int progress = ProgressToNextGameTick;
-	UpdateMissilePositionForRendering(m, progress);
-
-	// In some cases this calculated position is invalid.
-	// For example a missile shouldn't move inside a wall.
-	// In this case the game logic don't advance the missile position and removes the missile or shows an explosion animation at the old position.
-	// For the animation distribution logic this means we are not allowed to move to a tile where the missile could collide, because this could be a invalid position.
-
-	// If we are still at the current tile, this tile was already checked and is a valid tile
-	if (m.position.tileForRendering == m.position.tile)
-		return;
-
-	// If no collision can happen at the new tile we can advance
-	if (!CouldMissileCollide(m.position.tileForRendering, missileMovement == MissileMovementDistribution::Blockable))
-		return;
-
-	// The new tile could be invalid, so don't advance to it.
-	// We search the last offset that is in the old (valid) tile.
-	// Implementation note: If someone knows the correct math to calculate this without the loop, I would really appreciate it.
-	while (m.position.tile != m.position.tileForRendering) {
-		progress -= 1;
-
-		if (progress <= 0) {
-			m.position.tileForRendering = m.position.tile;
-			m.position.offsetForRendering = m.position.offset;
-			return;
-		}
-
-		UpdateMissilePositionForRendering(m, progress);
-	}
+	return *View->snapshot;
 }
 
-void UpdateMissilesRendererData()
+bool IsRenderedBefore(WorldTilePosition a, WorldTilePosition b)
 {
-	MissilesAtRenderingTile.clear();
-
-	for (auto &m : Missiles) {
-		UpdateMissileRendererData(m);
-		MissilesAtRenderingTile[m.position.tileForRendering].push_back(&m);
-	}
+	return a.x != b.x ? a.x < b.x : a.y < b.y;
 }
 
 uint32_t lastFpsUpdateInMs;
@@ -330,23 +304,27 @@ void DrawCursor(const Surface &out)
 /**
  * @brief Render a missile sprite
  * @param out Output buffer
- * @param missile Pointer to Missile struct
+ * @param missile Missile to draw
+ * @param renderOffset Offset of the missile from its rendering tile
  * @param targetBufferPosition Output buffer coordinate
  * @param pre Is the sprite in the background
  */
-void DrawMissilePrivate(const Surface &out, const Missile &missile, Point targetBufferPosition, bool pre, int lightTableIndex)
+void DrawMissilePrivate(const Surface &out, const MissileSnapshot &missile, Displacement renderOffset, Point targetBufferPosition, bool pre, int lightTableIndex)
 {
-	if (missile._miPreFlag != pre || !missile._miDrawFlag)
+	if (missile.isPre != pre || !missile.isDrawn)
+		return;
+
+	const OptionalClxSprite sprite = missile.sprites.frame(missile.frame);
+	if (!sprite)
 		return;
 
-	const Point missileRenderPosition { targetBufferPosition + missile.position.offsetForRendering - Displacement { missile._miAnimWidth2, 0 } };
-	const ClxSprite sprite = (*missile._miAnimData)[missile._miAnimFrame - 1];
-	if (missile._miUniqTrans != 0) {
-		ClxDrawTRN(out, missileRenderPosition, sprite, Monsters[missile._misource].uniqueMonsterTRN.get());
-	} else if (missile._miLightFlag) {
-		ClxDrawLight(out, missileRenderPosition, sprite, lightTableIndex);
+	const Point missileRenderPosition { targetBufferPosition + renderOffset - Displacement { missile.animWidth2, 0 } };
+	if (const uint8_t *trn = Snapshot().uniqueTrn(missile.uniqueTrn); trn != nullptr) {
+		ClxDrawTRN(out, missileRenderPosition, *sprite, trn);
+	} else if (missile.isLit) {
+		ClxDrawLight(out, missileRenderPosition, *sprite, lightTableIndex);
 	} else {
-		ClxDraw(out, missileRenderPosition, sprite);
+		ClxDraw(out, missileRenderPosition, *sprite);
 	}
 }
 
@@ -359,10 +337,12 @@ void DrawMissilePrivate(const Surface &out, const Missile &missile, Point target
  */
 void DrawMissile(const Surface &out, WorldTilePosition tilePosition, Point targetBufferPosition, bool pre, int lightTableIndex)
 {
-	const auto it = MissilesAtRenderingTile.find(tilePosition);
-	if (it == MissilesAtRenderingTile.end()) return;
-	for (Missile *missile : it->second) {
-		DrawMissilePrivate(out, *missile, targetBufferPosition, pre, lightTableIndex);
+	const std::vector<MissileOnTile> &missiles = View->missiles;
+	auto it = std::lower_bound(missiles.begin(), missiles.end(), tilePosition, [](const MissileOnTile &missile, WorldTilePosition tile) {
+		return IsRenderedBefore(missile.tile, tile);
+	});
+	for (; it != missiles.end() && it->tile == tilePosition; ++it) {
+		DrawMissilePrivate(out, Snapshot().missiles[it->index], it->offset, targetBufferPosition, pre, lightTableIndex);
 	}
 }
 
@@ -372,26 +352,18 @@ void DrawMissile(const Surface &out, WorldTilePosition tilePosition, Point targe
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  * @param monster Monster reference
+ * @param sprite The monster's current sprite
  */
-void DrawMonster(const Surface &out, Point tilePosition, Point targetBufferPosition, const Monster &monster, int lightTableIndex)
+void DrawMonster(const Surface &out, Point tilePosition, Point targetBufferPosition, const MonsterSnapshot &monster, ClxSprite sprite, int lightTableIndex)
 {
-	if (!monster.animInfo.sprites) {
-		Log("Draw Monster \"{}\": NULL Cel Buffer", monster.name());
-		return;
-	}
-
-	const ClxSprite sprite = monster.animInfo.currentSprite();
-
-	if (!IsTileLit(tilePosition)) {
+	if (!Snapshot().isTileLit(tilePosition)) {
 		ClxDrawTRN(out, targetBufferPosition, sprite, GetInfravisionTRN());
 		return;
 	}
-	uint8_t *trn = nullptr;
-	if (monster.isUnique())
-		trn = monster.uniqueMonsterTRN.get();
+	const uint8_t *trn = Snapshot().uniqueTrn(monster.uniqueTrn);
 	if (monster.mode == MonsterMode::Petrified)
 		trn = GetStoneTRN();
-	if (MyPlayer->_pInfraFlag && lightTableIndex > 8)
+	if (Snapshot().hasInfravision && lightTableIndex > 8)
 		trn = GetInfravisionTRN();
 	if (trn != nullptr)
 		ClxDrawTRN(out, targetBufferPosition, sprite, trn);
@@ -402,12 +374,10 @@ void DrawMonster(const Surface &out, Point tilePosition, Point targetBufferPosit
 /**
  * @brief Helper for rendering a specific player icon (Mana Shield or Reflect)
  */
-void DrawPlayerIconHelper(const Surface &out, MissileGraphicID missileGraphicId, Point position, const Player &player, bool infraVision, int lightTableIndex)
+void DrawPlayerIconHelper(const Surface &out, MissileGraphicID missileGraphicId, Point position, const PlayerSnapshot &player, bool lighting, bool infraVision, int lightTableIndex)
 {
-	const bool lighting = &player != MyPlayer;
-
-	if (player.isWalking())
-		position += GetOffsetForWalking(player.AnimInfo, player._pdir);
+	if (player.isWalking)
+		position += GetOffsetForWalking(player.animInfo, player.direction, View->progressToNextGameTick);
 
 	position.x -= GetMissileSpriteData(missileGraphicId).animWidth2;
 
@@ -431,14 +401,15 @@ void DrawPlayerIconHelper(const Surface &out, MissileGraphicID missileGraphicId,
  * @param out Output buffer
  * @param player Player reference
  * @param position Output buffer coordinates
+ * @param lighting Should lighting be applied
  * @param infraVision Should infravision be applied
  */
-void DrawPlayerIcons(const Surface &out, const Player &player, Point position, bool infraVision, int lightTableIndex)
+void DrawPlayerIcons(const Surface &out, const PlayerSnapshot &player, Point position, bool lighting, bool infraVision, int lightTableIndex)
 {
-	if (player.pManaShield)
-		DrawPlayerIconHelper(out, MissileGraphicID::ManaShield, position, player, infraVision, lightTableIndex);
-	if (player.wReflections > 0)
-		DrawPlayerIconHelper(out, MissileGraphicID::Reflect, position + Displacement { 0, 16 }, player, infraVision, lightTableIndex);
+	if (player.hasManaShield)
+		DrawPlayerIconHelper(out, MissileGraphicID::ManaShield, position, player, lighting, infraVision, lightTableIndex);
+	if (player.hasReflections)
+		DrawPlayerIconHelper(out, MissileGraphicID::Reflect, position + Displacement { 0, 16 }, player, lighting, infraVision, lightTableIndex);
 }
 
 uint8_t GetPlayerOutlineColor(int id)
@@ -459,37 +430,42 @@ uint8_t GetPlayerOutlineColor(int id)
 /**
  * @brief Render a player sprite
  * @param out Output buffer
- * @param player Player reference
+ * @param playerId Index of the player
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  */
-void DrawPlayer(const Surface &out, const Player &player, Point tilePosition, Point targetBufferPosition, int lightTableIndex)
+void DrawPlayer(const Surface &out, int playerId, Point tilePosition, Point targetBufferPosition, int lightTableIndex)
 {
-	if (!IsTileLit(tilePosition) && !MyPlayer->_pInfraFlag && !MyPlayer->isOnArenaLevel() && leveltype != DTYPE_TOWN) {
+	const WorldSnapshot &snapshot = Snapshot();
+	if (!snapshot.isTileLit(tilePosition) && !snapshot.hasInfravision && !snapshot.isOnArenaLevel && leveltype != DTYPE_TOWN) {
 		return;
 	}
 
-	const ClxSprite sprite = player.currentSprite();
-	const Point spriteBufferPosition = targetBufferPosition + player.getRenderingOffset(sprite);
+	const PlayerSnapshot &player = snapshot.players[playerId];
+	const OptionalClxSprite sprite = player.currentSprite(View->progressToNextGameTick);
+	if (!sprite)
+		return;
+	const Point spriteBufferPosition = targetBufferPosition + player.getRenderingOffset(*sprite, View->progressToNextGameTick);
 
-	if (&player == PlayerUnderCursor)
-		ClxDrawOutlineSkipColorZero(out, GetPlayerOutlineColor(player.getId()), spriteBufferPosition, sprite);
+	if (playerId == View->playerUnderCursor)
+		ClxDrawOutlineSkipColorZero(out, GetPlayerOutlineColor(playerId), spriteBufferPosition, *sprite);
 
-	if (&player == MyPlayer && IsNoneOf(leveltype, DTYPE_NEST, DTYPE_CRYPT)) {
-		ClxDraw(out, spriteBufferPosition, sprite);
-		DrawPlayerIcons(out, player, targetBufferPosition, /*infraVision=*/false, lightTableIndex);
+	if (playerId == snapshot.myPlayerId && IsNoneOf(leveltype, DTYPE_NEST, DTYPE_CRYPT)) {
+		ClxDraw(out, spriteBufferPosition, *sprite);
+		DrawPlayerIcons(out, player, targetBufferPosition, /*lighting=*/false, /*infraVision=*/false, lightTableIndex);
 		return;
 	}
 
-	if (!IsTileLit(tilePosition) || ((MyPlayer->_pInfraFlag || MyPlayer->isOnArenaLevel()) && lightTableIndex > 8)) {
-		ClxDrawTRN(out, spriteBufferPosition, sprite, GetInfravisionTRN());
-		DrawPlayerIcons(out, player, targetBufferPosition, /*infraVision=*/true, lightTableIndex);
+	const bool lighting = playerId != snapshot.myPlayerId;
+	if (!snapshot.isTileLit(tilePosition) || ((snapshot.hasInfravision || snapshot.isOnArenaLevel) && lightTableIndex > 8)) {
+		ClxDrawTRN(out, spriteBufferPosition, *sprite, GetInfravisionTRN());
+		DrawPlayerIcons(out, player, targetBufferPosition, lighting, /*infraVision=*/true, lightTableIndex);
 		return;
 	}
 
 	lightTableIndex = std::max(lightTableIndex - 5, 0);
-	ClxDrawLight(out, spriteBufferPosition, sprite, lightTableIndex);
-	DrawPlayerIcons(out, player, targetBufferPosition, /*infraVision=*/false, lightTableIndex);
+	ClxDrawLight(out, spriteBufferPosition, *sprite, lightTableIndex);
+	DrawPlayerIcons(out, player, targetBufferPosition, lighting, /*infraVision=*/false, lightTableIndex);
 }
 
 /**
@@ -500,13 +476,12 @@ void DrawPlayer(const Surface &out, const Player &player, Point tilePosition, Po
  */
 void DrawDeadPlayer(const Surface &out, Point tilePosition, Point targetBufferPosition, int lightTableIndex)
 {
-	dFlags[tilePosition.x][tilePosition.y] &= ~DungeonFlag::DeadPlayer;
-
-	for (const Player &player : Players) {
-		if (player.plractive && player.hasNoLife() && player.isOnActiveLevel() && player.position.tile == tilePosition) {
-			dFlags[tilePosition.x][tilePosition.y] |= DungeonFlag::DeadPlayer;
+	const std::array<PlayerSnapshot, MAX_PLRS> &players = Snapshot().players;
+	for (size_t i = 0; i < players.size(); i++) {
+		const PlayerSnapshot &player = players[i];
+		if (player.isActive && player.isDead && player.tile == tilePosition) {
 			const Point playerRenderPosition { targetBufferPosition };
-			DrawPlayer(out, player, tilePosition, playerRenderPosition, lightTableIndex);
+			DrawPlayer(out, static_cast<int>(i), tilePosition, playerRenderPosition, lightTableIndex);
 		}
 	}
 }
@@ -514,24 +489,26 @@ void DrawDeadPlayer(const Surface &out, Point tilePosition, Point targetBufferPo
 /**
  * @brief Render an object sprite
  * @param out Output buffer
- * @param objectToDraw Dungeone object to draw
+ * @param objectId Index of the object to draw
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
- * @param pre Is the sprite in the background
  */
-void DrawObject(const Surface &out, const Object &objectToDraw, Point tilePosition, Point targetBufferPosition, int lightTableIndex)
+void DrawObject(const Surface &out, int objectId, Point tilePosition, Point targetBufferPosition, int lightTableIndex)
 {
-	const ClxSprite sprite = objectToDraw.currentSprite();
+	const ObjectSnapshot &objectToDraw = Snapshot().objects[objectId];
+	const OptionalClxSprite sprite = objectToDraw.sprites.frame(objectToDraw.frame);
+	if (!sprite)
+		return;
 
-	const Point screenPosition = targetBufferPosition + objectToDraw.getRenderingOffset(sprite, tilePosition);
+	const Point screenPosition = targetBufferPosition + objectToDraw.getRenderingOffset(*sprite, tilePosition);
 
-	if (&objectToDraw == ObjectUnderCursor) {
-		ClxDrawOutlineSkipColorZero(out, OutlineColorsObject, screenPosition, sprite);
+	if (objectId == View->objectUnderCursor) {
+		ClxDrawOutlineSkipColorZero(out, OutlineColorsObject, screenPosition, *sprite);
 	}
 	if (objectToDraw.applyLighting) {
-		ClxDrawLight(out, screenPosition, sprite, lightTableIndex);
+		ClxDrawLight(out, screenPosition, *sprite, lightTableIndex);
 	} else {
-		ClxDraw(out, screenPosition, sprite);
+		ClxDraw(out, screenPosition, *sprite);
 	}
 }
 
@@ -563,7 +540,7 @@ void DrawCell(const Surface &out, const Lightmap lightmap, Point tilePosition, P
 	}
 #endif
 
-	bool transparency = TileHasAny(tilePosition, TileProperties::Transparent) && TransList[dTransVal[tilePosition.x][tilePosition.y]];
+	bool transparency = TileHasAny(tilePosition, TileProperties::Transparent) && Snapshot().transparency[dTransVal[tilePosition.x][tilePosition.y]];
 #ifdef _DEBUG
 	if ((SDL_GetModState() & SDL_KMOD_ALT) != 0) {
 		transparency = false;
@@ -616,10 +593,10 @@ void DrawCell(const Surface &out, const Lightmap lightmap, Point tilePosition, P
 		if (!isFloor || tileType == TileType::TransparentSquare) {
 			if (isFloor && tileType == TileType::TransparentSquare) {
 				RenderTileFoliage(out, bleedLightmap, targetBufferPosition,
-				    pDungeonCels.get(), levelCelBlock, foliageTbl);
+				    pDungeonCels.get(), pDungeonCelSpans.get(), levelCelBlock, foliageTbl);
 			} else {
 				RenderTile(out, bleedLightmap, targetBufferPosition,
-				    pDungeonCels.get(), levelCelBlock, getFirstTileMaskLeft(tileType), tbl);
+				    pDungeonCels.get(), pDungeonCelSpans.get(), levelCelBlock, getFirstTileMaskLeft(tileType), tbl);
 			}
 		}
 	}
@@ -628,10 +605,10 @@ void DrawCell(const Surface &out, const Lightmap lightmap, Point tilePosition, P
 		if (!isFloor || tileType == TileType::TransparentSquare) {
 			if (isFloor && tileType == TileType::TransparentSquare) {
 				RenderTileFoliage(out, bleedLightmap, targetBufferPosition + RightFrameDisplacement,
-				    pDungeonCels.get(), levelCelBlock, foliageTbl);
+				    pDungeonCels.get(), pDungeonCelSpans.get(), levelCelBlock, foliageTbl);
 			} else {
 				RenderTile(out, bleedLightmap, targetBufferPosition + RightFrameDisplacement,
-				    pDungeonCels.get(), levelCelBlock, getFirstTileMaskRight(tileType), tbl);
+				    pDungeonCels.get(), pDungeonCelSpans.get(), levelCelBlock, getFirstTileMaskRight(tileType), tbl);
 			}
 		}
 	}
@@ -642,7 +619,7 @@ void DrawCell(const Surface &out, const Lightmap lightmap, Point tilePosition, P
 			const LevelCelBlock levelCelBlock { pMap->mt[i] };
 			if (levelCelBlock.hasValue()) {
 				RenderTile(out, bleedLightmap, targetBufferPosition,
-				    pDungeonCels.get(), levelCelBlock,
+				    pDungeonCels.get(), pDungeonCelSpans.get(), levelCelBlock,
 				    transparency ? MaskType::Transparent : MaskType::Solid, foliageTbl);
 			}
 		}
@@ -650,7 +627,7 @@ void DrawCell(const Surface &out, const Lightmap lightmap, Point tilePosition, P
 			const LevelCelBlock levelCelBlock { pMap->mt[i + 1] };
 			if (levelCelBlock.hasValue()) {
 				RenderTile(out, bleedLightmap, targetBufferPosition + RightFrameDisplacement,
-				    pDungeonCels.get(), levelCelBlock,
+				    pDungeonCels.get(), pDungeonCelSpans.get(), levelCelBlock,
 				    transparency ? MaskType::Transparent : MaskType::Solid, foliageTbl);
 			}
 		}
@@ -677,7 +654,7 @@ void DrawCell(const Surface &out, const Lightmap lightmap, Point tilePosition, P
  */
 void DrawFloorTile(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition)
 {
-	const int lightTableIndex = dLight[tilePosition.x][tilePosition.y];
+	const int lightTableIndex = Snapshot().light[tilePosition.x][tilePosition.y];
 
 	const uint8_t *tbl = LightTables[lightTableIndex].data();
 #ifdef _DEBUG
@@ -689,15 +666,15 @@ void DrawFloorTile(const Surface &out, const Lightmap &lightmap, Point tilePosit
 	{
 		const LevelCelBlock levelCelBlock { DPieceMicros[levelPieceId].mt[0] };
 		if (levelCelBlock.hasValue()) {
-			RenderTileFrame(out, lightmap, targetBufferPosition, TileType::LeftTriangle,
-			    GetDunFrame(pDungeonCels.get(), levelCelBlock.frame()), DunFrameTriangleHeight, MaskType::Solid, tbl);
+			RenderTileFloor(out, lightmap, targetBufferPosition,
+			    pDungeonCels.get(), pDungeonCelSpans.get(), levelCelBlock, TileType::LeftTriangle, tbl);
 		}
 	}
 	{
 		const LevelCelBlock levelCelBlock { DPieceMicros[levelPieceId].mt[1] };
 		if (levelCelBlock.hasValue()) {
-			RenderTileFrame(out, lightmap, targetBufferPosition + RightFrameDisplacement, TileType::RightTriangle,
-			    GetDunFrame(pDungeonCels.get(), levelCelBlock.frame()), DunFrameTriangleHeight, MaskType::Solid, tbl);
+			RenderTileFloor(out, lightmap, targetBufferPosition + RightFrameDisplacement,
+			    pDungeonCels.get(), pDungeonCelSpans.get(), levelCelBlock, TileType::RightTriangle, tbl);
 		}
 	}
 }
@@ -711,15 +688,17 @@ void DrawFloorTile(const Surface &out, const Lightmap &lightmap, Point tilePosit
  */
 void DrawItem(const Surface &out, int8_t itemIndex, Point targetBufferPosition, int lightTableIndex)
 {
-	const Item &item = Items[itemIndex];
-	const ClxSprite sprite = item.AnimInfo.currentSprite();
-	const Point position = targetBufferPosition + item.getRenderingOffset(sprite);
-	if (!IsPlayerInStore() && (itemIndex == pcursitem || AutoMapShowItems)) {
-		ClxDrawOutlineSkipColorZero(out, GetOutlineColor(item, false), position, sprite);
+	const ItemSnapshot &item = Snapshot().items[itemIndex];
+	const OptionalClxSprite sprite = item.currentSprite(View->progressToNextGameTick);
+	if (!sprite)
+		return;
+	const Point position = targetBufferPosition + item.getRenderingOffset(*sprite);
+	if (!View->hideItemOutlines && (itemIndex == View->itemUnderCursor || View->outlineAllItems)) {
+		ClxDrawOutlineSkipColorZero(out, item.outlineColor, position, *sprite);
 	}
-	ClxDrawLight(out, position, sprite, lightTableIndex);
-	if (item.AnimInfo.isLastFrame() || item._iCurs == ICURS_MAGIC_ROCK)
-		AddItemToLabelQueue(itemIndex, position);
+	ClxDrawLight(out, position, *sprite, lightTableIndex);
+	if (item.animInfo.isLastFrame() || item.isMagicRock)
+		View->itemLabels.emplace_back(itemIndex, position);
 }
 
 /**
@@ -730,22 +709,27 @@ void DrawItem(const Surface &out, int8_t itemIndex, Point targetBufferPosition,
  */
 void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBufferPosition, int lightTableIndex)
 {
-	int mi = dMonster[tilePosition.x][tilePosition.y];
+	const WorldSnapshot &snapshot = Snapshot();
+	int mi = snapshot.monsterIds[tilePosition.x][tilePosition.y];
 
 	mi = std::abs(mi) - 1;
 
 	if (leveltype == DTYPE_TOWN) {
-		auto &towner = Towners[mi];
+		if (static_cast<size_t>(mi) >= snapshot.towners.size())
+			return;
+		const TownerSnapshot &towner = snapshot.towners[mi];
+		const OptionalClxSprite sprite = towner.sprites.frame(towner.frame);
+		if (!sprite)
+			return;
 		const Point position = targetBufferPosition + towner.getRenderingOffset();
-		const ClxSprite sprite = towner.currentSprite();
-		if (mi == pcursmonst) {
-			ClxDrawOutlineSkipColorZero(out, OutlineColorsTowner, position, sprite);
+		if (mi == View->monsterUnderCursor) {
+			ClxDrawOutlineSkipColorZero(out, OutlineColorsTowner, position, *sprite);
 		}
-		ClxDraw(out, position, sprite);
+		ClxDraw(out, position, *sprite);
 		return;
 	}
 
-	if (!IsTileLit(tilePosition) && !(MyPlayer->_pInfraFlag && IsFloor(tilePosition))) {
+	if (!snapshot.isTileLit(tilePosition) && !(snapshot.hasInfravision && IsFloor(tilePosition))) {
 		return;
 	}
 
@@ -754,19 +738,56 @@ void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBuffe
 		return;
 	}
 
-	const auto &monster = Monsters[mi];
-	if ((monster.flags & MFLAG_HIDDEN) != 0) {
+	const MonsterSnapshot &monster = snapshot.monsters[mi];
+	if (monster.isHidden) {
 		return;
 	}
 
-	const ClxSprite sprite = monster.animInfo.currentSprite();
-	const Displacement offset = monster.getRenderingOffset(sprite);
+	const OptionalClxSprite sprite = monster.currentSprite(View->progressToNextGameTick);
+	if (!sprite) {
+		Log("Draw Monster {}: NULL Cel Buffer", mi);
+		return;
+	}
+	const Displacement offset = monster.getRenderingOffset(*sprite, View->progressToNextGameTick);
 
 	const Point monsterRenderPosition = targetBufferPosition + offset;
-	if (mi == pcursmonst) {
-		ClxDrawOutlineSkipColorZero(out, OutlineColorsMonster, monsterRenderPosition, sprite);
+	if (mi == View->monsterUnderCursor) {
+		ClxDrawOutlineSkipColorZero(out, OutlineColorsMonster, monsterRenderPosition, *sprite);
+	}
+	DrawMonster(out, tilePosition, monsterRenderPosition, monster, *sprite, lightTableIndex);
+}
+
+/**
+ * @brief Moves a sprite that walks southwards or east back to the tile it's moving from
+ * @param mode Mode of the sprite
+ * @param walkSouthwards Mode of walking southwards
+ * @param walkSideways Mode of walking sideways
+ * @param direction Direction the sprite is facing
+ * @param tilePosition dPiece coordinates
+ * @param targetBufferPosition Output buffer coordinates
+ */
+template <typename Mode>
+void OffsetToTileMovingFrom(Mode mode, Mode walkSouthwards, Mode walkSideways, Direction direction, Point &tilePosition, Point &targetBufferPosition)
+{
+	if (mode == walkSouthwards) {
+		switch (direction) {
+		case Direction::SouthWest:
+			targetBufferPosition += { TILE_WIDTH / 2, -TILE_HEIGHT / 2 };
+			break;
+		case Direction::South:
+			targetBufferPosition += { 0, -TILE_HEIGHT };
+			break;
+		case Direction::SouthEast:
+			targetBufferPosition += { -TILE_WIDTH / 2, -TILE_HEIGHT / 2 };
+			break;
+		default:
+			DVL_UNREACHABLE();
+		}
+		tilePosition += Opposite(direction);
+	} else if (mode == walkSideways && direction == Direction::East) {
+		targetBufferPosition += { -TILE_WIDTH, 0 };
+		tilePosition += Opposite(direction);
 	}
-	DrawMonster(out, tilePosition, monsterRenderPosition, monster, lightTableIndex);
 }
 
 /**
@@ -779,20 +800,21 @@ void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBuffe
 void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition)
 {
 	assert(InDungeonBounds(tilePosition));
-	const int lightTableIndex = dLight[tilePosition.x][tilePosition.y];
+	const WorldSnapshot &snapshot = Snapshot();
+	const int lightTableIndex = snapshot.light[tilePosition.x][tilePosition.y];
 
 	DrawCell(out, lightmap, tilePosition, targetBufferPosition, lightTableIndex);
 
-	const int8_t bDead = dCorpse[tilePosition.x][tilePosition.y];
+	const int8_t bDead = snapshot.corpseIds[tilePosition.x][tilePosition.y];
 	const int8_t bMap = dTransVal[tilePosition.x][tilePosition.y];
 
 #ifdef _DEBUG
-	if (DebugVision && IsTileLit(tilePosition)) {
+	if (DebugVision && snapshot.isTileLit(tilePosition)) {
 		ClxDraw(out, targetBufferPosition, (*pSquareCel)[0]);
 	}
 #endif
 
-	if (MissilePreFlag) {
+	if (snapshot.missilePreFlag) {
 		DrawMissile(out, tilePosition, targetBufferPosition, true, lightTableIndex);
 	}
 
@@ -800,108 +822,80 @@ void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePositio
 		const Corpse &corpse = Corpses[(bDead & 0x1F) - 1];
 		const Point position { targetBufferPosition.x - CalculateSpriteTileCenterX(corpse.width), targetBufferPosition.y };
 		const ClxSprite sprite = corpse.spritesForDirection(static_cast<Direction>((bDead >> 5) & 7))[corpse.frame];
-		if (corpse.translationPaletteIndex != 0) {
-			const uint8_t *trn = Monsters[corpse.translationPaletteIndex - 1].uniqueMonsterTRN.get();
+		const uint8_t *trn = corpse.translationPaletteIndex != 0
+		    ? snapshot.uniqueTrn(snapshot.uniqueTrnIndex[corpse.translationPaletteIndex - 1])
+		    : nullptr;
+		if (trn != nullptr) {
 			ClxDrawTRN(out, position, sprite, trn);
 		} else {
 			ClxDrawLight(out, position, sprite, lightTableIndex);
 		}
 	}
 
-	const int8_t bItem = dItem[tilePosition.x][tilePosition.y];
-	const Object *object = lightTableIndex < LightsMax
-	    ? FindObjectAtPosition(tilePosition)
-	    : nullptr;
-	if (object != nullptr && object->_oPreFlag) {
-		DrawObject(out, *object, tilePosition, targetBufferPosition, lightTableIndex);
+	const int8_t bItem = snapshot.itemIds[tilePosition.x][tilePosition.y];
+	const int objectId = lightTableIndex < LightsMax
+	    ? snapshot.objectIdAt(tilePosition)
+	    : -1;
+	if (objectId != -1 && snapshot.objects[objectId].isPre) {
+		DrawObject(out, objectId, tilePosition, targetBufferPosition, lightTableIndex);
 	}
-	if (bItem > 0 && !Items[bItem - 1]._iPostDraw) {
+	if (bItem > 0 && !snapshot.items[bItem - 1].isPostDraw) {
 		DrawItem(out, static_cast<int8_t>(bItem - 1), targetBufferPosition, lightTableIndex);
 	}
 
-	if (TileContainsDeadPlayer(tilePosition)) {
+	if (snapshot.tileContainsDeadPlayer(tilePosition)) {
 		DrawDeadPlayer(out, tilePosition, targetBufferPosition, lightTableIndex);
 	}
-	Player *player = PlayerAtPosition(tilePosition);
-	if (player != nullptr) {
-		const uint8_t pid = player->getId();
+	if (const int8_t playerIndex = snapshot.playerIds[tilePosition.x][tilePosition.y]; playerIndex != 0) {
+		const int pid = std::abs(playerIndex) - 1;
 		assert(pid < MAX_PLRS);
-		int playerId = static_cast<int>(pid) + 1;
+		const PlayerSnapshot &player = snapshot.players[pid];
+		int playerId = pid + 1;
 		// If sprite is moving southwards or east, we want to draw it offset from the tile it's moving to, so we need negative ID
 		// This respests the order that tiles are drawn. By using the negative id, we ensure that the sprite is drawn with priority
-		if (player->_pmode == PM_WALK_SOUTHWARDS || (player->_pmode == PM_WALK_SIDEWAYS && player->_pdir == Direction::East))
+		if (player.mode == PM_WALK_SOUTHWARDS || (player.mode == PM_WALK_SIDEWAYS && player.direction == Direction::East))
 			playerId = -playerId;
-		if (dPlayer[tilePosition.x][tilePosition.y] == playerId) {
+		if (playerIndex == playerId) {
 			auto tempTilePosition = tilePosition;
 			auto tempTargetBufferPosition = targetBufferPosition;
 
 			// Offset the sprite to the tile it's moving from
-			if (player->_pmode == PM_WALK_SOUTHWARDS) {
-				switch (player->_pdir) {
-				case Direction::SouthWest:
-					tempTargetBufferPosition += { TILE_WIDTH / 2, -TILE_HEIGHT / 2 };
-					break;
-				case Direction::South:
-					tempTargetBufferPosition += { 0, -TILE_HEIGHT };
-					break;
-				case Direction::SouthEast:
-					tempTargetBufferPosition += { -TILE_WIDTH / 2, -TILE_HEIGHT / 2 };
-					break;
-				default:
-					DVL_UNREACHABLE();
-				}
-				tempTilePosition += Opposite(player->_pdir);
-			} else if (player->_pmode == PM_WALK_SIDEWAYS && player->_pdir == Direction::East) {
-				tempTargetBufferPosition += { -TILE_WIDTH, 0 };
-				tempTilePosition += Opposite(player->_pdir);
-			}
-			DrawPlayer(out, *player, tempTilePosition, tempTargetBufferPosition, lightTableIndex);
+			OffsetToTileMovingFrom(player.mode, PM_WALK_SOUTHWARDS, PM_WALK_SIDEWAYS, player.direction, tempTilePosition, tempTargetBufferPosition);
+			DrawPlayer(out, pid, tempTilePosition, tempTargetBufferPosition, lightTableIndex);
 		}
 	}
 
-	Monster *monster = FindMonsterAtPosition(tilePosition);
-	if (monster != nullptr) {
-		auto mid = monster->getId();
-		assert(mid < MaxMonsters);
-		int monsterId = static_cast<int>(mid) + 1;
-		// If sprite is moving southwards or east, we want to draw it offset from the tile it's moving to, so we need negative ID
-		// This respests the order that tiles are drawn. By using the negative id, we ensure that the sprite is drawn with priority
-		if (monster->mode == MonsterMode::MoveSouthwards || (monster->mode == MonsterMode::MoveSideways && monster->direction == Direction::East))
-			monsterId = -monsterId;
-		if (dMonster[tilePosition.x][tilePosition.y] == monsterId) {
-			auto tempTilePosition = tilePosition;
-			auto tempTargetBufferPosition = targetBufferPosition;
-
-			// Offset the sprite to the tile it's moving from
-			if (monster->mode == MonsterMode::MoveSouthwards) {
-				switch (monster->direction) {
-				case Direction::SouthWest:
-					tempTargetBufferPosition += { TILE_WIDTH / 2, -TILE_HEIGHT / 2 };
-					break;
-				case Direction::South:
-					tempTargetBufferPosition += { 0, -TILE_HEIGHT };
-					break;
-				case Direction::SouthEast:
-					tempTargetBufferPosition += { -TILE_WIDTH / 2, -TILE_HEIGHT / 2 };
-					break;
-				default:
-					DVL_UNREACHABLE();
-				}
-				tempTilePosition += Opposite(monster->direction);
-			} else if (monster->mode == MonsterMode::MoveSideways && monster->direction == Direction::East) {
-				tempTargetBufferPosition += { -TILE_WIDTH, 0 };
-				tempTilePosition += Opposite(monster->direction);
+	if (const int16_t monsterIndex = snapshot.monsterIds[tilePosition.x][tilePosition.y]; monsterIndex != 0) {
+		const int mid = std::abs(monsterIndex) - 1;
+		assert(static_cast<size_t>(mid) < MaxMonsters);
+		if (leveltype == DTYPE_TOWN) {
+			// Towners don't walk between tiles
+			if (monsterIndex > 0)
+				DrawMonsterHelper(out, tilePosition, targetBufferPosition, lightTableIndex);
+		} else {
+			const MonsterSnapshot &monster = snapshot.monsters[mid];
+			int monsterId = mid + 1;
+			// If sprite is moving southwards or east, we want to draw it offset from the tile it's moving to, so we need negative ID
+			// This respests the order that tiles are drawn. By using the negative id, we ensure that the sprite is drawn with priority
+			if (monster.mode == MonsterMode::MoveSouthwards || (monster.mode == MonsterMode::MoveSideways && monster.direction == Direction::East))
+				monsterId = -monsterId;
+			if (monsterIndex == monsterId) {
+				auto tempTilePosition = tilePosition;
+				auto tempTargetBufferPosition = targetBufferPosition;
+
+				// Offset the sprite to the tile it's moving from
+				OffsetToTileMovingFrom(monster.mode, MonsterMode::MoveSouthwards, MonsterMode::MoveSideways, monster.direction, tempTilePosition, tempTargetBufferPosition);
+				DrawMonsterHelper(out, tempTilePosition, tempTargetBufferPosition, lightTableIndex);
 			}
-			DrawMonsterHelper(out, tempTilePosition, tempTargetBufferPosition, lightTableIndex);
 		}
 	}
 
 	DrawMissile(out, tilePosition, targetBufferPosition, false, lightTableIndex);
 
-	if (object != nullptr && !object->_oPreFlag) {
-		DrawObject(out, *object, tilePosition, targetBufferPosition, lightTableIndex);
+	if (objectId != -1 && !snapshot.objects[objectId].isPre) {
+		DrawObject(out, objectId, tilePosition, targetBufferPosition, lightTableIndex);
 	}
-	if (bItem > 0 && Items[bItem - 1]._iPostDraw) {
+	if (bItem > 0 && snapshot.items[bItem - 1].isPostDraw) {
 		DrawItem(out, static_cast<int8_t>(bItem - 1), targetBufferPosition, lightTableIndex);
 	}
 
@@ -909,7 +903,7 @@ void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePositio
 		const bool perPixelLighting = *GetOptions().Graphics.perPixelLighting;
 		const int8_t bArch = dSpecial[tilePosition.x][tilePosition.y] - 1;
 		if (bArch >= 0) {
-			bool transparency = TransList[bMap];
+			bool transparency = snapshot.transparency[bMap];
 #ifdef _DEBUG
 			// Turn transparency off here for debugging
 			transparency = transparency && (SDL_GetModState() & SDL_KMOD_ALT) == 0;
@@ -953,8 +947,10 @@ void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePositio
 void DrawFloor(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition, int rows, int columns)
 {
 	for (int i = 0; i < rows; i++) {
+		// Floor tiles only extend upwards from their base, so rows outside of the buffer can be skipped entirely
+		const bool rowVisible = targetBufferPosition.y >= 0 && targetBufferPosition.y - TILE_HEIGHT < out.h();
 		for (int j = 0; j < columns; j++, tilePosition += Direction::East, targetBufferPosition.x += TILE_WIDTH) {
-			if (!InDungeonBounds(tilePosition))
+			if (!rowVisible || !InDungeonBounds(tilePosition))
 				continue;
 			if (IsFloor(tilePosition)) {
 				DrawFloorTile(out, lightmap, tilePosition, targetBufferPosition);
@@ -978,6 +974,210 @@ void DrawFloor(const Surface &out, const Lightmap &lightmap, Point tilePosition,
 	}
 }
 
+/**
+ * @brief Minimum height of a screen band when rendering the floor on the worker pool.
+ */
+constexpr int MinFloorBandHeight = TILE_HEIGHT * 2;
+
+[[nodiscard]] bool ShouldDrawFloorInBands()
+{
+#ifdef DUN_RENDER_STATS
+	// DunRenderStats is not thread-safe
+	return false;
+#else
+	return *GetOptions().Graphics.multithreadedRendering && GetWorkerPool().workerCount() != 0;
+#endif
+}
+
+/**
+ * @brief Render the floor in horizontal screen bands on the worker pool
+ *
+ * Each band renders into its own clipped subregion of the output buffer.
+ * The lightmap is looked up by output buffer address, so every band can share it.
+ * Returns once all bands have been rendered.
+ * @param out Buffer to render to
+ * @param lightmap Per-pixel light buffer
+ * @param tilePosition dPiece coordinates
+ * @param targetBufferPosition Target buffer coordinates
+ * @param rows Number of rows
+ * @param columns Tile in a row
+ */
+void DrawFloorInBands(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition, int rows, int columns)
+{
+	ThreadPool &pool = GetWorkerPool();
+	const int bandCount = std::clamp(out.h() / MinFloorBandHeight, 1, static_cast<int>(pool.workerCount()) + 1);
+	const int bandHeight = (out.h() + bandCount - 1) / bandCount;
+	pool.parallelFor(bandCount, [&](size_t band) {
+		const int top = static_cast<int>(band) * bandHeight;
+		const int height = std::min(bandHeight, out.h() - top);
+		if (height <= 0)
+			return;
+		DrawFloor(out.subregionY(top, height), lightmap, tilePosition, targetBufferPosition - Displacement { 0, top }, rows, columns);
+	});
+}
+
+/**
+ * @brief Horizontal margin of the floor cache on each side of the viewport.
+ */
+constexpr int FloorCacheMarginX = TILE_WIDTH * 4;
+
+/**
+ * @brief Vertical margin of the floor cache above and below the viewport.
+ */
+constexpr int FloorCacheMarginY = TILE_HEIGHT * 4;
+
+/**
+ * @brief Returns the position of a tile's base in screen space, relative to the top corner of the dungeon.
+ */
+[[nodiscard]] Point GetDungeonPixelPosition(Point tilePosition)
+{
+	return { (tilePosition.x - tilePosition.y) * TILE_WIDTH / 2, (tilePosition.x + tilePosition.y) * TILE_HEIGHT / 2 };
+}
+
+/**
+ * @brief An off-screen copy of the rendered floor, aligned to the dungeon rather than to the screen
+ *
+ * The cache is larger than the viewport, so scrolling only changes which part of it is copied to the screen.
+ * A floor tile is only rendered again when its `dPiece` or `dLight` entry changes.
+ * Once the view leaves the cached area, the cache is re-centered on the view and filled from scratch.
+ *
+ * Floor tiles are always rendered solid, so transparency does not affect them.
+ * Per-pixel lighting also depends on the neighbouring tiles, so the cache is only used without it.
+ */
+class FloorCache {
+public:
+	void invalidate()
+	{
+		valid_ = false;
+	}
+
+	/**
+	 * @brief Brings the visible floor tiles up to date and copies the view to the output buffer
+	 * @param out Buffer to render to
+	 * @param lightmap Per-pixel light buffer
+	 * @param tilePosition dPiece coordinates
+	 * @param targetBufferPosition Target buffer coordinates
+	 * @param rows Number of rows
+	 * @param columns Tile in a row
+	 */
+	void draw(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition, int rows, int columns)
+	{
+		const Point viewOrigin = GetDungeonPixelPosition(tilePosition) - (targetBufferPosition - Point {});
+		if (!valid_ || !containsView(viewOrigin, out))
+			reset(viewOrigin, out);
+
+		if (!updateTiles(lightmap, tilePosition, targetBufferPosition, out.h(), rows, columns)) {
+			reset(viewOrigin, out);
+			updateTiles(lightmap, tilePosition, targetBufferPosition, out.h(), rows, columns);
+		}
+
+		out.BlitFrom(*surface_, MakeSdlRect(viewOrigin.x - origin_.x, viewOrigin.y - origin_.y, out.w(), out.h()), { 0, 0 });
+	}
+
+private:
+	/** @brief Set on every key of a tile that has been rendered to the cache, so that no key is 0. */
+	static constexpr uint32_t TileKeyRendered = 1U << 24;
+
+	/**
+	 * @brief Renders the visible floor tiles that changed since they were last rendered to the cache
+	 * @return false if a tile could not be updated in place and the cache has to be reset
+	 */
+	bool updateTiles(const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition, int viewHeight, int rows, int columns)
+	{
+		const Surface &cache = *surface_;
+		for (int i = 0; i < rows; i++) {
+			const bool rowVisible = targetBufferPosition.y >= 0 && targetBufferPosition.y - TILE_HEIGHT < viewHeight;
+			for (int j = 0; j < columns; j++, tilePosition += Direction::East, targetBufferPosition.x += TILE_WIDTH) {
+				if (!rowVisible || !InDungeonBounds(tilePosition) || !IsFloor(tilePosition))
+					continue;
+				uint32_t &cachedKey = tileKeys_[tilePosition.x][tilePosition.y];
+				const uint32_t key = GetTileKey(tilePosition);
+				if (cachedKey == key)
+					continue;
+				// A piece that does not cover the whole tile would leave some of the old one behind
+				if (cachedKey != 0 && !CoversTile(tilePosition))
+					return false;
+				DrawFloorTile(cache, lightmap, tilePosition, GetDungeonPixelPosition(tilePosition) - (origin_ - Point {}));
+				cachedKey = key;
+			}
+			tilePosition += Displacement(Direction::West) * columns;
+			targetBufferPosition.x -= columns * TILE_WIDTH;
+
+			targetBufferPosition.y += TILE_HEIGHT / 2;
+			if ((i & 1) != 0) {
+				tilePosition.x++;
+				columns--;
+				targetBufferPosition.x += TILE_WIDTH / 2;
+			} else {
+				tilePosition.y++;
+				columns++;
+				targetBufferPosition.x -= TILE_WIDTH / 2;
+			}
+		}
+		return true;
+	}
+
+	[[nodiscard]] static uint32_t GetTileKey(Point tilePosition)
+	{
+		return TileKeyRendered | (static_cast<uint32_t>(Snapshot().light[tilePosition.x][tilePosition.y]) << 16) | dPiece[tilePosition.x][tilePosition.y];
+	}
+
+	/**
+	 * @brief Returns whether the tile's piece covers its whole floor diamond.
+	 */
+	[[nodiscard]] static bool CoversTile(Point tilePosition)
+	{
+		const MICROS &micros = DPieceMicros[dPiece[tilePosition.x][tilePosition.y]];
+		return LevelCelBlock { micros.mt[0] }.hasValue() && LevelCelBlock { micros.mt[1] }.hasValue();
+	}
+
+	[[nodiscard]] bool containsView(Point viewOrigin, const Surface &out) const
+	{
+		return viewOrigin.x >= origin_.x && viewOrigin.y >= origin_.y
+		    && viewOrigin.x + out.w() <= origin_.x + surface_->w()
+		    && viewOrigin.y + out.h() <= origin_.y + surface_->h();
+	}
+
+	void reset(Point viewOrigin, const Surface &out)
+	{
+		const int width = out.w() + 2 * FloorCacheMarginX;
+		const int height = out.h() + 2 * FloorCacheMarginY;
+		if (!surface_ || surface_->w() != width || surface_->h() != height)
+			surface_.emplace(width, height);
+		SDL_FillSurfaceRect(surface_->surface, nullptr, 0);
+		std::memset(tileKeys_, 0, sizeof(tileKeys_));
+		origin_ = viewOrigin - Displacement { FloorCacheMarginX, FloorCacheMarginY };
+		valid_ = true;
+	}
+
+	std::optional<OwnedSurface> surface_;
+	/** @brief Position of the cache's top-left pixel, relative to the top corner of the dungeon. */
+	Point origin_;
+	/** @brief The key each tile had when it was last rendered to the cache, or 0 if it has not been. */
+	uint32_t tileKeys_[MAXDUNX][MAXDUNY];
+	bool valid_ = false;
+};
+
+FloorCache CachedFloor;
+
+[[nodiscard]] bool ShouldUseFloorCache()
+{
+#ifdef DUN_RENDER_STATS
+	// Cached tiles would be missing from DunRenderStats
+	return false;
+#else
+#ifdef _DEBUG
+	if (DebugPath)
+		return false;
+#endif
+	const GraphicsOptions &options = GetOptions().Graphics;
+	if (!*options.floorCache || *options.perPixelLighting)
+		return false;
+	// Color cycling rotates the light tables every tick, which would change every cached tile.
+	return leveltype != DTYPE_HELL || !*options.colorCycling;
+#endif
+}
+
 /**
  * @brief Renders the floor tiles
  * @param out Output buffer
@@ -1068,7 +1268,7 @@ void DrawDirtTile(const Surface &out, const Lightmap &lightmap, Point tilePositi
 		return;
 	}
 
-	const int lightTableIndex = dLight[sample.x][sample.y];
+	const int lightTableIndex = Snapshot().light[sample.x][sample.y];
 
 	// Let the normal dungeon tile renderer compose the full tile
 	DrawCell(out, lightmap, sample, targetBufferPosition, lightTableIndex);
@@ -1173,13 +1373,21 @@ Displacement tileShift;
 int tileColumns;
 int tileRows;
 
-void CalcFirstTilePosition(Point &position, Displacement &offset)
+/**
+ * @brief Finds the first tile of the view and the offset to render it at
+ * @param position Center of view in dPiece coordinates, returns the first tile
+ * @param offset Returns the amount to offset the rendering in screen space
+ * @param isWalking Whether the local player is walking
+ * @param animInfo Animation of the local player
+ * @param dir Direction of the local player
+ * @param progressToNextGameTick Progress to the next game tick
+ */
+void CalcFirstTilePosition(Point &position, Displacement &offset, bool isWalking, const AnimationInfo &animInfo, Direction dir, uint8_t progressToNextGameTick)
 {
 	// Adjust by player offset and tile grid alignment
-	const Player &myPlayer = *MyPlayer;
 	offset = tileOffset;
-	if (myPlayer.isWalking())
-		offset += GetOffsetForWalking(myPlayer.AnimInfo, myPlayer._pdir, true);
+	if (isWalking)
+		offset += GetOffsetForWalking(animInfo, dir, progressToNextGameTick, true);
 
 	position += tileShift;
 
@@ -1196,8 +1404,8 @@ void CalcFirstTilePosition(Point &position, Displacement &offset)
 	}
 
 	// Draw areas moving in and out of the screen
-	if (myPlayer.isWalking()) {
-		switch (myPlayer._pdir) {
+	if (isWalking) {
+		switch (dir) {
 		case Direction::North:
 		case Direction::NorthEast:
 			offset.deltaY -= TILE_HEIGHT;
@@ -1218,14 +1426,46 @@ void CalcFirstTilePosition(Point &position, Displacement &offset)
 	}
 }
 
+/**
+ * @brief The snapshot the lightmap was last built from.
+ */
+std::optional<std::pair<uint32_t, uint32_t>> LightmapSnapshot;
+
+/**
+ * @brief Light changes not yet seen by the lightmap, see Lightmap::build().
+ */
+Bitset2d<MAXDUNX, MAXDUNY> LightmapChanges;
+
+/**
+ * @brief Returns the light changes between the snapshot the lightmap was last built from and the current one.
+ *
+ * Returns nullptr if snapshots were skipped or the level changed since, in which case the lightmap has to be built from scratch.
+ */
+Bitset2d<MAXDUNX, MAXDUNY> *GetLightmapChanges()
+{
+	const std::pair<uint32_t, uint32_t> snapshot { Snapshot().generation, Snapshot().sequence };
+	Bitset2d<MAXDUNX, MAXDUNY> *changes = nullptr;
+	if (LightmapSnapshot == snapshot) {
+		// Built from this snapshot before, and the build has consumed its changes
+		changes = &LightmapChanges;
+	} else if (LightmapSnapshot && LightmapSnapshot->first == snapshot.first && LightmapSnapshot->second + 1 == snapshot.second) {
+		LightmapChanges = Snapshot().lightChanges;
+		changes = &LightmapChanges;
+	}
+	LightmapSnapshot = snapshot;
+	return changes;
+}
+
 /**
  * @brief Configure render and process screen rows
  * @param fullOut Buffer to render to
- * @param position First tile of view in dPiece coordinate
- * @param offset Amount to offset the rendering in screen space
  */
-void DrawGame(const Surface &fullOut, Point position, Displacement offset)
+void DrawGame(const Surface &fullOut)
 {
+	const Point position = View->firstTile;
+	const Displacement offset = View->offset;
+	const PlayerSnapshot &myPlayer = Snapshot().players[Snapshot().myPlayerId];
+
 	// Limit rendering to the view area
 	const Surface &out = !*GetOptions().Graphics.zoom
 	    ? fullOut.subregionY(0, gnViewportHeight)
@@ -1239,11 +1479,9 @@ void DrawGame(const Surface &fullOut, Point position, Displacement offset)
 		columns -= (*GetOptions().Graphics.zoom) ? 2 : 4;
 	}
 
-	UpdateMissilesRendererData();
-
 	// Draw areas moving in and out of the screen
-	if (MyPlayer->isWalking()) {
-		switch (MyPlayer->_pdir) {
+	if (myPlayer.isWalking) {
+		switch (myPlayer.direction) {
 		case Direction::NoDirection:
 			break;
 		case Direction::North:
@@ -1271,16 +1509,38 @@ void DrawGame(const Surface &fullOut, Point position, Displacement offset)
 	DunRenderStats.clear();
 #endif
 
-	Lightmap lightmap = Lightmap::build(*GetOptions().Graphics.perPixelLighting, position, Point {} + offset,
-	    gnScreenWidth, gnViewportHeight, rows, columns,
-	    out.at(0, 0), out.pitch(), LightTables, FullyLitLightTable, FullyDarkLightTable,
-	    dLight, MicroTileLen);
+	const Lightmap lightmap = [&]() {
+		DVL_PROFILE_SCOPE("BuildLightmap");
+		return Lightmap::build(*GetOptions().Graphics.perPixelLighting, position, Point {} + offset,
+		    gnScreenWidth, gnViewportHeight, rows, columns,
+		    out.at(0, 0), out.pitch(), LightTables, FullyLitLightTable, FullyDarkLightTable,
+		    Snapshot().light, GetLightmapChanges(), MicroTileLen);
+	}();
 
-	DrawFloor(out, lightmap, position, Point {} + offset, rows, columns);
-	DrawTileContent(out, lightmap, position, Point {} + offset, rows, columns);
-	DrawOOB(out, lightmap, position, Point {} + offset, rows, columns);
+	{
+		DVL_PROFILE_SCOPE("DrawFloor");
+		if (ShouldUseFloorCache()) {
+			CachedFloor.draw(out, lightmap, position, Point {} + offset, rows, columns);
+		} else {
+			CachedFloor.invalidate();
+			if (ShouldDrawFloorInBands()) {
+				DrawFloorInBands(out, lightmap, position, Point {} + offset, rows, columns);
+			} else {
+				DrawFloor(out, lightmap, position, Point {} + offset, rows, columns);
+			}
+		}
+	}
+	{
+		DVL_PROFILE_SCOPE("DrawTileContent");
+		DrawTileContent(out, lightmap, position, Point {} + offset, rows, columns);
+	}
+	{
+		DVL_PROFILE_SCOPE("DrawOOB");
+		DrawOOB(out, lightmap, position, Point {} + offset, rows, columns);
+	}
 
 	if (*GetOptions().Graphics.zoom) {
+		DVL_PROFILE_SCOPE("Zoom");
 		Zoom(fullOut.subregionY(0, gnViewportHeight));
 	}
 
@@ -1304,19 +1564,174 @@ void DrawGame(const Surface &fullOut, Point position, Displacement offset)
 }
 
 /**
- * @brief Start rendering of screen, town variation
+ * @brief Gathers what a world render needs besides the snapshot, has to run on the main thread
+ * @param view View to fill in
+ * @param viewPosition Center of view in dPiece coordinates
+ */
+void PrepareWorldView(WorldView &view, Point viewPosition)
+{
+	view.snapshot = GetWorldSnapshot();
+	view.progressToNextGameTick = ProgressToNextGameTick;
+	const WorldSnapshot &snapshot = *view.snapshot;
+
+	const PlayerSnapshot &myPlayer = snapshot.players[snapshot.myPlayerId];
+	view.firstTile = viewPosition;
+	CalcFirstTilePosition(view.firstTile, view.offset, myPlayer.isWalking, myPlayer.animInfo, myPlayer.direction, view.progressToNextGameTick);
+
+	view.monsterUnderCursor = pcursmonst;
+	view.playerUnderCursor = PlayerUnderCursor != nullptr ? PlayerUnderCursor->getId() : -1;
+	view.objectUnderCursor = ObjectUnderCursor != nullptr ? static_cast<int>(ObjectUnderCursor - Objects) : -1;
+	view.itemUnderCursor = pcursitem;
+	view.outlineAllItems = AutoMapShowItems;
+	view.hideItemOutlines = IsPlayerInStore();
+
+	view.missiles.clear();
+	for (size_t i = 0; i < snapshot.missiles.size(); i++) {
+		const MissileRenderPosition position = GetMissileRenderPosition(snapshot.missiles[i], view.progressToNextGameTick);
+		view.missiles.push_back({ position.tile, position.offset, static_cast<uint16_t>(i) });
+	}
+	std::stable_sort(view.missiles.begin(), view.missiles.end(), [](const MissileOnTile &a, const MissileOnTile &b) {
+		return IsRenderedBefore(a.tile, b.tile);
+	});
+
+	// Missile::StopMissile() leaves a missile where it was last drawn
+	if (snapshot.missiles.size() == Missiles.size()) {
+		std::vector<const MissileOnTile *> byIndex(snapshot.missiles.size());
+		for (const MissileOnTile &missile : view.missiles)
+			byIndex[missile.index] = &missile;
+		size_t i = 0;
+		for (Missile &missile : Missiles) {
+			missile.position.tileForRendering = byIndex[i]->tile;
+			missile.position.offsetForRendering = byIndex[i]->offset;
+			i++;
+		}
+	}
+}
+
+/**
+ * @brief Renders the dungeon, can run on any thread as long as the main thread leaves the game state alone
  * @param out Buffer to render to
- * @param startPosition Center of view in dPiece coordinates
+ * @param view View to render
  */
-void DrawView(const Surface &out, Point startPosition)
+void RenderWorld(const Surface &out, WorldView &view)
 {
+	View = &view;
+	view.itemLabels.clear();
 #ifdef _DEBUG
 	DebugCoordsMap.clear();
 #endif
-	Displacement offset = {};
-	CalcFirstTilePosition(startPosition, offset);
-	DrawGame(out, startPosition, offset);
+	DrawGame(out);
+	View = nullptr;
+}
+
+/**
+ * @brief Queues the labels of the items found by a world render that are still where they were drawn
+ */
+void QueueItemLabels(const WorldView &view)
+{
+	for (const auto &[itemIndex, position] : view.itemLabels) {
+		const Item &item = Items[itemIndex];
+		if (InDungeonBounds(item.position) && dItem[item.position.x][item.position.y] == itemIndex + 1)
+			AddItemToLabelQueue(itemIndex, position);
+	}
+}
+
+/**
+ * @brief A world render done on the render thread, for the next frame to show.
+ */
+struct PrerenderedWorld {
+	std::optional<OwnedSurface> surface;
+	WorldView view;
+	bool ready = false;
+};
+
+PrerenderedWorld Prerendered;
+
+/**
+ * @brief The view shown by the last frame.
+ */
+WorldView CurrentView;
+
+JobThread &GetRenderThread()
+{
+	static JobThread renderThread;
+	return renderThread;
+}
+
+[[nodiscard]] bool ShouldUseRenderThread()
+{
+#ifdef DUN_RENDER_STATS
+	// DunRenderStats is not thread-safe
+	return false;
+#else
+#ifdef _DEBUG
+	// The walk path is drawn with the text renderer, which the main thread uses at the same time
+	if (DebugPath)
+		return false;
+#endif
+	return *GetOptions().Graphics.renderThread && GetRenderThread().isThreaded();
+#endif
+}
+
+/**
+ * @brief Shows the world render done on the render thread, or renders the world if there is none to show
+ * @param out Buffer to render to
+ * @param viewPosition Center of view in dPiece coordinates
+ * @return The view that is shown
+ */
+const WorldView &DrawWorld(const Surface &out, Point viewPosition)
+{
+	if (Prerendered.ready) {
+		Prerendered.ready = false;
+		const Surface &prerendered = *Prerendered.surface;
+		const bool usable = Prerendered.view.snapshot->generation == GetWorldSnapshot()->generation
+		    && prerendered.w() == out.w() && prerendered.h() == gnViewportHeight;
+		if (usable) {
+			out.BlitFrom(prerendered, MakeSdlRect(0, 0, prerendered.w(), prerendered.h()), { 0, 0 });
+			QueueItemLabels(Prerendered.view);
+			std::swap(CurrentView, Prerendered.view);
+		}
+		// Let go of the older snapshot, so that the next capture can reuse it
+		Prerendered.view.snapshot = nullptr;
+		if (usable)
+			return CurrentView;
+	}
+
+	PrepareWorldView(CurrentView, viewPosition);
+	RenderWorld(out, CurrentView);
+	QueueItemLabels(CurrentView);
+	return CurrentView;
+}
+
+/**
+ * @brief Starts rendering the world for the next frame on the render thread, if enabled
+ * @param viewPosition Center of view in dPiece coordinates
+ */
+void PrerenderWorld(Point viewPosition)
+{
+	if (!ShouldUseRenderThread())
+		return;
+
+	PrepareWorldView(Prerendered.view, viewPosition);
+	if (!Prerendered.surface || Prerendered.surface->w() != gnScreenWidth || Prerendered.surface->h() != gnViewportHeight)
+		Prerendered.surface.emplace(gnScreenWidth, gnViewportHeight);
+	GetRenderThread().start([]() {
+		RenderWorld(*Prerendered.surface, Prerendered.view);
+		Prerendered.ready = true;
+	});
+}
+
+/**
+ * @brief Start rendering of screen, town variation
+ * @param out Buffer to render to
+ * @param startPosition Center of view in dPiece coordinates
+ */
+void DrawView(const Surface &out, Point startPosition)
+{
+	DVL_PROFILE_SCOPE("DrawView");
+	const WorldView &view = DrawWorld(out, startPosition);
 	if (AutomapActive) {
+		DVL_PROFILE_SCOPE("DrawAutomap");
 		DrawAutomap(out.subregionY(0, gnViewportHeight));
 	}
 #ifdef _DEBUG
@@ -1389,7 +1804,7 @@ void DrawView(const Surface &out, Point startPosition)
 #endif
 	DrawItemNameLabels(out);
 	DrawMonsterHealthBar(out);
-	DrawFloatingNumbers(out, startPosition, offset);
+	DrawFloatingNumbers(out, view.firstTile, view.offset);
 
 	if (IsPlayerInStore() && !qtextflag)
 		DrawSText(out);
@@ -1515,6 +1930,7 @@ void DrawMain(int dwHgt, bool drawDesc, bool drawHp, bool drawMana, bool drawSba
 	if (!gbActive || RenderDirectlyToOutputSurface) {
 		return;
 	}
+	DVL_PROFILE_SCOPE("DrawMain");
 
 	assert(dwHgt >= 0 && dwHgt <= gnScreenHeight);
 
@@ -1571,13 +1987,18 @@ const auto OptionChangeHandlerShowFPS = (GetOptions().Graphics.showFPS.SetValueC
 } // namespace
 
 Displacement GetOffsetForWalking(const AnimationInfo &animationInfo, const Direction dir, bool cameraMode /*= false*/)
+{
+	return GetOffsetForWalking(animationInfo, dir, ProgressToNextGameTick, cameraMode);
+}
+
+Displacement GetOffsetForWalking(const AnimationInfo &animationInfo, const Direction dir, uint8_t progressToNextGameTick, bool cameraMode /*= false*/)
 {
 	// clang-format off
 	//                                           South,        SouthWest,    West,         NorthWest,    North,        NorthEast,     East,         SouthEast,
 	constexpr Displacement MovingOffset[8]   = { {   0,  32 }, { -32,  16 }, { -64,   0 }, { -32, -16 }, {   0, -32 }, {  32, -16 },  {  64,   0 }, {  32,  16 } };
 	// clang-format on
 
-	const uint8_t animationProgress = animationInfo.getAnimationProgress();
+	const uint8_t animationProgress = animationInfo.getAnimationProgress(progressToNextGameTick);
 	Displacement offset = MovingOffset[static_cast<size_t>(dir)];
 	offset *= animationProgress;
 	offset /= AnimationInfo::baseValueFraction;
@@ -1721,7 +2142,8 @@ Point GetScreenPosition(Point tile)
 {
 	Point firstTile = ViewPosition;
 	Displacement offset = {};
-	CalcFirstTilePosition(firstTile, offset);
+	const Player &myPlayer = *MyPlayer;
+	CalcFirstTilePosition(firstTile, offset, myPlayer.isWalking(), myPlayer.AnimInfo, myPlayer._pdir, ProgressToNextGameTick);
 
 	const Displacement delta = firstTile - tile;
 
@@ -1733,6 +2155,11 @@ Point GetScreenPosition(Point tile)
 
 extern SDL_Surface *PalSurface;
 
+void InvalidateFloorCache()
+{
+	CachedFloor.invalidate();
+}
+
 void ClearScreenBuffer()
 {
 	if (HeadlessMode)
@@ -1834,6 +2261,7 @@ void DrawAndBlit()
 	if (!gbRunGame || HeadlessMode) {
 		return;
 	}
+	DVL_PROFILE_SCOPE("DrawAndBlit");
 
 	int hgt = 0;
 	bool drawHealth = IsRedrawComponent(PanelDrawComponent::Health);
@@ -1911,6 +2339,9 @@ void DrawAndBlit()
 	DrawConsole(out);
 #endif
 
+	// Renders the next frame's dungeon while this one is presented
+	PrerenderWorld(ViewPosition);
+
 	RedrawComplete();
 	for (const PanelDrawComponent component : enum_values<PanelDrawComponent>()) {
 		if (IsRedrawComponent(component)) {
@@ -1919,6 +2350,8 @@ void DrawAndBlit()
 	}
 
 	RenderPresent();
+
+	GetRenderThread().wait();
 }
 
 } // namespace devilution
@@ -5,6 +5,8 @@
  */
 #pragma once
 
+#include <cstdint>
+
 #include "engine/animationinfo.h"
 #include "engine/direction.hpp"
 #include "engine/displacement.hpp"
@@ -24,6 +26,15 @@ extern bool frameflag;
  */
 Displacement GetOffsetForWalking(const AnimationInfo &animationInfo, Direction dir, bool cameraMode = false);
 
+/**
+ * @brief Returns the offset for the walking animation when the given fraction of the next game tick has passed
+ * @param animationInfo the current active walking animation
+ * @param dir walking direction
+ * @param progressToNextGameTick Progress to the next game tick (see AnimationInfo::baseValueFraction)
+ * @param cameraMode Adjusts the offset relative to the camera
+ */
+Displacement GetOffsetForWalking(const AnimationInfo &animationInfo, Direction dir, uint8_t progressToNextGameTick, bool cameraMode = false);
+
 /**
  * @brief Clear cursor state
  */
@@ -63,6 +74,13 @@ void CalcViewportGeometry();
  */
 Point GetScreenPosition(Point tile);
 
+/**
+ * @brief Discards the cached floor layer.
+ *
+ * Must be called whenever the dungeon graphics or the light tables change.
+ */
+void InvalidateFloorCache();
+
 /**
  * @brief Render the whole screen black
  */
@@ -0,0 +1,508 @@
+#include "engine/render/world_snapshot.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <span>
+
+#include "engine/render/scrollrt.h"
+#include "lighting.h"
+#include "missiles.h"
+#include "tables/misdat.h"
+#include "towners.h"
+
+namespace devilution {
+
+namespace {
+
+std::shared_ptr<WorldSnapshot> LatestSnapshot;
+/** @brief The snapshot before the latest one, recycled by the next capture once the renderer lets go of it. */
+std::shared_ptr<WorldSnapshot> SpareSnapshot;
+uint32_t SnapshotSequence;
+uint32_t SnapshotGeneration;
+bool SnapshotStale;
+
+/**
+ * @brief Finds the list of a sprite list or sheet that starts at the given data.
+ * @return The list's index, or -1 if it is not part of `sprites`.
+ */
+int FindList(OptionalClxSpriteListOrSheet sprites, const uint8_t *data)
+{
+	if (!sprites)
+		return -1;
+	if (!sprites->isSheet())
+		return sprites->list().data() == data ? 0 : -1;
+	const ClxSpriteSheet sheet = sprites->sheet();
+	for (uint16_t i = 0; i < sheet.numLists(); i++) {
+		if (sheet[i].data() == data)
+			return i;
+	}
+	return -1;
+}
+
+OptionalClxSpriteListOrSheet Unowned(const OptionalOwnedClxSpriteListOrSheet &sprites)
+{
+	if (!sprites)
+		return std::nullopt;
+	return ClxSpriteListOrSheet { *sprites };
+}
+
+SpriteListRef FindMonsterSprites(size_t levelType, OptionalClxSpriteList sprites)
+{
+	if (!sprites || levelType >= LevelMonsterTypeCount)
+		return {};
+	const CMonster &monsterType = LevelMonsterTypes[levelType];
+	for (size_t graphic = 0; graphic < std::size(monsterType.anims); graphic++) {
+		const int list = FindList(monsterType.anims[graphic].sprites, sprites->data());
+		if (list >= 0) {
+			return {
+				.source = SpriteListRef::Source::Monster,
+				.graphic = static_cast<uint8_t>(graphic),
+				.list = static_cast<uint8_t>(list),
+				.index = static_cast<uint16_t>(levelType),
+			};
+		}
+	}
+	return {};
+}
+
+SpriteListRef FindMissileSprites(const Missile &missile)
+{
+	if (!missile._miAnimData || missile._miAnimType == MissileGraphicID::None)
+		return {};
+	const int list = FindList(Unowned(GetMissileSpriteData(missile._miAnimType).sprites), missile._miAnimData->data());
+	if (list >= 0) {
+		return {
+			.source = SpriteListRef::Source::Missile,
+			.list = static_cast<uint8_t>(list),
+			.index = static_cast<uint16_t>(missile._miAnimType),
+		};
+	}
+	// Charging monsters are drawn as a missile with the monster's own graphics
+	if (missile._misource >= 0 && static_cast<size_t>(missile._misource) < MaxMonsters)
+		return FindMonsterSprites(Monsters[missile._misource].levelType, missile._miAnimData);
+	return {};
+}
+
+SpriteListRef FindSpritesIn(std::span<const OptionalOwnedClxSpriteList> lists, SpriteListRef::Source source, OptionalClxSpriteList sprites)
+{
+	if (!sprites)
+		return {};
+	for (size_t i = 0; i < lists.size(); i++) {
+		if (lists[i] && ClxSpriteList { *lists[i] }.data() == sprites->data())
+			return { .source = source, .index = static_cast<uint16_t>(i) };
+	}
+	return {};
+}
+
+PlayerSpriteRef FindPlayerSprites(const Player &player, const uint8_t *data)
+{
+	for (const PlayerAnimationData &animationData : player.AnimationData) {
+		if (animationData.sprites == nullptr)
+			continue;
+		const OwnedClxSpriteSheet &sheet = *animationData.sprites;
+		const uint16_t numLists = ClxSpriteSheet { sheet }.numLists();
+		for (uint16_t i = 0; i < numLists; i++) {
+			if (sheet[i].data() == data)
+				return { animationData.sprites, static_cast<uint8_t>(i) };
+		}
+	}
+	return {};
+}
+
+PlayerSpriteRef FindPlayerPreview(const Player &player)
+{
+	if (!player.previewCelSprite)
+		return {};
+	for (const PlayerAnimationData &animationData : player.AnimationData) {
+		if (animationData.sprites == nullptr)
+			continue;
+		const OwnedClxSpriteSheet &sheet = *animationData.sprites;
+		const uint16_t numLists = ClxSpriteSheet { sheet }.numLists();
+		for (uint16_t i = 0; i < numLists; i++) {
+			if (sheet[i][0] == *player.previewCelSprite)
+				return { animationData.sprites, static_cast<uint8_t>(i) };
+		}
+	}
+	return {};
+}
+
+AnimationInfo WithoutSprites(AnimationInfo animInfo)
+{
+	animInfo.sprites = std::nullopt;
+	return animInfo;
+}
+
+/**
+ * @brief Could the missile (at the next game tick) collide? This method is a simplified version of CheckMissileCol (for example without random).
+ */
+bool CouldMissileCollide(Point tile, bool checkPlayerAndMonster)
+{
+	if (!InDungeonBounds(tile))
+		return true;
+	if (checkPlayerAndMonster) {
+		if (dMonster[tile.x][tile.y] > 0)
+			return true;
+		if (dPlayer[tile.x][tile.y] > 0)
+			return true;
+	}
+
+	return IsMissileBlockedByTile(tile);
+}
+
+MissileRenderPosition GetMissilePositionForRendering(const MissileSnapshot &missile, int progress)
+{
+	DisplacementOf<int64_t> velocity = missile.velocity;
+	velocity *= progress;
+	velocity /= AnimationInfo::baseValueFraction;
+	const Displacement pixelsTravelled = (missile.traveled + Displacement { static_cast<int>(velocity.deltaX), static_cast<int>(velocity.deltaY) }) >> 16;
+	const Displacement tileOffset = pixelsTravelled.screenToMissile();
+
+	// calculate the future missile position
+	return { missile.start + tileOffset, pixelsTravelled + tileOffset.worldToScreen() };
+}
+
+void CaptureMissiles(WorldSnapshot &snapshot)
+{
+	snapshot.missiles.clear();
+	for (const Missile &missile : Missiles) {
+		const MissileMovementDistribution missileMovement = GetMissileData(missile._mitype).movementDistribution;
+		MissileSnapshot &entry = snapshot.missiles.emplace_back(MissileSnapshot {
+		    .sprites = FindMissileSprites(missile),
+		    .frame = static_cast<int16_t>(missile._miAnimFrame - 1),
+		    .uniqueTrn = -1,
+		    .animWidth2 = missile._miAnimWidth2,
+		    .isDrawn = missile._miDrawFlag,
+		    .isPre = missile._miPreFlag,
+		    .isLit = missile._miLightFlag,
+		    // don't calculate missile position if they don't move
+		    .moves = missileMovement != MissileMovementDistribution::Disabled && missile.position.velocity != Displacement {},
+		    .tile = missile.position.tile,
+		    .start = missile.position.start,
+		    .offset = missile.position.offset,
+		    .traveled = missile.position.traveled,
+		    .velocity = missile.position.velocity,
+		    .collisionMask = 0,
+		});
+		if (missile._miUniqTrans != 0 && missile._misource >= 0 && static_cast<size_t>(missile._misource) < MaxMonsters)
+			entry.uniqueTrn = snapshot.uniqueTrnIndex[missile._misource];
+		if (!entry.moves)
+			continue;
+		for (int dy = -2; dy <= 2; dy++) {
+			for (int dx = -2; dx <= 2; dx++) {
+				const Point tile { missile.position.tile.x + dx, missile.position.tile.y + dy };
+				if (CouldMissileCollide(tile, missileMovement == MissileMovementDistribution::Blockable))
+					entry.collisionMask |= 1U << ((dy + 2) * 5 + (dx + 2));
+			}
+		}
+	}
+}
+
+void CaptureUniqueTrns(WorldSnapshot &snapshot)
+{
+	snapshot.uniqueTrns.clear();
+	snapshot.uniqueTrnIndex.fill(-1);
+	for (size_t i = 0; i < MaxMonsters; i++) {
+		const uint8_t *trn = Monsters[i].uniqueMonsterTRN.get();
+		if (trn == nullptr || snapshot.uniqueTrns.size() > std::numeric_limits<int8_t>::max())
+			continue;
+		snapshot.uniqueTrnIndex[i] = static_cast<int8_t>(snapshot.uniqueTrns.size());
+		std::memcpy(snapshot.uniqueTrns.emplace_back().data(), trn, 256);
+	}
+}
+
+void CaptureMonsters(WorldSnapshot &snapshot)
+{
+	for (size_t i = 0; i < ActiveMonsterCount; i++) {
+		const unsigned monsterId = ActiveMonsters[i];
+		const Monster &monster = Monsters[monsterId];
+		snapshot.monsters[monsterId] = MonsterSnapshot {
+			.animInfo = WithoutSprites(monster.animInfo),
+			.sprites = FindMonsterSprites(monster.levelType, monster.animInfo.sprites),
+			.uniqueTrn = monster.isUnique() ? snapshot.uniqueTrnIndex[monsterId] : static_cast<int8_t>(-1),
+			.mode = monster.mode,
+			.direction = monster.direction,
+			.isWalking = monster.isWalking(),
+			.isHidden = (monster.flags & MFLAG_HIDDEN) != 0,
+		};
+	}
+
+	snapshot.towners.clear();
+	if (leveltype != DTYPE_TOWN)
+		return;
+	for (size_t i = 0; i < Towners.size(); i++) {
+		const Towner &towner = Towners[i];
+		snapshot.towners.push_back(TownerSnapshot {
+		    .sprites = towner.anim ? SpriteListRef { .source = SpriteListRef::Source::Towner, .index = static_cast<uint16_t>(i) } : SpriteListRef {},
+		    .frame = towner._tAnimFrame,
+		    .animWidth = towner._tAnimWidth,
+		});
+	}
+}
+
+void CapturePlayers(WorldSnapshot &snapshot)
+{
+	for (size_t i = 0; i < MAX_PLRS; i++) {
+		PlayerSnapshot &entry = snapshot.players[i];
+		if (i >= Players.size()) {
+			entry = {};
+			continue;
+		}
+		const Player &player = Players[i];
+		entry = PlayerSnapshot {
+			.animInfo = WithoutSprites(player.AnimInfo),
+			.sprites = player.AnimInfo.sprites ? FindPlayerSprites(player, player.AnimInfo.sprites->data()) : PlayerSpriteRef {},
+			.preview = FindPlayerPreview(player),
+			.tile = player.position.tile,
+			.mode = player._pmode,
+			.direction = player._pdir,
+			.isActive = player.plractive && player.isOnActiveLevel(),
+			.isWalking = player.isWalking(),
+			.isDead = player.hasNoLife(),
+			.hasManaShield = player.pManaShield,
+			.hasReflections = player.wReflections > 0,
+		};
+	}
+}
+
+void CaptureItems(WorldSnapshot &snapshot)
+{
+	const std::span<const OptionalOwnedClxSpriteList> itemAnimations = GetItemAnimations();
+	for (uint8_t i = 0; i < ActiveItemCount; i++) {
+		const int itemIndex = ActiveItems[i];
+		const Item &item = Items[itemIndex];
+		snapshot.items[itemIndex] = ItemSnapshot {
+			.animInfo = WithoutSprites(item.AnimInfo),
+			.sprites = FindSpritesIn(itemAnimations, SpriteListRef::Source::Item, item.AnimInfo.sprites),
+			.outlineColor = GetOutlineColor(item, false),
+			.isPostDraw = item._iPostDraw,
+			.isMagicRock = item._iCurs == ICURS_MAGIC_ROCK,
+		};
+	}
+}
+
+void CaptureObjects(WorldSnapshot &snapshot)
+{
+	const std::span<const OptionalOwnedClxSpriteList> objectSprites = GetObjectSprites();
+	for (int i = 0; i < ActiveObjectCount; i++) {
+		const int objectIndex = ActiveObjects[i];
+		const Object &object = Objects[objectIndex];
+		snapshot.objects[objectIndex] = ObjectSnapshot {
+			.sprites = FindSpritesIn(objectSprites, SpriteListRef::Source::Object, object._oAnimData),
+			.frame = static_cast<int16_t>(object._oAnimFrame - 1),
+			.position = object.position,
+			.isPre = object._oPreFlag,
+			.applyLighting = object.applyLighting,
+		};
+	}
+}
+
+/**
+ * @brief Dead players are marked on the tile they died on, but the marker is only cleared lazily.
+ */
+void UpdateDeadPlayerFlags()
+{
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			if (!HasAnyOf(dFlags[x][y], DungeonFlag::DeadPlayer))
+				continue;
+			const Point tile { x, y };
+			const bool hasDeadPlayer = std::any_of(Players.begin(), Players.end(), [&tile](const Player &player) {
+				return player.plractive && player.hasNoLife() && player.isOnActiveLevel() && player.position.tile == tile;
+			});
+			if (!hasDeadPlayer)
+				dFlags[x][y] &= ~DungeonFlag::DeadPlayer;
+		}
+	}
+}
+
+} // namespace
+
+OptionalClxSpriteList SpriteListRef::resolve() const
+{
+	const auto fromListOrSheet = [this](OptionalClxSpriteListOrSheet sprites) -> OptionalClxSpriteList {
+		if (!sprites)
+			return std::nullopt;
+		if (!sprites->isSheet())
+			return sprites->list();
+		if (list >= sprites->sheet().numLists())
+			return std::nullopt;
+		return sprites->sheet()[list];
+	};
+
+	switch (source) {
+	case Source::None:
+		return std::nullopt;
+	case Source::Missile:
+		return fromListOrSheet(Unowned(GetMissileSpriteData(static_cast<MissileGraphicID>(index)).sprites));
+	case Source::Monster:
+		if (index >= LevelMonsterTypeCount || graphic >= std::size(LevelMonsterTypes[index].anims))
+			return std::nullopt;
+		return fromListOrSheet(LevelMonsterTypes[index].anims[graphic].sprites);
+	case Source::Object: {
+		const std::span<const OptionalOwnedClxSpriteList> objectSprites = GetObjectSprites();
+		if (index >= objectSprites.size() || !objectSprites[index])
+			return std::nullopt;
+		return ClxSpriteList { *objectSprites[index] };
+	}
+	case Source::Item: {
+		const std::span<const OptionalOwnedClxSpriteList> itemAnimations = GetItemAnimations();
+		if (index >= itemAnimations.size() || !itemAnimations[index])
+			return std::nullopt;
+		return ClxSpriteList { *itemAnimations[index] };
+	}
+	case Source::Towner:
+		if (index >= Towners.size())
+			return std::nullopt;
+		return Towners[index].anim;
+	}
+	return std::nullopt;
+}
+
+OptionalClxSprite SpriteListRef::frame(int frame) const
+{
+	const OptionalClxSpriteList sprites = resolve();
+	if (!sprites || frame < 0 || static_cast<uint32_t>(frame) >= sprites->numSprites())
+		return std::nullopt;
+	return (*sprites)[frame];
+}
+
+OptionalClxSprite PlayerSpriteRef::frame(int frame) const
+{
+	if (sheet == nullptr || list >= ClxSpriteSheet { *sheet }.numLists())
+		return std::nullopt;
+	const ClxSpriteList sprites = (*sheet)[list];
+	if (frame < 0 || static_cast<uint32_t>(frame) >= sprites.numSprites())
+		return std::nullopt;
+	return sprites[frame];
+}
+
+Displacement MonsterSnapshot::getRenderingOffset(ClxSprite sprite, uint8_t progressToNextGameTick) const
+{
+	Displacement offset = { -CalculateSpriteTileCenterX(sprite.width()), 0 };
+	if (isWalking)
+		offset += GetOffsetForWalking(animInfo, direction, progressToNextGameTick);
+	return offset;
+}
+
+Displacement PlayerSnapshot::getRenderingOffset(ClxSprite sprite, uint8_t progressToNextGameTick) const
+{
+	Displacement offset = { -CalculateSpriteTileCenterX(sprite.width()), 0 };
+	if (isWalking)
+		offset += GetOffsetForWalking(animInfo, direction, progressToNextGameTick);
+	return offset;
+}
+
+bool MissileSnapshot::couldCollideAt(WorldTilePosition position) const
+{
+	const int dx = position.x - tile.x;
+	const int dy = position.y - tile.y;
+	if (std::abs(dx) > 2 || std::abs(dy) > 2)
+		return true;
+	return (collisionMask & (1U << ((dy + 2) * 5 + (dx + 2)))) != 0;
+}
+
+void CaptureWorldSnapshot(WorldSnapshot &snapshot)
+{
+	const Player &myPlayer = *MyPlayer;
+
+	snapshot.myPlayerId = myPlayer.getId();
+	snapshot.hasInfravision = myPlayer._pInfraFlag;
+	snapshot.isOnArenaLevel = myPlayer.isOnArenaLevel();
+	snapshot.missilePreFlag = MissilePreFlag;
+
+	UpdateDeadPlayerFlags();
+
+	std::memcpy(snapshot.light, dLight, sizeof(dLight));
+	std::memcpy(snapshot.flags, dFlags, sizeof(dFlags));
+	std::memcpy(snapshot.monsterIds, dMonster, sizeof(dMonster));
+	std::memcpy(snapshot.playerIds, dPlayer, sizeof(dPlayer));
+	std::memcpy(snapshot.itemIds, dItem, sizeof(dItem));
+	std::memcpy(snapshot.objectIds, dObject, sizeof(dObject));
+	std::memcpy(snapshot.corpseIds, dCorpse, sizeof(dCorpse));
+	snapshot.transparency = TransList;
+	snapshot.lightChanges = DirtyLightTiles;
+	DirtyLightTiles.reset();
+
+	CaptureUniqueTrns(snapshot);
+	CaptureMonsters(snapshot);
+	CapturePlayers(snapshot);
+	CaptureItems(snapshot);
+	CaptureObjects(snapshot);
+	CaptureMissiles(snapshot);
+}
+
+MissileRenderPosition GetMissileRenderPosition(const MissileSnapshot &missile, uint8_t progressToNextGameTick)
+{
+	if (!missile.moves)
+		return { missile.tile, missile.offset };
+
+	int progress = progressToNextGameTick;
+	MissileRenderPosition position = GetMissilePositionForRendering(missile, progress);
+
+	// In some cases this calculated position is invalid.
+	// For example a missile shouldn't move inside a wall.
+	// In this case the game logic don't advance the missile position and removes the missile or shows an explosion animation at the old position.
+	// For the animation distribution logic this means we are not allowed to move to a tile where the missile could collide, because this could be a invalid position.
+
+	// If we are still at the current tile, this tile was already checked and is a valid tile
+	if (position.tile == missile.tile)
+		return position;
+
+	// If no collision can happen at the new tile we can advance
+	if (!missile.couldCollideAt(position.tile))
+		return position;
+
+	// The new tile could be invalid, so don't advance to it.
+	// We search the last offset that is in the old (valid) tile.
+	// Implementation note: If someone knows the correct math to calculate this without the loop, I would really appreciate it.
+	while (missile.tile != position.tile) {
+		progress -= 1;
+
+		if (progress <= 0)
+			return { missile.tile, missile.offset };
+
+		position = GetMissilePositionForRendering(missile, progress);
+	}
+	return position;
+}
+
+void PublishWorldSnapshot()
+{
+	std::shared_ptr<WorldSnapshot> snapshot;
+	if (SpareSnapshot != nullptr && SpareSnapshot.use_count() == 1)
+		snapshot = std::move(SpareSnapshot);
+	else
+		snapshot = std::make_shared<WorldSnapshot>();
+
+	CaptureWorldSnapshot(*snapshot);
+	snapshot->sequence = ++SnapshotSequence;
+	snapshot->generation = SnapshotGeneration;
+
+	SpareSnapshot = std::move(LatestSnapshot);
+	LatestSnapshot = std::move(snapshot);
+	SnapshotStale = false;
+}
+
+std::shared_ptr<const WorldSnapshot> GetWorldSnapshot()
+{
+	if (LatestSnapshot == nullptr || SnapshotStale)
+		PublishWorldSnapshot();
+	return LatestSnapshot;
+}
+
+void MarkWorldSnapshotStale()
+{
+	SnapshotStale = true;
+}
+
+void DiscardWorldSnapshots()
+{
+	SnapshotGeneration++;
+	LatestSnapshot = nullptr;
+	SpareSnapshot = nullptr;
+	SnapshotStale = false;
+}
+
+} // namespace devilution
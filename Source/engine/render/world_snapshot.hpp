@@ -0,0 +1,326 @@
+/**
+ * @file world_snapshot.hpp
+ *
+ * Copy of the game state that the dungeon view is rendered from.
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "engine/animationinfo.h"
+#include "engine/clx_sprite.hpp"
+#include "engine/direction.hpp"
+#include "engine/displacement.hpp"
+#include "engine/point.hpp"
+#include "engine/world_tile.hpp"
+#include "items.h"
+#include "levels/gendung.h"
+#include "monster.h"
+#include "multi.h"
+#include "objects.h"
+#include "player.h"
+#include "utils/attributes.h"
+#include "utils/bitset2d.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Names a sprite list by the resource table it was loaded into, rather than by its address.
+ *
+ * The renderer looks the list up again when it draws, so a snapshot never points into sprite data.
+ */
+struct SpriteListRef {
+	enum class Source : uint8_t {
+		None,
+		/** @brief `index` is a MissileGraphicID, `list` a Direction16. */
+		Missile,
+		/** @brief `index` is a level monster type, `graphic` a MonsterGraphic, `list` a Direction. */
+		Monster,
+		/** @brief `index` is the slot in GetObjectSprites(). */
+		Object,
+		/** @brief `index` is the slot in GetItemAnimations(). */
+		Item,
+		/** @brief `index` is the towner's index. */
+		Towner,
+	};
+
+	Source source = Source::None;
+	uint8_t graphic = 0;
+	uint8_t list = 0;
+	uint16_t index = 0;
+
+	[[nodiscard]] OptionalClxSpriteList resolve() const;
+
+	/**
+	 * @brief Returns the given frame, or nothing if the list is gone or is shorter than it was.
+	 */
+	[[nodiscard]] OptionalClxSprite frame(int frame) const;
+};
+
+/**
+ * @brief A direction of a player's sprite sheet, which stays alive while the snapshot refers to it.
+ *
+ * Player graphics are reloaded whenever the equipment changes, so they can't be looked up again later.
+ */
+struct PlayerSpriteRef {
+	std::shared_ptr<const OwnedClxSpriteSheet> sheet;
+	uint8_t list = 0;
+
+	[[nodiscard]] OptionalClxSprite frame(int frame) const;
+};
+
+struct MonsterSnapshot {
+	/** @brief A copy of the monster's animation state, without its sprites. */
+	AnimationInfo animInfo;
+	SpriteListRef sprites;
+	/** @brief Translation of unique monsters, see WorldSnapshot::uniqueTrn(). */
+	int8_t uniqueTrn;
+	MonsterMode mode;
+	Direction direction;
+	bool isWalking;
+	bool isHidden;
+
+	[[nodiscard]] OptionalClxSprite currentSprite(uint8_t progressToNextGameTick) const
+	{
+		return sprites.frame(animInfo.getFrameToUseForRendering(progressToNextGameTick));
+	}
+
+	[[nodiscard]] Displacement getRenderingOffset(ClxSprite sprite, uint8_t progressToNextGameTick) const;
+};
+
+struct TownerSnapshot {
+	SpriteListRef sprites;
+	uint8_t frame;
+	uint16_t animWidth;
+
+	[[nodiscard]] Displacement getRenderingOffset() const
+	{
+		return { -CalculateSpriteTileCenterX(animWidth), 0 };
+	}
+};
+
+struct PlayerSnapshot {
+	/** @brief A copy of the player's animation state, without its sprites. */
+	AnimationInfo animInfo;
+	PlayerSpriteRef sprites;
+	/** @brief Shown instead of the animation while a command is pending, see Player::previewCelSprite. */
+	PlayerSpriteRef preview;
+	Point tile;
+	PLR_MODE mode;
+	Direction direction;
+	/** @brief Whether the player is in the game and on the level being shown. */
+	bool isActive;
+	bool isWalking;
+	bool isDead;
+	bool hasManaShield;
+	bool hasReflections;
+
+	[[nodiscard]] OptionalClxSprite currentSprite(uint8_t progressToNextGameTick) const
+	{
+		if (preview.sheet != nullptr)
+			return preview.frame(0);
+		return sprites.frame(animInfo.getFrameToUseForRendering(progressToNextGameTick));
+	}
+
+	[[nodiscard]] Displacement getRenderingOffset(ClxSprite sprite, uint8_t progressToNextGameTick) const;
+};
+
+struct MissileSnapshot {
+	SpriteListRef sprites;
+	/** @brief The frame to draw, 0-based. */
+	int16_t frame;
+	/** @brief Translation of the unique monster that cast the missile, see WorldSnapshot::uniqueTrn(). */
+	int8_t uniqueTrn;
+	int16_t animWidth2;
+	bool isDrawn;
+	bool isPre;
+	bool isLit;
+
+	/** @brief Whether the missile moves between ticks, and so is drawn ahead of its tile. */
+	bool moves;
+	WorldTilePosition tile;
+	WorldTilePosition start;
+	Displacement offset;
+	Displacement traveled;
+	Displacement velocity;
+	/**
+	 * @brief The tiles around `tile` the missile could collide with by the next tick.
+	 *
+	 * Bit `(dy + 2) * 5 + (dx + 2)` stands for the tile at `tile + { dx, dy }`.
+	 */
+	uint32_t collisionMask;
+
+	/**
+	 * @brief Could the missile collide at the given tile by the next tick?
+	 *
+	 * Tiles out of reach of the mask are assumed to block it.
+	 */
+	[[nodiscard]] bool couldCollideAt(WorldTilePosition position) const;
+};
+
+struct ItemSnapshot {
+	/** @brief A copy of the item's animation state, without its sprites. */
+	AnimationInfo animInfo;
+	SpriteListRef sprites;
+	uint8_t outlineColor;
+	bool isPostDraw;
+	bool isMagicRock;
+
+	[[nodiscard]] OptionalClxSprite currentSprite(uint8_t progressToNextGameTick) const
+	{
+		return sprites.frame(animInfo.getFrameToUseForRendering(progressToNextGameTick));
+	}
+
+	[[nodiscard]] Displacement getRenderingOffset(ClxSprite sprite) const
+	{
+		return { -CalculateSpriteTileCenterX(sprite.width()), 0 };
+	}
+};
+
+struct ObjectSnapshot {
+	SpriteListRef sprites;
+	/** @brief The frame to draw, 0-based. */
+	int16_t frame;
+	Point position;
+	bool isPre;
+	bool applyLighting;
+
+	[[nodiscard]] Displacement getRenderingOffset(ClxSprite sprite, Point tilePosition) const
+	{
+		Displacement offset = Displacement { -CalculateSpriteTileCenterX(sprite.width()), 0 };
+		if (position != tilePosition) {
+			// drawing a large or offset object, calculate the correct position for the center of the sprite
+			Displacement worldOffset = position - tilePosition;
+			offset -= worldOffset.worldToScreen();
+		}
+		return offset;
+	}
+};
+
+/**
+ * @brief Everything the dungeon view reads from the simulation, captured once per game tick.
+ *
+ * The tile grids use the same indices as the game's own grids (`dMonster`, `dPlayer`, ...),
+ * and those indices address the entity arrays of the snapshot, so the renderer never has to
+ * look at `Monsters`, `Players`, `Missiles`, `Items` or `Objects`.
+ * Entity entries are only meaningful where a tile grid refers to them.
+ *
+ * Nothing in a snapshot points into game state or sprite data, see SpriteListRef.
+ * The level geometry (`dPiece`, `dSpecial`, ...) and corpses only change while a level
+ * is loaded, so the renderer keeps reading those directly.
+ */
+struct WorldSnapshot {
+	/** @brief Counts up with every capture, so that the renderer can tell which changes it has seen. */
+	uint32_t sequence;
+	/** @brief Changes whenever the level is loaded or left, see DiscardWorldSnapshots(). */
+	uint32_t generation;
+
+	uint8_t myPlayerId;
+	/** @brief Whether the local player can see monsters and players in the dark. */
+	bool hasInfravision;
+	bool isOnArenaLevel;
+	/** @brief See MissilePreFlag. */
+	bool missilePreFlag;
+
+	uint8_t light[MAXDUNX][MAXDUNY];
+	DungeonFlag flags[MAXDUNX][MAXDUNY];
+	int16_t monsterIds[MAXDUNX][MAXDUNY];
+	int8_t playerIds[MAXDUNX][MAXDUNY];
+	int8_t itemIds[MAXDUNX][MAXDUNY];
+	int8_t objectIds[MAXDUNX][MAXDUNY];
+	int8_t corpseIds[MAXDUNX][MAXDUNY];
+	/** @brief See TransList. */
+	std::array<bool, 256> transparency;
+	/** @brief Tiles whose light level changed since the previous capture, see DirtyLightTiles. */
+	Bitset2d<MAXDUNX, MAXDUNY> lightChanges;
+
+	/** @brief Copies of the unique monster translations, see uniqueTrn(). */
+	std::vector<std::array<uint8_t, 256>> uniqueTrns;
+	/** @brief Index into `uniqueTrns` by monster id, -1 for monsters without a translation. */
+	std::array<int8_t, MaxMonsters> uniqueTrnIndex;
+
+	std::array<MonsterSnapshot, MaxMonsters> monsters;
+	std::vector<TownerSnapshot> towners;
+	std::array<PlayerSnapshot, MAX_PLRS> players;
+	std::array<ItemSnapshot, MAXITEMS + 1> items;
+	std::array<ObjectSnapshot, MAXOBJECTS> objects;
+	/** @brief Every missile, in the same order as `Missiles`. */
+	std::vector<MissileSnapshot> missiles;
+
+	[[nodiscard]] bool isTileLit(Point position) const
+	{
+		return InDungeonBounds(position) && HasAnyOf(flags[position.x][position.y], DungeonFlag::Lit);
+	}
+
+	[[nodiscard]] bool tileContainsDeadPlayer(Point position) const
+	{
+		return InDungeonBounds(position) && HasAnyOf(flags[position.x][position.y], DungeonFlag::DeadPlayer);
+	}
+
+	/**
+	 * @brief Returns the translation with the given index, or nullptr for -1.
+	 */
+	[[nodiscard]] const uint8_t *uniqueTrn(int8_t index) const
+	{
+		return index >= 0 ? uniqueTrns[index].data() : nullptr;
+	}
+
+	/**
+	 * @brief Returns the id of the object covering the tile, large objects included, or -1 for none.
+	 */
+	[[nodiscard]] int objectIdAt(Point position) const
+	{
+		const int8_t id = objectIds[position.x][position.y];
+		return id != 0 ? std::abs(id) - 1 : -1;
+	}
+};
+
+/**
+ * @brief Copies the rendered part of the game state into a snapshot.
+ *
+ * Has to run on the thread that owns the game state. Also takes the pending DirtyLightTiles
+ * and brings the `DungeonFlag::DeadPlayer` markers up to date, as the renderer can't write to `dFlags`.
+ */
+void CaptureWorldSnapshot(WorldSnapshot &snapshot);
+
+struct MissileRenderPosition {
+	WorldTilePosition tile;
+	Displacement offset;
+};
+
+/**
+ * @brief Where to draw a missile when the given fraction of the next game tick has passed.
+ *
+ * The missile moves ahead of its tile, but never onto a tile it could collide with before the next tick.
+ */
+MissileRenderPosition GetMissileRenderPosition(const MissileSnapshot &missile, uint8_t progressToNextGameTick);
+
+/**
+ * @brief Captures a new snapshot for the renderer. Called once per game tick.
+ *
+ * Snapshots the renderer has let go of are reused.
+ */
+void PublishWorldSnapshot();
+
+/**
+ * @brief Returns the latest snapshot, capturing one first if there is none or it is out of date.
+ *
+ * The snapshot stays unchanged for as long as the caller holds on to it.
+ */
+[[nodiscard]] std::shared_ptr<const WorldSnapshot> GetWorldSnapshot();
+
+/**
+ * @brief Makes the next GetWorldSnapshot() capture again, for changes made between game ticks.
+ */
+void MarkWorldSnapshotStale();
+
+/**
+ * @brief Drops the snapshots of a level that is being left, and gives the next ones a new generation.
+ */
+void DiscardWorldSnapshots();
+
+} // namespace devilution
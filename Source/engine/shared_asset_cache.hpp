@@ -0,0 +1,105 @@
+/**
+ * @file shared_asset_cache.hpp
+ *
+ * Sharing a single copy of an asset between all of its users.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include <ankerl/unordered_dense.h>
+
+namespace devilution {
+
+/**
+ * @brief Hands out shared references to loaded assets, so that all users that ask for
+ * the same key get the same copy.
+ *
+ * The cache does not keep assets alive by itself: an asset is freed as soon as
+ * the last reference to it is dropped, and is loaded again when it is next asked for.
+ *
+ * Not thread-safe.
+ *
+ * @tparam Key Identifies everything that affects the loaded asset
+ * @tparam T The loaded asset
+ */
+template <typename Key, typename T>
+class SharedAssetCache {
+public:
+	struct Stats {
+		/** @brief Requests for an asset that was already loaded. */
+		size_t hits = 0;
+		/** @brief Requests that loaded the asset. */
+		size_t misses = 0;
+		/** @brief Assets that are currently loaded. */
+		size_t loaded = 0;
+	};
+
+	/**
+	 * @brief Returns the asset for `key`, calling `load()` to load it if no one holds it.
+	 * @param load Returns the asset as a `T`
+	 */
+	template <typename Load>
+	std::shared_ptr<const T> getOrLoad(const Key &key, Load &&load)
+	{
+		const auto it = entries_.find(key);
+		if (it != entries_.end()) {
+			if (std::shared_ptr<const T> asset = it->second.lock()) {
+				++hits_;
+				return asset;
+			}
+		}
+		++misses_;
+		std::shared_ptr<const T> asset = std::make_shared<const T>(std::forward<Load>(load)());
+		if (it != entries_.end()) {
+			it->second = asset;
+		} else {
+			removeExpired();
+			entries_.emplace(key, asset);
+		}
+		return asset;
+	}
+
+	/**
+	 * @brief Forgets all assets, so that they are loaded again the next time they are asked for.
+	 *
+	 * Assets that are still held stay valid for as long as they are held.
+	 */
+	void clear()
+	{
+		entries_.clear();
+		nextSweep_ = MinSweepSize;
+	}
+
+	[[nodiscard]] Stats stats() const
+	{
+		Stats stats { hits_, misses_, 0 };
+		for (const auto &[key, asset] : entries_) {
+			if (!asset.expired())
+				++stats.loaded;
+		}
+		return stats;
+	}
+
+private:
+	static constexpr size_t MinSweepSize = 16;
+
+	/** @brief Drops the entries of freed assets once enough of them may have piled up. */
+	void removeExpired()
+	{
+		if (entries_.size() < nextSweep_)
+			return;
+		std::erase_if(entries_, [](const auto &entry) { return entry.second.expired(); });
+		nextSweep_ = std::max(MinSweepSize, entries_.size() * 2);
+	}
+
+	ankerl::unordered_dense::map<Key, std::weak_ptr<const T>> entries_;
+	size_t nextSweep_ = MinSweepSize;
+	size_t hits_ = 0;
+	size_t misses_ = 0;
+};
+
+} // namespace devilution
@@ -6,6 +6,7 @@
 #include "engine/sound.h"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <expected>
@@ -15,6 +16,9 @@
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
+
+#include <ankerl/unordered_dense.h>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_error.h>
@@ -36,6 +40,7 @@
 #include "utils/stdcompat/shared_ptr_array.hpp"
 #include "utils/str_cat.hpp"
 #include "utils/stubs.h"
+#include "utils/thread_pool.hpp"
 
 namespace devilution {
 
@@ -64,7 +69,13 @@ std::string GetMp3Path(const char *path)
 	return mp3Path;
 }
 
-std::expected<void, std::string> LoadAudioFile(const char *path, bool stream, SoundSample &result)
+std::string AudioFileNotFoundError(const char *path)
+{
+	return StrCat("Audio file not found\n", path, "\n", SDL_GetError(), "\n" __FILE__ ":", __LINE__);
+}
+
+/** @param threadsafe Read MPQ files through a handle of their own, for loading off the main thread */
+std::expected<void, std::string> LoadAudioFile(const char *path, bool stream, SoundSample &result, bool threadsafe = false)
 {
 	bool isMp3 = true;
 	std::string foundPath = GetMp3Path(path);
@@ -75,7 +86,7 @@ std::expected<void, std::string> LoadAudioFile(const char *path, bool stream, So
 		isMp3 = false;
 	}
 	if (!ref.ok()) {
-		return std::unexpected(StrCat("Audio file not found\n", path, "\n", SDL_GetError(), "\n" __FILE__ ":", __LINE__));
+		return std::unexpected(AudioFileNotFoundError(path));
 	}
 
 #ifdef STREAM_ALL_AUDIO_MIN_FILE_SIZE
@@ -98,7 +109,7 @@ std::expected<void, std::string> LoadAudioFile(const char *path, bool stream, So
 #if !defined(STREAM_ALL_AUDIO_MIN_FILE_SIZE) || STREAM_ALL_AUDIO_MIN_FILE_SIZE == 0
 		const size_t size = ref.size();
 #endif
-		AssetHandle handle = OpenAsset(std::move(ref));
+		AssetHandle handle = OpenAsset(std::move(ref), threadsafe);
 		if (!handle.ok()) {
 			return std::unexpected(StrCat("Failed to load audio file\n", foundPath, "\n", SDL_GetError(), "\n" __FILE__ ":", __LINE__));
 		}
@@ -114,6 +125,39 @@ std::expected<void, std::string> LoadAudioFile(const char *path, bool stream, So
 	return {};
 }
 
+std::expected<std::unique_ptr<TSnd>, std::string> LoadSound(const char *path, bool stream, bool threadsafe)
+{
+	auto snd = std::make_unique<TSnd>();
+	snd->start_tc = SDL_GetTicks() - 80 - 1;
+	RETURN_IF_ERROR(LoadAudioFile(path, stream, snd->DSB, threadsafe));
+	return snd;
+}
+
+struct PrefetchedSound {
+	SoundCache<TSnd>::Key key;
+	SoundCategory category;
+	uint32_t generation;
+	std::unique_ptr<TSnd> sound;
+};
+
+/** @brief Sounds loaded by the workers, waiting to be added to the cache by the main thread. */
+struct PrefetchedSounds {
+	SdlMutex mutex;
+	std::vector<PrefetchedSound> sounds;
+};
+
+/** @brief Shared with the workers, so that it outlives the loads that are still running. */
+std::shared_ptr<PrefetchedSounds> prefetchedSounds;
+
+/** @brief Prefetches that have not been added to the cache yet, with the generation of their category. */
+ankerl::unordered_dense::map<SoundCache<TSnd>::Key, uint32_t> pendingPrefetches;
+
+/** @brief Incremented when a category is released, so that its prefetches still running are dropped. */
+std::array<uint32_t, NumSoundCategories> prefetchGenerations {};
+
+/** @brief Sounds that failed to load when played, so that the error is only reported once. */
+ankerl::unordered_dense::set<SoundCache<TSnd>::Key> failedSounds;
+
 std::list<std::unique_ptr<SoundSample>> duplicateSounds;
 std::optional<SdlMutex> duplicateSoundsMutex;
 
@@ -226,12 +270,7 @@ void snd_play_snd(TSnd *pSnd, int lVolume, int lPan, int userVolume)
 
 std::expected<std::unique_ptr<TSnd>, std::string> SoundFileLoadWithStatus(const char *path, bool stream)
 {
-	auto snd = std::make_unique<TSnd>();
-	snd->start_tc = SDL_GetTicks() - 80 - 1;
-#ifndef NOSOUND
-	RETURN_IF_ERROR(LoadAudioFile(path, stream, snd->DSB));
-#endif
-	return snd;
+	return LoadSound(path, stream, /*threadsafe=*/false);
 }
 
 std::unique_ptr<TSnd> sound_file_load(const char *path, bool stream)
@@ -241,6 +280,108 @@ std::unique_ptr<TSnd> sound_file_load(const char *path, bool stream)
 	return std::move(result).value();
 }
 
+SoundCache<TSnd> &GetSoundCache()
+{
+	static SoundCache<TSnd> cache(DEVILUTIONX_SOUND_CACHE_SIZE);
+	return cache;
+}
+
+TSnd *GetCachedSound(SoundCache<TSnd>::Key key, SoundCategory category, const char *path)
+{
+	SoundCache<TSnd> &cache = GetSoundCache();
+	if (TSnd *sound = cache.find(key, category))
+		return sound;
+	// It may have been prefetched since the last update, such as in the menus, which don't update.
+	UpdateSoundCache();
+	if (TSnd *sound = cache.peek(key))
+		return sound;
+	if (failedSounds.contains(key))
+		return nullptr;
+	// Missing sounds are reported when they are first needed, such as by `InitMonsterSND`,
+	// so a sound that fails here is corrupt and merely stays silent rather than ending the game.
+	std::expected<std::unique_ptr<TSnd>, std::string> sound = SoundFileLoadWithStatus(path);
+	if (!sound.has_value()) {
+		LogError(LogCategory::Audio, "Failed to load {}: {}", path, sound.error());
+		failedSounds.insert(key);
+		return nullptr;
+	}
+	const size_t size = (*sound)->DSB.GetDataSize();
+	return cache.insert(key, category, *std::move(sound), size);
+}
+
+std::expected<void, std::string> CheckSoundFile(const char *path)
+{
+	if (!FindAsset(GetMp3Path(path)).ok() && !FindAsset(path).ok())
+		return std::unexpected(AudioFileNotFoundError(path));
+	return {};
+}
+
+void PrefetchSound(SoundCache<TSnd>::Key key, SoundCategory category, std::string path)
+{
+	const uint32_t generation = prefetchGenerations[static_cast<size_t>(category)];
+	if (GetSoundCache().peek(key) != nullptr)
+		return;
+	const auto [it, inserted] = pendingPrefetches.try_emplace(key, generation);
+	if (!inserted) {
+		if (it->second == generation)
+			return;
+		it->second = generation;
+	}
+
+	if (prefetchedSounds == nullptr)
+		prefetchedSounds = std::make_shared<PrefetchedSounds>();
+	GetWorkerPool().submit([key, category, generation, path = std::move(path), prefetched = prefetchedSounds]() {
+		std::expected<std::unique_ptr<TSnd>, std::string> sound = LoadSound(path.c_str(), /*stream=*/false, /*threadsafe=*/true);
+		if (!sound.has_value()) {
+			// Left to be loaded, and reported, when it is played.
+			LogError(LogCategory::Audio, "Failed to prefetch {}: {}", path, sound.error());
+			sound = nullptr;
+		}
+		const std::lock_guard<SdlMutex> lock(prefetched->mutex);
+		prefetched->sounds.push_back(PrefetchedSound { key, category, generation, *std::move(sound) });
+	});
+}
+
+void UpdateSoundCache()
+{
+	SoundCache<TSnd> &cache = GetSoundCache();
+	cache.trim();
+	if (prefetchedSounds == nullptr)
+		return;
+
+	std::vector<PrefetchedSound> sounds;
+	{
+		const std::lock_guard<SdlMutex> lock(prefetchedSounds->mutex);
+		sounds = std::move(prefetchedSounds->sounds);
+		prefetchedSounds->sounds.clear();
+	}
+	for (PrefetchedSound &prefetched : sounds) {
+		const auto it = pendingPrefetches.find(prefetched.key);
+		if (it != pendingPrefetches.end() && it->second == prefetched.generation)
+			pendingPrefetches.erase(it);
+		if (prefetched.sound == nullptr || prefetched.generation != prefetchGenerations[static_cast<size_t>(prefetched.category)])
+			continue;
+		const size_t size = prefetched.sound->DSB.GetDataSize();
+		cache.insertIfRoom(prefetched.key, prefetched.category, std::move(prefetched.sound), size);
+	}
+}
+
+void ReleaseCachedSounds(SoundCategory category)
+{
+	++prefetchGenerations[static_cast<size_t>(category)];
+	GetSoundCache().clear(category);
+	// The failures aren't kept per category, and releasing is rare enough to simply try them all again.
+	failedSounds.clear();
+}
+
+void ReleaseCachedSounds()
+{
+	for (uint32_t &generation : prefetchGenerations)
+		++generation;
+	GetSoundCache().clear();
+	failedSounds.clear();
+}
+
 TSnd::~TSnd()
 {
 	if (DSB.IsLoaded())
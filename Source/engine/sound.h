@@ -11,6 +11,7 @@
 #include <optional>
 #include <string>
 
+#include "engine/sound_cache.hpp"
 #include "levels/gendung.h"
 #include "utils/attributes.h"
 
@@ -69,6 +70,50 @@ void ClearDuplicateSounds();
 void snd_play_snd(TSnd *pSnd, int lVolume, int lPan, int userVolume);
 std::unique_ptr<TSnd> sound_file_load(const char *path, bool stream = false);
 std::expected<std::unique_ptr<TSnd>, std::string> SoundFileLoadWithStatus(const char *path, bool stream = false);
+
+/**
+ * @brief The sounds that are loaded on demand: sound effects, keyed by their `SfxID`,
+ * and monster sounds, keyed by `MonsterSoundKey()`.
+ *
+ * The budget is set by `DEVILUTIONX_SOUND_CACHE_SIZE`.
+ */
+SoundCache<TSnd> &GetSoundCache();
+
+/** @brief Keys of monster sounds have the top bit set, so that they never clash with an `SfxID`. */
+constexpr SoundCache<TSnd>::Key MonsterSoundKey(size_t monsterType, size_t mode, size_t variant)
+{
+	return static_cast<SoundCache<TSnd>::Key>(0x80000000U | (monsterType << 3) | (mode << 1) | variant);
+}
+
+/**
+ * @brief Returns a sound from the sound cache, loading it on the calling thread on a miss.
+ *
+ * The sound remains valid until the next call that can load a sound.
+ *
+ * @return nullptr if the sound can't be loaded, which is logged once
+ */
+TSnd *GetCachedSound(SoundCache<TSnd>::Key key, SoundCategory category, const char *path);
+
+/**
+ * @brief Checks that a sound file, or its MP3 version, exists without loading it.
+ * @return The same error as `SoundFileLoadWithStatus` for a missing file
+ */
+std::expected<void, std::string> CheckSoundFile(const char *path);
+
+/**
+ * @brief Starts loading a sound on a worker thread. It is added to the sound cache by
+ * `UpdateSoundCache()`, if it fits in the budget without unloading any other sound.
+ */
+void PrefetchSound(SoundCache<TSnd>::Key key, SoundCategory category, std::string path);
+
+/** @brief Adds the sounds that have finished prefetching to the cache, called once per game tick and on a miss. */
+void UpdateSoundCache();
+
+/** @brief Unloads all sounds of a category and drops its pending prefetches. */
+void ReleaseCachedSounds(SoundCategory category);
+
+/** @brief Unloads all cached sounds and drops all pending prefetches. */
+void ReleaseCachedSounds();
 void snd_init();
 void snd_deinit();
 _music_id GetLevelMusic(dungeon_type dungeonType);
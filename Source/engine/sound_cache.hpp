@@ -0,0 +1,245 @@
+/**
+ * @file sound_cache.hpp
+ *
+ * Memory budget for loaded sound effects.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <utility>
+
+#include <ankerl/unordered_dense.h>
+
+#ifndef DEVILUTIONX_SOUND_CACHE_SIZE
+#define DEVILUTIONX_SOUND_CACHE_SIZE 0
+#endif
+
+namespace devilution {
+
+enum class SoundCategory : uint8_t {
+	Effect,
+	Ui,
+	Hero,
+	Monster,
+};
+
+constexpr size_t NumSoundCategories = 4;
+
+struct SoundCacheStats {
+	struct Category {
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t entries = 0;
+		size_t bytes = 0;
+	};
+
+	std::array<Category, NumSoundCategories> categories;
+	size_t evictions = 0;
+	/** @brief Prefetched sounds that were dropped because they did not fit the budget. */
+	size_t dropped = 0;
+	size_t bytes = 0;
+	size_t budget = 0;
+};
+
+/**
+ * @brief Keeps loaded sounds in memory up to a budget, unloading the least recently played ones.
+ *
+ * Sounds are identified by a key chosen by the caller and loaded by the caller on a miss.
+ * A sound that is still playing is never unloaded to make room, even if that leaves
+ * the cache over its budget until it has finished.
+ *
+ * Not thread-safe, sounds are only played from the main thread.
+ *
+ * @tparam Sound Must provide `bool isPlaying()`
+ */
+template <typename Sound>
+class SoundCache {
+public:
+	using Key = uint32_t;
+
+	/** @param budget Maximum total size of the loaded sounds in bytes, 0 for no limit */
+	explicit SoundCache(size_t budget = 0)
+	    : budget_(budget)
+	{
+	}
+
+	SoundCache(const SoundCache &) = delete;
+	SoundCache &operator=(const SoundCache &) = delete;
+
+	[[nodiscard]] size_t budget() const
+	{
+		return budget_;
+	}
+
+	/**
+	 * @brief Returns a loaded sound and marks it as recently played.
+	 * @param category Counts a miss against this category
+	 * @return `nullptr` on a miss
+	 */
+	Sound *find(Key key, SoundCategory category)
+	{
+		const auto it = index_.find(key);
+		if (it == index_.end()) {
+			++stats_.categories[static_cast<size_t>(category)].misses;
+			return nullptr;
+		}
+		++stats_.categories[static_cast<size_t>(it->second->category)].hits;
+		lru_.splice(lru_.begin(), lru_, it->second);
+		return it->second->sound.get();
+	}
+
+	/** @brief Returns a loaded sound without counting it as a use. */
+	[[nodiscard]] Sound *peek(Key key) const
+	{
+		const auto it = index_.find(key);
+		return it != index_.end() ? it->second->sound.get() : nullptr;
+	}
+
+	/**
+	 * @brief Takes ownership of a newly loaded sound, unloading others as needed to stay within the budget.
+	 * @return The cached sound, which is the one already cached for `key` if there is one
+	 */
+	Sound *insert(Key key, SoundCategory category, std::unique_ptr<Sound> sound, size_t size)
+	{
+		if (Sound *cached = peek(key))
+			return cached;
+		if (budget_ != 0)
+			evictToFit(size < budget_ ? budget_ - size : 0);
+		return add(key, category, std::move(sound), size);
+	}
+
+	/**
+	 * @brief Like `insert`, but for prefetched sounds: these only take up free space
+	 * and never cause a sound that has been played to be unloaded.
+	 * @return Whether the sound was cached
+	 */
+	bool insertIfRoom(Key key, SoundCategory category, std::unique_ptr<Sound> sound, size_t size)
+	{
+		if (peek(key) != nullptr)
+			return false;
+		if (budget_ != 0 && stats_.bytes + size > budget_) {
+			++stats_.dropped;
+			return false;
+		}
+		add(key, category, std::move(sound), size);
+		return true;
+	}
+
+	/** @brief Unloads sounds that had to be kept past the budget while they were playing. */
+	void trim()
+	{
+		if (budget_ != 0)
+			evictToFit(budget_);
+	}
+
+	/** @brief Changes the budget, unloading sounds as needed. 0 removes the limit. */
+	void setBudget(size_t budget)
+	{
+		budget_ = budget;
+		trim();
+	}
+
+	/** @brief Unloads all sounds of a category, including those that are playing. */
+	void clear(SoundCategory category)
+	{
+		for (auto it = lru_.begin(); it != lru_.end();) {
+			if (it->category == category)
+				it = erase(it);
+			else
+				++it;
+		}
+	}
+
+	/** @brief Unloads all sounds, including those that are playing. The counters are kept. */
+	void clear()
+	{
+		lru_.clear();
+		index_.clear();
+		stats_.bytes = 0;
+		for (SoundCacheStats::Category &category : stats_.categories) {
+			category.entries = 0;
+			category.bytes = 0;
+		}
+	}
+
+	void resetStats()
+	{
+		for (SoundCacheStats::Category &category : stats_.categories) {
+			category.hits = 0;
+			category.misses = 0;
+		}
+		stats_.evictions = 0;
+		stats_.dropped = 0;
+	}
+
+	/** @brief Calls `fn(Sound &)` for every loaded sound. */
+	template <typename F>
+	void forEach(F &&fn)
+	{
+		for (Entry &entry : lru_)
+			fn(*entry.sound);
+	}
+
+	[[nodiscard]] SoundCacheStats stats() const
+	{
+		SoundCacheStats stats = stats_;
+		stats.budget = budget_;
+		return stats;
+	}
+
+private:
+	struct Entry {
+		Key key;
+		SoundCategory category;
+		std::unique_ptr<Sound> sound;
+		size_t size;
+	};
+
+	using Iterator = typename std::list<Entry>::iterator;
+
+	Sound *add(Key key, SoundCategory category, std::unique_ptr<Sound> sound, size_t size)
+	{
+		Sound *result = sound.get();
+		lru_.push_front(Entry { key, category, std::move(sound), size });
+		index_.emplace(key, lru_.begin());
+		SoundCacheStats::Category &categoryStats = stats_.categories[static_cast<size_t>(category)];
+		++categoryStats.entries;
+		categoryStats.bytes += size;
+		stats_.bytes += size;
+		return result;
+	}
+
+	Iterator erase(Iterator it)
+	{
+		SoundCacheStats::Category &categoryStats = stats_.categories[static_cast<size_t>(it->category)];
+		--categoryStats.entries;
+		categoryStats.bytes -= it->size;
+		stats_.bytes -= it->size;
+		index_.erase(it->key);
+		return lru_.erase(it);
+	}
+
+	/** @brief Unloads the least recently played sounds that are not playing until at most `budget` bytes are used. */
+	void evictToFit(size_t budget)
+	{
+		for (auto it = lru_.end(); it != lru_.begin() && stats_.bytes > budget;) {
+			--it;
+			if (it->sound->isPlaying())
+				continue;
+			it = erase(it);
+			++stats_.evictions;
+		}
+	}
+
+	/** @brief Most recently played first. */
+	std::list<Entry> lru_;
+	ankerl::unordered_dense::map<Key, Iterator> index_;
+	size_t budget_;
+	SoundCacheStats stats_;
+};
+
+} // namespace devilution
@@ -12,6 +12,17 @@ void ClearDuplicateSounds() { }
 void snd_play_snd(TSnd *pSnd, int lVolume, int lPan, int userVolume) { }
 std::unique_ptr<TSnd> sound_file_load(const char *path, bool stream) { return nullptr; }
 std::expected<std::unique_ptr<TSnd>, std::string> SoundFileLoadWithStatus(const char *path, bool stream) { return nullptr; }
+SoundCache<TSnd> &GetSoundCache()
+{
+	static SoundCache<TSnd> cache;
+	return cache;
+}
+TSnd *GetCachedSound(SoundCache<TSnd>::Key key, SoundCategory category, const char *path) { return nullptr; }
+std::expected<void, std::string> CheckSoundFile(const char *path) { return {}; }
+void PrefetchSound(SoundCache<TSnd>::Key key, SoundCategory category, std::string path) { }
+void UpdateSoundCache() { }
+void ReleaseCachedSounds(SoundCategory category) { }
+void ReleaseCachedSounds() { }
 TSnd::~TSnd() { }
 void snd_init() { }
 void snd_deinit() { }
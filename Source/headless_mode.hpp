@@ -5,7 +5,9 @@
 namespace devilution {
 
 /**
- * @brief Don't load UI or show Messageboxes or other user-interaction. Needed for unit tests.
+ * @brief Don't load UI or show Messageboxes or other user-interaction.
+ *
+ * Used by unit tests and by `--headless` demo playback, which runs the game logic without a window.
  */
 extern DVL_API_FOR_TEST bool HeadlessMode;
 
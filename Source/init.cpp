@@ -28,6 +28,7 @@
 #include "hwcursor.hpp"
 #include "options.h"
 #include "pfile.h"
+#include "save_snapshot.hpp"
 #include "utils/file_util.h"
 #include "utils/language.h"
 #include "utils/log.hpp"
@@ -119,8 +120,10 @@ void init_cleanup()
 		pfile_write_hero(/*writeGameData=*/false);
 		sfile_write_stash();
 	}
+	WaitForSaves();
 
 	MpqArchives.clear();
+	InvalidateAssetIndex();
 	HasHellfireMpq = false;
 
 	NetClose();
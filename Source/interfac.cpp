@@ -335,6 +335,7 @@ void DoLoad(interface_mode uMsg)
 		break;
 	case WM_DIABNEXTLVL:
 		IncProgress();
+		PrefetchLvlGFX(GetLevelType(myPlayer.plrlevel));
 		if (!gbIsMultiplayer) {
 			pfile_save_level();
 		} else {
@@ -351,6 +352,7 @@ void DoLoad(interface_mode uMsg)
 		break;
 	case WM_DIABPREVLVL:
 		IncProgress();
+		PrefetchLvlGFX(GetLevelType(currlevel - 1));
 		if (!gbIsMultiplayer) {
 			pfile_save_level();
 		} else {
@@ -371,6 +373,7 @@ void DoLoad(interface_mode uMsg)
 		ReturnLevelType = GetLevelType(ReturnLevel);
 		ReturnLvlPosition = GetMapReturnPosition();
 		IncProgress();
+		PrefetchLvlGFX(setlvltype);
 		if (!gbIsMultiplayer) {
 			pfile_save_level();
 		} else {
@@ -387,6 +390,7 @@ void DoLoad(interface_mode uMsg)
 		break;
 	case WM_DIABRTNLVL:
 		IncProgress();
+		PrefetchLvlGFX(GetLevelType(GetMapReturnLevel()));
 		if (!gbIsMultiplayer) {
 			pfile_save_level();
 		} else {
@@ -417,6 +421,7 @@ void DoLoad(interface_mode uMsg)
 		break;
 	case WM_DIABTOWNWARP:
 		IncProgress();
+		PrefetchLvlGFX(GetLevelType(myPlayer.plrlevel));
 		if (!gbIsMultiplayer) {
 			pfile_save_level();
 		} else {
@@ -433,6 +438,7 @@ void DoLoad(interface_mode uMsg)
 		break;
 	case WM_DIABTWARPUP:
 		IncProgress();
+		PrefetchLvlGFX(GetLevelType(myPlayer.plrlevel));
 		if (!gbIsMultiplayer) {
 			pfile_save_level();
 		} else {
@@ -448,6 +454,7 @@ void DoLoad(interface_mode uMsg)
 		break;
 	case WM_DIABRETOWN:
 		IncProgress();
+		PrefetchLvlGFX(GetLevelType(myPlayer.plrlevel));
 		if (!gbIsMultiplayer) {
 			pfile_save_level();
 		} else {
@@ -2740,7 +2740,7 @@ void CalcPlrGraphics(Player &player, PlayerWeaponGraphic animWeaponId, PlayerArm
 	const uint8_t gfxNum = static_cast<uint8_t>(animWeaponId) | static_cast<uint8_t>(animArmorId);
 	if (player._pgfxnum != gfxNum && loadgfx) {
 		player._pgfxnum = gfxNum;
-		ResetPlayerGFX(player);
+		ResetChangedPlayerGFX(player);
 		SetPlrAnims(player);
 		player.previewCelSprite = std::nullopt;
 		player_graphic graphic = player.getGraphic();
@@ -2751,7 +2751,7 @@ void CalcPlrGraphics(Player &player, PlayerWeaponGraphic animWeaponId, PlayerArm
 		OptionalClxSpriteList sprites;
 		if (!HeadlessMode) {
 			auto &animData = player.AnimationData[static_cast<size_t>(graphic)];
-			if (animData.sprites.has_value()) {
+			if (animData.sprites) {
 				sprites = animData.spritesForDirection(player._pdir);
 			} else {
 				// In multiplayer games, a remote player can unequip their shield while that player is blocking an attack on the host.
@@ -3811,6 +3811,11 @@ void FreeItemGFX()
 	}
 }
 
+std::span<const OptionalOwnedClxSpriteList> GetItemAnimations()
+{
+	return itemanims;
+}
+
 void GetItemFrm(Item &item)
 {
 	const int it = ItemCAnimTbl[item._iCurs];
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <span>
 
 #include "utils/enum_traits.h"
 
@@ -131,6 +133,59 @@ constexpr int_fast16_t DunFrameTriangleHeight = 31;
 constexpr size_t ReencodedTriangleFrameSize = 544 - 32;
 constexpr size_t ReencodedTrapezoidFrameSize = 800 - 16;
 
+/**
+ * @brief A horizontal run of opaque pixels in a row of a dungeon frame.
+ *
+ * In the upper half of a frame, runs are also split wherever `MaskType::Left`
+ * or `MaskType::Right` switches between opaque and blended, so a masked draw only
+ * needs to check the flag of each run.
+ */
+struct DunFrameSpan {
+	/** @brief Offset of the first pixel from the start of the re-encoded frame data. */
+	uint16_t srcOffset;
+	uint8_t x;
+	uint8_t width;
+	/** @brief Whether the run is blended when drawn with `MaskType::Left`. */
+	bool blendedWithLeftMask;
+	/** @brief Whether the run is blended when drawn with `MaskType::Right`. */
+	bool blendedWithRightMask;
+};
+
+/**
+ * @brief Pre-decoded runs of a dungeon frame, built by `ReencodeDungeonCels`.
+ *
+ * Encoding (native endianness, 2-byte aligned):
+ * - uint16_t height
+ * - uint16_t rowBegin[height + 1]: index of the first span of every row, bottom row first
+ * - DunFrameSpan spans[]
+ *
+ * The pixels themselves are not copied, spans point into the re-encoded frame data.
+ */
+class DunFrameSpans {
+public:
+	explicit DunFrameSpans(const std::byte *data)
+	    : data_(reinterpret_cast<const uint16_t *>(data))
+	{
+	}
+
+	[[nodiscard]] int_fast16_t height() const
+	{
+		return static_cast<int_fast16_t>(data_[0]);
+	}
+
+	/**
+	 * @brief Returns the spans of the given row, counting from the bottom.
+	 */
+	[[nodiscard]] std::span<const DunFrameSpan> row(int_fast16_t y) const
+	{
+		const auto *spans = reinterpret_cast<const DunFrameSpan *>(&data_[1 + height() + 1]);
+		return { spans + data_[1 + y], spans + data_[1 + y + 1] };
+	}
+
+private:
+	const uint16_t *data_;
+};
+
 /**
  * @return Returns the center of the sprite relative to the center of the tile.
  */
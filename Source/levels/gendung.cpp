@@ -45,6 +45,7 @@ WorldTileRectangle SetPiece;
 OptionalOwnedClxSpriteList pSpecialCels;
 std::unique_ptr<MegaTile[]> pMegaTiles;
 std::unique_ptr<std::byte[]> pDungeonCels;
+std::unique_ptr<std::byte[]> pDungeonCelSpans;
 TileProperties SOLData[MAXTILES];
 WorldTilePosition dminPosition;
 WorldTilePosition dmaxPosition;
@@ -506,7 +507,7 @@ std::expected<void, std::string> LoadLevelSOLData()
 	return {};
 }
 
-void SetDungeonMicros(std::unique_ptr<std::byte[]> &dungeonCels, uint_fast8_t &microTileLen)
+void SetDungeonMicros(std::unique_ptr<std::byte[]> &dungeonCels, std::unique_ptr<std::byte[]> &dungeonCelSpans, uint_fast8_t &microTileLen)
 {
 	microTileLen = 10;
 	size_t blocks = 10;
@@ -541,7 +542,7 @@ void SetDungeonMicros(std::unique_ptr<std::byte[]> &dungeonCels, uint_fast8_t &m
 	c_sort(frameToTypeList, [](const std::pair<uint16_t, DunFrameInfo> &a, const std::pair<uint16_t, DunFrameInfo> &b) {
 		return a.first < b.first;
 	});
-	ReencodeDungeonCels(dungeonCels, frameToTypeList);
+	ReencodeDungeonCels(dungeonCels, dungeonCelSpans, frameToTypeList);
 
 	std::vector<std::pair<uint16_t, uint16_t>> celBlockAdjustments = ComputeCelBlockAdjustments(frameToTypeList);
 	if (celBlockAdjustments.size() == 0) return;
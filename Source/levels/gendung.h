@@ -122,6 +122,8 @@ extern OptionalOwnedClxSpriteList pSpecialCels;
 /** Specifies the tile definitions of the active dungeon type; (e.g. levels/l1data/l1.til). */
 extern DVL_API_FOR_TEST std::unique_ptr<MegaTile[]> pMegaTiles;
 extern DVL_API_FOR_TEST std::unique_ptr<std::byte[]> pDungeonCels;
+/** Pre-decoded spans of the frames in `pDungeonCels`, see `GetDunFrameSpans`. */
+extern std::unique_ptr<std::byte[]> pDungeonCelSpans;
 /**
  * List tile properties
  */
@@ -134,7 +136,7 @@ extern WorldTilePosition dmaxPosition;
 extern DVL_API_FOR_TEST dungeon_type leveltype;
 /** Specifies the active dungeon level of the current game. */
 extern DVL_API_FOR_TEST uint8_t currlevel;
-extern bool setlevel;
+extern DVL_API_FOR_TEST bool setlevel;
 /** Specifies the active quest level of the current game. */
 extern _setlevels setlvlnum;
 /** Specifies the dungeon type of the active quest level of the current game. */
@@ -154,9 +156,9 @@ extern DVL_API_FOR_TEST int8_t dTransVal[MAXDUNX][MAXDUNY];
 /** Current realtime lighting. Per tile. */
 extern DVL_API_FOR_TEST uint8_t dLight[MAXDUNX][MAXDUNY];
 /** Precalculated static lights. dLight uses this as a base before applying lights. Per tile. */
-extern uint8_t dPreLight[MAXDUNX][MAXDUNY];
+extern DVL_API_FOR_TEST uint8_t dPreLight[MAXDUNX][MAXDUNY];
 /** Holds various information about dungeon tiles, @see DungeonFlag */
-extern DungeonFlag dFlags[MAXDUNX][MAXDUNY];
+extern DVL_API_FOR_TEST DungeonFlag dFlags[MAXDUNX][MAXDUNY];
 /** Contains the player numbers (players array indices) of the map. negative id indicates player moving. */
 extern int8_t dPlayer[MAXDUNX][MAXDUNY];
 /**
@@ -165,7 +167,7 @@ extern int8_t dPlayer[MAXDUNX][MAXDUNY];
  * (monsters array index) in the dungeon.
  * Negative id indicates monsters moving.
  */
-extern int16_t dMonster[MAXDUNX][MAXDUNY];
+extern DVL_API_FOR_TEST int16_t dMonster[MAXDUNX][MAXDUNY];
 /**
  * Contains the dead numbers (deads array indices) and dead direction of
  * the map, encoded as specified by the pseudo-code below.
@@ -298,7 +300,7 @@ struct Miniset {
 }
 
 std::expected<void, std::string> LoadLevelSOLData();
-void SetDungeonMicros(std::unique_ptr<std::byte[]> &dungeonCels, uint_fast8_t &microTileLen);
+void SetDungeonMicros(std::unique_ptr<std::byte[]> &dungeonCels, std::unique_ptr<std::byte[]> &dungeonCelSpans, uint_fast8_t &microTileLen);
 void DRLG_InitTrans();
 void DRLG_MRectTrans(WorldTilePosition origin, WorldTilePosition extent);
 void DRLG_MRectTrans(WorldTileRectangle area);
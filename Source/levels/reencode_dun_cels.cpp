@@ -237,9 +237,171 @@ size_t GetReencodedSize(const uint8_t *dungeonCels, std::span<std::pair<uint16_t
 	return result;
 }
 
+static_assert(sizeof(DunFrameSpan) == 6, "DunFrameSpan is stored without padding");
+
+class DunFrameSpansBuilder {
+public:
+	void beginRow()
+	{
+		rowBegin_.push_back(static_cast<uint16_t>(spans_.size()));
+	}
+
+	/**
+	 * @brief Adds a run of opaque pixels to the current row, split where the masks switch between opaque and blended.
+	 */
+	void addRun(int x, int width, size_t srcOffset)
+	{
+		const int y = static_cast<int>(rowBegin_.size()) - 1;
+		// Same as `InitPrefix` in dun_render.cpp: with `MaskType::Left`, pixels left of
+		// `leftMaskEnd` are blended, with `MaskType::Right` pixels from `rightMaskBegin` on are.
+		const int leftMaskEnd = (2 * y) - DunFrameWidth;
+		const int rightMaskBegin = (2 * DunFrameWidth) - (2 * y);
+		const int end = x + width;
+		while (x < end) {
+			int runEnd = end;
+			if (x < leftMaskEnd && leftMaskEnd < runEnd) runEnd = leftMaskEnd;
+			if (x < rightMaskBegin && rightMaskBegin < runEnd) runEnd = rightMaskBegin;
+			spans_.push_back(DunFrameSpan {
+			    .srcOffset = static_cast<uint16_t>(srcOffset),
+			    .x = static_cast<uint8_t>(x),
+			    .width = static_cast<uint8_t>(runEnd - x),
+			    .blendedWithLeftMask = x < leftMaskEnd,
+			    .blendedWithRightMask = x >= rightMaskBegin,
+			});
+			srcOffset += runEnd - x;
+			x = runEnd;
+		}
+	}
+
+	void addTriangleLower(bool left, size_t &srcOffset)
+	{
+		for (int width = 2; width <= DunFrameWidth; width += 2) {
+			beginRow();
+			addRun(left ? DunFrameWidth - width : 0, width, srcOffset);
+			srcOffset += width;
+		}
+	}
+
+	void addTriangle(bool left, size_t srcOffset)
+	{
+		addTriangleLower(left, srcOffset);
+		for (int width = DunFrameWidth - 2; width > 0; width -= 2) {
+			beginRow();
+			addRun(left ? DunFrameWidth - width : 0, width, srcOffset);
+			srcOffset += width;
+		}
+	}
+
+	void addSquareRows(int_fast16_t height, size_t srcOffset)
+	{
+		for (int_fast16_t y = 0; y < height; ++y) {
+			beginRow();
+			addRun(0, DunFrameWidth, srcOffset);
+			srcOffset += DunFrameWidth;
+		}
+	}
+
+	void addTrapezoid(bool left, size_t srcOffset)
+	{
+		addTriangleLower(left, srcOffset);
+		addSquareRows(DunFrameHeight / 2, srcOffset);
+	}
+
+	void addTransparentSquare(const uint8_t *frame, size_t srcOffset, int_fast16_t height)
+	{
+		for (int_fast16_t y = 0; y < height; ++y) {
+			beginRow();
+			for (int x = 0; x < DunFrameWidth;) {
+				const auto v = static_cast<int8_t>(frame[srcOffset++]);
+				if (v > 0) {
+					addRun(x, v, srcOffset);
+					srcOffset += v;
+					x += v;
+				} else {
+					x -= v;
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Appends the frame to `out` and resets the builder for the next one.
+	 */
+	void finish(std::vector<std::byte> &out)
+	{
+		const auto height = static_cast<uint16_t>(rowBegin_.size());
+		rowBegin_.push_back(static_cast<uint16_t>(spans_.size()));
+		const size_t begin = out.size();
+		out.resize(begin + sizeof(height) + (rowBegin_.size() * sizeof(uint16_t)) + (spans_.size() * sizeof(DunFrameSpan)));
+		std::byte *dst = &out[begin];
+		std::memcpy(dst, &height, sizeof(height));
+		dst += sizeof(height);
+		std::memcpy(dst, rowBegin_.data(), rowBegin_.size() * sizeof(uint16_t));
+		dst += rowBegin_.size() * sizeof(uint16_t);
+		std::memcpy(dst, spans_.data(), spans_.size() * sizeof(DunFrameSpan));
+		rowBegin_.clear();
+		spans_.clear();
+	}
+
+private:
+	std::vector<uint16_t> rowBegin_;
+	std::vector<DunFrameSpan> spans_;
+};
+
+/**
+ * @brief Builds the span lists for the re-encoded dungeon cels.
+ *
+ * The result starts with a table of 2 offsets per frame, indexed like the
+ * re-encoded frame table: one for the frame and one for its foliage (0 if none).
+ */
+std::unique_ptr<std::byte[]> BuildDungeonCelSpans(const uint8_t *dungeonCels, std::span<std::pair<uint16_t, DunFrameInfo>> frames)
+{
+	const size_t tableSize = 2 * (frames.size() + 1) * sizeof(uint32_t);
+	std::vector<uint32_t> table(2 * (frames.size() + 1), 0);
+	std::vector<std::byte> data(tableSize);
+	DunFrameSpansBuilder builder;
+	uint32_t frameIndex = 1;
+	for (const auto &entry : frames) {
+		const DunFrameInfo &info = entry.second;
+		const uint8_t *frameData = &dungeonCels[LoadLE32(&dungeonCels[frameIndex * 4])];
+		table[2 * frameIndex] = static_cast<uint32_t>(data.size());
+		switch (info.type) {
+		case TileType::TransparentSquare:
+			if (info.isFloor()) {
+				builder.addTriangle(info.isFloorLeft(), 0);
+				builder.finish(data);
+				table[(2 * frameIndex) + 1] = static_cast<uint32_t>(data.size());
+				builder.addTransparentSquare(frameData, ReencodedTriangleFrameSize, /*height=*/16);
+			} else {
+				builder.addTransparentSquare(frameData, 0, DunFrameHeight);
+			}
+			break;
+		case TileType::Square:
+			builder.addSquareRows(DunFrameHeight, 0);
+			break;
+		case TileType::LeftTriangle:
+		case TileType::RightTriangle:
+			builder.addTriangle(info.type == TileType::LeftTriangle, 0);
+			break;
+		case TileType::LeftTrapezoid:
+		case TileType::RightTrapezoid:
+			builder.addTrapezoid(info.type == TileType::LeftTrapezoid, 0);
+			break;
+		}
+		builder.finish(data);
+		++frameIndex;
+	}
+	std::memcpy(data.data(), table.data(), tableSize);
+
+	std::unique_ptr<std::byte[]> result { new std::byte[data.size()] };
+	std::memcpy(result.get(), data.data(), data.size());
+	LogVerbose(" Built dungeon CEL spans: {} bytes", FormatInteger(static_cast<uint32_t>(data.size())));
+	return result;
+}
+
 } // namespace
 
-void ReencodeDungeonCels(std::unique_ptr<std::byte[]> &dungeonCels, std::span<std::pair<uint16_t, DunFrameInfo>> frames)
+void ReencodeDungeonCels(std::unique_ptr<std::byte[]> &dungeonCels, std::unique_ptr<std::byte[]> &dungeonCelSpans, std::span<std::pair<uint16_t, DunFrameInfo>> frames)
 {
 	const auto *srcData = reinterpret_cast<const uint8_t *>(dungeonCels.get());
 	const auto *srcOffsets = reinterpret_cast<const uint32_t *>(srcData);
@@ -299,6 +461,7 @@ void ReencodeDungeonCels(std::unique_ptr<std::byte[]> &dungeonCels, std::span<st
 	    FormatInteger(Swap32LE(dstOffsets[Swap32LE(dstOffsets[0]) + 1])),
 	    FormatInteger(numFoliage));
 
+	dungeonCelSpans = BuildDungeonCelSpans(resultPtr, frames);
 	dungeonCels = std::move(result);
 }
 
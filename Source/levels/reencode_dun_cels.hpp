@@ -34,8 +34,10 @@ struct DunFrameInfo {
  * 2. Extracts floor tile foliage into a triangle with the floor frame and a separate 16-px tall `TransparentSquare`.
  *
  * This reduces memory usage and simplifies the rendering.
+ *
+ * Also builds the `DunFrameSpans` of every frame into `dungeonCelSpans`, see `GetDunFrameSpans`.
  */
-void ReencodeDungeonCels(std::unique_ptr<std::byte[]> &dungeonCels, std::span<std::pair<uint16_t, DunFrameInfo>> frames);
+void ReencodeDungeonCels(std::unique_ptr<std::byte[]> &dungeonCels, std::unique_ptr<std::byte[]> &dungeonCelSpans, std::span<std::pair<uint16_t, DunFrameInfo>> frames);
 
 /**
  * @brief Computes adjustments to apply to frame indexes in cel block data.
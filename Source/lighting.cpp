@@ -44,6 +44,7 @@ std::array<uint8_t, 256> PauseTable;
 bool DisableLighting;
 #endif
 bool UpdateLighting;
+Bitset2d<MAXDUNX, MAXDUNY> DirtyLightTiles;
 
 namespace {
 
@@ -75,10 +76,12 @@ void RotateRadius(DisplacementOf<int8_t> &offset, DisplacementOf<int8_t> &dist,
 
 DVL_ALWAYS_INLINE void SetLight(Point position, uint8_t v)
 {
-	if (LoadingMapObjects)
+	if (LoadingMapObjects) {
 		dPreLight[position.x][position.y] = v;
-	else
+	} else if (dLight[position.x][position.y] != v) {
 		dLight[position.x][position.y] = v;
+		DirtyLightTiles.set(position.x, position.y);
+	}
 }
 
 DVL_ALWAYS_INLINE uint8_t GetLight(Point position)
@@ -118,8 +121,13 @@ void DoUnLight(Point position, uint8_t radius)
 	auto searchArea = PointsInRectangle(WorldTileRectangle { position, radius });
 
 	for (const WorldTilePosition targetPosition : searchArea) {
-		if (InDungeonBounds(targetPosition))
-			dLight[targetPosition.x][targetPosition.y] = dPreLight[targetPosition.x][targetPosition.y];
+		if (!InDungeonBounds(targetPosition))
+			continue;
+		uint8_t &light = dLight[targetPosition.x][targetPosition.y];
+		if (light != dPreLight[targetPosition.x][targetPosition.y]) {
+			light = dPreLight[targetPosition.x][targetPosition.y];
+			DirtyLightTiles.set(targetPosition.x, targetPosition.y);
+		}
 	}
 }
 
@@ -330,6 +338,7 @@ void MakeLightTable()
 void ToggleLighting()
 {
 	DisableLighting = !DisableLighting;
+	DirtyLightTiles.set();
 
 	if (DisableLighting) {
 		memset(dLight, 0, sizeof(dLight));
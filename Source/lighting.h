@@ -14,7 +14,9 @@
 #include "engine/lighting_defs.hpp"
 #include "engine/point.hpp"
 #include "engine/world_tile.hpp"
+#include "levels/gendung_defs.hpp"
 #include "utils/attributes.h"
+#include "utils/bitset2d.hpp"
 
 namespace devilution {
 
@@ -51,6 +53,8 @@ extern std::array<uint8_t, 256> PauseTable;
 extern bool DisableLighting;
 #endif
 extern bool UpdateLighting;
+/** @brief Tiles whose dLight value changed since the per-pixel lightmap was last built. */
+extern DVL_API_FOR_TEST Bitset2d<MAXDUNX, MAXDUNY> DirtyLightTiles;
 
 void DoUnLight(Point position, uint8_t radius);
 void DoLighting(Point position, uint8_t radius, DisplacementOf<int8_t> offset);
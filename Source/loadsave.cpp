@@ -5,12 +5,15 @@
  */
 #include "loadsave.h"
 
+#include <array>
+#include <bit>
 #include <climits>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <expected>
 #include <numeric>
+#include <span>
 #include <string>
 
 #include <ankerl/unordered_dense.h>
@@ -35,6 +38,7 @@
 #include "pfile.h"
 #include "plrmsg.h"
 #include "qol/stash.h"
+#include "save_snapshot.hpp"
 #include "stores.h"
 #include "tables/playerdat.hpp"
 #include "utils/algorithm/container.hpp"
@@ -87,6 +91,30 @@ T SwapBE(T in)
 	}
 }
 
+/**
+ * @brief Converts values between the host's byte order and `Order`, which is the same in both directions.
+ *
+ * A plain loop over contiguous values, so that compilers can vectorize it on hosts that need to swap.
+ */
+template <std::endian Order, class T>
+void ConvertByteOrder(std::span<T> values)
+{
+	if constexpr (sizeof(T) > 1 && Order != std::endian::native) {
+		for (T &value : values)
+			value = std::byteswap(value);
+	}
+}
+
+/** @brief The default conversion between the values of a grid and how they are stored in the save file. */
+template <class T>
+struct ConvertTo {
+	template <class U>
+	constexpr T operator()(U value) const
+	{
+		return static_cast<T>(value);
+	}
+};
+
 void TerminateUtf8(char *str, size_t maxLength)
 {
 	const std::string_view inStr { str, maxLength };
@@ -123,6 +151,13 @@ public:
 			m_buffer_ = nullptr;
 	}
 
+	/** @param buffer Already decoded */
+	LoadHelper(std::unique_ptr<std::byte[]> buffer, size_t size)
+	    : m_buffer_(std::move(buffer))
+	    , m_size_(size)
+	{
+	}
+
 	bool IsValid(size_t size = 1)
 	{
 		return m_buffer_ != nullptr
@@ -183,18 +218,62 @@ public:
 	{
 		return Next<uint32_t>() != 0;
 	}
+
+	/**
+	 * @brief Reads a grid, which the save file stores row by row, into an array indexed by `[x][y]`.
+	 *
+	 * Checks the bounds once for the whole grid and reads a row at a time.
+	 *
+	 * @tparam TFile Type of the values in the save file
+	 * @param fromFile Converts a value from the save file into an element of the grid
+	 */
+	template <class TFile, class T, size_t Width, size_t Height, class Fn = ConvertTo<T>>
+	void NextGridLE(T (&grid)[Width][Height], Fn fromFile = {})
+	{
+		NextGrid<TFile, std::endian::little>(grid, fromFile);
+	}
+
+	/** @copydoc NextGridLE */
+	template <class TFile, class T, size_t Width, size_t Height, class Fn = ConvertTo<T>>
+	void NextGridBE(T (&grid)[Width][Height], Fn fromFile = {})
+	{
+		NextGrid<TFile, std::endian::big>(grid, fromFile);
+	}
+
+private:
+	template <class TFile, std::endian Order, class T, size_t Width, size_t Height, class Fn>
+	void NextGrid(T (&grid)[Width][Height], Fn &fromFile)
+	{
+		if (!IsValid(sizeof(TFile) * Width * Height)) {
+			// A truncated file: read value by value, which fills in whatever is missing with zeroes.
+			for (size_t j = 0; j < Height; j++) {
+				for (size_t i = 0; i < Width; i++)
+					grid[i][j] = fromFile(Order == std::endian::little ? NextLE<TFile>() : NextBE<TFile>());
+			}
+			return;
+		}
+
+		std::array<TFile, Width> row;
+		for (size_t j = 0; j < Height; j++) {
+			memcpy(row.data(), &m_buffer_[m_cur_], sizeof(row));
+			m_cur_ += sizeof(row);
+			ConvertByteOrder<Order>(std::span<TFile>(row));
+			for (size_t i = 0; i < Width; i++)
+				grid[i][j] = fromFile(row[i]);
+		}
+	}
 };
 
 class SaveHelper {
-	SaveWriter &m_mpqWriter;
+	SaveSnapshot &m_snapshot;
 	const char *m_szFileName_;
 	std::unique_ptr<std::byte[]> m_buffer_;
 	size_t m_cur_ = 0;
 	size_t m_capacity_;
 
 public:
-	SaveHelper(SaveWriter &mpqWriter, const char *szFileName, size_t bufferLen)
-	    : m_mpqWriter(mpqWriter)
+	SaveHelper(SaveSnapshot &snapshot, const char *szFileName, size_t bufferLen)
+	    : m_snapshot(snapshot)
 	    , m_szFileName_(szFileName)
 	    , m_buffer_(new std::byte[codec_get_encoded_len(bufferLen)])
 	    , m_capacity_(bufferLen)
@@ -245,12 +324,57 @@ public:
 		WriteBytes(&value, sizeof(value));
 	}
 
+	/**
+	 * @brief Writes a grid indexed by `[x][y]` row by row, as the save file stores it.
+	 *
+	 * Checks the bounds once for the whole grid and writes a row at a time.
+	 *
+	 * @tparam TFile Type of the values in the save file
+	 * @param toFile Converts an element of the grid into a value for the save file
+	 */
+	template <class TFile, class T, size_t Width, size_t Height, class Fn = ConvertTo<TFile>>
+	void WriteGridLE(const T (&grid)[Width][Height], Fn toFile = {})
+	{
+		WriteGrid<TFile, std::endian::little>(grid, toFile);
+	}
+
+	/** @copydoc WriteGridLE */
+	template <class TFile, class T, size_t Width, size_t Height, class Fn = ConvertTo<TFile>>
+	void WriteGridBE(const T (&grid)[Width][Height], Fn toFile = {})
+	{
+		WriteGrid<TFile, std::endian::big>(grid, toFile);
+	}
+
 	~SaveHelper()
 	{
-		const auto encodedLen = codec_get_encoded_len(m_cur_);
-		const char *const password = pfile_get_password();
-		codec_encode(m_buffer_.get(), m_cur_, encodedLen, password);
-		m_mpqWriter.WriteFile(m_szFileName_, m_buffer_.get(), encodedLen);
+		m_snapshot.addFile(m_szFileName_, std::move(m_buffer_), m_cur_);
+	}
+
+private:
+	template <class TFile, std::endian Order, class T, size_t Width, size_t Height, class Fn>
+	void WriteGrid(const T (&grid)[Width][Height], Fn &toFile)
+	{
+		if (!IsValid(sizeof(TFile) * Width * Height)) {
+			// Out of space: write value by value, which keeps whatever still fits.
+			for (size_t j = 0; j < Height; j++) {
+				for (size_t i = 0; i < Width; i++) {
+					if constexpr (Order == std::endian::little)
+						WriteLE<TFile>(toFile(grid[i][j]));
+					else
+						WriteBE<TFile>(toFile(grid[i][j]));
+				}
+			}
+			return;
+		}
+
+		std::array<TFile, Width> row;
+		for (size_t j = 0; j < Height; j++) {
+			for (size_t i = 0; i < Width; i++)
+				row[i] = toFile(grid[i][j]);
+			ConvertByteOrder<Order>(std::span<TFile>(row));
+			memcpy(&m_buffer_[m_cur_], row.data(), sizeof(row));
+			m_cur_ += sizeof(row);
+		}
 	}
 };
 
@@ -265,6 +389,22 @@ struct LevelConversionData {
 	MonsterConversionData monsterConversionData[MaxMonsters];
 };
 
+uint8_t SavedFlagsToFile(DungeonFlag flags)
+{
+	return static_cast<uint8_t>(flags & DungeonFlag::SavedFlags);
+}
+
+DungeonFlag LoadedFlagsFromFile(uint8_t flags)
+{
+	return static_cast<DungeonFlag>(flags) & DungeonFlag::LoadedFlags;
+}
+
+uint8_t AutomapViewFromFile(uint8_t view)
+{
+	const auto automapView = static_cast<MapExplorationType>(view);
+	return automapView == MAP_EXP_OLD ? MAP_EXP_SELF : automapView;
+}
+
 [[nodiscard]] bool LoadItemData(LoadHelper &file, Item &item)
 {
 	item._iSeed = file.NextLE<uint32_t>();
@@ -1851,19 +1991,16 @@ ankerl::unordered_dense::map<uint8_t, uint8_t> SaveDroppedItems(SaveHelper &file
  */
 void SaveDroppedItemLocations(SaveHelper &file, const ankerl::unordered_dense::map<uint8_t, uint8_t> &itemIndexes)
 {
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			file.WriteLE<uint8_t>(itemIndexes.at(dItem[i][j]));
-	}
+	file.WriteGridLE<uint8_t>(dItem, [&](int8_t item) { return itemIndexes.at(item); });
 }
 
 constexpr uint32_t VersionAdditionalMissiles = 0;
 
-void SaveAdditionalMissiles(SaveWriter &saveWriter)
+void SaveAdditionalMissiles(SaveSnapshot &snapshot)
 {
 	constexpr size_t BytesWrittenBySaveMissile = 180;
 	const uint32_t missileCountAdditional = (Missiles.size() > MaxMissilesForSaveGame) ? static_cast<uint32_t>(Missiles.size() - MaxMissilesForSaveGame) : 0;
-	SaveHelper file(saveWriter, "additionalMissiles", sizeof(uint32_t) + sizeof(uint32_t) + (missileCountAdditional * BytesWrittenBySaveMissile));
+	SaveHelper file(snapshot, "additionalMissiles", sizeof(uint32_t) + sizeof(uint32_t) + (missileCountAdditional * BytesWrittenBySaveMissile));
 
 	file.WriteLE<uint32_t>(VersionAdditionalMissiles);
 	file.WriteLE<uint32_t>(missileCountAdditional);
@@ -1898,9 +2035,9 @@ void LoadAdditionalMissiles()
 	}
 }
 
-void SaveLevelSeeds(SaveWriter &saveWriter)
+void SaveLevelSeeds(SaveSnapshot &snapshot)
 {
-	SaveHelper file(saveWriter, "levelseeds", giNumberOfLevels * (sizeof(uint8_t) + sizeof(uint32_t)));
+	SaveHelper file(snapshot, "levelseeds", giNumberOfLevels * (sizeof(uint8_t) + sizeof(uint32_t)));
 
 	for (int i = 0; i < giNumberOfLevels; i++) {
 		file.WriteLE<uint8_t>(LevelSeeds[i] ? 1 : 0);
@@ -1925,7 +2062,7 @@ void LoadLevelSeeds()
 	}
 }
 
-void SaveLevel(SaveWriter &saveWriter, LevelConversionData *levelConversionData)
+void SaveLevel(SaveSnapshot &snapshot, LevelConversionData *levelConversionData)
 {
 	Player &myPlayer = *MyPlayer;
 
@@ -1936,14 +2073,10 @@ void SaveLevel(SaveWriter &saveWriter, LevelConversionData *levelConversionData)
 
 	char szName[MaxMpqPathSize];
 	GetTempLevelNames(szName);
-	SaveHelper file(saveWriter, szName, 256 * 1024);
+	SaveHelper file(snapshot, szName, 256 * 1024);
 
-	if (leveltype != DTYPE_TOWN) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteLE<int8_t>(dCorpse[i][j]);
-		}
-	}
+	if (leveltype != DTYPE_TOWN)
+		file.WriteGridLE<int8_t>(dCorpse);
 
 	file.WriteBE(static_cast<int32_t>(ActiveMonsterCount));
 	file.WriteBE<int32_t>(ActiveItemCount);
@@ -1969,33 +2102,15 @@ void SaveLevel(SaveWriter &saveWriter, LevelConversionData *levelConversionData)
 
 	auto itemIndexes = SaveDroppedItems(file);
 
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			file.WriteLE<uint8_t>(static_cast<uint8_t>(dFlags[i][j] & DungeonFlag::SavedFlags));
-	}
+	file.WriteGridLE<uint8_t>(dFlags, SavedFlagsToFile);
 	SaveDroppedItemLocations(file, itemIndexes);
 
 	if (leveltype != DTYPE_TOWN) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteBE<int32_t>(dMonster[i][j]);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteLE<int8_t>(dObject[i][j]);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteLE<uint8_t>(dLight[i][j]);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteLE<uint8_t>(dPreLight[i][j]);
-		}
-		for (int j = 0; j < DMAXY; j++) {
-			for (int i = 0; i < DMAXX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteLE<uint8_t>(AutomapView[i][j]);
-		}
+		file.WriteGridBE<int32_t>(dMonster);
+		file.WriteGridLE<int8_t>(dObject);
+		file.WriteGridLE<uint8_t>(dLight);
+		file.WriteGridLE<uint8_t>(dPreLight);
+		file.WriteGridLE<uint8_t>(AutomapView);
 	}
 
 	if (!setlevel)
@@ -2004,22 +2119,28 @@ void SaveLevel(SaveWriter &saveWriter, LevelConversionData *levelConversionData)
 		myPlayer._pSLvlVisited[setlvlnum] = true;
 }
 
-std::expected<void, std::string> LoadLevel(LevelConversionData *levelConversionData)
+LoadHelper OpenLevelFile()
 {
+	size_t size;
+	if (std::unique_ptr<std::byte[]> cached = pfile_take_cached_level(size))
+		return LoadHelper(std::move(cached), size);
+
 	char szName[MaxMpqPathSize];
 	std::optional<SaveReader> archive = OpenSaveArchive(gSaveNumber);
 	GetTempLevelNames(szName);
 	if (!archive || !archive->HasFile(szName))
 		GetPermLevelNames(szName);
-	LoadHelper file(std::move(archive), szName);
+	return LoadHelper(std::move(archive), szName);
+}
+
+std::expected<void, std::string> LoadLevel(LevelConversionData *levelConversionData)
+{
+	LoadHelper file = OpenLevelFile();
 	if (!file.IsValid())
 		return std::unexpected(std::string(_("Unable to open save file archive")));
 
 	if (leveltype != DTYPE_TOWN) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dCorpse[i][j] = file.NextLE<int8_t>();
-		}
+		file.NextGridLE<int8_t>(dCorpse);
 		MoveLightsToCorpses();
 	}
 
@@ -2050,39 +2171,19 @@ std::expected<void, std::string> LoadLevel(LevelConversionData *levelConversionD
 
 	LoadDroppedItems(file, savedItemCount);
 
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			dFlags[i][j] = static_cast<DungeonFlag>(file.NextLE<uint8_t>()) & DungeonFlag::LoadedFlags;
-	}
+	file.NextGridLE<uint8_t>(dFlags, LoadedFlagsFromFile);
 
 	// skip dItem indexes, this gets populated in LoadDroppedItems
 	file.Skip<uint8_t>(MAXDUNX * MAXDUNY);
 
 	if (leveltype != DTYPE_TOWN) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			{
-				dMonster[i][j] = file.NextBE<int32_t>();
-				if (dMonster[i][j] > 0 && removedMonsterIds.contains(std::abs(dMonster[i][j]) - 1)) {
-					dMonster[i][j] = 0;
-				}
-			}
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dObject[i][j] = file.NextLE<int8_t>();
-		}
+		file.NextGridBE<int32_t>(dMonster, [&](int32_t monster) {
+			return static_cast<int16_t>(monster > 0 && removedMonsterIds.contains(std::abs(monster) - 1) ? 0 : monster);
+		});
+		file.NextGridLE<int8_t>(dObject);
 		file.Skip<uint8_t>(MAXDUNY * MAXDUNX); // dLight
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dPreLight[i][j] = file.NextLE<uint8_t>();
-		}
-		for (int j = 0; j < DMAXY; j++) {
-			for (int i = 0; i < DMAXX; i++) { // NOLINT(modernize-loop-convert)
-				const auto automapView = static_cast<MapExplorationType>(file.NextLE<uint8_t>());
-				AutomapView[i][j] = automapView == MAP_EXP_OLD ? MAP_EXP_SELF : automapView;
-			}
-		}
+		file.NextGridLE<uint8_t>(dPreLight);
+		file.NextGridLE<uint8_t>(AutomapView, AutomapViewFromFile);
 
 		// No need to load dLight, we can recreate it accurately from LightList
 		memcpy(dLight, dPreLight, sizeof(dLight));                                     // resets the light on entering a level to get rid of incorrect light
@@ -2145,7 +2246,9 @@ std::expected<void, std::string> ConvertLevels(SaveWriter &saveWriter)
 
 		LevelConversionData levelConversionData;
 		RETURN_IF_ERROR(LoadLevel(&levelConversionData));
-		SaveLevel(saveWriter, &levelConversionData);
+		SaveSnapshot snapshot(pfile_get_password());
+		SaveLevel(snapshot, &levelConversionData);
+		snapshot.writeTo(saveWriter);
 	}
 
 	setlevel = true; // Convert quest levels
@@ -2165,7 +2268,9 @@ std::expected<void, std::string> ConvertLevels(SaveWriter &saveWriter)
 
 		LevelConversionData levelConversionData;
 		RETURN_IF_ERROR(LoadLevel(&levelConversionData));
-		SaveLevel(saveWriter, &levelConversionData);
+		SaveSnapshot snapshot(pfile_get_password());
+		SaveLevel(snapshot, &levelConversionData);
+		snapshot.writeTo(saveWriter);
 	}
 
 	gbSkipSync = false;
@@ -2371,9 +2476,9 @@ void LoadHotkeys()
 	myPlayer._pRSplType = static_cast<SpellType>(file.NextLE<uint8_t>());
 }
 
-void SaveHotkeys(SaveWriter &saveWriter, const Player &player)
+void SaveHotkeys(SaveSnapshot &snapshot, const Player &player)
 {
-	SaveHelper file(saveWriter, "hotkeys", HotkeysSize());
+	SaveHelper file(snapshot, "hotkeys", HotkeysSize());
 
 	// Write the number of spell hotkeys
 	file.WriteLE<uint8_t>(static_cast<uint8_t>(NumHotkeys));
@@ -2598,47 +2703,21 @@ std::expected<void, std::string> LoadGame(bool firstflag)
 		uniqueItemFlag = file.NextBool8();
 
 	file.Skip<uint8_t>(MAXDUNY * MAXDUNX); // dLight
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			dFlags[i][j] = static_cast<DungeonFlag>(file.NextLE<uint8_t>()) & DungeonFlag::LoadedFlags;
-	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			dPlayer[i][j] = file.NextLE<int8_t>();
-	}
+	file.NextGridLE<uint8_t>(dFlags, LoadedFlagsFromFile);
+	file.NextGridLE<int8_t>(dPlayer);
 
 	// skip dItem indexes, this gets populated in LoadDroppedItems
 	file.Skip<uint8_t>(MAXDUNX * MAXDUNY);
 
 	if (leveltype != DTYPE_TOWN) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			{
-				dMonster[i][j] = file.NextBE<int32_t>();
-				if (dMonster[i][j] > 0 && removedMonsterIds.contains(std::abs(dMonster[i][j]) - 1)) {
-					dMonster[i][j] = 0;
-				}
-			}
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dCorpse[i][j] = file.NextLE<int8_t>();
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dObject[i][j] = file.NextLE<int8_t>();
-		}
+		file.NextGridBE<int32_t>(dMonster, [&](int32_t monster) {
+			return static_cast<int16_t>(monster > 0 && removedMonsterIds.contains(std::abs(monster) - 1) ? 0 : monster);
+		});
+		file.NextGridLE<int8_t>(dCorpse);
+		file.NextGridLE<int8_t>(dObject);
 		file.Skip<uint8_t>(MAXDUNY * MAXDUNX); // dLight
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dPreLight[i][j] = file.NextLE<uint8_t>();
-		}
-		for (int j = 0; j < DMAXY; j++) {
-			for (int i = 0; i < DMAXX; i++) { // NOLINT(modernize-loop-convert)
-				const auto automapView = static_cast<MapExplorationType>(file.NextLE<uint8_t>());
-				AutomapView[i][j] = automapView == MAP_EXP_OLD ? MAP_EXP_SELF : automapView;
-			}
-		}
+		file.NextGridLE<uint8_t>(dPreLight);
+		file.NextGridLE<uint8_t>(AutomapView, AutomapViewFromFile);
 		file.Skip(MAXDUNX * MAXDUNY); // dMissile
 
 		// No need to load dLight, we can recreate it accurately from LightList
@@ -2687,10 +2766,10 @@ std::expected<void, std::string> LoadGame(bool firstflag)
 	return {};
 }
 
-void SaveHeroItems(SaveWriter &saveWriter, Player &player)
+void SaveHeroItems(SaveSnapshot &snapshot, Player &player)
 {
 	const size_t itemCount = static_cast<size_t>(NUM_INVLOC) + InventoryGridCells + MaxBeltItems;
-	SaveHelper file(saveWriter, "heroitems", (itemCount * (gbIsHellfire ? HellfireItemSaveSize : DiabloItemSaveSize)) + sizeof(uint8_t));
+	SaveHelper file(snapshot, "heroitems", (itemCount * (gbIsHellfire ? HellfireItemSaveSize : DiabloItemSaveSize)) + sizeof(uint8_t));
 
 	file.WriteLE<uint8_t>(gbIsHellfire ? 1 : 0);
 
@@ -2702,7 +2781,7 @@ void SaveHeroItems(SaveWriter &saveWriter, Player &player)
 		SaveItem(file, item);
 }
 
-void SaveStash(SaveWriter &stashWriter)
+void SaveStash(SaveSnapshot &snapshot)
 {
 	const char *filename;
 	if (!gbIsMultiplayer)
@@ -2713,7 +2792,7 @@ void SaveStash(SaveWriter &stashWriter)
 	const int itemSize = (gbIsHellfire ? HellfireItemSaveSize : DiabloItemSaveSize);
 
 	SaveHelper file(
-	    stashWriter,
+	    snapshot,
 	    filename,
 	    sizeof(uint8_t)
 	        + sizeof(uint32_t)
@@ -2759,9 +2838,9 @@ void SaveStash(SaveWriter &stashWriter)
 	file.WriteLE<uint32_t>(static_cast<uint32_t>(Stash.GetPage()));
 }
 
-void SaveGameData(SaveWriter &saveWriter)
+void SaveGameData(SaveSnapshot &snapshot)
 {
-	SaveHelper file(saveWriter, "game", 320 * 1024);
+	SaveHelper file(snapshot, "game", 320 * 1024);
 
 	if (gbIsSpawn && !gbIsHellfire)
 		file.WriteLE<uint32_t>(LoadLE32("SHAR"));
@@ -2867,46 +2946,19 @@ void SaveGameData(SaveWriter &saveWriter)
 	for (const bool uniqueItemFlag : UniqueItemFlags)
 		file.WriteLE<uint8_t>(uniqueItemFlag ? 1 : 0);
 
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			file.WriteLE<uint8_t>(dLight[i][j]);
-	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			file.WriteLE<uint8_t>(static_cast<uint8_t>(dFlags[i][j] & DungeonFlag::SavedFlags));
-	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			file.WriteLE<int8_t>(dPlayer[i][j]);
-	}
+	file.WriteGridLE<uint8_t>(dLight);
+	file.WriteGridLE<uint8_t>(dFlags, SavedFlagsToFile);
+	file.WriteGridLE<int8_t>(dPlayer);
 
 	SaveDroppedItemLocations(file, itemIndexes);
 
 	if (leveltype != DTYPE_TOWN) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteBE<int32_t>(dMonster[i][j]);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteLE<int8_t>(dCorpse[i][j]);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteLE<int8_t>(dObject[i][j]);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)        // NOLINT(modernize-loop-convert)
-				file.WriteLE<uint8_t>(dLight[i][j]); // BUGFIX: dLight got saved already
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteLE<uint8_t>(dPreLight[i][j]);
-		}
-		for (int j = 0; j < DMAXY; j++) {
-			for (int i = 0; i < DMAXX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteLE<uint8_t>(AutomapView[i][j]);
-		}
+		file.WriteGridBE<int32_t>(dMonster);
+		file.WriteGridLE<int8_t>(dCorpse);
+		file.WriteGridLE<int8_t>(dObject);
+		file.WriteGridLE<uint8_t>(dLight); // BUGFIX: dLight got saved already
+		file.WriteGridLE<uint8_t>(dPreLight);
+		file.WriteGridLE<uint8_t>(AutomapView);
 		for (int j = 0; j < MAXDUNY; j++) {
 			for (int i = 0; i < MAXDUNX; i++)                                 // NOLINT(modernize-loop-convert)
 				file.WriteLE<int8_t>(TileContainsMissile({ i, j }) ? -1 : 0); // For backwards compatibility
@@ -2922,8 +2974,8 @@ void SaveGameData(SaveWriter &saveWriter)
 	file.WriteLE<uint8_t>(AutomapActive ? 1 : 0);
 	file.WriteBE<int32_t>(AutoMapScale);
 
-	SaveAdditionalMissiles(saveWriter);
-	SaveLevelSeeds(saveWriter);
+	SaveAdditionalMissiles(snapshot);
+	SaveLevelSeeds(snapshot);
 }
 
 void SaveGame()
@@ -2933,9 +2985,9 @@ void SaveGame()
 	sfile_write_stash();
 }
 
-void SaveLevel(SaveWriter &saveWriter)
+void SaveLevel(SaveSnapshot &snapshot)
 {
-	SaveLevel(saveWriter, nullptr);
+	SaveLevel(snapshot, nullptr);
 }
 
 std::expected<void, std::string> LoadLevel()
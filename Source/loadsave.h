@@ -10,6 +10,7 @@
 
 #include "pfile.h"
 #include "player.h"
+#include "save_snapshot.hpp"
 #include "utils/attributes.h"
 
 namespace devilution {
@@ -36,14 +37,14 @@ void RemoveEmptyInventory(Player &player);
  * @param firstflag Can be set to false if we are simply reloading the current game
  */
 std::expected<void, std::string> LoadGame(bool firstflag);
-void SaveHotkeys(SaveWriter &saveWriter, const Player &player);
-void SaveHeroItems(SaveWriter &saveWriter, Player &player);
-void SaveGameData(SaveWriter &saveWriter);
+void SaveHotkeys(SaveSnapshot &snapshot, const Player &player);
+void SaveHeroItems(SaveSnapshot &snapshot, Player &player);
+void SaveGameData(SaveSnapshot &snapshot);
 void SaveGame();
-void SaveLevel(SaveWriter &saveWriter);
+void SaveLevel(SaveSnapshot &snapshot);
 std::expected<void, std::string> LoadLevel();
 std::expected<void, std::string> ConvertLevels(SaveWriter &saveWriter);
 void LoadStash();
-void SaveStash(SaveWriter &stashWriter);
+void SaveStash(SaveSnapshot &snapshot);
 
 } // namespace devilution
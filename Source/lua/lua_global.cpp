@@ -40,6 +40,7 @@
 #include "options.h"
 #include "plrmsg.h"
 #include "stores.h"
+#include "tables/load_tables.hpp"
 #include "utils/console.h"
 #include "utils/log.hpp"
 #include "utils/str_cat.hpp"
@@ -268,14 +269,7 @@ void LuaReloadActiveMods()
 		ui_sound_init();
 
 	// Reload game data (this can probably be done later in the process to avoid having to reload it)
-	LoadTextData();
-	LoadPlayerDataFiles();
-	LoadSpellData();
-	LoadMissileData();
-	LoadMonsterData();
-	LoadItemData();
-	LoadObjectData();
-	LoadQuestData();
+	LoadDataTables();
 
 	lua::LoadModsComplete();
 }
@@ -8,9 +8,13 @@
 #include "lua/modules/dev/items.hpp"
 #include "lua/modules/dev/level.hpp"
 #include "lua/modules/dev/monsters.hpp"
+#include "lua/modules/dev/mpq_cache.hpp"
 #include "lua/modules/dev/player.hpp"
+#include "lua/modules/dev/profiler.hpp"
 #include "lua/modules/dev/quests.hpp"
+#include "lua/modules/dev/saves.hpp"
 #include "lua/modules/dev/search.hpp"
+#include "lua/modules/dev/sound_cache.hpp"
 #include "lua/modules/dev/towners.hpp"
 
 namespace devilution {
@@ -22,9 +26,13 @@ sol::table LuaDevModule(sol::state_view &lua)
 	LuaSetDoc(table, "items", "", "Item-related commands.", LuaDevItemsModule(lua));
 	LuaSetDoc(table, "level", "", "Level-related commands.", LuaDevLevelModule(lua));
 	LuaSetDoc(table, "monsters", "", "Monster-related commands.", LuaDevMonstersModule(lua));
+	LuaSetDoc(table, "mpqcache", "", "Cache of decompressed MPQ files.", LuaDevMpqCacheModule(lua));
 	LuaSetDoc(table, "player", "", "Player-related commands.", LuaDevPlayerModule(lua));
+	LuaSetDoc(table, "profiler", "", "Frame profiler commands.", LuaDevProfilerModule(lua));
 	LuaSetDoc(table, "quests", "", "Quest-related commands.", LuaDevQuestsModule(lua));
+	LuaSetDoc(table, "saves", "", "Timings of saving the game.", LuaDevSavesModule(lua));
 	LuaSetDoc(table, "search", "", "Search the map for monsters / items / objects.", LuaDevSearchModule(lua));
+	LuaSetDoc(table, "soundcache", "", "Cache of loaded sound effects.", LuaDevSoundCacheModule(lua));
 	LuaSetDoc(table, "towners", "", "Town NPC commands.", LuaDevTownersModule(lua));
 	return table;
 }
@@ -0,0 +1,73 @@
+#ifdef _DEBUG
+#include "lua/modules/dev/mpq_cache.hpp"
+
+#include <cstddef>
+#include <string>
+
+#include <sol/sol.hpp>
+
+#include "lua/metadoc.hpp"
+#include "utils/str_cat.hpp"
+
+#ifndef UNPACKED_MPQS
+#include "mpq/mpq_file_cache.hpp"
+#endif
+
+namespace devilution {
+namespace {
+
+#ifdef UNPACKED_MPQS
+std::string DebugCmdMpqCacheStats()
+{
+	return "Binary compiled without MPQ support.";
+}
+
+std::string DebugCmdMpqCacheBudget(size_t)
+{
+	return "Binary compiled without MPQ support.";
+}
+
+std::string DebugCmdMpqCacheClear()
+{
+	return "Binary compiled without MPQ support.";
+}
+#else
+std::string DebugCmdMpqCacheStats()
+{
+	const MpqFileCache::Stats stats = GetMpqFileCache().stats();
+	if (stats.budget == 0)
+		return "MPQ file cache is disabled.";
+	const size_t lookups = stats.hits + stats.misses;
+	return StrCat(stats.entries, " files, ", stats.bytes / 1024, " of ", stats.budget / 1024, " KiB\n",
+	    stats.hits, " hits, ", stats.misses, " misses (", lookups == 0 ? 0 : stats.hits * 100 / lookups, "% hit rate), ",
+	    stats.evictions, " evictions");
+}
+
+std::string DebugCmdMpqCacheBudget(size_t kib)
+{
+	GetMpqFileCache().setBudget(kib * 1024);
+	if (kib == 0)
+		return "MPQ file cache disabled.";
+	return StrCat("MPQ file cache budget set to ", kib, " KiB.");
+}
+
+std::string DebugCmdMpqCacheClear()
+{
+	GetMpqFileCache().clear();
+	return "MPQ file cache cleared.";
+}
+#endif
+
+} // namespace
+
+sol::table LuaDevMpqCacheModule(sol::state_view &lua)
+{
+	sol::table table = lua.create_table();
+	LuaSetDocFn(table, "budget", "(kib: number)", "Set the memory budget of the cache, 0 disables it.", &DebugCmdMpqCacheBudget);
+	LuaSetDocFn(table, "clear", "()", "Drop all cached files and reset the counters.", &DebugCmdMpqCacheClear);
+	LuaSetDocFn(table, "stats", "()", "Show the cache size and hit/miss counters.", &DebugCmdMpqCacheStats);
+	return table;
+}
+
+} // namespace devilution
+#endif // _DEBUG
@@ -72,6 +72,8 @@ std::string DebugSetPlayerTrn(std::string_view path)
 		}
 	}
 	debugTRN = path;
+	// Other players may still share the sprites with the previous TRN.
+	ClearPlayerGFXCache();
 	Player &player = *MyPlayer;
 	InitPlayerGFX(player);
 	StartStand(player, player._pdir);
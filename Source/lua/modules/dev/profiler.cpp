@@ -0,0 +1,50 @@
+#ifdef _DEBUG
+#include "lua/modules/dev/profiler.hpp"
+
+#include <string>
+
+#include <sol/sol.hpp>
+
+#include "lua/metadoc.hpp"
+#include "utils/frame_profiler.hpp"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+namespace {
+
+std::string DebugCmdProfilerStart()
+{
+#ifdef DISABLE_FRAME_PROFILER
+	return "Binary compiled without frame profiler support.";
+#else
+	StartFrameProfiler();
+	return "Frame profiler started.";
+#endif
+}
+
+std::string DebugCmdProfilerStop()
+{
+	StopFrameProfiler();
+	return "Frame profiler stopped.";
+}
+
+std::string DebugCmdProfilerDump(std::string path)
+{
+	if (!WriteFrameProfilerTrace(path.c_str()))
+		return StrCat("Failed to write ", path);
+	return StrCat("Trace written to ", path);
+}
+
+} // namespace
+
+sol::table LuaDevProfilerModule(sol::state_view &lua)
+{
+	sol::table table = lua.create_table();
+	LuaSetDocFn(table, "dump", "(path: string)", "Write the recorded frame timings as a Chrome trace (chrome://tracing, Perfetto).", &DebugCmdProfilerDump);
+	LuaSetDocFn(table, "start", "()", "Start recording frame timings, discarding earlier ones.", &DebugCmdProfilerStart);
+	LuaSetDocFn(table, "stop", "()", "Stop recording frame timings.", &DebugCmdProfilerStop);
+	return table;
+}
+
+} // namespace devilution
+#endif // _DEBUG
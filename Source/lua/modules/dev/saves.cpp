@@ -0,0 +1,52 @@
+#ifdef _DEBUG
+#include "lua/modules/dev/saves.hpp"
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#include <sol/sol.hpp>
+
+#include "lua/metadoc.hpp"
+#include "save_snapshot.hpp"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+namespace {
+
+void AppendStage(std::string &out, std::string_view name, const SaveStats::Stage &stage, size_t saves)
+{
+	using std::chrono::microseconds;
+	StrAppend(out, "\n", name, ": last ", std::chrono::duration_cast<microseconds>(stage.last).count(),
+	    " us, max ", std::chrono::duration_cast<microseconds>(stage.max).count(),
+	    " us, average ", saves == 0 ? 0 : std::chrono::duration_cast<microseconds>(stage.total).count() / saves, " us");
+}
+
+std::string DebugCmdSavesStats()
+{
+	const SaveStats stats = GetSaveStats();
+	std::string result = StrCat(stats.saves, " saves, ", stats.bytes / 1024, " KiB");
+	AppendStage(result, "Snapshot", stats.snapshot, stats.saves);
+	AppendStage(result, "Write", stats.write, stats.saves);
+	StrAppend(result, "\nWaited for writes: ", std::chrono::duration_cast<std::chrono::microseconds>(stats.waited).count(), " us");
+	return result;
+}
+
+std::string DebugCmdSavesReset()
+{
+	ResetSaveStats();
+	return "Save timings reset.";
+}
+
+} // namespace
+
+sol::table LuaDevSavesModule(sol::state_view &lua)
+{
+	sol::table table = lua.create_table();
+	LuaSetDocFn(table, "reset", "()", "Reset the save timings.", &DebugCmdSavesReset);
+	LuaSetDocFn(table, "stats", "()", "Show how long the snapshot and write stages of saving took.", &DebugCmdSavesStats);
+	return table;
+}
+
+} // namespace devilution
+#endif // _DEBUG
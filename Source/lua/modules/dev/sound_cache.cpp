@@ -0,0 +1,64 @@
+#ifdef _DEBUG
+#include "lua/modules/dev/sound_cache.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <sol/sol.hpp>
+
+#include "engine/sound.h"
+#include "lua/metadoc.hpp"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+namespace {
+
+constexpr std::string_view CategoryNames[NumSoundCategories] = { "Effects", "UI", "Hero", "Monsters" };
+
+std::string DebugCmdSoundCacheStats()
+{
+	const SoundCacheStats stats = GetSoundCache().stats();
+	std::string result;
+	if (stats.budget == 0)
+		StrAppend(result, stats.bytes / 1024, " KiB, no budget");
+	else
+		StrAppend(result, stats.bytes / 1024, " of ", stats.budget / 1024, " KiB");
+	StrAppend(result, ", ", stats.evictions, " evictions, ", stats.dropped, " prefetches dropped");
+	for (size_t i = 0; i < NumSoundCategories; ++i) {
+		const SoundCacheStats::Category &category = stats.categories[i];
+		const size_t lookups = category.hits + category.misses;
+		StrAppend(result, "\n", CategoryNames[i], ": ", category.entries, " sounds, ", category.bytes / 1024, " KiB, ",
+		    category.hits, " hits, ", category.misses, " misses (", lookups == 0 ? 0 : category.hits * 100 / lookups, "% hit rate)");
+	}
+	return result;
+}
+
+std::string DebugCmdSoundCacheBudget(size_t kib)
+{
+	GetSoundCache().setBudget(kib * 1024);
+	if (kib == 0)
+		return "Sound cache budget removed.";
+	return StrCat("Sound cache budget set to ", kib, " KiB.");
+}
+
+std::string DebugCmdSoundCacheClear()
+{
+	ReleaseCachedSounds();
+	GetSoundCache().resetStats();
+	return "Sound cache cleared.";
+}
+
+} // namespace
+
+sol::table LuaDevSoundCacheModule(sol::state_view &lua)
+{
+	sol::table table = lua.create_table();
+	LuaSetDocFn(table, "budget", "(kib: number)", "Set the memory budget of the cache, 0 removes it.", &DebugCmdSoundCacheBudget);
+	LuaSetDocFn(table, "clear", "()", "Unload all sounds and reset the counters.", &DebugCmdSoundCacheClear);
+	LuaSetDocFn(table, "stats", "()", "Show the resident size and hit rate of each category of sounds.", &DebugCmdSoundCacheStats);
+	return table;
+}
+
+} // namespace devilution
+#endif // _DEBUG
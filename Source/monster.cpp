@@ -40,7 +40,9 @@
 #include "dvlnet/leaveinfo.hpp"
 #include "effects.h"
 #include "engine/animationinfo.h"
+#include "engine/asset_prefetch.hpp"
 #include "engine/backbuffer_state.hpp"
+#include "engine/clx_cache.hpp"
 #include "engine/clx_sprite.hpp"
 #include "engine/direction.hpp"
 #include "engine/lighting_defs.hpp"
@@ -3207,16 +3209,96 @@ bool UpdateModeStance(Monster &monster)
 	}
 }
 
-MonsterSpritesData LoadMonsterSpritesData(const MonsterData &monsterData)
+/** @brief Monster sprites that are being loaded in the background, keyed by sprite ID. */
+AssetPrefetcher<MonsterSpritesData> MonsterSpritesPrefetcher;
+
+void GetMonsterSoundPath(char (&path)[64], const MonsterData &data, MonsterSound mode, size_t variant)
+{
+	constexpr std::string_view Prefixes[] {
+		"a", // Attack
+		"h", // Hit
+		"d", // Death
+		"s", // Special
+	};
+	*BufCopy(path, "monsters\\", data.soundPath(), Prefixes[static_cast<size_t>(mode)], variant + 1, ".wav") = '\0';
+}
+
+#ifndef UNPACKED_MPQS
+/**
+ * @brief The key of the converted sprites in the CLX cache, which covers all of the monster's animation files.
+ */
+std::optional<std::string> MonsterSpritesCacheKey(const MonsterData &monsterData, size_t numAnims)
+{
+	if (!IsClxCacheEnabled())
+		return std::nullopt;
+	std::string key = StrCat("monster|", monsterData.width, "|");
+	const FileNameWithCharAffixGenerator pathFn({ "monsters\\", monsterData.spritePath() }, DEVILUTIONX_CL2_EXT, Animletter);
+	for (size_t i = 0; i < numAnims; ++i) {
+		if (monsterData.hasAnim(i) && !AppendClxCacheKey(key, pathFn(i)))
+			return std::nullopt;
+	}
+	return key;
+}
+
+/**
+ * @brief Reads the sprites from the CLX cache, where they are stored as the offsets followed by the data.
+ */
+bool LoadCachedMonsterSpritesData(std::string_view key, size_t numLoadedAnims, MonsterSpritesData &result)
+{
+	const std::optional<CachedClxData> cached = LoadCachedClxData(key);
+	const size_t offsetsSize = (numLoadedAnims + 1) * sizeof(uint32_t);
+	if (!cached || cached->size < offsetsSize)
+		return false;
+	memcpy(result.offsets.data(), cached->data.get(), offsetsSize);
+	const size_t dataSize = cached->size - offsetsSize;
+	// The offsets slice `result.data`, so reject a truncated or corrupt cache file rather than read out of bounds.
+	if (result.offsets[0] != 0 || result.offsets[numLoadedAnims] != dataSize)
+		return false;
+	for (size_t i = 0; i < numLoadedAnims; ++i) {
+		if (result.offsets[i] > result.offsets[i + 1])
+			return false;
+	}
+	result.data = std::unique_ptr<std::byte[]>(new std::byte[dataSize]);
+	memcpy(result.data.get(), &cached->data[offsetsSize], dataSize);
+	return true;
+}
+
+void StoreCachedMonsterSpritesData(std::string_view key, size_t numLoadedAnims, const MonsterSpritesData &sprites)
+{
+	const size_t offsetsSize = (numLoadedAnims + 1) * sizeof(uint32_t);
+	const size_t dataSize = sprites.offsets[numLoadedAnims];
+	const std::unique_ptr<uint8_t[]> blob { new uint8_t[offsetsSize + dataSize] };
+	memcpy(blob.get(), sprites.offsets.data(), offsetsSize);
+	memcpy(&blob[offsetsSize], sprites.data.get(), dataSize);
+	StoreCachedClxData(key, blob.get(), offsetsSize + dataSize, /*numLists=*/0);
+}
+#endif
+
+/**
+ * @param threadsafe Load from a worker thread. Returns empty data instead of raising an error if the files can't be read.
+ */
+MonsterSpritesData LoadMonsterSpritesData(const MonsterData &monsterData, bool threadsafe = false)
 {
 	const size_t numAnims = GetNumAnims(monsterData);
 
 	MonsterSpritesData result;
-	result.data = MultiFileLoader<MonsterSpritesData::MaxAnims> {}(
+#ifndef UNPACKED_MPQS
+	size_t numLoadedAnims = 0;
+	for (size_t i = 0; i < numAnims; ++i) {
+		if (monsterData.hasAnim(i))
+			++numLoadedAnims;
+	}
+	const std::optional<std::string> cacheKey = MonsterSpritesCacheKey(monsterData, numAnims);
+	if (cacheKey && LoadCachedMonsterSpritesData(*cacheKey, numLoadedAnims, result))
+		return result;
+#endif
+	result.data = MultiFileLoader<MonsterSpritesData::MaxAnims> { threadsafe }(
 	    numAnims,
 	    FileNameWithCharAffixGenerator({ "monsters\\", monsterData.spritePath() }, DEVILUTIONX_CL2_EXT, Animletter),
 	    result.offsets.data(),
 	    [&monsterData](size_t index) { return monsterData.hasAnim(index); });
+	if (result.data == nullptr)
+		return result;
 
 #ifndef UNPACKED_MPQS
 	// Convert CL2 to CLX:
@@ -3240,11 +3322,27 @@ MonsterSpritesData LoadMonsterSpritesData(const MonsterData &monsterData)
 	for (size_t i = 0; i < clxData.size(); ++i) {
 		memcpy(&result.data[result.offsets[i]], clxData[i].data(), clxData[i].size());
 	}
+	if (cacheKey)
+		StoreCachedMonsterSpritesData(*cacheKey, clxData.size(), result);
 #endif
 
 	return result;
 }
 
+/**
+ * @brief Adopts the sprites prefetched by `AddMonsterType`, or loads them now if there are none.
+ */
+MonsterSpritesData TakeOrLoadMonsterSpritesData(const MonsterData &monsterData)
+{
+	std::optional<MonsterSpritesData> prefetched = MonsterSpritesPrefetcher.take(static_cast<size_t>(monsterData.spriteId));
+	if (prefetched && prefetched->data != nullptr) {
+		LevelAssetPrefetchStats.prefetched++;
+		return *std::move(prefetched);
+	}
+	LevelAssetPrefetchStats.loadedOnDemand++;
+	return LoadMonsterSpritesData(monsterData);
+}
+
 void EnsureMonsterIndexIsActive(size_t monsterId)
 {
 	assert(monsterId < MaxMonsters);
@@ -3308,6 +3406,13 @@ std::expected<size_t, std::string> AddMonsterType(_monster_id type, placeflag pl
 		}
 
 		RETURN_IF_ERROR(InitMonsterSND(monsterType));
+
+		// Start reading the sprites now, they are picked up by `InitAllMonsterGFX` once the level is generated.
+		if (!HeadlessMode) {
+			MonsterSpritesPrefetcher.prefetch(static_cast<size_t>(monsterData.spriteId), [&monsterData]() {
+				return LoadMonsterSpritesData(monsterData, /*threadsafe=*/true);
+			});
+		}
 	}
 
 	monsterType.placeFlags |= placeflag;
@@ -3416,6 +3521,7 @@ void InitLevelMonsters()
 {
 	LevelMonsterTypeCount = 0;
 	monstimgtot = 0;
+	MonsterSpritesPrefetcher.clear();
 
 	for (CMonster &levelMonsterType : LevelMonsterTypes) {
 		levelMonsterType.placeFlags = 0;
@@ -3515,30 +3621,22 @@ std::expected<void, std::string> GetLevelMTypes()
 	return {};
 }
 
-std::expected<void, std::string> InitMonsterSND(CMonster &monsterType)
+std::expected<void, std::string> InitMonsterSND(const CMonster &monsterType)
 {
 	if (!gbSndInited)
 		return {};
 
-	const char *prefixes[] {
-		"a", // Attack
-		"h", // Hit
-		"d", // Death
-		"s", // Special
-	};
-
 	const MonsterData &data = MonstersData[monsterType.type];
-	const std::string_view soundSuffix = data.soundPath();
-
-	for (int i = 0; i < 4; i++) {
-		const std::string_view prefix = prefixes[i];
-		if (prefix == "s" && !data.hasSpecialSound)
+	for (size_t i = 0; i < 4; i++) {
+		const auto mode = static_cast<MonsterSound>(i);
+		if (mode == MonsterSound::Special && !data.hasSpecialSound)
 			continue;
 
-		for (int j = 0; j < 2; j++) {
+		for (size_t j = 0; j < 2; j++) {
 			char path[64];
-			*BufCopy(path, "monsters\\", soundSuffix, prefix, j + 1, ".wav") = '\0';
-			ASSIGN_OR_RETURN(monsterType.sounds[i][j], SoundFileLoadWithStatus(path));
+			GetMonsterSoundPath(path, data, mode, j);
+			RETURN_IF_ERROR(CheckSoundFile(path));
+			PrefetchSound(MonsterSoundKey(monsterType.type, i, j), SoundCategory::Monster, path);
 		}
 	}
 	return {};
@@ -3552,7 +3650,7 @@ std::expected<void, std::string> InitMonsterGFX(CMonster &monsterType, MonsterSp
 	const _monster_id mtype = monsterType.type;
 	const MonsterData &monsterData = MonstersData[mtype];
 	if (spritesData.data == nullptr)
-		spritesData = LoadMonsterSpritesData(monsterData);
+		spritesData = TakeOrLoadMonsterSpritesData(monsterData);
 	monsterType.animData = std::move(spritesData.data);
 
 	const size_t numAnims = GetNumAnims(monsterData);
@@ -3636,7 +3734,7 @@ std::expected<void, std::string> InitAllMonsterGFX()
 		CMonster &firstMonster = LevelMonsterTypes[monsterTypes[0]];
 		if (firstMonster.animData != nullptr)
 			continue;
-		MonsterSpritesData spritesData = LoadMonsterSpritesData(firstMonster.data());
+		MonsterSpritesData spritesData = TakeOrLoadMonsterSpritesData(firstMonster.data());
 		const size_t spritesDataSize = spritesData.offsets[GetNumAnimsWithGraphics(firstMonster.data())];
 		for (size_t i = 1; i < monsterTypes.size(); ++i) {
 			MonsterSpritesData spritesDataCopy { std::unique_ptr<std::byte[]> { new std::byte[spritesDataSize] }, spritesData.offsets };
@@ -3649,6 +3747,7 @@ std::expected<void, std::string> InitAllMonsterGFX()
 		RETURN_IF_ERROR(InitMonsterGFX(firstMonster, std::move(spritesData)));
 	}
 	LogVerbose(" Total monster graphics:                 {:>4d} KiB {:>4d} KiB", totalUniqueBytes / 1024, totalBytes / 1024);
+	MonsterSpritesPrefetcher.clear();
 
 	if (totalUniqueBytes > 0) {
 		// we loaded new sprites, check if we need to update existing monsters
@@ -4344,13 +4443,8 @@ void FreeMonsters()
 		for (AnimStruct &animData : monsterType.anims) {
 			animData.sprites = std::nullopt;
 		}
-
-		for (auto &variants : monsterType.sounds) {
-			for (auto &sound : variants) {
-				sound = nullptr;
-			}
-		}
 	}
+	ReleaseCachedSounds(SoundCategory::Monster);
 }
 
 bool DirOK(const Monster &monster, Direction mdir)
@@ -4564,16 +4658,22 @@ void PlayEffect(Monster &monster, MonsterSound mode)
 		return;
 	}
 
-	TSnd *snd = monster.type().sounds[static_cast<size_t>(mode)][sndIdx].get();
-	if (snd == nullptr || snd->isPlaying()) {
+	const MonsterData &data = monster.data();
+	if (mode == MonsterSound::Special && !data.hasSpecialSound)
 		return;
-	}
 
 	int lVolume = 0;
 	int lPan = 0;
 	if (!CalculateSoundPosition(monster.position.tile, &lVolume, &lPan))
 		return;
 
+	char path[64];
+	GetMonsterSoundPath(path, data, mode, static_cast<size_t>(sndIdx));
+	TSnd *snd = GetCachedSound(MonsterSoundKey(monster.type().type, static_cast<size_t>(mode), static_cast<size_t>(sndIdx)), SoundCategory::Monster, path);
+	if (snd == nullptr || snd->isPlaying()) {
+		return;
+	}
+
 	snd_play_snd(snd, lVolume, lPan, *GetOptions().Audio.soundVolume);
 }
 
@@ -27,6 +27,7 @@
 #include "tables/monstdat.h"
 #include "tables/spelldat.h"
 #include "tables/textdat.h"
+#include "utils/attributes.h"
 #include "utils/language.h"
 
 namespace devilution {
@@ -186,7 +187,6 @@ struct MonsterSpritesData {
 struct CMonster {
 	std::unique_ptr<std::byte[]> animData;
 	AnimStruct anims[6];
-	std::unique_ptr<TSnd> sounds[4][2];
 
 	_monster_id type;
 	/** placeflag enum as a flags*/
@@ -207,7 +207,7 @@ struct CMonster {
 	}
 };
 
-extern CMonster LevelMonsterTypes[MaxLvlMTypes];
+extern DVL_API_FOR_TEST CMonster LevelMonsterTypes[MaxLvlMTypes];
 
 struct Monster { // note: missing field _mAFNum
 	std::unique_ptr<uint8_t[]> uniqueMonsterTRN;
@@ -489,10 +489,10 @@ struct Monster { // note: missing field _mAFNum
 	}
 };
 
-extern size_t LevelMonsterTypeCount;
-extern Monster Monsters[MaxMonsters];
-extern unsigned ActiveMonsters[MaxMonsters];
-extern size_t ActiveMonsterCount;
+extern DVL_API_FOR_TEST size_t LevelMonsterTypeCount;
+extern DVL_API_FOR_TEST Monster Monsters[MaxMonsters];
+extern DVL_API_FOR_TEST unsigned ActiveMonsters[MaxMonsters];
+extern DVL_API_FOR_TEST size_t ActiveMonsterCount;
 extern int MonsterKillCounts[NUM_MAX_MTYPES];
 extern bool sgbSaveSoundOn;
 
@@ -504,7 +504,11 @@ inline std::expected<size_t, std::string> AddMonsterType(UniqueMonsterType uniqu
 {
 	return AddMonsterType(UniqueMonstersData[static_cast<size_t>(uniqueType)].mtype, placeflag);
 }
-std::expected<void, std::string> InitMonsterSND(CMonster &monsterType);
+/**
+ * @brief Starts loading the sounds of a monster type, they are otherwise loaded when first played.
+ * @return An error if any of the sounds is missing
+ */
+std::expected<void, std::string> InitMonsterSND(const CMonster &monsterType);
 std::expected<void, std::string> InitMonsterGFX(CMonster &monsterType, MonsterSpritesData &&spritesData = {});
 std::expected<void, std::string> InitAllMonsterGFX();
 void WeakenNaKrul();
@@ -0,0 +1,90 @@
+#include "mpq/mpq_file_cache.hpp"
+
+#include <mutex>
+#include <utility>
+
+namespace devilution {
+
+MpqFileCache::MpqFileCache(size_t budget)
+    : budget_(budget)
+{
+}
+
+bool MpqFileCache::accepts(size_t size) const
+{
+	const std::lock_guard<SdlMutex> lock(mutex_);
+	return size != 0 && size <= budget_ / MaxEntryFraction;
+}
+
+std::shared_ptr<const std::byte[]> MpqFileCache::find(uint32_t archiveId, uint32_t hashIndex, size_t &size)
+{
+	const std::lock_guard<SdlMutex> lock(mutex_);
+	if (budget_ == 0)
+		return nullptr;
+	const auto it = index_.find(MakeKey(archiveId, hashIndex));
+	if (it == index_.end()) {
+		++misses_;
+		return nullptr;
+	}
+	++hits_;
+	lru_.splice(lru_.begin(), lru_, it->second);
+	size = it->second->size;
+	return it->second->data;
+}
+
+void MpqFileCache::insert(uint32_t archiveId, uint32_t hashIndex, std::shared_ptr<const std::byte[]> data, size_t size)
+{
+	const std::lock_guard<SdlMutex> lock(mutex_);
+	if (size == 0 || size > budget_ / MaxEntryFraction)
+		return;
+	const uint64_t key = MakeKey(archiveId, hashIndex);
+	if (index_.contains(key))
+		return; // Another thread read the same file in the meantime.
+	evictToFit(budget_ - size);
+	lru_.push_front(Entry { key, std::move(data), size });
+	index_.emplace(key, lru_.begin());
+	bytes_ += size;
+}
+
+void MpqFileCache::setBudget(size_t budget)
+{
+	const std::lock_guard<SdlMutex> lock(mutex_);
+	budget_ = budget;
+	evictToFit(budget);
+}
+
+void MpqFileCache::clear()
+{
+	const std::lock_guard<SdlMutex> lock(mutex_);
+	lru_.clear();
+	index_.clear();
+	bytes_ = 0;
+	hits_ = 0;
+	misses_ = 0;
+	evictions_ = 0;
+}
+
+MpqFileCache::Stats MpqFileCache::stats() const
+{
+	const std::lock_guard<SdlMutex> lock(mutex_);
+	return Stats { hits_, misses_, evictions_, lru_.size(), bytes_, budget_ };
+}
+
+void MpqFileCache::evictToFit(size_t budget)
+{
+	while (bytes_ > budget) {
+		const Entry &entry = lru_.back();
+		bytes_ -= entry.size;
+		index_.erase(entry.key);
+		lru_.pop_back();
+		++evictions_;
+	}
+}
+
+MpqFileCache &GetMpqFileCache()
+{
+	static MpqFileCache cache(DEVILUTIONX_MPQ_CACHE_SIZE);
+	return cache;
+}
+
+} // namespace devilution
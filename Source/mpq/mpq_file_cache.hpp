@@ -0,0 +1,105 @@
+/**
+ * @file mpq_file_cache.hpp
+ *
+ * Size-bounded cache of decompressed MPQ files.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+
+#include <ankerl/unordered_dense.h>
+
+#include "utils/sdl_mutex.h"
+
+#ifndef DEVILUTIONX_MPQ_CACHE_SIZE
+#define DEVILUTIONX_MPQ_CACHE_SIZE (32 * 1024 * 1024)
+#endif
+
+namespace devilution {
+
+/**
+ * @brief Keeps the most recently read MPQ files in memory, so that reading them again
+ * does not decompress them again.
+ *
+ * Files are identified by their archive and hash table index.
+ * All methods are thread-safe.
+ */
+class MpqFileCache {
+public:
+	struct Stats {
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t evictions = 0;
+		size_t entries = 0;
+		size_t bytes = 0;
+		size_t budget = 0;
+	};
+
+	/** @brief A single file may use at most this fraction of the budget. */
+	static constexpr size_t MaxEntryFraction = 4;
+
+	/** @param budget Maximum total size of the cached files in bytes, 0 disables the cache */
+	explicit MpqFileCache(size_t budget);
+
+	MpqFileCache(const MpqFileCache &) = delete;
+	MpqFileCache &operator=(const MpqFileCache &) = delete;
+
+	/**
+	 * @brief Whether a file of the given size would be cached.
+	 *
+	 * Large files, such as music, are left to be streamed.
+	 */
+	[[nodiscard]] bool accepts(size_t size) const;
+
+	/**
+	 * @brief Returns the cached contents of a file and marks it as recently used.
+	 * @return `nullptr` on a miss
+	 */
+	std::shared_ptr<const std::byte[]> find(uint32_t archiveId, uint32_t hashIndex, size_t &size);
+
+	/**
+	 * @brief Caches the contents of a file, evicting the least recently used files to stay within the budget.
+	 */
+	void insert(uint32_t archiveId, uint32_t hashIndex, std::shared_ptr<const std::byte[]> data, size_t size);
+
+	/** @brief Changes the budget, evicting files as needed. 0 disables the cache. */
+	void setBudget(size_t budget);
+
+	/** @brief Drops all files and resets the counters. */
+	void clear();
+
+	[[nodiscard]] Stats stats() const;
+
+private:
+	struct Entry {
+		uint64_t key;
+		std::shared_ptr<const std::byte[]> data;
+		size_t size;
+	};
+
+	static uint64_t MakeKey(uint32_t archiveId, uint32_t hashIndex)
+	{
+		return (static_cast<uint64_t>(archiveId) << 32) | hashIndex;
+	}
+
+	/** @pre `mutex_` is locked */
+	void evictToFit(size_t budget);
+
+	mutable SdlMutex mutex_;
+	/** @brief Most recently used first. */
+	std::list<Entry> lru_;
+	ankerl::unordered_dense::map<uint64_t, std::list<Entry>::iterator> index_;
+	size_t budget_;
+	size_t bytes_ = 0;
+	size_t hits_ = 0;
+	size_t misses_ = 0;
+	size_t evictions_ = 0;
+};
+
+/** @brief The cache shared by all game data archives, sized by `DEVILUTIONX_MPQ_CACHE_SIZE`. */
+MpqFileCache &GetMpqFileCache();
+
+} // namespace devilution
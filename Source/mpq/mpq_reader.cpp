@@ -1,18 +1,42 @@
 #include "mpq/mpq_reader.hpp"
 
+#include <array>
+#include <atomic>
 #include <cerrno>
 #include <cstring>
 #include <limits>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
+#include <ankerl/unordered_dense.h>
 #include <mpqfs/mpqfs.h>
 
+#include "mpq/mpq_file_cache.hpp"
+#include "utils/endian_read.hpp"
+#include "utils/mapped_file.hpp"
 #include "utils/str_cat.hpp"
 
 namespace devilution {
 
+/**
+ * @brief The files of an archive that are stored without compression or encryption,
+ * read straight from a memory mapping of the archive file.
+ */
+struct MpqMappedFiles {
+	struct Entry {
+		size_t offset;
+		uint32_t size;
+	};
+
+	MappedFile file;
+	/** @brief Keyed by the two name hashes of each file, see `MpqNameKey`. */
+	ankerl::unordered_dense::map<uint64_t, Entry> entries;
+};
+
 namespace {
 
 // Helper: NUL-terminate a string_view into a stack buffer.
@@ -36,17 +60,157 @@ std::string FormatMpqfsError(mpqfs_error_code code)
 	return mpqfs_error_message(code);
 }
 
+// IDs are never reused, so files cached for a closed archive can't be mistaken for another one's.
+std::atomic<uint32_t> NextArchiveId { 1 };
+
+// mpqfs doesn't tell where a file is in the archive, so the tables are read here as well.
+constexpr size_t MpqHeaderAlignment = 512;
+constexpr size_t MpqHeaderSizeV0 = 32;
+constexpr size_t MpqHeaderSizeV1 = 44;
+constexpr uint32_t MpqHashTableKey = 0xC3AF3770;  // Hash of "(hash table)"
+constexpr uint32_t MpqBlockTableKey = 0xEC83B3A3; // Hash of "(block table)"
+constexpr uint32_t MpqHashNameA = 1;
+constexpr uint32_t MpqHashNameB = 2;
+
+constexpr uint32_t MpqFileImplode = 0x00000100;
+constexpr uint32_t MpqFileCompress = 0x00000200;
+constexpr uint32_t MpqFileEncrypted = 0x00010000;
+constexpr uint32_t MpqFilePatchFile = 0x00100000;
+constexpr uint32_t MpqFileDeleteMarker = 0x02000000;
+constexpr uint32_t MpqFileSectorCrc = 0x04000000;
+constexpr uint32_t MpqFileExists = 0x80000000;
+constexpr uint32_t MpqFileNotStored = MpqFileImplode | MpqFileCompress | MpqFileEncrypted | MpqFilePatchFile | MpqFileDeleteMarker | MpqFileSectorCrc;
+
+const std::array<uint32_t, 0x500> &GetMpqCryptTable()
+{
+	static const std::array<uint32_t, 0x500> Table = []() {
+		std::array<uint32_t, 0x500> table;
+		uint32_t seed = 0x00100001;
+		for (uint32_t index1 = 0; index1 < 0x100; ++index1) {
+			for (uint32_t index2 = index1, i = 0; i < 5; ++i, index2 += 0x100) {
+				seed = (seed * 125 + 3) % 0x2AAAAB;
+				const uint32_t high = (seed & 0xFFFF) << 16;
+				seed = (seed * 125 + 3) % 0x2AAAAB;
+				table[index2] = high | (seed & 0xFFFF);
+			}
+		}
+		return table;
+	}();
+	return Table;
+}
+
+uint32_t HashMpqFileName(std::string_view filename, uint32_t hashType)
+{
+	const std::array<uint32_t, 0x500> &cryptTable = GetMpqCryptTable();
+	uint32_t seed1 = 0x7FED7FED;
+	uint32_t seed2 = 0xEEEEEEEE;
+	for (char c : filename) {
+		uint32_t ch = static_cast<uint8_t>(c);
+		if (ch >= 'a' && ch <= 'z')
+			ch -= 'a' - 'A';
+		else if (ch == '/')
+			ch = '\\';
+		seed1 = cryptTable[hashType * 0x100 + ch] ^ (seed1 + seed2);
+		seed2 = ch + seed1 + seed2 + (seed2 << 5) + 3;
+	}
+	return seed1;
+}
+
+uint64_t MpqNameKey(uint32_t nameA, uint32_t nameB)
+{
+	return (static_cast<uint64_t>(nameA) << 32) | nameB;
+}
+
+/** @brief Reads and decrypts a hash or block table, `count` entries of 4 words each. */
+std::vector<uint32_t> ReadMpqTable(const char *data, size_t count, uint32_t key)
+{
+	const std::array<uint32_t, 0x500> &cryptTable = GetMpqCryptTable();
+	std::vector<uint32_t> table(count * 4);
+	uint32_t seed = 0xEEEEEEEE;
+	for (uint32_t &word : table) {
+		seed += cryptTable[0x400 + (key & 0xFF)];
+		word = LoadLE32(data) ^ (key + seed);
+		data += 4;
+		key = ((~key << 0x15) + 0x11111111) | (key >> 0x0B);
+		seed = word + seed + (seed << 5) + 3;
+	}
+	return table;
+}
+
+/**
+ * @return `nullptr` if the archive can't be mapped, is in a format that isn't supported here,
+ * or has no files that are stored as is
+ */
+std::shared_ptr<const MpqMappedFiles> MapStoredFiles(const char *path)
+{
+	std::optional<MappedFile> file = MappedFile::Open(path);
+	if (!file)
+		return nullptr;
+	const char *data = file->data();
+	const size_t size = file->size();
+
+	size_t archiveOffset = 0;
+	while (archiveOffset + MpqHeaderSizeV0 <= size && std::memcmp(data + archiveOffset, "MPQ\x1A", 4) != 0)
+		archiveOffset += MpqHeaderAlignment;
+	if (archiveOffset + MpqHeaderSizeV0 > size)
+		return nullptr;
+	const char *header = data + archiveOffset;
+	const uint16_t formatVersion = LoadLE16(header + 12);
+	if (formatVersion > 1)
+		return nullptr;
+	// Archives larger than 4 GiB are left to mpqfs.
+	if (formatVersion == 1
+	    && (archiveOffset + MpqHeaderSizeV1 > size || LoadLE32(header + 32) != 0 || LoadLE32(header + 36) != 0 || LoadLE32(header + 40) != 0))
+		return nullptr;
+	const size_t hashTableOffset = archiveOffset + LoadLE32(header + 16);
+	const size_t blockTableOffset = archiveOffset + LoadLE32(header + 20);
+	const size_t hashTableSize = LoadLE32(header + 24);
+	const size_t blockTableSize = LoadLE32(header + 28);
+	if (hashTableOffset > size || hashTableSize > (size - hashTableOffset) / 16
+	    || blockTableOffset > size || blockTableSize > (size - blockTableOffset) / 16)
+		return nullptr;
+
+	const std::vector<uint32_t> hashTable = ReadMpqTable(data + hashTableOffset, hashTableSize, MpqHashTableKey);
+	const std::vector<uint32_t> blockTable = ReadMpqTable(data + blockTableOffset, blockTableSize, MpqBlockTableKey);
+
+	ankerl::unordered_dense::map<uint64_t, MpqMappedFiles::Entry> entries;
+	for (size_t i = 0; i < hashTableSize; ++i) {
+		const uint32_t *hashEntry = &hashTable[i * 4];
+		const uint32_t blockIndex = hashEntry[3];
+		// Skips free and deleted entries, whose block index is out of range, and localized files, which the game doesn't request.
+		if (blockIndex >= blockTableSize || (hashEntry[2] & 0xFFFF) != 0)
+			continue;
+		const uint32_t *blockEntry = &blockTable[static_cast<size_t>(blockIndex) * 4];
+		const size_t offset = archiveOffset + blockEntry[0];
+		const uint32_t storedSize = blockEntry[1];
+		const uint32_t fileSize = blockEntry[2];
+		const uint32_t flags = blockEntry[3];
+		if ((flags & MpqFileExists) == 0 || (flags & MpqFileNotStored) != 0 || storedSize != fileSize || fileSize == 0)
+			continue;
+		if (offset > size || fileSize > size - offset)
+			continue;
+		entries.try_emplace(MpqNameKey(hashEntry[0], hashEntry[1]), MpqMappedFiles::Entry { offset, fileSize });
+	}
+	if (entries.empty())
+		return nullptr;
+	return std::make_shared<const MpqMappedFiles>(MpqMappedFiles { *std::move(file), std::move(entries) });
+}
+
 } // namespace
 
-MpqArchive::MpqArchive(std::string path, mpqfs_archive_t *archive)
+MpqArchive::MpqArchive(std::string path, mpqfs_archive_t *archive, uint32_t id)
     : path_(std::move(path))
     , archive_(archive)
+    , id_(id)
 {
 }
 
 MpqArchive::MpqArchive(MpqArchive &&other) noexcept
     : path_(std::move(other.path_))
     , archive_(other.archive_)
+    , id_(other.id_)
+    , fileCacheEnabled_(other.fileCacheEnabled_)
+    , mappedFiles_(std::move(other.mappedFiles_))
 {
 	other.archive_ = nullptr;
 }
@@ -57,6 +221,9 @@ MpqArchive &MpqArchive::operator=(MpqArchive &&other) noexcept
 		mpqfs_close(archive_);
 		path_ = std::move(other.path_);
 		archive_ = other.archive_;
+		id_ = other.id_;
+		fileCacheEnabled_ = other.fileCacheEnabled_;
+		mappedFiles_ = std::move(other.mappedFiles_);
 		other.archive_ = nullptr;
 	}
 	return *this;
@@ -74,7 +241,7 @@ std::expected<MpqArchive, std::string> MpqArchive::Open(const char *path)
 	if (code != MPQFS_OK) {
 		return std::unexpected(FormatMpqfsError(code));
 	}
-	return MpqArchive(path, handle);
+	return MpqArchive(path, handle, NextArchiveId++);
 }
 
 std::expected<MpqArchive, std::string> MpqArchive::Clone()
@@ -84,7 +251,17 @@ std::expected<MpqArchive, std::string> MpqArchive::Clone()
 	if (code != MPQFS_OK) {
 		return std::unexpected(FormatMpqfsError(code));
 	}
-	return MpqArchive(path_, clone);
+	MpqArchive result(path_, clone, id_);
+	result.fileCacheEnabled_ = fileCacheEnabled_;
+	result.mappedFiles_ = mappedFiles_;
+	return result;
+}
+
+void MpqArchive::EnableFileCache()
+{
+	fileCacheEnabled_ = true;
+	if (mappedFiles_ == nullptr)
+		mappedFiles_ = MapStoredFiles(path_.c_str());
 }
 
 bool MpqArchive::HasFile(std::string_view filename) const
@@ -137,6 +314,19 @@ std::unique_ptr<std::byte[]> MpqArchive::ReadFile(
 		return nullptr;
 	}
 
+	MpqFileCache &cache = GetMpqFileCache();
+	const uint32_t hashIndex = fileCacheEnabled_ ? mpqfs_find_hash(archive_, buf) : std::numeric_limits<uint32_t>::max();
+	if (hashIndex != std::numeric_limits<uint32_t>::max()) {
+		size_t cachedSize;
+		if (std::shared_ptr<const std::byte[]> cached = cache.find(id_, hashIndex, cachedSize); cached != nullptr) {
+			auto result = std::make_unique<std::byte[]>(cachedSize);
+			std::memcpy(result.get(), cached.get(), cachedSize);
+			error = 0;
+			fileSize = cachedSize;
+			return result;
+		}
+	}
+
 	size_t size = 0;
 	mpqfs_error_code code = mpqfs_file_size(archive_, buf, &size);
 	if (code != MPQFS_OK) {
@@ -152,9 +342,26 @@ std::unique_ptr<std::byte[]> MpqArchive::ReadFile(
 		return nullptr;
 	}
 
+	if (hashIndex != std::numeric_limits<uint32_t>::max() && cache.accepts(bytesRead)) {
+		std::shared_ptr<std::byte[]> copy { new std::byte[bytesRead] };
+		std::memcpy(copy.get(), result.get(), bytesRead);
+		cache.insert(id_, hashIndex, std::move(copy), bytesRead);
+	}
+
 	error = 0;
 	fileSize = bytesRead;
 	return result;
 }
 
+std::shared_ptr<const std::byte[]> MpqArchive::MapFile(std::string_view filename, std::size_t &fileSize) const
+{
+	if (mappedFiles_ == nullptr)
+		return nullptr;
+	const auto it = mappedFiles_->entries.find(MpqNameKey(HashMpqFileName(filename, MpqHashNameA), HashMpqFileName(filename, MpqHashNameB)));
+	if (it == mappedFiles_->entries.end())
+		return nullptr;
+	fileSize = it->second.size;
+	return std::shared_ptr<const std::byte[]>(mappedFiles_, reinterpret_cast<const std::byte *>(mappedFiles_->file.data() + it->second.offset));
+}
+
 } // namespace devilution
@@ -13,6 +13,8 @@ typedef struct mpqfs_archive mpqfs_archive_t;
 
 namespace devilution {
 
+struct MpqMappedFiles;
+
 class MpqArchive {
 public:
 	static std::expected<MpqArchive, std::string> Open(const char *path);
@@ -38,13 +40,39 @@ public:
 	    std::size_t &fileSize,
 	    int32_t &error);
 
+	/**
+	 * @brief Returns a file stored without compression or encryption as a view of the memory-mapped archive.
+	 *
+	 * Can be called from any thread. Only archives with the file cache enabled are mapped.
+	 *
+	 * @return `nullptr` if the file isn't stored that way or the archive isn't mapped, use `ReadFile` then
+	 */
+	std::shared_ptr<const std::byte[]> MapFile(std::string_view filename, std::size_t &fileSize) const;
+
 	mpqfs_archive_t *handle() const { return archive_; }
 
+	const std::string &path() const { return path_; }
+
+	/** @brief Identifies the archive in the file cache. Clones share the ID of the original. */
+	uint32_t id() const { return id_; }
+
+	/**
+	 * @brief Keep the files read from this archive in `GetMpqFileCache()` and map the archive for `MapFile`.
+	 *
+	 * Only for archives that are not modified while open, such as the game data.
+	 */
+	void EnableFileCache();
+	bool IsFileCacheEnabled() const { return fileCacheEnabled_; }
+
 private:
-	MpqArchive(std::string path, mpqfs_archive_t *archive);
+	MpqArchive(std::string path, mpqfs_archive_t *archive, uint32_t id);
 
 	std::string path_;
 	mpqfs_archive_t *archive_ = nullptr;
+	uint32_t id_ = 0;
+	bool fileCacheEnabled_ = false;
+	/** @brief Shared with clones, `nullptr` if the archive isn't mapped. */
+	std::shared_ptr<const MpqMappedFiles> mappedFiles_;
 };
 
 } // namespace devilution
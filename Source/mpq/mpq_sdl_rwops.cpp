@@ -1,7 +1,10 @@
 #include "mpq/mpq_sdl_rwops.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
+#include <utility>
 
 #include <mpqfs/mpqfs.h>
 
@@ -16,6 +19,8 @@
 #include "utils/sdl_compat.h"
 #endif
 
+#include "mpq/mpq_file_cache.hpp"
+
 namespace devilution {
 
 namespace {
@@ -28,23 +33,72 @@ constexpr size_t MaxMpqPathSize = 256;
  * Wraps an mpqfs_stream_t (sector-based, on-demand decompression) and,
  * for the threadsafe variant, an independently cloned archive so that
  * reads don't race with the main thread's archive FILE*.
+ *
+ * Files from the file cache are instead read from the shared, already
+ * decompressed buffer; `stream` is null then.
  * ----------------------------------------------------------------------- */
 
 struct MpqStreamCtx {
 	mpqfs_stream_t *stream;      /* Sector-based stream (owned)           */
 	mpqfs_archive_t *ownedClone; /* Non-null if we cloned for threadsafe  */
+
+	std::shared_ptr<const std::byte[]> cached; /* Cached file contents   */
+	size_t cachedSize = 0;
+	size_t cachedPos = 0;
 };
 
 static void DestroyCtx(MpqStreamCtx *ctx)
 {
 	if (ctx == nullptr)
 		return;
-	mpqfs_stream_close(ctx->stream);
+	if (ctx->stream != nullptr)
+		mpqfs_stream_close(ctx->stream);
 	if (ctx->ownedClone != nullptr)
 		mpqfs_close(ctx->ownedClone);
 	delete ctx;
 }
 
+/* -----------------------------------------------------------------------
+ * Stream operations that work on either backing of the context.
+ * Seeking in a cached file clamps to its bounds, like SDL's memory
+ * streams do.
+ * ----------------------------------------------------------------------- */
+
+static mpqfs_error_code CtxSize(MpqStreamCtx *ctx, size_t *size)
+{
+	if (ctx->stream == nullptr) {
+		*size = ctx->cachedSize;
+		return MPQFS_OK;
+	}
+	return mpqfs_stream_size(ctx->stream, size);
+}
+
+static mpqfs_error_code CtxSeek(MpqStreamCtx *ctx, int64_t offset, int whence, int64_t *pos)
+{
+	if (ctx->stream == nullptr) {
+		int64_t base = 0;
+		if (whence == SEEK_CUR)
+			base = static_cast<int64_t>(ctx->cachedPos);
+		else if (whence == SEEK_END)
+			base = static_cast<int64_t>(ctx->cachedSize);
+		ctx->cachedPos = static_cast<size_t>(std::clamp<int64_t>(base + offset, 0, static_cast<int64_t>(ctx->cachedSize)));
+		*pos = static_cast<int64_t>(ctx->cachedPos);
+		return MPQFS_OK;
+	}
+	return mpqfs_stream_seek(ctx->stream, offset, whence, pos);
+}
+
+static mpqfs_error_code CtxRead(MpqStreamCtx *ctx, void *ptr, size_t size, size_t *n)
+{
+	if (ctx->stream == nullptr) {
+		*n = std::min(size, ctx->cachedSize - ctx->cachedPos);
+		std::memcpy(ptr, &ctx->cached[ctx->cachedPos], *n);
+		ctx->cachedPos += *n;
+		return MPQFS_OK;
+	}
+	return mpqfs_stream_read(ctx->stream, ptr, size, n);
+}
+
 /* -----------------------------------------------------------------------
  * Helper: create the MpqStreamCtx, optionally cloning the archive for
  * thread-safety.  Tries hash-based open first, falls back to filename.
@@ -81,7 +135,7 @@ static MpqStreamCtx *CreateCtx(mpqfs_archive_t *archive,
 		return nullptr;
 	}
 
-	auto *ctx = new (std::nothrow) MpqStreamCtx { stream, clone };
+	auto *ctx = new (std::nothrow) MpqStreamCtx { stream, clone, nullptr };
 	if (ctx == nullptr) {
 		mpqfs_stream_close(stream);
 		if (clone != nullptr)
@@ -92,6 +146,45 @@ static MpqStreamCtx *CreateCtx(mpqfs_archive_t *archive,
 	return ctx;
 }
 
+/* -----------------------------------------------------------------------
+ * Helper: serve the file from the file cache, decompressing it into the
+ * cache first on a miss.  Returns nullptr if the file is not cacheable,
+ * in which case it is streamed as usual.
+ * ----------------------------------------------------------------------- */
+
+static MpqStreamCtx *CreateCachedCtx(MpqArchive &archive,
+    uint32_t hashIndex,
+    const char *filename,
+    bool threadsafe)
+{
+	MpqFileCache &cache = GetMpqFileCache();
+	size_t size = 0;
+	std::shared_ptr<const std::byte[]> data = cache.find(archive.id(), hashIndex, size);
+	if (data == nullptr) {
+		size = archive.GetFileSizeFromHash(hashIndex);
+		if (!cache.accepts(size))
+			return nullptr;
+		MpqStreamCtx *streamCtx = CreateCtx(archive.handle(), hashIndex, filename, threadsafe);
+		if (streamCtx == nullptr)
+			return nullptr;
+		std::shared_ptr<std::byte[]> buffer { new (std::nothrow) std::byte[size] };
+		size_t bytesRead = 0;
+		while (buffer != nullptr && bytesRead < size) {
+			size_t n = 0;
+			if (mpqfs_stream_read(streamCtx->stream, &buffer[bytesRead], size - bytesRead, &n) != MPQFS_OK || n == 0)
+				break;
+			bytesRead += n;
+		}
+		DestroyCtx(streamCtx);
+		if (bytesRead != size)
+			return nullptr;
+		cache.insert(archive.id(), hashIndex, buffer, size);
+		data = std::move(buffer);
+	}
+
+	return new (std::nothrow) MpqStreamCtx { nullptr, nullptr, std::move(data), size };
+}
+
 /* =======================================================================
  * SDL3 implementation
  * ======================================================================= */
@@ -102,7 +195,7 @@ static Sint64 SDLCALL MpqStream_Size(void *userdata)
 {
 	auto *ctx = static_cast<MpqStreamCtx *>(userdata);
 	size_t size = 0;
-	const mpqfs_error_code code = mpqfs_stream_size(ctx->stream, &size);
+	const mpqfs_error_code code = CtxSize(ctx, &size);
 	if (code != MPQFS_OK) {
 		SDL_SetError("%s", mpqfs_error_message(code));
 		return -1;
@@ -123,7 +216,7 @@ static Sint64 SDLCALL MpqStream_Seek(void *userdata, Sint64 offset, SDL_IOWhence
 		return -1;
 	}
 	int64_t pos = 0;
-	const mpqfs_error_code code = mpqfs_stream_seek(ctx->stream, offset, w, &pos);
+	const mpqfs_error_code code = CtxSeek(ctx, offset, w, &pos);
 	if (code != MPQFS_OK) {
 		SDL_SetError("%s", mpqfs_error_message(code));
 		return -1;
@@ -135,7 +228,7 @@ static size_t SDLCALL MpqStream_Read(void *userdata, void *ptr, size_t size, SDL
 {
 	auto *ctx = static_cast<MpqStreamCtx *>(userdata);
 	size_t n = 0;
-	const mpqfs_error_code code = mpqfs_stream_read(ctx->stream, ptr, size, &n);
+	const mpqfs_error_code code = CtxRead(ctx, ptr, size, &n);
 	if (code != MPQFS_OK) {
 		if (status != nullptr)
 			*status = SDL_IO_STATUS_ERROR;
@@ -191,7 +284,7 @@ static Sint64 SDLCALL MpqStream_Size(SDL_RWops *rw)
 {
 	auto *ctx = static_cast<MpqStreamCtx *>(rw->hidden.unknown.data1);
 	size_t size = 0;
-	const mpqfs_error_code code = mpqfs_stream_size(ctx->stream, &size);
+	const mpqfs_error_code code = CtxSize(ctx, &size);
 	if (code != MPQFS_OK) {
 		SDL_SetError("%s", mpqfs_error_message(code));
 		return -1;
@@ -215,7 +308,7 @@ static OffsetType SDLCALL MpqStream_Seek(SDL_RWops *rw, OffsetType offset, int w
 	}
 
 	int64_t pos = 0;
-	const mpqfs_error_code code = mpqfs_stream_seek(ctx->stream, offset, w, &pos);
+	const mpqfs_error_code code = CtxSeek(ctx, offset, w, &pos);
 	if (code != MPQFS_OK) {
 		SDL_SetError("%s", mpqfs_error_message(code));
 		return -1;
@@ -231,7 +324,7 @@ static SizeType SDLCALL MpqStream_Read(SDL_RWops *rw, void *ptr,
 
 	size_t totalBytes = static_cast<size_t>(size) * static_cast<size_t>(maxnum);
 	size_t n = 0;
-	const mpqfs_error_code code = mpqfs_stream_read(ctx->stream, ptr, totalBytes, &n);
+	const mpqfs_error_code code = CtxRead(ctx, ptr, totalBytes, &n);
 	if (code != MPQFS_OK) {
 		SDL_SetError("%s", mpqfs_error_message(code));
 		return 0;
@@ -274,7 +367,11 @@ SdlRwopsType *SDL_RWops_FromMpqFile(MpqArchive &archive,
 	std::memcpy(pathBuf, filename.data(), filename.size());
 	pathBuf[filename.size()] = '\0';
 
-	MpqStreamCtx *ctx = CreateCtx(archive.handle(), hashIndex, pathBuf, threadsafe);
+	MpqStreamCtx *ctx = nullptr;
+	if (archive.IsFileCacheEnabled() && hashIndex != UINT32_MAX)
+		ctx = CreateCachedCtx(archive, hashIndex, pathBuf, threadsafe);
+	if (ctx == nullptr)
+		ctx = CreateCtx(archive.handle(), hashIndex, pathBuf, threadsafe);
 	if (ctx == nullptr)
 		return nullptr;
 
@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <ctime>
 #include <expected>
+#include <optional>
 #include <string>
 
 #include <algorithm>
@@ -19,6 +20,7 @@
 #include "debug.h"
 #endif
 #include "diablo_msg.hpp"
+#include "engine/asset_prefetch.hpp"
 #include "engine/backbuffer_state.hpp"
 #include "engine/load_cel.hpp"
 #include "engine/load_file.hpp"
@@ -3690,15 +3692,34 @@ std::expected<void, std::string> LoadLevelObjects(uint16_t filesWidths[65])
 		}
 	}
 
+	// Decode all the object graphics in parallel, then adopt them in order.
+	AssetPrefetcher<std::expected<OwnedClxSpriteList, std::string>> prefetcher;
+	for (size_t i = 0, n = ObjMasterLoadList.size(); i < n; ++i) {
+		if (filesWidths[i] == 0) {
+			continue;
+		}
+		std::string filestr = StrCat("objects\\", ObjMasterLoadList[i]);
+		prefetcher.prefetch(i, [filestr = std::move(filestr), width = filesWidths[i]]() {
+			return LoadCelWithStatus(filestr.c_str(), width, /*threadsafe=*/true);
+		});
+	}
+
 	for (size_t i = 0, n = ObjMasterLoadList.size(); i < n; ++i) {
 		if (filesWidths[i] == 0) {
 			continue;
 		}
 
 		ObjFileList[numobjfiles] = static_cast<object_graphic_id>(i);
-		char filestr[32];
-		*BufCopy(filestr, "objects\\", ObjMasterLoadList[i]) = '\0';
-		ASSIGN_OR_RETURN(pObjCels[numobjfiles], LoadCelWithStatus(filestr, filesWidths[i]));
+		std::optional<std::expected<OwnedClxSpriteList, std::string>> prefetched = prefetcher.take(i);
+		if (prefetched && prefetched->has_value()) {
+			pObjCels[numobjfiles] = **std::move(prefetched);
+			LevelAssetPrefetchStats.prefetched++;
+		} else {
+			char filestr[32];
+			*BufCopy(filestr, "objects\\", ObjMasterLoadList[i]) = '\0';
+			ASSIGN_OR_RETURN(pObjCels[numobjfiles], LoadCelWithStatus(filestr, filesWidths[i]));
+			LevelAssetPrefetchStats.loadedOnDemand++;
+		}
 		numobjfiles++;
 	}
 	return {};
@@ -3748,6 +3769,11 @@ void FreeObjectGFX()
 	numobjfiles = 0;
 }
 
+std::span<const OptionalOwnedClxSpriteList> GetObjectSprites()
+{
+	return { pObjCels, static_cast<size_t>(numobjfiles) };
+}
+
 void AddL1Objs(int x1, int y1, int x2, int y2)
 {
 	for (int j = y1; j < y2; j++) {
@@ -8,6 +8,7 @@
 #include <cmath>
 #include <cstdint>
 #include <expected>
+#include <span>
 #include <string>
 
 #include "cursor.h"
@@ -283,7 +284,7 @@ struct Object {
 extern DVL_API_FOR_TEST Object Objects[MAXOBJECTS];
 extern int AvailableObjects[MAXOBJECTS];
 extern int ActiveObjects[MAXOBJECTS];
-extern int ActiveObjectCount;
+extern DVL_API_FOR_TEST int ActiveObjectCount;
 /** @brief Indicates that objects are being loaded during gameplay and pre calculated data should be updated. */
 extern bool LoadingMapObjects;
 /** Tracks progress through the tome sequence that spawns Na-Krul (see OperateNakrulBook()) */
@@ -330,6 +331,8 @@ bool IsItemBlockingObjectAtPosition(Point position);
 
 std::expected<void, std::string> InitObjectGFX();
 void FreeObjectGFX();
+/** @brief The object sprites loaded for the current level, indexed by the slot an object's animation was loaded into. */
+std::span<const OptionalOwnedClxSpriteList> GetObjectSprites();
 void AddL1Objs(int x1, int y1, int x2, int y2);
 void AddL2Objs(int x1, int y1, int x2, int y2);
 void AddL3Objs(int x1, int y1, int x2, int y2);
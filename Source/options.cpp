@@ -796,6 +796,9 @@ GraphicsOptions::GraphicsOptions()
     , brightness("Brightness Correction", OptionEntryFlags::Invisible, "Brightness Correction", "Brightness correction level.", 0)
     , zoom("Zoom", OptionEntryFlags::None, N_("Zoom"), N_("Zoom on when enabled."), false)
     , perPixelLighting("Per-pixel Lighting", OptionEntryFlags::None, N_("Per-pixel Lighting"), N_("Subtile lighting for smoother light gradients."), DEFAULT_PER_PIXEL_LIGHTING)
+    , multithreadedRendering("Multithreaded Rendering", OptionEntryFlags::None, N_("Multithreaded Rendering"), N_("Splits dungeon rendering across all CPU cores."), false)
+    , floorCache("Floor Cache", OptionEntryFlags::None, N_("Floor Cache"), N_("Keeps the rendered dungeon floor between frames and only redraws the tiles that change."), true)
+    , renderThread("Render Thread", OptionEntryFlags::None, N_("Render Thread"), N_("Renders the dungeon on a thread of its own while the previous frame is presented. The dungeon is shown one frame late."), false)
     , colorCycling("Color Cycling", OptionEntryFlags::None, N_("Color Cycling"), N_("Color cycling effect used for water, lava, and acid animation."), true)
     , alternateNestArt("Alternate nest art", OptionEntryFlags::OnlyHellfire | OptionEntryFlags::CantChangeInGame, N_("Alternate nest art"), N_("The game will use an alternative palette for Hellfire’s nest tileset."), false)
 #if SDL_VERSION_ATLEAST(2, 0, 0)
@@ -827,6 +830,9 @@ std::vector<OptionEntryBase *> GraphicsOptions::GetEntries()
 		&zoom,
 		&showFPS,
 		&perPixelLighting,
+		&multithreadedRendering,
+		&floorCache,
+		&renderThread,
 		&colorCycling,
 		&alternateNestArt,
 #if SDL_VERSION_ATLEAST(2, 0, 0)
@@ -884,6 +890,7 @@ GameplayOptions::GameplayOptions()
               { StoreUi::VisualGrid, N_("Visual grid") },
           })
     , skipLoadingScreenThresholdMs("Skip loading screen threshold, ms", OptionEntryFlags::Invisible, "", "", 0)
+    , levelCacheSize("Level cache size", OptionEntryFlags::Invisible, "", "", 4)
 {
 }
 
@@ -929,6 +936,7 @@ std::vector<OptionEntryBase *> GameplayOptions::GetEntries()
 		&grabInput,
 		&pauseOnFocusLoss,
 		&skipLoadingScreenThresholdMs,
+		&levelCacheSize,
 	};
 }
 
@@ -549,6 +549,12 @@ struct GraphicsOptions : OptionCategoryBase {
 	OptionEntryBoolean zoom;
 	/** @brief Subtile lighting for smoother light gradients. */
 	OptionEntryBoolean perPixelLighting;
+	/** @brief Render the dungeon floor in screen bands on worker threads. */
+	OptionEntryBoolean multithreadedRendering;
+	/** @brief Keep the rendered dungeon floor between frames. */
+	OptionEntryBoolean floorCache;
+	/** @brief Render the dungeon view on a thread of its own, one frame behind the rest of the screen. */
+	OptionEntryBoolean renderThread;
 	/** @brief Enable color cycling animations. */
 	OptionEntryBoolean colorCycling;
 	/** @brief Use alternate nest palette. */
@@ -652,6 +658,13 @@ struct GameplayOptions : OptionCategoryBase {
 	 * Advanced option, not displayed in the UI.
 	 */
 	OptionEntryInt<int> skipLoadingScreenThresholdMs;
+
+	/**
+	 * @brief Number of recently left levels kept in memory, so that returning to them does not read the save file.
+	 *
+	 * Advanced option, not displayed in the UI.
+	 */
+	OptionEntryInt<int> levelCacheSize;
 };
 
 struct ControllerOptions : OptionCategoryBase {
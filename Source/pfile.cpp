@@ -5,12 +5,16 @@
  */
 #include "pfile.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <expected>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include <ankerl/unordered_dense.h>
 
@@ -26,17 +30,21 @@
 #include "engine/load_file.hpp"
 #include "engine/render/primitive_render.hpp"
 #include "game_mode.hpp"
+#include "levels/gendung.h"
 #include "loadsave.h"
 #include "menu.h"
 #include "mods/mod_identity.h"
 #include "mpq/mpq_common.hpp"
+#include "options.h"
 #include "pack.h"
 #include "qol/stash.h"
+#include "save_snapshot.hpp"
 #include "tables/playerdat.hpp"
 #include "utils/endian_read.hpp"
 #include "utils/endian_swap.hpp"
 #include "utils/file_util.h"
 #include "utils/language.h"
+#include "utils/log.hpp"
 #include "utils/parse_int.hpp"
 #include "utils/paths.h"
 #include "utils/sdl_compat.h"
@@ -69,6 +77,56 @@ namespace {
 /** List of character names for the character selection screen. */
 char hero_names[MAX_CHARACTERS][PlayerNameLength];
 
+/**
+ * @brief Fingerprints of the level files last written to the save archive, by level.
+ *
+ * A level that is left unchanged serializes to the same bytes, so it does not have to be written again.
+ * Cleared whenever the level files in the archive are removed or rewritten by other means.
+ */
+ankerl::unordered_dense::map<uint16_t, uint64_t> SavedLevelFingerprints;
+size_t LevelBytesWritten;
+size_t LevelBytesSkipped;
+
+struct CachedLevel {
+	uint16_t key;
+	std::unique_ptr<std::byte[]> data;
+	size_t size;
+};
+
+/**
+ * @brief The state of the most recently left levels as they were saved, most recent first.
+ *
+ * Only a shortcut for reading them back: each of them is also in the save archive,
+ * so it has to be dropped whenever the level files there are removed or rewritten by other means.
+ */
+std::vector<CachedLevel> CachedLevels;
+
+uint16_t GetSavedLevelKey()
+{
+	return setlevel ? static_cast<uint16_t>(0x100 | setlvlnum) : static_cast<uint16_t>(currlevel);
+}
+
+void CacheLevel(uint16_t key, const std::byte *data, size_t size)
+{
+	std::erase_if(CachedLevels, [key](const CachedLevel &level) { return level.key == key; });
+	const auto capacity = static_cast<size_t>(std::max(*GetOptions().Gameplay.levelCacheSize, 0));
+	if (capacity == 0) {
+		CachedLevels.clear();
+		return;
+	}
+	std::unique_ptr<std::byte[]> copy { new std::byte[size] };
+	memcpy(copy.get(), data, size);
+	CachedLevels.insert(CachedLevels.begin(), CachedLevel { key, std::move(copy), size });
+	if (CachedLevels.size() > capacity)
+		CachedLevels.resize(capacity);
+}
+
+void ClearSavedLevels()
+{
+	SavedLevelFingerprints.clear();
+	CachedLevels.clear();
+}
+
 // Effective save-file extension token (no leading dot). Defaults to "sv"; an active mod may
 // override the save namespace by declaring `saveExtension` in its manifest.
 std::string_view GetSaveExtension()
@@ -132,23 +190,31 @@ bool GetTempSaveNames(uint8_t dwIndex, char *szTemp)
 	return GetSaveNames(dwIndex, "temp", szTemp);
 }
 
-void RenameTempToPerm(SaveWriter &saveWriter)
+void RenameTempToPerm(SaveSnapshot &snapshot)
 {
 	char szTemp[MaxMpqPathSize];
 	char szPerm[MaxMpqPathSize];
 
+	// The names depend on giNumberOfLevels, so they are worked out before the snapshot is written.
+	std::vector<std::pair<std::string, std::string>> names;
 	uint32_t dwIndex = 0;
 	while (GetTempSaveNames(dwIndex, szTemp)) {
 		[[maybe_unused]] const bool result = GetPermSaveNames(dwIndex, szPerm); // DO NOT PUT DIRECTLY INTO ASSERT!
 		assert(result);
 		dwIndex++;
-		if (saveWriter.HasFile(szTemp)) {
-			if (saveWriter.HasFile(szPerm))
-				saveWriter.RemoveHashEntry(szPerm);
-			saveWriter.RenameFile(szTemp, szPerm);
-		}
+		names.emplace_back(szTemp, szPerm);
 	}
 	assert(!GetPermSaveNames(dwIndex, szPerm));
+
+	snapshot.addEdit([names = std::move(names)](SaveWriter &saveWriter) {
+		for (const auto &[temp, perm] : names) {
+			if (saveWriter.HasFile(temp.c_str())) {
+				if (saveWriter.HasFile(perm.c_str()))
+					saveWriter.RemoveHashEntry(perm.c_str());
+				saveWriter.RenameFile(temp.c_str(), perm.c_str());
+			}
+		}
+	});
 }
 
 bool ReadHero(SaveReader &archive, PlayerPack *pPack)
@@ -168,29 +234,25 @@ bool ReadHero(SaveReader &archive, PlayerPack *pPack)
 	return ret;
 }
 
-void EncodeHero(SaveWriter &saveWriter, const PlayerPack *pack)
+void EncodeHero(SaveSnapshot &snapshot, const PlayerPack *pack)
 {
 	const size_t packedLen = codec_get_encoded_len(sizeof(*pack));
-	const std::unique_ptr<std::byte[]> packed { new std::byte[packedLen] };
+	std::unique_ptr<std::byte[]> packed { new std::byte[packedLen] };
 
 	memcpy(packed.get(), pack, sizeof(*pack));
-	codec_encode(packed.get(), sizeof(*pack), packedLen, pfile_get_password());
-	saveWriter.WriteFile("hero", packed.get(), packedLen);
+	snapshot.addFile("hero", std::move(packed), sizeof(*pack));
 }
 
 SaveWriter GetSaveWriter(uint32_t saveNum, bool carryForward = true)
 {
+	WaitForSaves();
 	return SaveWriter(GetSavePath(saveNum), carryForward);
 }
 
-SaveWriter GetStashWriter()
-{
-	return SaveWriter(GetStashSavePath(), /*carryForward=*/true);
-}
-
 #ifndef DISABLE_DEMOMODE
 void CopySaveFile(uint32_t saveNum, std::string targetPath)
 {
+	WaitForSaves();
 	const std::string savePath = GetSavePath(saveNum);
 #if defined(UNPACKED_SAVES)
 #ifdef DVL_NO_FILESYSTEM
@@ -260,6 +322,7 @@ bool ArchiveContainsGame(SaveReader &hsArchive)
 
 std::optional<SaveReader> CreateSaveReader(std::string &&path)
 {
+	WaitForSaves();
 #ifdef UNPACKED_SAVES
 	if (!FileExists(path))
 		return std::nullopt;
@@ -524,20 +587,20 @@ HeroCompareResult CompareSaves(const std::string &actualSavePath, const std::str
 }
 #endif // !DISABLE_DEMOMODE
 
-void pfile_write_hero(SaveWriter &saveWriter, bool writeGameData)
+void pfile_write_hero(SaveSnapshot &snapshot, bool writeGameData)
 {
 	if (writeGameData) {
-		SaveGameData(saveWriter);
-		RenameTempToPerm(saveWriter);
+		SaveGameData(snapshot);
+		RenameTempToPerm(snapshot);
 	}
 	PlayerPack pkplr;
 	Player &myPlayer = *MyPlayer;
 
 	PackPlayer(pkplr, myPlayer);
-	EncodeHero(saveWriter, &pkplr);
+	EncodeHero(snapshot, &pkplr);
 	if (!gbVanilla) {
-		SaveHotkeys(saveWriter, myPlayer);
-		SaveHeroItems(saveWriter, myPlayer);
+		SaveHotkeys(snapshot, myPlayer);
+		SaveHeroItems(snapshot, myPlayer);
 	}
 }
 
@@ -644,11 +707,13 @@ const char *pfile_get_password()
 
 void pfile_write_hero(bool writeGameData)
 {
-	SaveWriter saveWriter = GetSaveWriter(gSaveNumber, /*carryForward=*/writeGameData);
-	pfile_write_hero(saveWriter, writeGameData);
+	SaveSnapshot snapshot(pfile_get_password());
+	pfile_write_hero(snapshot, writeGameData);
+	QueueSave(GetSavePath(gSaveNumber), /*carryForward=*/writeGameData, std::move(snapshot));
 
 #ifdef __EMSCRIPTEN__
 	// Persist saves to IndexedDB for browser storage
+	WaitForSaves();
 	emscripten_run_script("if (typeof Module !== 'undefined' && Module.saveToIndexedDB) Module.saveToIndexedDB();");
 #endif
 }
@@ -659,7 +724,9 @@ void pfile_write_hero_demo(int demo)
 	const std::string savePath = GetSavePath(gSaveNumber, StrCat("demo_", demo, "_reference_"));
 	CopySaveFile(gSaveNumber, savePath);
 	auto saveWriter = SaveWriter(savePath.c_str());
-	pfile_write_hero(saveWriter, true);
+	SaveSnapshot snapshot(pfile_get_password());
+	pfile_write_hero(snapshot, true);
+	snapshot.writeTo(saveWriter);
 }
 
 HeroCompareResult pfile_compare_hero_demo(int demo, bool logDetails)
@@ -673,7 +740,9 @@ HeroCompareResult pfile_compare_hero_demo(int demo, bool logDetails)
 	{
 		CopySaveFile(gSaveNumber, actualSavePath);
 		SaveWriter saveWriter(actualSavePath.c_str());
-		pfile_write_hero(saveWriter, true);
+		SaveSnapshot snapshot(pfile_get_password());
+		pfile_write_hero(snapshot, true);
+		snapshot.writeTo(saveWriter);
 	}
 
 	return CompareSaves(actualSavePath, referenceSavePath, logDetails);
@@ -685,9 +754,9 @@ void sfile_write_stash()
 	if (!Stash.dirty)
 		return;
 
-	SaveWriter stashWriter = GetStashWriter();
-
-	SaveStash(stashWriter);
+	SaveSnapshot snapshot(pfile_get_password());
+	SaveStash(snapshot);
+	QueueSave(GetStashSavePath(), /*carryForward=*/true, std::move(snapshot));
 
 	Stash.dirty = false;
 }
@@ -762,12 +831,14 @@ bool pfile_ui_save_create(_uiheroinfo *heroinfo)
 	CreatePlayer(player, heroinfo->heroclass);
 	CopyUtf8(player._pName, heroinfo->name, PlayerNameLength);
 	PackPlayer(pkplr, player);
-	EncodeHero(saveWriter, &pkplr);
+	SaveSnapshot snapshot(pfile_get_password());
+	EncodeHero(snapshot, &pkplr);
 	Game2UiPlayer(player, heroinfo, false);
 	if (!gbVanilla) {
-		SaveHotkeys(saveWriter, player);
-		SaveHeroItems(saveWriter, player);
+		SaveHotkeys(snapshot, player);
+		SaveHeroItems(snapshot, player);
 	}
+	snapshot.writeTo(saveWriter);
 
 	return true;
 }
@@ -777,6 +848,7 @@ bool pfile_delete_save(_uiheroinfo *heroInfo)
 	const uint32_t saveNum = heroInfo->saveNumber;
 	if (saveNum < MAX_CHARACTERS) {
 		hero_names[saveNum][0] = '\0';
+		WaitForSaves();
 		RemoveFile(GetSavePath(saveNum).c_str());
 	}
 	return true;
@@ -805,18 +877,51 @@ void pfile_read_player_from_save(uint32_t saveNum, Player &player)
 
 void pfile_save_level()
 {
-	SaveWriter saveWriter = GetSaveWriter(gSaveNumber);
-	SaveLevel(saveWriter);
+	SaveSnapshot snapshot(pfile_get_password());
+	SaveLevel(snapshot);
+
+	const uint16_t key = GetSavedLevelKey();
+	snapshot.forEachFile([key](std::string_view, const std::byte *data, size_t size) {
+		CacheLevel(key, data, size);
+	});
+
+	const uint64_t fingerprint = snapshot.fingerprint();
+	const auto [it, inserted] = SavedLevelFingerprints.try_emplace(key, fingerprint);
+	if (!inserted && it->second == fingerprint) {
+		LevelBytesSkipped += snapshot.size();
+		LogVerbose("Level unchanged, skipped saving {} bytes ({} skipped, {} written in total)", snapshot.size(), LevelBytesSkipped, LevelBytesWritten);
+		return;
+	}
+	it->second = fingerprint;
+	LevelBytesWritten += snapshot.size();
+	LogVerbose("Saving level, {} bytes ({} skipped, {} written in total)", snapshot.size(), LevelBytesSkipped, LevelBytesWritten);
+
+	QueueSave(GetSavePath(gSaveNumber), /*carryForward=*/true, std::move(snapshot));
+}
+
+std::unique_ptr<std::byte[]> pfile_take_cached_level(size_t &size)
+{
+	const uint16_t key = GetSavedLevelKey();
+	const auto it = std::find_if(CachedLevels.begin(), CachedLevels.end(), [key](const CachedLevel &level) { return level.key == key; });
+	if (it == CachedLevels.end())
+		return nullptr;
+	// The level is cached again when it is left, so there is no need to keep a copy while it is being played.
+	std::unique_ptr<std::byte[]> data = std::move(it->data);
+	size = it->size;
+	CachedLevels.erase(it);
+	return data;
 }
 
 std::expected<void, std::string> pfile_convert_levels()
 {
+	ClearSavedLevels();
 	SaveWriter saveWriter = GetSaveWriter(gSaveNumber);
 	return ConvertLevels(saveWriter);
 }
 
 void pfile_remove_temp_files()
 {
+	ClearSavedLevels();
 	if (gbIsMultiplayer)
 		return;
 
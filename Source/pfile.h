@@ -127,6 +127,11 @@ void pfile_save_level();
 std::expected<void, std::string> pfile_convert_levels();
 void pfile_remove_temp_files();
 std::unique_ptr<std::byte[]> pfile_read(const char *pszName, size_t *pdwLen);
+/**
+ * @brief Takes the state of the current level, as it was last saved, out of the cache of recently left levels.
+ * @return `nullptr` if the level is not cached and has to be read from the save archive
+ */
+std::unique_ptr<std::byte[]> pfile_take_cached_level(size_t &size);
 void pfile_update(bool forceSave);
 
 } // namespace devilution
@@ -6,6 +6,9 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_events.h>
@@ -28,6 +31,8 @@
 #include "engine/points_in_rectangle_range.hpp"
 #include "engine/random.hpp"
 #include "engine/render/clx_render.hpp"
+#include "engine/render/world_snapshot.hpp"
+#include "engine/shared_asset_cache.hpp"
 #include "engine/trn.hpp"
 #include "engine/world_tile.hpp"
 #include "game_mode.hpp"
@@ -1530,6 +1535,107 @@ void GetPlayerGraphicsPath(std::string_view path, std::string_view prefix, std::
 	*BufCopy(out, "plrgfx\\", path, "\\", prefix, "\\", prefix, type) = '\0';
 }
 
+struct PlayerGraphicFile {
+	std::string_view cel;
+	PlayerWeaponGraphic weapon;
+};
+
+/**
+ * @brief Selects the file of a player graphic for the player's equipment and the current level.
+ * @return `std::nullopt` if the player has no such graphic here
+ */
+std::optional<PlayerGraphicFile> GetPlayerGraphicFile(const Player &player, player_graphic graphic)
+{
+	PlayerWeaponGraphic animWeaponId = GetPlayerWeaponGraphic(graphic, static_cast<PlayerWeaponGraphic>(player._pgfxnum & 0xF));
+
+	std::string_view szCel;
+	switch (graphic) {
+	case player_graphic::Stand:
+		szCel = "as";
+		if (leveltype == DTYPE_TOWN)
+			szCel = "st";
+		break;
+	case player_graphic::Walk:
+		szCel = "aw";
+		if (leveltype == DTYPE_TOWN)
+			szCel = "wl";
+		break;
+	case player_graphic::Attack:
+		if (leveltype == DTYPE_TOWN)
+			return std::nullopt;
+		szCel = "at";
+		break;
+	case player_graphic::Hit:
+		if (leveltype == DTYPE_TOWN)
+			return std::nullopt;
+		szCel = "ht";
+		break;
+	case player_graphic::Lightning:
+		szCel = "lm";
+		break;
+	case player_graphic::Fire:
+		szCel = "fm";
+		break;
+	case player_graphic::Magic:
+		szCel = "qm";
+		break;
+	case player_graphic::Death:
+		// Only one Death animation exists, for unarmed characters
+		animWeaponId = PlayerWeaponGraphic::Unarmed;
+		szCel = "dt";
+		break;
+	case player_graphic::Block:
+		if (leveltype == DTYPE_TOWN)
+			return std::nullopt;
+		if (!player._pBlockFlag)
+			return std::nullopt;
+		szCel = "bl";
+		break;
+	default:
+		app_fatal("PLR:2");
+	}
+	return PlayerGraphicFile { szCel, animWeaponId };
+}
+
+/**
+ * @brief Identifies the sprites loaded for a player graphic, which are the same for all players with the same key.
+ *
+ * Uses the class rather than the sprite class, as it also selects the class TRN.
+ */
+uint32_t GetPlayerGraphicKey(const Player &player, player_graphic graphic, const PlayerGraphicFile &file)
+{
+	return (static_cast<uint32_t>(player._pClass) << 16)
+	    | (static_cast<uint32_t>(player._pgfxnum >> 4) << 12)
+	    | (static_cast<uint32_t>(file.weapon) << 8)
+	    | (static_cast<uint32_t>(graphic) << 1)
+	    | (leveltype == DTYPE_TOWN ? 1 : 0);
+}
+
+OwnedClxSpriteSheet LoadPlayerSprites(Player &player, player_graphic graphic, const PlayerGraphicFile &file)
+{
+	const HeroClass cls = GetPlayerSpriteClass(player._pClass);
+	const PlayerSpriteData &spriteData = GetPlayerSpriteDataForClass(cls);
+	const char *path = spriteData.classPath.c_str();
+
+	const char prefixBuf[3] = { spriteData.classChar, ArmourChar[player._pgfxnum >> 4], WepChar[static_cast<std::size_t>(file.weapon)] };
+	char pszName[256];
+	GetPlayerGraphicsPath(path, std::string_view(prefixBuf, 3), file.cel, pszName);
+	const uint16_t animationWidth = GetPlayerSpriteWidth(cls, graphic, file.weapon);
+	OwnedClxSpriteSheet sprites = LoadCl2Sheet(pszName, animationWidth);
+	std::optional<std::array<uint8_t, 256>> graphicTRN = GetPlayerGraphicTRN(pszName);
+	if (graphicTRN) {
+		ClxApplyTrans(sprites, graphicTRN->data());
+	}
+	std::optional<std::array<uint8_t, 256>> classTRN = GetClassTRN(player);
+	if (classTRN) {
+		ClxApplyTrans(sprites, classTRN->data());
+	}
+	return sprites;
+}
+
+/** @brief Player sprites, shared by all players that look the same, keyed by `GetPlayerGraphicKey()`. */
+SharedAssetCache<uint32_t, OwnedClxSpriteSheet> PlayerSpritesCache;
+
 } // namespace
 
 void Player::CalcScrolls()
@@ -1983,6 +2089,7 @@ void Player::UpdatePreviewCelSprite(_cmd_id cmdId, Point point, uint16_t wParam1
 	if (!previewCelSprite || *previewCelSprite != sprites[0]) {
 		previewCelSprite = sprites[0];
 		progressToNextGameTickWhenPreviewWasSet = ProgressToNextGameTick;
+		MarkWorldSnapshotStale();
 	}
 }
 
@@ -2109,72 +2216,14 @@ void LoadPlrGFX(Player &player, player_graphic graphic)
 	if (animationData.sprites)
 		return;
 
-	const HeroClass cls = GetPlayerSpriteClass(player._pClass);
-	PlayerWeaponGraphic animWeaponId = GetPlayerWeaponGraphic(graphic, static_cast<PlayerWeaponGraphic>(player._pgfxnum & 0xF));
-
-	const PlayerSpriteData &spriteData = GetPlayerSpriteDataForClass(cls);
-	const char *path = spriteData.classPath.c_str();
-
-	std::string_view szCel;
-	switch (graphic) {
-	case player_graphic::Stand:
-		szCel = "as";
-		if (leveltype == DTYPE_TOWN)
-			szCel = "st";
-		break;
-	case player_graphic::Walk:
-		szCel = "aw";
-		if (leveltype == DTYPE_TOWN)
-			szCel = "wl";
-		break;
-	case player_graphic::Attack:
-		if (leveltype == DTYPE_TOWN)
-			return;
-		szCel = "at";
-		break;
-	case player_graphic::Hit:
-		if (leveltype == DTYPE_TOWN)
-			return;
-		szCel = "ht";
-		break;
-	case player_graphic::Lightning:
-		szCel = "lm";
-		break;
-	case player_graphic::Fire:
-		szCel = "fm";
-		break;
-	case player_graphic::Magic:
-		szCel = "qm";
-		break;
-	case player_graphic::Death:
-		// Only one Death animation exists, for unarmed characters
-		animWeaponId = PlayerWeaponGraphic::Unarmed;
-		szCel = "dt";
-		break;
-	case player_graphic::Block:
-		if (leveltype == DTYPE_TOWN)
-			return;
-		if (!player._pBlockFlag)
-			return;
-		szCel = "bl";
-		break;
-	default:
-		app_fatal("PLR:2");
-	}
+	const std::optional<PlayerGraphicFile> file = GetPlayerGraphicFile(player, graphic);
+	if (!file)
+		return;
 
-	const char prefixBuf[3] = { spriteData.classChar, ArmourChar[player._pgfxnum >> 4], WepChar[static_cast<std::size_t>(animWeaponId)] };
-	char pszName[256];
-	GetPlayerGraphicsPath(path, std::string_view(prefixBuf, 3), szCel, pszName);
-	const uint16_t animationWidth = GetPlayerSpriteWidth(cls, graphic, animWeaponId);
-	animationData.sprites = LoadCl2Sheet(pszName, animationWidth);
-	std::optional<std::array<uint8_t, 256>> graphicTRN = GetPlayerGraphicTRN(pszName);
-	if (graphicTRN) {
-		ClxApplyTrans(*animationData.sprites, graphicTRN->data());
-	}
-	std::optional<std::array<uint8_t, 256>> classTRN = GetClassTRN(player);
-	if (classTRN) {
-		ClxApplyTrans(*animationData.sprites, classTRN->data());
-	}
+	animationData.key = GetPlayerGraphicKey(player, graphic, *file);
+	animationData.sprites = PlayerSpritesCache.getOrLoad(animationData.key, [&]() {
+		return LoadPlayerSprites(player, graphic, *file);
+	});
 }
 
 void InitPlayerGFX(Player &player)
@@ -2208,10 +2257,39 @@ void ResetPlayerGFX(Player &player)
 	}
 
 	for (PlayerAnimationData &animData : player.AnimationData) {
-		animData.sprites = std::nullopt;
+		animData.sprites = nullptr;
+	}
+}
+
+void ResetChangedPlayerGFX(Player &player)
+{
+	bool changed = false;
+	for (size_t i = 0; i < enum_size<player_graphic>::value; i++) {
+		PlayerAnimationData &animData = player.AnimationData[i];
+		if (!animData.sprites)
+			continue;
+		const auto graphic = static_cast<player_graphic>(i);
+		const std::optional<PlayerGraphicFile> file = GetPlayerGraphicFile(player, graphic);
+		if (file && GetPlayerGraphicKey(player, graphic, *file) == animData.key)
+			continue;
+		animData.sprites = nullptr;
+		changed = true;
+	}
+	if (!changed)
+		return;
+
+	player.AnimInfo.sprites = std::nullopt;
+	if (!gbRunGame) {
+		player.PartyInfoSprites[0] = std::nullopt;
+		player.PartyInfoSprites[1] = std::nullopt;
 	}
 }
 
+void ClearPlayerGFXCache()
+{
+	PlayerSpritesCache.clear();
+}
+
 void NewPlrAnim(Player &player, player_graphic graphic, Direction dir, AnimationDistributionFlags flags /*= AnimationDistributionFlags::None*/, int8_t numSkippedFrames /*= 0*/, int8_t distributeFramesBeforeFrame /*= 0*/)
 {
 	LoadPlrGFX(player, graphic);
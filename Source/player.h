@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include <algorithm>
@@ -188,9 +189,12 @@ constexpr std::array<char, 9> WepChar = {
  */
 struct PlayerAnimationData {
 	/**
-	 * @brief Sprite lists for each of the 8 directions.
+	 * @brief Sprite lists for each of the 8 directions, shared with all other players that look the same.
 	 */
-	OptionalOwnedClxSpriteSheet sprites;
+	std::shared_ptr<const OwnedClxSpriteSheet> sprites;
+
+	/** @brief Identifies `sprites` by the player's class and equipment graphics. */
+	uint32_t key = 0;
 
 	[[nodiscard]] ClxSpriteList spritesForDirection(Direction direction) const
 	{
@@ -933,10 +937,25 @@ Player *PlayerAtPosition(Point position, bool ignoreMovingPlayers = false);
 ClxSprite GetPlayerPortraitSprite(Player &player);
 bool IsPlayerUnarmed(Player &player);
 
+/**
+ * @brief Loads a player graphic unless it is already loaded.
+ *
+ * The sprites are shared with all other players that have the same class and equipment graphics.
+ */
 void LoadPlrGFX(Player &player, player_graphic graphic);
 void InitPlayerGFX(Player &player);
 void ResetPlayerGFX(Player &player);
 
+/**
+ * @brief Releases the player graphics that no longer match the player's equipment, keeping the others.
+ */
+void ResetChangedPlayerGFX(Player &player);
+
+/**
+ * @brief Makes the next `LoadPlrGFX` load the sprites again, rather than share those that other players hold.
+ */
+void ClearPlayerGFXCache();
+
 /**
  * @brief Sets the new Player Animation with all relevant information for rendering
  * @param player The player to set the animation for
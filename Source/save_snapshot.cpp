@@ -0,0 +1,196 @@
+#include "save_snapshot.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <string_view>
+#include <utility>
+
+#include <ankerl/unordered_dense.h>
+
+#include "codec.h"
+#include "utils/file_util.h"
+#include "utils/log.hpp"
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/thread_pool.hpp"
+
+namespace devilution {
+
+namespace {
+
+std::chrono::nanoseconds Since(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+}
+
+void AddTime(SaveStats::Stage &stage, std::chrono::nanoseconds duration)
+{
+	stage.last = duration;
+	stage.max = std::max(stage.max, duration);
+	stage.total += duration;
+}
+
+struct SaveJob {
+	std::string path;
+	bool carryForward;
+	SaveSnapshot snapshot;
+};
+
+/**
+ * @brief Saves waiting to be written. A single worker task writes them one after the other,
+ * and is started again by the next save once it has run out of work.
+ */
+class SaveQueue {
+public:
+	void push(SaveJob &&job)
+	{
+		{
+			const std::lock_guard<SdlMutex> lock(mutex_);
+			AddTime(stats_.snapshot, Since(job.snapshot.created()));
+			++stats_.saves;
+			stats_.bytes += job.snapshot.size();
+			jobs_.push_back(std::move(job));
+			if (busy_)
+				return;
+			busy_ = true;
+		}
+		GetWorkerPool().submit([this]() { run(); });
+	}
+
+	void wait()
+	{
+		const auto start = std::chrono::steady_clock::now();
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		if (!busy_)
+			return;
+		while (busy_)
+			idleCond_.wait(mutex_);
+		stats_.waited += Since(start);
+	}
+
+	SaveStats stats()
+	{
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		return stats_;
+	}
+
+	void resetStats()
+	{
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		stats_ = {};
+	}
+
+private:
+	void run()
+	{
+		std::unique_lock<SdlMutex> lock(mutex_);
+		while (!jobs_.empty()) {
+			SaveJob job = std::move(jobs_.front());
+			jobs_.pop_front();
+			lock.unlock();
+			const auto start = std::chrono::steady_clock::now();
+			{
+				// The archive's tables are written when the writer is closed.
+				SaveWriter writer(job.path, job.carryForward);
+				job.snapshot.writeTo(writer);
+			}
+#ifndef UNPACKED_SAVES
+			// Nothing waits for the save to complete, so don't leave it to the system to decide
+			// when it is actually stored, or a crash or power loss could leave it half-written.
+			if (!SyncFile(job.path.c_str()))
+				LogError("Failed to flush {} to disk", job.path);
+#endif
+			const std::chrono::nanoseconds duration = Since(start);
+			lock.lock();
+			AddTime(stats_.write, duration);
+		}
+		busy_ = false;
+		idleCond_.broadcast();
+	}
+
+	SdlMutex mutex_;
+	SdlCond idleCond_;
+	std::deque<SaveJob> jobs_;
+	/** @brief Whether a worker task is writing the queued saves. */
+	bool busy_ = false;
+	SaveStats stats_;
+};
+
+SaveQueue &GetSaveQueue()
+{
+	static SaveQueue queue;
+	return queue;
+}
+
+} // namespace
+
+SaveSnapshot::SaveSnapshot(const char *password)
+    : password_(password)
+    , created_(std::chrono::steady_clock::now())
+{
+}
+
+void SaveSnapshot::addFile(std::string name, std::unique_ptr<std::byte[]> data, size_t size)
+{
+	size_ += size;
+	steps_.emplace_back(File { std::move(name), std::move(data), size });
+}
+
+void SaveSnapshot::addEdit(std::function<void(SaveWriter &)> edit)
+{
+	steps_.emplace_back(std::move(edit));
+}
+
+uint64_t SaveSnapshot::fingerprint() const
+{
+	const ankerl::unordered_dense::hash<std::string_view> hash;
+	uint64_t result = 0;
+	const auto combine = [&](std::string_view value) {
+		result ^= hash(value) + 0x9e3779b97f4a7c15 + (result << 6) + (result >> 2);
+	};
+	for (const std::variant<File, Edit> &step : steps_) {
+		if (const File *file = std::get_if<File>(&step)) {
+			combine(file->name);
+			combine(std::string_view(reinterpret_cast<const char *>(file->data.get()), file->size));
+		}
+	}
+	return result;
+}
+
+void SaveSnapshot::writeTo(SaveWriter &writer)
+{
+	for (std::variant<File, Edit> &step : steps_) {
+		if (File *file = std::get_if<File>(&step)) {
+			const size_t encodedLen = codec_get_encoded_len(file->size);
+			codec_encode(file->data.get(), file->size, encodedLen, password_);
+			writer.WriteFile(file->name.c_str(), file->data.get(), encodedLen);
+		} else {
+			std::get<Edit>(step)(writer);
+		}
+	}
+	steps_.clear();
+	size_ = 0;
+}
+
+void QueueSave(std::string path, bool carryForward, SaveSnapshot &&snapshot)
+{
+	GetSaveQueue().push(SaveJob { std::move(path), carryForward, std::move(snapshot) });
+}
+
+void WaitForSaves()
+{
+	GetSaveQueue().wait();
+}
+
+SaveStats GetSaveStats()
+{
+	return GetSaveQueue().stats();
+}
+
+void ResetSaveStats()
+{
+	GetSaveQueue().resetStats();
+}
+
+} // namespace devilution
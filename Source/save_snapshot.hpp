@@ -0,0 +1,120 @@
+/**
+ * @file save_snapshot.hpp
+ *
+ * Saving in two stages: the game state is serialized into memory on the main thread,
+ * then encoded and written to the save archive on a worker thread.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "pfile.h"
+
+namespace devilution {
+
+/**
+ * @brief The files of a save, serialized but not yet encoded, and the other changes to make to the archive.
+ */
+class SaveSnapshot {
+public:
+	/** @param password Used to encode the files, must outlive the snapshot */
+	explicit SaveSnapshot(const char *password);
+
+	SaveSnapshot(SaveSnapshot &&) = default;
+	SaveSnapshot &operator=(SaveSnapshot &&) = default;
+
+	/**
+	 * @brief Adds a file to write to the archive.
+	 * @param data Must have room for `codec_get_encoded_len(size)` bytes, as it is encoded in place
+	 */
+	void addFile(std::string name, std::unique_ptr<std::byte[]> data, size_t size);
+
+	/** @brief Adds a change, such as renaming or removing files, to make once the files added so far have been written. */
+	void addEdit(std::function<void(SaveWriter &)> edit);
+
+	/** @brief Total size of the files in bytes. */
+	[[nodiscard]] size_t size() const
+	{
+		return size_;
+	}
+
+	/** @brief Calls `fn(std::string_view name, const std::byte *data, size_t size)` for every file. */
+	template <typename F>
+	void forEachFile(F &&fn) const
+	{
+		for (const std::variant<File, Edit> &step : steps_) {
+			if (const File *file = std::get_if<File>(&step))
+				fn(std::string_view(file->name), file->data.get(), file->size);
+		}
+	}
+
+	/** @brief A hash of the names and contents of the files, to tell whether they differ from an earlier snapshot. */
+	[[nodiscard]] uint64_t fingerprint() const;
+
+	[[nodiscard]] std::chrono::steady_clock::time_point created() const
+	{
+		return created_;
+	}
+
+	/** @brief Encodes and writes the files, and makes the other changes, in the order they were added. */
+	void writeTo(SaveWriter &writer);
+
+private:
+	struct File {
+		std::string name;
+		std::unique_ptr<std::byte[]> data;
+		size_t size;
+	};
+
+	using Edit = std::function<void(SaveWriter &)>;
+
+	const char *password_;
+	std::vector<std::variant<File, Edit>> steps_;
+	size_t size_ = 0;
+	std::chrono::steady_clock::time_point created_;
+};
+
+struct SaveStats {
+	struct Stage {
+		std::chrono::nanoseconds last {};
+		std::chrono::nanoseconds max {};
+		std::chrono::nanoseconds total {};
+	};
+
+	size_t saves = 0;
+	size_t bytes = 0;
+	/** @brief Serializing into a snapshot, on the main thread. */
+	Stage snapshot;
+	/** @brief Encoding the files and writing the archive, on a worker thread. */
+	Stage write;
+	/** @brief Time the main thread spent waiting for saves to be written. */
+	std::chrono::nanoseconds waited {};
+};
+
+/**
+ * @brief Writes a snapshot to the save archive at `path` on a worker thread.
+ *
+ * Saves are written one at a time, in the order they were queued, so a later save
+ * of the same archive always ends up on disk after an earlier one.
+ */
+void QueueSave(std::string path, bool carryForward, SaveSnapshot &&snapshot);
+
+/**
+ * @brief Returns once all queued saves have been written.
+ *
+ * Must be called before the save archives are read or written directly, and before shutting down.
+ */
+void WaitForSaves();
+
+SaveStats GetSaveStats();
+void ResetSaveStats();
+
+} // namespace devilution
@@ -2,82 +2,83 @@
 
 #include <cstdint>
 #include <cstring>
+#include <utility>
 
 namespace devilution {
 
 // NOTE: Diablo's "SHA1" is different from actual SHA1 in that it uses arithmetic
-// right shifts (sign bit extension).
+// right shifts (sign bit extension) and does not rotate the expanded message words.
+// This is also why the SHA-1 instructions of x86 and ARM CPUs cannot be used for it.
 
 namespace {
 
 /**
  * Diablo-"SHA1" circular left shift, portable version.
  */
-uint32_t SHA1CircularShift(uint32_t word, size_t bits)
+constexpr uint32_t SHA1CircularShift(uint32_t word, size_t bits)
 {
 	// The SHA-like algorithm as originally implemented treated word as a signed value and used arithmetic right shifts
 	//  (sign-extending). This results in the high 32-`bits` bits being set to 1.
-	if ((word & (1 << 31)) != 0)
-		return (0xFFFFFFFF << bits) | (word >> (32 - bits));
-	return (word << bits) | (word >> (32 - bits));
+	// Shifting the signed value does the same without a branch, which would be mispredicted for half of all words.
+	return (word << bits) | static_cast<uint32_t>(static_cast<int32_t>(word) >> (32 - bits));
 }
 
-void SHA1ProcessMessageBlock(SHA1Context *context)
+template <size_t Round>
+uint32_t SHA1Function(uint32_t b, uint32_t c, uint32_t d)
 {
-	std::uint32_t w[80];
-
-	memcpy(w, context->buffer, BlockSize * sizeof(uint32_t));
-	for (int i = 16; i < 80; i++) {
-		w[i] = w[i - 16] ^ w[i - 14] ^ w[i - 8] ^ w[i - 3];
-	}
-
-	std::uint32_t a = context->state[0];
-	std::uint32_t b = context->state[1];
-	std::uint32_t c = context->state[2];
-	std::uint32_t d = context->state[3];
-	std::uint32_t e = context->state[4];
-
-	for (int i = 0; i < 20; i++) {
-		const std::uint32_t temp = SHA1CircularShift(a, 5) + ((b & c) | ((~b) & d)) + e + w[i] + 0x5A827999;
-		e = d;
-		d = c;
-		c = SHA1CircularShift(b, 30);
-		b = a;
-		a = temp;
-	}
-
-	for (int i = 20; i < 40; i++) {
-		const std::uint32_t temp = SHA1CircularShift(a, 5) + (b ^ c ^ d) + e + w[i] + 0x6ED9EBA1;
-		e = d;
-		d = c;
-		c = SHA1CircularShift(b, 30);
-		b = a;
-		a = temp;
-	}
-
-	for (int i = 40; i < 60; i++) {
-		const std::uint32_t temp = SHA1CircularShift(a, 5) + ((b & c) | (b & d) | (c & d)) + e + w[i] + 0x8F1BBCDC;
-		e = d;
-		d = c;
-		c = SHA1CircularShift(b, 30);
-		b = a;
-		a = temp;
-	}
-
-	for (int i = 60; i < 80; i++) {
-		const std::uint32_t temp = SHA1CircularShift(a, 5) + (b ^ c ^ d) + e + w[i] + 0xCA62C1D6;
-		e = d;
-		d = c;
-		c = SHA1CircularShift(b, 30);
-		b = a;
-		a = temp;
-	}
-
-	context->state[0] += a;
-	context->state[1] += b;
-	context->state[2] += c;
-	context->state[3] += d;
-	context->state[4] += e;
+	if constexpr (Round < 20)
+		return ((b & c) | ((~b) & d)) + 0x5A827999;
+	else if constexpr (Round < 40)
+		return (b ^ c ^ d) + 0x6ED9EBA1;
+	else if constexpr (Round < 60)
+		return ((b & c) | (b & d) | (c & d)) + 0x8F1BBCDC;
+	else
+		return (b ^ c ^ d) + 0xCA62C1D6;
+}
+
+/**
+ * One of the 80 rounds. Only the last 16 words of the message schedule are kept, expanding it as the rounds go.
+ */
+template <size_t Round>
+void SHA1Round(uint32_t w[BlockSize], uint32_t &a, uint32_t &b, uint32_t &c, uint32_t &d, uint32_t &e)
+{
+	if constexpr (Round >= BlockSize)
+		w[Round % BlockSize] ^= w[(Round + 2) % BlockSize] ^ w[(Round + 8) % BlockSize] ^ w[(Round + 13) % BlockSize];
+	const std::uint32_t temp = SHA1CircularShift(a, 5) + SHA1Function<Round>(b, c, d) + e + w[Round % BlockSize];
+	e = d;
+	d = c;
+	c = SHA1CircularShift(b, 30);
+	b = a;
+	a = temp;
+}
+
+/**
+ * All rounds, unrolled, so that the round functions and schedule indices are constants.
+ */
+template <size_t... Rounds>
+void SHA1Rounds(uint32_t w[BlockSize], uint32_t &a, uint32_t &b, uint32_t &c, uint32_t &d, uint32_t &e, std::index_sequence<Rounds...> /*rounds*/)
+{
+	(SHA1Round<Rounds>(w, a, b, c, d, e), ...);
+}
+
+void SHA1ProcessMessageBlock(uint32_t state[SHA1HashSize], const uint32_t data[BlockSize])
+{
+	std::uint32_t w[BlockSize];
+	memcpy(w, data, sizeof(w));
+
+	std::uint32_t a = state[0];
+	std::uint32_t b = state[1];
+	std::uint32_t c = state[2];
+	std::uint32_t d = state[3];
+	std::uint32_t e = state[4];
+
+	SHA1Rounds(w, a, b, c, d, e, std::make_index_sequence<80>());
+
+	state[0] += a;
+	state[1] += b;
+	state[2] += c;
+	state[3] += d;
+	state[4] += e;
 }
 
 } // namespace
@@ -89,8 +90,7 @@ void SHA1Result(SHA1Context &context, uint32_t messageDigest[SHA1HashSize])
 
 void SHA1Calculate(SHA1Context &context, const uint32_t data[BlockSize])
 {
-	memcpy(&context.buffer[0], data, BlockSize * sizeof(uint32_t));
-	SHA1ProcessMessageBlock(&context);
+	SHA1ProcessMessageBlock(context.state, data);
 }
 
 } // namespace devilution
@@ -606,9 +606,7 @@ void LoadItemDatFromFile(DataFile &dataFile, std::string_view filename, int32_t
 	AllItemsList.shrink_to_fit();
 }
 
-namespace {
-
-void LoadItemDat()
+void LoadBaseItemData()
 {
 	const std::string_view filename = "txtdata\\items\\itemdat.tsv";
 	DataFile dataFile = DataFile::loadOrDie(filename);
@@ -617,10 +615,15 @@ void LoadItemDat()
 	AdditionalUniqueBaseItemStringsToIndices.clear();
 	ItemMappingIdsToIndices.clear();
 	LoadItemDatFromFile(dataFile, filename, 0);
+}
 
+void OnBaseItemDataLoaded()
+{
 	lua::ItemDataLoaded();
 }
 
+namespace {
+
 void ReadItemPower(RecordReader &reader, std::string_view fieldName, ItemPower &power)
 {
 	reader.read(fieldName, power.type, ParseItemEffectType);
@@ -664,9 +667,7 @@ void LoadUniqueItemDatFromFile(DataFile &dataFile, std::string_view filename, in
 	UniqueItems.shrink_to_fit();
 }
 
-namespace {
-
-void LoadUniqueItemDat()
+void LoadUniqueItemData()
 {
 	const std::string_view filename = "txtdata\\items\\unique_itemdat.tsv";
 	DataFile dataFile = DataFile::loadOrDie(filename);
@@ -674,10 +675,15 @@ void LoadUniqueItemDat()
 	UniqueItems.clear();
 	UniqueItemMappingIdsToIndices.clear();
 	LoadUniqueItemDatFromFile(dataFile, filename, 0);
+}
 
+void OnUniqueItemDataLoaded()
+{
 	lua::UniqueItemDataLoaded();
 }
 
+namespace {
+
 void LoadItemAffixesDat(std::string_view filename, std::vector<PLStruct> &out)
 {
 	DataFile dataFile = DataFile::loadOrDie(filename);
@@ -704,14 +710,21 @@ void LoadItemAffixesDat(std::string_view filename, std::vector<PLStruct> &out)
 
 } // namespace
 
-void LoadItemData()
+void LoadItemAffixData()
 {
-	LoadItemDat();
-	LoadUniqueItemDat();
 	LoadItemAffixesDat("txtdata\\items\\item_prefixes.tsv", ItemPrefixes);
 	LoadItemAffixesDat("txtdata\\items\\item_suffixes.tsv", ItemSuffixes);
 }
 
+void LoadItemData()
+{
+	LoadBaseItemData();
+	OnBaseItemDataLoaded();
+	LoadUniqueItemData();
+	OnUniqueItemDataLoaded();
+	LoadItemAffixData();
+}
+
 std::string_view ItemTypeToString(ItemType itemType)
 {
 	switch (itemType) {
@@ -661,6 +661,19 @@ void LoadItemDatFromFile(DataFile &dataFile, std::string_view filename, int32_t
 void LoadUniqueItemDatFromFile(DataFile &dataFile, std::string_view filename, int32_t baseMappingId);
 void LoadItemData();
 
+/**
+ * @brief The steps of `LoadItemData`, so that the files can be parsed off the main thread.
+ *
+ * The `On*Loaded` steps fire the Lua events and must be called on the main thread.
+ * Unique items can refer to base items added by the `ItemDataLoaded` event,
+ * so `LoadUniqueItemData` must come after `OnBaseItemDataLoaded`.
+ */
+void LoadBaseItemData();
+void OnBaseItemDataLoaded();
+void LoadUniqueItemData();
+void OnUniqueItemDataLoaded();
+void LoadItemAffixData();
+
 } // namespace devilution
 
 template <>
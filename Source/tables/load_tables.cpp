@@ -0,0 +1,61 @@
+#include "tables/load_tables.hpp"
+
+#include <chrono>
+#include <vector>
+
+#include "data/compiled_file.hpp"
+#include "quests.h"
+#include "tables/itemdat.h"
+#include "tables/misdat.h"
+#include "tables/monstdat.h"
+#include "tables/objdat.h"
+#include "tables/playerdat.hpp"
+#include "tables/spelldat.h"
+#include "tables/textdat.h"
+#include "utils/log.hpp"
+#include "utils/task_graph.hpp"
+#include "utils/thread_pool.hpp"
+
+namespace devilution {
+
+namespace {
+
+double ToMilliseconds(std::chrono::duration<double, std::milli> duration)
+{
+	return duration.count();
+}
+
+} // namespace
+
+void LoadDataTables()
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	TaskGraph graph;
+	const TaskGraph::TaskId text = graph.add("text", {}, LoadTextData);
+	graph.add("players", {}, LoadPlayerDataFiles);
+	graph.add("spells", {}, LoadSpellData);
+	graph.add("missiles", {}, LoadMissileData);
+	const TaskGraph::TaskId monsters = graph.add("monsters", {}, LoadMonsterTypeData, OnMonsterTypeDataLoaded);
+	graph.add("unique monsters", { text, monsters }, LoadUniqueMonsterData, OnUniqueMonsterDataLoaded);
+	const TaskGraph::TaskId items = graph.add("items", {}, LoadBaseItemData, OnBaseItemDataLoaded);
+	graph.add("unique items", { items }, LoadUniqueItemData, OnUniqueItemDataLoaded);
+	graph.add("item affixes", {}, LoadItemAffixData);
+	graph.add("objects", {}, LoadObjectData);
+	graph.add("quests", { text }, LoadQuestData);
+
+	const unsigned workerCount = GetWorkerPool().workerCount();
+	const std::vector<TaskGraph::Timing> timings = graph.run(workerCount);
+
+	for (const TaskGraph::Timing &timing : timings) {
+		LogVerbose("Loaded {} table in {:.2f} ms (waited {:.2f} ms)", timing.name, ToMilliseconds(timing.load), ToMilliseconds(timing.waited));
+	}
+	LogVerbose("Loaded data tables in {:.2f} ms on {} worker threads",
+	    ToMilliseconds(std::chrono::steady_clock::now() - start), workerCount);
+	if (IsDataFileCacheEnabled()) {
+		const DataFileCacheStats dataFileCacheStats = GetDataFileCacheStats();
+		LogVerbose("Data file cache: {} hits, {} misses since startup", dataFileCacheStats.hits, dataFileCacheStats.misses);
+	}
+}
+
+} // namespace devilution
@@ -0,0 +1,19 @@
+/**
+ * @file load_tables.hpp
+ *
+ * Loading all game data tables.
+ */
+#pragma once
+
+namespace devilution {
+
+/**
+ * @brief (Re)loads the game data tables from the loaded archives.
+ *
+ * Tables that don't depend on each other are parsed in parallel on worker threads.
+ * The Lua events that follow some of them are fired on the calling thread while no table
+ * is being parsed, in the same order as loading the tables one by one would.
+ */
+void LoadDataTables();
+
+} // namespace devilution
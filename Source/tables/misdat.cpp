@@ -368,10 +368,10 @@ std::expected<MissileMovementDistribution, std::string> ParseMissileMovementDist
 	return std::unexpected("Unknown enum value");
 }
 
-void LoadMisdat()
+} // namespace
+
+void LoadMisdatFromFile(DataFile &dataFile, std::string_view filename)
 {
-	const std::string_view filename = "txtdata\\missiles\\misdat.tsv";
-	DataFile dataFile = DataFile::loadOrDie(filename);
 	dataFile.skipHeaderOrDie(filename);
 
 	MissilesData.clear();
@@ -395,6 +395,15 @@ void LoadMisdat()
 	MissilesData.shrink_to_fit();
 }
 
+namespace {
+
+void LoadMisdat()
+{
+	const std::string_view filename = "txtdata\\missiles\\misdat.tsv";
+	DataFile dataFile = DataFile::loadOrDie(filename);
+	LoadMisdatFromFile(dataFile, filename);
+}
+
 } // namespace
 
 uint8_t MissileFileData::animDelay(uint8_t dir) const
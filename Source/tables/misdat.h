@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <expected>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "effects.h"
@@ -18,6 +19,8 @@
 
 namespace devilution {
 
+class DataFile;
+
 enum mienemy_type : uint8_t {
 	TARGET_MONSTERS,
 	TARGET_PLAYERS,
@@ -243,6 +246,7 @@ struct MissileFileData {
 const MissileData &GetMissileData(MissileID missileId);
 MissileFileData &GetMissileSpriteData(MissileGraphicID graphicId);
 
+void LoadMisdatFromFile(DataFile &dataFile, std::string_view filename);
 void LoadMissileData();
 
 std::expected<void, std::string> InitMissileGFX();
@@ -402,9 +402,7 @@ void LoadMonstDatFromFile(DataFile &dataFile, const std::string_view filename, b
 	}
 }
 
-namespace {
-
-void LoadMonstDat()
+void LoadMonsterTypeData()
 {
 	const std::string_view filename = "txtdata\\monsters\\monstdat.tsv";
 	DataFile dataFile = DataFile::loadOrDie(filename);
@@ -412,14 +410,15 @@ void LoadMonstDat()
 	AdditionalMonsterIdStringsToIndices.clear();
 	MonstersData.resize(NUM_DEFAULT_MTYPES); // ensure the hardcoded monster type slots are filled
 	LoadMonstDatFromFile(dataFile, filename, false);
+}
 
+void OnMonsterTypeDataLoaded()
+{
 	lua::MonsterDataLoaded();
 
 	MonstersData.shrink_to_fit();
 }
 
-} // namespace
-
 void LoadUniqueMonstDatFromFile(DataFile &dataFile, std::string_view filename)
 {
 	dataFile.skipHeaderOrDie(filename);
@@ -452,27 +451,28 @@ void LoadUniqueMonstDatFromFile(DataFile &dataFile, std::string_view filename)
 	}
 }
 
-namespace {
-
-void LoadUniqueMonstDat()
+void LoadUniqueMonsterData()
 {
 	const std::string_view filename = "txtdata\\monsters\\unique_monstdat.tsv";
 	DataFile dataFile = DataFile::loadOrDie(filename);
 
 	UniqueMonstersData.clear();
 	LoadUniqueMonstDatFromFile(dataFile, filename);
+}
 
+void OnUniqueMonsterDataLoaded()
+{
 	lua::UniqueMonsterDataLoaded();
 
 	UniqueMonstersData.shrink_to_fit();
 }
 
-} // namespace
-
 void LoadMonsterData()
 {
-	LoadMonstDat();
-	LoadUniqueMonstDat();
+	LoadMonsterTypeData();
+	OnMonsterTypeDataLoaded();
+	LoadUniqueMonsterData();
+	OnUniqueMonsterDataLoaded();
 }
 
 size_t GetNumMonsterSprites()
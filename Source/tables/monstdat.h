@@ -355,6 +355,18 @@ void LoadMonstDatFromFile(DataFile &dataFile, std::string_view filename, bool gr
 void LoadUniqueMonstDatFromFile(DataFile &dataFile, std::string_view filename);
 void LoadMonsterData();
 
+/**
+ * @brief The steps of `LoadMonsterData`, so that the files can be parsed off the main thread.
+ *
+ * The `On*Loaded` steps fire the Lua events and must be called on the main thread.
+ * Unique monsters can refer to monster types added by the `MonsterDataLoaded` event,
+ * so `LoadUniqueMonsterData` must come after `OnMonsterTypeDataLoaded`.
+ */
+void LoadMonsterTypeData();
+void OnMonsterTypeDataLoaded();
+void LoadUniqueMonsterData();
+void OnUniqueMonsterDataLoaded();
+
 /**
  * @brief Returns the number of the monster sprite files.
  *
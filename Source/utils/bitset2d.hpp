@@ -26,6 +26,11 @@ public:
 		data_.set(index(x, y), value);
 	}
 
+	void set()
+	{
+		data_.set();
+	}
+
 	void reset(size_t x, size_t y)
 	{
 		data_.reset(index(x, y));
@@ -41,6 +46,11 @@ public:
 		return data_.count();
 	}
 
+	[[nodiscard]] bool any() const
+	{
+		return data_.any();
+	}
+
 private:
 	static size_t index(size_t x, size_t y)
 	{
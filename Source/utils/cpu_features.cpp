@@ -0,0 +1,33 @@
+#include "utils/cpu_features.hpp"
+
+#ifdef USE_SDL3
+#include <SDL3/SDL_cpuinfo.h>
+#else
+#include <SDL.h>
+#endif
+
+namespace devilution {
+
+namespace {
+
+CpuFeatures DetectCpuFeatures()
+{
+	CpuFeatures features;
+#if DVL_SIMD_X86
+	features.sse2 = SDL_HasSSE2();
+#endif
+#if DVL_SIMD_AARCH64
+	features.neon = true;
+#endif
+	return features;
+}
+
+} // namespace
+
+const CpuFeatures &GetCpuFeatures()
+{
+	static const CpuFeatures Features = DetectCpuFeatures();
+	return Features;
+}
+
+} // namespace devilution
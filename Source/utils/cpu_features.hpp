@@ -0,0 +1,39 @@
+#pragma once
+
+namespace devilution {
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define DVL_SIMD_X86 1
+#else
+#define DVL_SIMD_X86 0
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define DVL_SIMD_AARCH64 1
+#else
+#define DVL_SIMD_AARCH64 0
+#endif
+
+// Enables an instruction set for a single function so that the rest of the
+// build can keep targeting the baseline CPU.
+#if DVL_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define DVL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define DVL_TARGET(isa)
+#endif
+
+/**
+ * @brief SIMD instruction sets of the CPU we are running on.
+ */
+struct CpuFeatures {
+	bool sse2 = false;
+	/** Always available on AArch64, which is the only NEON target we have kernels for. */
+	bool neon = false;
+};
+
+/**
+ * @brief Returns the features of the current CPU, detected on first use.
+ */
+const CpuFeatures &GetCpuFeatures();
+
+} // namespace devilution
@@ -39,6 +39,7 @@
 #endif
 
 #if defined(DVL_HAS_POSIX_2001) && !defined(DEVILUTIONX_WINDOWS_NO_WCHAR)
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -263,6 +264,49 @@ bool GetFileSize(const char *path, std::uintmax_t *size)
 #endif
 }
 
+bool GetFileModificationTime(const char *path, std::int64_t *mtime)
+{
+#ifdef _WIN32
+	FILETIME writeTime;
+#if defined(WINVER) && WINVER <= 0x0500 && (!defined(_WIN32_WINNT) || _WIN32_WINNT == 0)
+	HANDLE handle = ::CreateFileA(path, GENERIC_READ,
+	    FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING,
+	    FILE_ATTRIBUTE_NORMAL, NULL);
+	if (handle == INVALID_HANDLE_VALUE)
+		return false;
+	const bool ok = ::GetFileTime(handle, NULL, NULL, &writeTime);
+	::CloseHandle(handle);
+	if (!ok)
+		return false;
+#else
+	WIN32_FILE_ATTRIBUTE_DATA attr;
+#ifdef DEVILUTIONX_WINDOWS_NO_WCHAR
+	if (!GetFileAttributesExA(path, GetFileExInfoStandard, &attr)) {
+		return false;
+	}
+#else
+	const auto pathUtf16 = ToWideChar(path);
+	if (pathUtf16 == nullptr) {
+		LogError("UTF-8 -> UTF-16 conversion error code {}", ::GetLastError());
+		return false;
+	}
+	if (!GetFileAttributesExW(&pathUtf16[0], GetFileExInfoStandard, &attr)) {
+		return false;
+	}
+#endif
+	writeTime = attr.ftLastWriteTime;
+#endif
+	*mtime = static_cast<std::int64_t>(static_cast<std::uint64_t>(writeTime.dwHighDateTime) << 32 | writeTime.dwLowDateTime);
+	return true;
+#else
+	struct ::stat statResult;
+	if (::stat(path, &statResult) == -1)
+		return false;
+	*mtime = static_cast<std::int64_t>(statResult.st_mtime);
+	return true;
+#endif
+}
+
 bool CreateDir(const char *path)
 {
 #ifdef DVL_HAS_FILESYSTEM
@@ -391,6 +435,47 @@ bool ResizeFile(const char *path, std::uintmax_t size)
 #endif
 }
 
+bool SyncFile(const char *path)
+{
+#ifdef _WIN32
+#ifdef DEVILUTIONX_WINDOWS_NO_WCHAR
+	HANDLE file = ::CreateFileA(path, GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		LogError("CreateFileA({}) failed: {}", path, ::GetLastError());
+		return false;
+	}
+#else
+	const auto pathUtf16 = ToWideChar(path);
+	if (pathUtf16 == nullptr) {
+		LogError("UTF-8 -> UTF-16 conversion error code {}", ::GetLastError());
+		return false;
+	}
+	HANDLE file = ::CreateFileW(&pathUtf16[0], GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		LogError("CreateFileW({}) failed: {}", path, ::GetLastError());
+		return false;
+	}
+#endif
+	if (::FlushFileBuffers(file) == 0) {
+		LogError("FlushFileBuffers failed: {}", ::GetLastError());
+		::CloseHandle(file);
+		return false;
+	}
+	::CloseHandle(file);
+	return true;
+#elif defined(DVL_HAS_POSIX_2001)
+	const int fd = ::open(path, O_RDONLY);
+	if (fd == -1)
+		return false;
+	const bool ok = ::fsync(fd) == 0;
+	::close(fd);
+	return ok;
+#else
+	// Nothing to flush to on this platform.
+	return true;
+#endif
+}
+
 void RenameFile(const char *from, const char *to)
 {
 #ifdef _WIN32
@@ -35,6 +35,14 @@ std::string_view Dirname(std::string_view path);
 bool FileExistsAndIsWriteable(const char *path);
 bool GetFileSize(const char *path, std::uintmax_t *size);
 
+/**
+ * @brief Gets the time a file was last written to.
+ *
+ * The unit and epoch are platform-specific, so the result is only meaningful when compared
+ * with another result on the same system.
+ */
+bool GetFileModificationTime(const char *path, std::int64_t *mtime);
+
 /**
  * @brief Creates a single directory (non-recursively).
  *
@@ -44,6 +52,11 @@ bool CreateDir(const char *path);
 
 void RecursivelyCreateDir(const char *path);
 bool ResizeFile(const char *path, std::uintmax_t size);
+/**
+ * @brief Waits until the contents of the file have been written to the storage device.
+ * @return Whether it succeeded. Always succeeds on platforms that can't tell.
+ */
+bool SyncFile(const char *path);
 void RenameFile(const char *from, const char *to);
 void CopyFileOverwrite(const char *from, const char *to);
 void RemoveFile(const char *path);
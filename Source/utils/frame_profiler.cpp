@@ -0,0 +1,208 @@
+#include "utils/frame_profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "utils/file_util.h"
+#include "utils/sdl_mutex.h"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+
+namespace frame_profiler_internal {
+std::atomic<bool> Running { false };
+} // namespace frame_profiler_internal
+
+namespace {
+
+/**
+ * @brief An event in a ring buffer. The fields are atomic, as they may be read while being overwritten.
+ */
+struct ProfileEventSlot {
+	std::atomic<const char *> name;
+	std::atomic<uint64_t> start;
+	std::atomic<uint64_t> duration;
+};
+
+/**
+ * @brief Events of one thread. Only the owning thread writes, so recording needs no locks.
+ *
+ * The reader copies the events without waiting for the writer and afterwards throws
+ * away the ones the writer may have overwritten in the meantime, like a seqlock.
+ */
+struct ThreadBuffer {
+	std::array<ProfileEventSlot, ProfileEventsPerThread> events;
+	/** @brief Number of events ever written, the next one goes to `head % ProfileEventsPerThread`. */
+	std::atomic<uint64_t> head { 0 };
+	/** @brief Thread id shown in the trace. */
+	unsigned id;
+	/** @brief Whether a live thread writes to this buffer. Guarded by `BuffersMutex`. */
+	bool inUse;
+};
+
+const std::chrono::steady_clock::time_point Epoch = std::chrono::steady_clock::now();
+
+/** @brief Events that started before this time belong to an earlier run. */
+std::atomic<uint64_t> RunStart { 0 };
+
+SdlMutex BuffersMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> Buffers;
+
+ThreadBuffer *AcquireBuffer()
+{
+	const std::lock_guard<SdlMutex> lock(BuffersMutex);
+	// Buffers of finished threads are handed to new threads, together with their old events.
+	for (const std::unique_ptr<ThreadBuffer> &buffer : Buffers) {
+		if (!buffer->inUse) {
+			buffer->inUse = true;
+			return buffer.get();
+		}
+	}
+	Buffers.push_back(std::make_unique<ThreadBuffer>());
+	ThreadBuffer &buffer = *Buffers.back();
+	buffer.id = static_cast<unsigned>(Buffers.size());
+	buffer.inUse = true;
+	return &buffer;
+}
+
+struct ThreadBufferOwner {
+	ThreadBuffer *buffer = nullptr;
+
+	~ThreadBufferOwner()
+	{
+		if (buffer == nullptr)
+			return;
+		const std::lock_guard<SdlMutex> lock(BuffersMutex);
+		buffer->inUse = false;
+	}
+};
+
+thread_local ThreadBufferOwner CurrentThreadBuffer;
+
+void AppendMicroseconds(std::string &out, uint64_t nanoseconds)
+{
+	const uint64_t fraction = nanoseconds % 1000;
+	StrAppend(out, nanoseconds / 1000, fraction < 100 ? (fraction < 10 ? ".00" : ".0") : ".", fraction);
+}
+
+void AppendJsonString(std::string &out, const char *str)
+{
+	out += '"';
+	for (; *str != '\0'; ++str) {
+		const char c = *str;
+		if (c == '"' || c == '\\') {
+			out += '\\';
+			out += c;
+		} else if (static_cast<unsigned char>(c) < 0x20) {
+			out += ' ';
+		} else {
+			out += c;
+		}
+	}
+	out += '"';
+}
+
+void AppendEvents(std::string &out, const ThreadBuffer &buffer, uint64_t runStart, bool &first)
+{
+	const uint64_t head = buffer.head.load(std::memory_order_acquire);
+	const uint64_t begin = head > ProfileEventsPerThread ? head - ProfileEventsPerThread : 0;
+	std::vector<ProfileEvent> events;
+	events.reserve(head - begin);
+	for (uint64_t i = begin; i < head; ++i) {
+		const ProfileEventSlot &slot = buffer.events[i % ProfileEventsPerThread];
+		events.push_back(ProfileEvent {
+		    slot.name.load(std::memory_order_relaxed),
+		    slot.start.load(std::memory_order_relaxed),
+		    slot.duration.load(std::memory_order_relaxed),
+		});
+	}
+
+	// The writer may have wrapped around while we were copying.
+	// Any slot it has started to write since then is unreliable. Having read any of
+	// its writes to a slot, this fence pairs with the one in `RecordProfileEvent`,
+	// so that the head it had stored before is seen here.
+	std::atomic_thread_fence(std::memory_order_acquire);
+	const uint64_t headAfter = buffer.head.load(std::memory_order_relaxed);
+	const uint64_t firstValid = headAfter + 1 > ProfileEventsPerThread ? headAfter + 1 - ProfileEventsPerThread : 0;
+
+	for (uint64_t i = std::max(begin, firstValid); i < head; ++i) {
+		const ProfileEvent &event = events[i - begin];
+		if (event.start < runStart)
+			continue;
+		if (!first)
+			out += ",\n";
+		first = false;
+		out += R"({"name":)";
+		AppendJsonString(out, event.name);
+		out += R"(,"ph":"X","ts":)";
+		AppendMicroseconds(out, event.start - runStart);
+		out += R"(,"dur":)";
+		AppendMicroseconds(out, event.duration);
+		StrAppend(out, R"(,"pid":1,"tid":)", buffer.id, "}");
+	}
+}
+
+} // namespace
+
+void StartFrameProfiler()
+{
+	RunStart.store(GetProfilerTime(), std::memory_order_relaxed);
+	frame_profiler_internal::Running.store(true, std::memory_order_relaxed);
+}
+
+void StopFrameProfiler()
+{
+	frame_profiler_internal::Running.store(false, std::memory_order_relaxed);
+}
+
+uint64_t GetProfilerTime()
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Epoch).count());
+}
+
+void RecordProfileEvent(const char *name, uint64_t start, uint64_t end)
+{
+	ThreadBufferOwner &owner = CurrentThreadBuffer;
+	if (owner.buffer == nullptr)
+		owner.buffer = AcquireBuffer();
+	ThreadBuffer &buffer = *owner.buffer;
+
+	const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+	ProfileEventSlot &slot = buffer.events[head % ProfileEventsPerThread];
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.name.store(name, std::memory_order_relaxed);
+	slot.start.store(start, std::memory_order_relaxed);
+	slot.duration.store(end - start, std::memory_order_relaxed);
+	buffer.head.store(head + 1, std::memory_order_release);
+}
+
+std::string GetFrameProfilerTrace()
+{
+	const uint64_t runStart = RunStart.load(std::memory_order_relaxed);
+	std::string out = "{\"traceEvents\":[\n";
+	bool first = true;
+	{
+		const std::lock_guard<SdlMutex> lock(BuffersMutex);
+		for (const std::unique_ptr<ThreadBuffer> &buffer : Buffers)
+			AppendEvents(out, *buffer, runStart, first);
+	}
+	out += "\n],\"displayTimeUnit\":\"ms\"}\n";
+	return out;
+}
+
+bool WriteFrameProfilerTrace(const char *path)
+{
+	FILE *file = OpenFile(path, "wb");
+	if (file == nullptr)
+		return false;
+	const std::string trace = GetFrameProfilerTrace();
+	const bool written = std::fwrite(trace.data(), trace.size(), 1, file) == 1;
+	return std::fclose(file) == 0 && written;
+}
+
+} // namespace devilution
@@ -0,0 +1,104 @@
+/**
+ * @file frame_profiler.hpp
+ *
+ * Scoped timers that can be exported in the Chrome trace-event format.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace devilution {
+
+/**
+ * @brief A finished scope, with times in nanoseconds since the profiler was first used.
+ */
+struct ProfileEvent {
+	const char *name;
+	uint64_t start;
+	uint64_t duration;
+};
+
+/**
+ * @brief Number of events kept per thread, older events are overwritten.
+ *
+ * Once a buffer has wrapped around, the trace leaves out its oldest slot as it may be in the middle of being overwritten.
+ */
+constexpr size_t ProfileEventsPerThread = 16384;
+
+namespace frame_profiler_internal {
+extern std::atomic<bool> Running;
+} // namespace frame_profiler_internal
+
+/**
+ * @brief Starts recording scopes. Events from a previous run are discarded.
+ */
+void StartFrameProfiler();
+
+void StopFrameProfiler();
+
+inline bool IsFrameProfilerRunning()
+{
+	return frame_profiler_internal::Running.load(std::memory_order_relaxed);
+}
+
+uint64_t GetProfilerTime();
+
+/**
+ * @brief Appends an event to the ring buffer of the calling thread.
+ * @param name Must outlive the profiler, typically a string literal.
+ */
+void RecordProfileEvent(const char *name, uint64_t start, uint64_t end);
+
+/**
+ * @brief Returns the recorded events as Chrome trace-event JSON, loadable in chrome://tracing or Perfetto.
+ *
+ * Can be called while other threads are still recording.
+ */
+std::string GetFrameProfilerTrace();
+
+/**
+ * @brief Writes the result of `GetFrameProfilerTrace()` to a file.
+ * @return Whether the file was written
+ */
+bool WriteFrameProfilerTrace(const char *path);
+
+class ProfileScope {
+public:
+	explicit ProfileScope(const char *name)
+	    : name_(name)
+	    , recording_(IsFrameProfilerRunning())
+	    , start_(recording_ ? GetProfilerTime() : 0)
+	{
+	}
+
+	~ProfileScope()
+	{
+		if (recording_)
+			RecordProfileEvent(name_, start_, GetProfilerTime());
+	}
+
+	ProfileScope(const ProfileScope &) = delete;
+	ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+	const char *name_;
+	bool recording_;
+	uint64_t start_;
+};
+
+#define DVL_PROFILE_CONCAT_IMPL(a, b) a##b
+#define DVL_PROFILE_CONCAT(a, b) DVL_PROFILE_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Times the rest of the enclosing block. Nested scopes show up as children in the trace.
+ */
+#ifndef DISABLE_FRAME_PROFILER
+#define DVL_PROFILE_SCOPE(name) const ::devilution::ProfileScope DVL_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#else
+#define DVL_PROFILE_SCOPE(name)
+#endif
+
+} // namespace devilution
@@ -0,0 +1,61 @@
+#include "utils/frame_time_stats.hpp"
+
+#include <algorithm>
+#include <format>
+
+namespace devilution {
+
+namespace {
+
+double ToMilliseconds(uint64_t nanoseconds)
+{
+	return static_cast<double>(nanoseconds) / 1000000.0;
+}
+
+} // namespace
+
+void FrameTimeStats::clear()
+{
+	frames_.clear();
+	logicTicks_ = 0;
+	logicTotal_ = 0;
+	renderedFrames_ = 0;
+	renderTotal_ = 0;
+}
+
+uint64_t FrameTimeStats::percentile(unsigned percent) const
+{
+	if (frames_.empty())
+		return 0;
+	std::vector<uint64_t> sorted = frames_;
+	const size_t rank = std::max<size_t>((sorted.size() * std::min(percent, 100U) + 99) / 100, 1);
+	std::nth_element(sorted.begin(), sorted.begin() + (rank - 1), sorted.end());
+	return sorted[rank - 1];
+}
+
+uint64_t FrameTimeStats::max() const
+{
+	if (frames_.empty())
+		return 0;
+	return *std::max_element(frames_.begin(), frames_.end());
+}
+
+size_t FrameTimeStats::stutterCount() const
+{
+	const uint64_t threshold = percentile(50) * StutterFactor;
+	return static_cast<size_t>(std::count_if(frames_.begin(), frames_.end(), [threshold](uint64_t duration) {
+		return duration > threshold;
+	}));
+}
+
+std::string FrameTimeStats::toJson(double seconds) const
+{
+	return std::format(R"({{"frames":{},"seconds":{:.3f},"renderedFps":{:.1f},)"
+	                   R"("frameTimeMs":{{"p50":{:.3f},"p90":{:.3f},"p99":{:.3f},"max":{:.3f}}},"stutters":{},)"
+	                   R"("logic":{{"ticks":{},"totalMs":{:.3f}}},"render":{{"frames":{},"totalMs":{:.3f}}}}})",
+	    frames_.size(), seconds, seconds > 0 ? static_cast<double>(frames_.size()) / seconds : 0.0,
+	    ToMilliseconds(percentile(50)), ToMilliseconds(percentile(90)), ToMilliseconds(percentile(99)), ToMilliseconds(max()), stutterCount(),
+	    logicTicks_, ToMilliseconds(logicTotal_), renderedFrames_, ToMilliseconds(renderTotal_));
+}
+
+} // namespace devilution
@@ -0,0 +1,72 @@
+/**
+ * @file frame_time_stats.hpp
+ *
+ * Per-frame timing statistics for timedemo runs.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace devilution {
+
+/**
+ * @brief Collects frame, logic and render durations and summarizes them.
+ *
+ * All durations are in nanoseconds.
+ */
+class FrameTimeStats {
+public:
+	/** @brief A frame that takes this many times longer than the median frame counts as a stutter. */
+	static constexpr uint64_t StutterFactor = 2;
+
+	void clear();
+
+	void addFrame(uint64_t duration)
+	{
+		frames_.push_back(duration);
+	}
+
+	void addLogic(uint64_t duration)
+	{
+		++logicTicks_;
+		logicTotal_ += duration;
+	}
+
+	void addRender(uint64_t duration)
+	{
+		++renderedFrames_;
+		renderTotal_ += duration;
+	}
+
+	[[nodiscard]] size_t frameCount() const
+	{
+		return frames_.size();
+	}
+
+	/**
+	 * @brief Returns the frame duration that `percent`% of frames don't exceed (nearest-rank), 0 if no frames were added.
+	 */
+	[[nodiscard]] uint64_t percentile(unsigned percent) const;
+
+	[[nodiscard]] uint64_t max() const;
+
+	/** @brief Number of frames that took over `StutterFactor` times the median. */
+	[[nodiscard]] size_t stutterCount() const;
+
+	/**
+	 * @brief Returns a single-line JSON object, durations are in milliseconds.
+	 * @param seconds Wall-clock duration of the whole run
+	 */
+	[[nodiscard]] std::string toJson(double seconds) const;
+
+private:
+	std::vector<uint64_t> frames_;
+	uint64_t logicTicks_ = 0;
+	uint64_t logicTotal_ = 0;
+	uint64_t renderedFrames_ = 0;
+	uint64_t renderTotal_ = 0;
+};
+
+} // namespace devilution
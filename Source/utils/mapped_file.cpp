@@ -0,0 +1,66 @@
+#include "utils/mapped_file.hpp"
+
+#include <utility>
+
+#if !defined(__DJGPP__) && !defined(_WIN32) && defined(__has_include)
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define DVL_HAS_MMAP
+#endif
+#endif
+
+namespace devilution {
+
+std::optional<MappedFile> MappedFile::Open(const char *path)
+{
+#ifdef DVL_HAS_MMAP
+	const int fd = ::open(path, O_RDONLY);
+	if (fd == -1)
+		return std::nullopt;
+	struct ::stat statResult;
+	if (::fstat(fd, &statResult) == -1 || statResult.st_size <= 0) {
+		::close(fd);
+		return std::nullopt;
+	}
+	const auto size = static_cast<size_t>(statResult.st_size);
+	void *data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping keeps the file open.
+	::close(fd);
+	if (data == MAP_FAILED)
+		return std::nullopt;
+	return MappedFile { static_cast<const char *>(data), size };
+#else
+	(void)path;
+	return std::nullopt;
+#endif
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0))
+{
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+	if (this != &other) {
+		MappedFile old { std::move(*this) };
+		data_ = std::exchange(other.data_, nullptr);
+		size_ = std::exchange(other.size_, 0);
+	}
+	return *this;
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef DVL_HAS_MMAP
+	if (data_ != nullptr)
+		::munmap(const_cast<char *>(data_), size_);
+#endif
+}
+
+} // namespace devilution
@@ -0,0 +1,47 @@
+/**
+ * @file mapped_file.hpp
+ *
+ * Read-only memory-mapped files.
+ */
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+namespace devilution {
+
+/**
+ * @brief A read-only view of a whole file, mapped into memory.
+ *
+ * The pages are loaded on first access and shared with the OS file cache,
+ * so mapping a file does not copy it.
+ */
+class MappedFile {
+public:
+	/**
+	 * @return std::nullopt if the file is empty, can't be opened, or the platform does not support memory mapping.
+	 */
+	static std::optional<MappedFile> Open(const char *path);
+
+	MappedFile(MappedFile &&other) noexcept;
+	MappedFile &operator=(MappedFile &&other) noexcept;
+	~MappedFile();
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	[[nodiscard]] const char *data() const { return data_; }
+	[[nodiscard]] size_t size() const { return size_; }
+
+private:
+	MappedFile(const char *data, size_t size)
+	    : data_(data)
+	    , size_(size)
+	{
+	}
+
+	const char *data_ = nullptr;
+	size_t size_ = 0;
+};
+
+} // namespace devilution
@@ -0,0 +1,97 @@
+#pragma once
+
+#ifdef USE_SDL3
+#include <SDL3/SDL_mutex.h>
+#else
+#include <SDL_mutex.h>
+#endif
+
+#include "appfat.h"
+#include "utils/sdl_mutex.h"
+
+namespace devilution {
+
+/*
+ * RAII wrapper for SDL_cond. Waiting requires the associated SdlMutex to be locked.
+ */
+#if defined(__EMSCRIPTEN__)
+class SdlCond final {
+public:
+	SdlCond() noexcept { }
+	~SdlCond() noexcept { }
+
+	SdlCond(const SdlCond &) = delete;
+	SdlCond(SdlCond &&) = delete;
+	SdlCond &operator=(const SdlCond &) = delete;
+	SdlCond &operator=(SdlCond &&) = delete;
+
+	void wait(SdlMutex & /*mutex*/) noexcept { }
+	void signal() noexcept { }
+	void broadcast() noexcept { }
+};
+#else
+class SdlCond final {
+public:
+	SdlCond()
+#ifdef USE_SDL3
+	    : cond_(SDL_CreateCondition())
+#else
+	    : cond_(SDL_CreateCond())
+#endif
+	{
+		if (cond_ == nullptr)
+			ErrSdl();
+	}
+
+	~SdlCond()
+	{
+#ifdef USE_SDL3
+		SDL_DestroyCondition(cond_);
+#else
+		SDL_DestroyCond(cond_);
+#endif
+	}
+
+	SdlCond(const SdlCond &) = delete;
+	SdlCond(SdlCond &&) = delete;
+	SdlCond &operator=(const SdlCond &) = delete;
+	SdlCond &operator=(SdlCond &&) = delete;
+
+	void wait(SdlMutex &mutex) noexcept // NOLINT(readability-identifier-naming)
+	{
+#ifdef USE_SDL3
+		SDL_WaitCondition(cond_, mutex.get());
+#else
+		const int err = SDL_CondWait(cond_, mutex.get());
+		if (err == -1) ErrSdl();
+#endif
+	}
+
+	void signal() noexcept // NOLINT(readability-identifier-naming)
+	{
+#ifdef USE_SDL3
+		SDL_SignalCondition(cond_);
+#else
+		SDL_CondSignal(cond_);
+#endif
+	}
+
+	void broadcast() noexcept // NOLINT(readability-identifier-naming)
+	{
+#ifdef USE_SDL3
+		SDL_BroadcastCondition(cond_);
+#else
+		SDL_CondBroadcast(cond_);
+#endif
+	}
+
+private:
+#ifdef USE_SDL3
+	SDL_Condition *cond_;
+#else
+	SDL_cond *cond_;
+#endif
+};
+#endif
+
+} // namespace devilution
@@ -141,6 +141,7 @@ SoundSample::SoundSample(SoundSample &&other) noexcept
     , isMp3_(other.isMp3_)
 #ifdef USE_SDL3
     , audio_(other.audio_)
+    , decoded_data_size_(other.decoded_data_size_)
     , track_(other.track_)
     , gain_(other.gain_)
     , muteGain_(other.muteGain_)
@@ -153,6 +154,7 @@ SoundSample::SoundSample(SoundSample &&other) noexcept
 {
 #ifdef USE_SDL3
 	other.audio_ = nullptr;
+	other.decoded_data_size_ = 0;
 	other.track_ = nullptr;
 #endif
 	other.file_data_size_ = 0;
@@ -168,6 +170,7 @@ SoundSample &SoundSample::operator=(SoundSample &&other) noexcept
 		isMp3_ = other.isMp3_;
 #ifdef USE_SDL3
 		audio_ = other.audio_;
+		decoded_data_size_ = other.decoded_data_size_;
 		track_ = other.track_;
 		gain_ = other.gain_;
 		muteGain_ = other.muteGain_;
@@ -175,6 +178,7 @@ SoundSample &SoundSample::operator=(SoundSample &&other) noexcept
 		leftGain_ = other.leftGain_;
 		rightGain_ = other.rightGain_;
 		other.audio_ = nullptr;
+		other.decoded_data_size_ = 0;
 		other.track_ = nullptr;
 #else
 		stream_ = std::move(other.stream_);
@@ -242,6 +246,7 @@ void SoundSample::Release()
 		MIX_DestroyAudio(audio_);
 		audio_ = nullptr;
 	}
+	decoded_data_size_ = 0;
 #else
 	stream_ = nullptr;
 #endif
@@ -383,6 +388,12 @@ int SoundSample::SetChunk(ArraySharedPtr<std::uint8_t> fileData, std::size_t dwB
 		return -1;
 	}
 
+	// The mixer keeps predecoded audio as float samples, which take up several times the size of the file.
+	SDL_AudioSpec spec;
+	const Sint64 frames = MIX_GetAudioDuration(audio_);
+	if (frames > 0 && MIX_GetAudioFormat(audio_, &spec))
+		decoded_data_size_ = static_cast<std::size_t>(frames) * spec.channels * sizeof(float);
+
 	return 0;
 #else
 	isMp3_ = isMp3;
@@ -63,6 +63,16 @@ public:
 		return file_data_ == nullptr;
 	}
 
+	/** @brief Size of the sound data held in memory, 0 for a streamed sound. */
+	[[nodiscard]] std::size_t GetDataSize() const
+	{
+#ifdef USE_SDL3
+		return file_data_size_ + decoded_data_size_;
+#else
+		return file_data_size_;
+#endif
+	}
+
 	int DuplicateFrom(const SoundSample &other)
 	{
 		if (other.IsStreaming())
@@ -113,6 +123,8 @@ private:
 
 #ifdef USE_SDL3
 	MIX_Audio *audio_ = nullptr;
+	/** @brief Size of the samples that `audio_` was decoded to, on top of the file data. */
+	std::size_t decoded_data_size_ = 0;
 	MIX_Track *track_ = nullptr;
 	float gain_ = 1.0f;
 	float muteGain_ = 1.0f;
@@ -0,0 +1,95 @@
+#include "utils/task_graph.hpp"
+
+#include <mutex>
+#include <utility>
+
+#include "appfat.h"
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/thread_pool.hpp"
+
+namespace devilution {
+
+namespace {
+
+std::chrono::nanoseconds Since(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+}
+
+} // namespace
+
+TaskGraph::TaskId TaskGraph::add(std::string_view name, std::initializer_list<TaskId> dependencies, std::function<void()> load, std::function<void()> finish)
+{
+	const TaskId id = tasks_.size();
+	for (const TaskId dependency : dependencies) {
+		assert(dependency < id);
+		tasks_[dependency].dependents.push_back(id);
+	}
+	tasks_.push_back(Task { name, std::move(load), std::move(finish), {}, dependencies.size() });
+	return id;
+}
+
+std::vector<TaskGraph::Timing> TaskGraph::run(unsigned workerCount)
+{
+	std::vector<Timing> timings;
+	timings.reserve(tasks_.size());
+	for (const Task &task : tasks_)
+		timings.push_back(Timing { task.name, {}, {} });
+
+	SdlMutex mutex;
+	SdlCond loadedCond;
+	std::vector<bool> loaded(tasks_.size(), false);
+	size_t loading = 0;
+
+	// Declared last, so that it is destroyed, and its workers joined, before the state they use.
+	ThreadPool pool(workerCount);
+	const auto submit = [&](TaskId id) {
+		{
+			const std::lock_guard<SdlMutex> lock(mutex);
+			++loading;
+		}
+		pool.submit([&, id]() {
+			const auto start = std::chrono::steady_clock::now();
+			tasks_[id].load();
+			const std::chrono::nanoseconds duration = Since(start);
+			const std::lock_guard<SdlMutex> lock(mutex);
+			timings[id].load = duration;
+			loaded[id] = true;
+			--loading;
+			loadedCond.broadcast();
+		});
+	};
+
+	for (TaskId id = 0; id < tasks_.size(); ++id) {
+		if (tasks_[id].numDependencies == 0)
+			submit(id);
+	}
+
+	// Dependencies are always added before their dependents, so by the time a task is
+	// waited on here, all of its dependencies have finished and it has been submitted.
+	for (TaskId id = 0; id < tasks_.size(); ++id) {
+		Task &task = tasks_[id];
+		{
+			const auto start = std::chrono::steady_clock::now();
+			std::unique_lock<SdlMutex> lock(mutex);
+			while (!loaded[id])
+				loadedCond.wait(mutex);
+			// Tasks are only submitted from this thread, so once nothing is loading,
+			// the finish step has the data of every task to itself.
+			while (task.finish && loading != 0)
+				loadedCond.wait(mutex);
+			timings[id].waited = Since(start);
+		}
+		if (task.finish)
+			task.finish();
+		for (const TaskId dependent : task.dependents) {
+			if (--tasks_[dependent].numDependencies == 0)
+				submit(dependent);
+		}
+	}
+
+	return timings;
+}
+
+} // namespace devilution
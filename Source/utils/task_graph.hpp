@@ -0,0 +1,69 @@
+/**
+ * @file task_graph.hpp
+ *
+ * Running dependent loading steps in parallel.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <string_view>
+#include <vector>
+
+namespace devilution {
+
+/**
+ * @brief A set of tasks that are loaded on worker threads as soon as their dependencies allow.
+ *
+ * Each task has a `load` step, which runs on a worker thread, and an optional `finish` step,
+ * which runs on the thread that calls `run()`. The `finish` steps always run in the order
+ * the tasks were added, regardless of which loads complete first, so that anything observable
+ * from them, such as Lua events, happens in a deterministic order.
+ *
+ * A task is loaded only after all of its dependencies have been loaded and finished.
+ * A `finish` step only runs once every load that has started has completed, and no load
+ * starts while it runs, so it may read and write the data of any task.
+ */
+class TaskGraph {
+public:
+	using TaskId = size_t;
+
+	struct Timing {
+		std::string_view name;
+		/** @brief Time spent in `load`. */
+		std::chrono::nanoseconds load;
+		/** @brief Time the calling thread spent waiting for `load`, and any other loads before `finish`, to complete. */
+		std::chrono::nanoseconds waited;
+	};
+
+	/**
+	 * @param name For timing reports, must outlive the graph
+	 * @param dependencies Tasks that must be finished before this task is loaded, must have been added before
+	 */
+	TaskId add(std::string_view name, std::initializer_list<TaskId> dependencies, std::function<void()> load, std::function<void()> finish = {});
+
+	/**
+	 * @brief Runs all tasks and returns once they have all finished. A graph can only be run once.
+	 *
+	 * Uses a pool of its own rather than `GetWorkerPool()`: a fatal error on a worker
+	 * exits the program, which must not try to join the failing thread.
+	 *
+	 * @param workerCount 0 runs everything on the calling thread
+	 */
+	std::vector<Timing> run(unsigned workerCount);
+
+private:
+	struct Task {
+		std::string_view name;
+		std::function<void()> load;
+		std::function<void()> finish;
+		std::vector<TaskId> dependents;
+		size_t numDependencies;
+	};
+
+	std::vector<Task> tasks_;
+};
+
+} // namespace devilution
@@ -0,0 +1,195 @@
+#include "utils/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#ifdef USE_SDL3
+#include <SDL3/SDL_cpuinfo.h>
+#else
+#include <SDL.h>
+#endif
+
+namespace devilution {
+
+namespace {
+
+struct ParallelForState {
+	ParallelForState(size_t count, tl::function_ref<void(size_t)> fn)
+	    : count(count)
+	    , remaining(count)
+	    , fn(fn)
+	{
+	}
+
+	const size_t count;
+	std::atomic<size_t> next { 0 };
+	std::atomic<size_t> remaining;
+	tl::function_ref<void(size_t)> fn;
+};
+
+/**
+ * @brief Runs indices of a parallel-for until none are left.
+ * @return true if this call finished the last index
+ */
+bool RunParallelForIndices(ParallelForState &state)
+{
+	bool finishedLast = false;
+	for (size_t i = state.next.fetch_add(1); i < state.count; i = state.next.fetch_add(1)) {
+		state.fn(i);
+		if (state.remaining.fetch_sub(1) == 1)
+			finishedLast = true;
+	}
+	return finishedLast;
+}
+
+unsigned DefaultWorkerCount()
+{
+#if defined(__EMSCRIPTEN__) || defined(__DJGPP__) || defined(USE_SDL1)
+	return 0;
+#else
+#ifdef USE_SDL3
+	const int cpuCount = SDL_GetNumLogicalCPUCores();
+#else
+	const int cpuCount = SDL_GetCPUCount();
+#endif
+	return cpuCount > 1 ? static_cast<unsigned>(cpuCount - 1) : 0;
+#endif
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(unsigned workerCount)
+{
+	workers_.reserve(workerCount);
+	for (unsigned i = 0; i < workerCount; ++i)
+		workers_.emplace_back(WorkerMain, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		stopping_ = true;
+	}
+	queueCond_.broadcast();
+	for (SdlThread &worker : workers_)
+		worker.join();
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+	if (workers_.empty()) {
+		task();
+		return;
+	}
+	{
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		queue_.push_back(std::move(task));
+	}
+	queueCond_.signal();
+}
+
+void ThreadPool::parallelFor(size_t count, tl::function_ref<void(size_t)> fn)
+{
+	if (count == 0)
+		return;
+	if (workers_.empty() || count == 1) {
+		for (size_t i = 0; i < count; ++i)
+			fn(i);
+		return;
+	}
+
+	// Helpers may start after all indices have been taken,
+	// so the state has to outlive this call.
+	auto state = std::make_shared<ParallelForState>(count, fn);
+	const size_t helperCount = std::min<size_t>(count - 1, workers_.size());
+	for (size_t i = 0; i < helperCount; ++i) {
+		submit([this, state]() {
+			if (RunParallelForIndices(*state)) {
+				const std::lock_guard<SdlMutex> lock(mutex_);
+				doneCond_.broadcast();
+			}
+		});
+	}
+
+	RunParallelForIndices(*state);
+
+	std::unique_lock<SdlMutex> lock(mutex_);
+	while (state->remaining.load() != 0)
+		doneCond_.wait(mutex_);
+}
+
+int SDLCALL ThreadPool::WorkerMain(void *data)
+{
+	static_cast<ThreadPool *>(data)->workerLoop();
+	return 0;
+}
+
+void ThreadPool::workerLoop()
+{
+	while (true) {
+		std::function<void()> task;
+		{
+			std::unique_lock<SdlMutex> lock(mutex_);
+			while (queue_.empty() && !stopping_)
+				queueCond_.wait(mutex_);
+			if (queue_.empty())
+				return;
+			task = std::move(queue_.front());
+			queue_.pop_front();
+		}
+		task();
+	}
+}
+
+ThreadPool &GetWorkerPool()
+{
+	static ThreadPool pool(DefaultWorkerCount());
+	return pool;
+}
+
+JobThread::JobThread()
+    // With a single CPU, or no thread support at all, a thread of its own would only add overhead.
+    : thread_(DefaultWorkerCount() != 0 ? 1 : 0)
+{
+}
+
+JobThread::~JobThread()
+{
+	wait();
+}
+
+void JobThread::start(std::function<void()> job)
+{
+	wait();
+	{
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		busy_ = true;
+	}
+	thread_.submit([this, job = std::move(job)]() mutable {
+		job();
+		// Whatever the job holds on to is released before wait() returns.
+		job = nullptr;
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		busy_ = false;
+		idleCond_.broadcast();
+	});
+}
+
+void JobThread::wait()
+{
+	std::unique_lock<SdlMutex> lock(mutex_);
+	while (busy_)
+		idleCond_.wait(mutex_);
+}
+
+bool JobThread::busy()
+{
+	const std::lock_guard<SdlMutex> lock(mutex_);
+	return busy_;
+}
+
+} // namespace devilution
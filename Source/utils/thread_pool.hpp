@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include <function_ref.hpp>
+
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
+
+namespace devilution {
+
+/**
+ * @brief A fixed set of worker threads that run queued tasks.
+ *
+ * A pool without workers runs every task inline on the calling thread,
+ * which is what platforms without thread support get.
+ */
+class ThreadPool {
+public:
+	explicit ThreadPool(unsigned workerCount);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	[[nodiscard]] unsigned workerCount() const
+	{
+		return static_cast<unsigned>(workers_.size());
+	}
+
+	/**
+	 * @brief Queues a task to be run on a worker thread.
+	 *
+	 * Tasks still queued when the pool is destroyed are run before the workers exit.
+	 */
+	void submit(std::function<void()> task);
+
+	/**
+	 * @brief Calls `fn(i)` for every `i` in `[0, count)` and returns once all calls have finished.
+	 *
+	 * The calling thread takes part in the work, so this never waits on tasks
+	 * that were queued ahead of it with `submit`.
+	 */
+	void parallelFor(size_t count, tl::function_ref<void(size_t)> fn);
+
+private:
+	static int SDLCALL WorkerMain(void *data);
+	void workerLoop();
+
+	std::vector<SdlThread> workers_;
+	std::deque<std::function<void()>> queue_;
+	SdlMutex mutex_;
+	SdlCond queueCond_;
+	SdlCond doneCond_;
+	bool stopping_ = false;
+};
+
+/**
+ * @brief Returns the shared worker pool, with one worker per additional logical CPU.
+ */
+ThreadPool &GetWorkerPool();
+
+/**
+ * @brief A thread of its own that runs one job at a time, so that the job can overlap with the caller's work.
+ *
+ * Unlike tasks on the shared worker pool, a job never waits behind unrelated work.
+ * Where the worker pool has no workers, the job runs inline.
+ */
+class JobThread {
+public:
+	JobThread();
+	~JobThread();
+
+	JobThread(const JobThread &) = delete;
+	JobThread &operator=(const JobThread &) = delete;
+
+	/**
+	 * @brief Starts a job, after waiting for the previous one to finish.
+	 */
+	void start(std::function<void()> job);
+
+	/**
+	 * @brief Returns once the last started job has finished.
+	 */
+	void wait();
+
+	[[nodiscard]] bool busy();
+
+	/**
+	 * @brief Whether jobs run on a thread of their own rather than inline.
+	 */
+	[[nodiscard]] bool isThreaded() const
+	{
+		return thread_.workerCount() != 0;
+	}
+
+private:
+	SdlMutex mutex_;
+	SdlCond idleCond_;
+	bool busy_ = false;
+	/** @brief Declared last, so that the thread has exited before the state it signals is destroyed. */
+	ThreadPool thread_;
+};
+
+} // namespace devilution
@@ -119,6 +119,8 @@ void RunAnimationTest(const std::vector<TestData *> &vecTestData)
 			    << " currentFrame: " << animInfo.currentFrame
 			    << " DelayCounter: " << animInfo.tickCounterOfCurrentFrame
 			    << " GameTick: " << currentGameTick;
+			// Rendering from a world snapshot passes the progress instead of reading the global.
+			EXPECT_EQ(animInfo.getFrameToUseForRendering(ProgressToNextGameTick), renderingData->_ExpectedRenderingFrame);
 		} break;
 		}
 	}
@@ -547,3 +549,24 @@ TEST(AnimationInfo, Stand) // Distribution Logic shouldn't change anything here
 	        new RenderingData(0.6f, 0),
 	    });
 }
+
+TEST(AnimationInfo, ExplicitProgressToNextGameTick)
+{
+	AnimationInfo animInfo = {};
+	animInfo.setNewAnimation(std::nullopt, 10, 1, AnimationDistributionFlags::ProcessAnimationPending, 0, 10);
+	animInfo.processAnimation();
+
+	ProgressToNextGameTick = 0;
+	const int8_t frameAtHalfTick = animInfo.getFrameToUseForRendering(AnimationInfo::baseValueFraction / 2);
+	const uint8_t progressAtHalfTick = animInfo.getAnimationProgress(AnimationInfo::baseValueFraction / 2);
+
+	// The explicit progress doesn't depend on the global one.
+	ProgressToNextGameTick = AnimationInfo::baseValueFraction / 2;
+	EXPECT_EQ(animInfo.getFrameToUseForRendering(), frameAtHalfTick);
+	EXPECT_EQ(animInfo.getAnimationProgress(), progressAtHalfTick);
+	EXPECT_GT(animInfo.getAnimationProgress(AnimationInfo::baseValueFraction / 2), animInfo.getAnimationProgress(0));
+
+	// Petrified animations don't advance, whatever progress is passed.
+	animInfo.isPetrified = true;
+	EXPECT_EQ(animInfo.getAnimationProgress(AnimationInfo::baseValueFraction / 2), animInfo.getAnimationProgress(0));
+}
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <expected>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "engine/assets.hpp"
+#include "headless_mode.hpp"
+#ifndef UNPACKED_MPQS
+#include "mpq/mpq_writer.hpp"
+#endif
+#include "utils/file_util.h"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+namespace {
+
+constexpr size_t NumSyntheticAssets = 4000;
+constexpr const char *ModsRoot = "asset_lookup_benchmark_mods" DIRECTORY_SEPARATOR_STR;
+
+// A stand-in for the game's listfile: real asset names plus names shaped like them.
+std::vector<std::string> AssetNames;
+
+void InitOnce()
+{
+	[[maybe_unused]] static const bool GlobalInitDone = []() {
+		// Without the game data, lookups that would hit an MPQ resolve as missing instead.
+		HeadlessMode = true;
+		LoadCoreArchives();
+		LoadGameArchives();
+
+		AssetNames = {
+			"levels\\l1data\\l1.cel",
+			"levels\\l1data\\l1.til",
+			"levels\\l1data\\l1.min",
+			"levels\\l1data\\l1.sol",
+			"levels\\towndata\\town.cel",
+			"data\\inv\\objcurs.cel",
+			"ctrlpan\\panel8.cel",
+			"gendata\\cut2.cel",
+			"plrgfx\\warrior\\wla\\wlaat.cl2",
+			"monsters\\zombie\\zombiea.cl2",
+			"txtdata\\monsters\\monstdat.tsv",
+			"fonts\\12-00.clx",
+		};
+		static constexpr const char *Directories[] = { "monsters", "objects", "items", "missiles", "plrgfx", "levels" };
+		for (size_t i = 0; i < NumSyntheticAssets; ++i) {
+			AssetNames.push_back(StrCat(Directories[i % std::size(Directories)], "\\asset", i / 16, "\\asset", i, ".cl2"));
+		}
+		return true;
+	}();
+}
+
+void CreateEmptyFile(const std::string &path)
+{
+	const std::string dir { Dirname(path) };
+	RecursivelyCreateDir(dir.c_str());
+	FILE *file = OpenFile(path.c_str(), "wb");
+	if (file != nullptr)
+		std::fclose(file);
+}
+
+/**
+ * @brief Creates `numMods` loose mod directories, each overriding a different subset of `AssetNames`.
+ */
+std::vector<std::string> CreateMods(size_t numMods)
+{
+	std::vector<std::string> modPaths;
+	for (size_t mod = 0; mod < numMods; ++mod) {
+		std::string modPath = StrCat(ModsRoot, "mod", mod, DIRECTORY_SEPARATOR_STR);
+		for (size_t i = 0; i < AssetNames.size(); i += mod + 2) {
+			std::string relativePath = AssetNames[i];
+			std::replace(relativePath.begin(), relativePath.end(), '\\', DirectorySeparator);
+			CreateEmptyFile(modPath + relativePath);
+		}
+		modPaths.push_back(std::move(modPath));
+	}
+	return modPaths;
+}
+
+/**
+ * @brief Removes everything `CreateMods` and `CreateMpqMods` created.
+ */
+void RemoveMods()
+{
+	std::error_code ec;
+	std::filesystem::remove_all(ModsRoot, ec);
+}
+
+void BM_FindAllAssets(benchmark::State &state)
+{
+	InitOnce();
+	const std::vector<std::string> modPaths = CreateMods(static_cast<size_t>(state.range(0)));
+	const std::vector<std::string> savedOverridePaths = OverridePaths;
+	OverridePaths = modPaths;
+	RebuildAssetIndex();
+
+	for (auto _ : state) {
+		for (const std::string &name : AssetNames) {
+			AssetRef ref = FindAsset(name);
+			benchmark::DoNotOptimize(ref);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(AssetNames.size()));
+
+	OverridePaths = savedOverridePaths;
+	RebuildAssetIndex();
+	RemoveMods();
+}
+
+BENCHMARK(BM_FindAllAssets)->ArgName("mods")->Arg(0)->Arg(1)->Arg(5);
+
+#ifndef UNPACKED_MPQS
+/**
+ * @brief Creates `numMods` packed mods, each overriding a different subset of `AssetNames`.
+ *
+ * Every other name is skipped compared to `CreateMods`, to stay within the hash table of an MPQ.
+ */
+std::vector<std::string> CreateMpqMods(size_t numMods)
+{
+	RecursivelyCreateDir(ModsRoot);
+	const std::byte data[1] {};
+	std::vector<std::string> mpqPaths;
+	for (size_t mod = 0; mod < numMods; ++mod) {
+		std::string mpqPath = StrCat(ModsRoot, "mod", mod, ".mpq");
+		{
+			MpqWriter writer(mpqPath, /*carryForward=*/false);
+			for (size_t i = 0; i < AssetNames.size(); i += 2 * (mod + 2)) {
+				writer.WriteFile(AssetNames[i], data, sizeof(data));
+			}
+		}
+		mpqPaths.push_back(std::move(mpqPath));
+	}
+	return mpqPaths;
+}
+
+void BM_FindAllAssetsInMpqMods(benchmark::State &state)
+{
+	InitOnce();
+	const std::vector<std::string> mpqPaths = CreateMpqMods(static_cast<size_t>(state.range(0)));
+	// Mods are registered from this priority up, see `LoadModArchives`.
+	int priority = 10000;
+	for (const std::string &mpqPath : mpqPaths) {
+		std::expected<MpqArchive, std::string> archive = MpqArchive::Open(mpqPath.c_str());
+		if (!archive.has_value()) {
+			state.SkipWithError(archive.error().c_str());
+			break;
+		}
+		MpqArchives.emplace(priority++, *std::move(archive));
+	}
+	InvalidateAssetIndex();
+
+	for (auto _ : state) {
+		for (const std::string &name : AssetNames) {
+			AssetRef ref = FindAsset(name);
+			benchmark::DoNotOptimize(ref);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(AssetNames.size()));
+
+	for (int modPriority = 10000; modPriority < priority; ++modPriority)
+		MpqArchives.erase(modPriority);
+	InvalidateAssetIndex();
+	RemoveMods();
+}
+
+BENCHMARK(BM_FindAllAssetsInMpqMods)->ArgName("mods")->Arg(1)->Arg(5);
+#endif
+
+} // namespace
+} // namespace devilution
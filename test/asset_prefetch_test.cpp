@@ -0,0 +1,62 @@
+#include <atomic>
+#include <memory>
+#include <optional>
+
+#include <gtest/gtest.h>
+
+#include "engine/asset_prefetch.hpp"
+
+namespace devilution {
+namespace {
+
+TEST(AssetPrefetcherTest, TakeReturnsPrefetchedValue)
+{
+	AssetPrefetcher<int> prefetcher;
+	prefetcher.prefetch(1, []() { return 42; });
+	prefetcher.prefetch(2, []() { return 7; });
+	EXPECT_EQ(prefetcher.take(2), 7);
+	EXPECT_EQ(prefetcher.take(1), 42);
+}
+
+TEST(AssetPrefetcherTest, TakeWithoutPrefetchIsEmpty)
+{
+	AssetPrefetcher<int> prefetcher;
+	EXPECT_EQ(prefetcher.take(3), std::nullopt);
+	prefetcher.prefetch(3, []() { return 1; });
+	EXPECT_EQ(prefetcher.take(3), 1);
+	EXPECT_EQ(prefetcher.take(3), std::nullopt);
+}
+
+TEST(AssetPrefetcherTest, SameKeyIsLoadedOnce)
+{
+	auto loads = std::make_shared<std::atomic<int>>(0);
+	AssetPrefetcher<int> prefetcher;
+	for (int i = 0; i < 3; ++i) {
+		prefetcher.prefetch(5, [loads, i]() {
+			++*loads;
+			return i;
+		});
+	}
+	EXPECT_EQ(prefetcher.take(5), 0);
+	EXPECT_EQ(*loads, 1);
+}
+
+TEST(AssetPrefetcherTest, HoldsMoveOnlyValues)
+{
+	AssetPrefetcher<std::unique_ptr<int>> prefetcher;
+	prefetcher.prefetch(0, []() { return std::make_unique<int>(9); });
+	std::optional<std::unique_ptr<int>> value = prefetcher.take(0);
+	ASSERT_TRUE(value.has_value());
+	EXPECT_EQ(**value, 9);
+}
+
+TEST(AssetPrefetcherTest, ClearDropsPendingLoads)
+{
+	AssetPrefetcher<int> prefetcher;
+	prefetcher.prefetch(4, []() { return 4; });
+	prefetcher.clear();
+	EXPECT_EQ(prefetcher.take(4), std::nullopt);
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,105 @@
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "engine/clx_cache.hpp"
+#include "utils/file_util.h"
+
+namespace devilution {
+namespace {
+
+const std::string CacheDir = "Test_ClxCache" DIRECTORY_SEPARATOR_STR;
+
+class ClxCacheTest : public ::testing::Test {
+protected:
+	static void SetUpTestSuite()
+	{
+		EnableClxCache(CacheDir);
+	}
+
+	void TearDown() override
+	{
+		for (const std::string &file : ListFiles(CacheDir.c_str()))
+			RemoveFile((CacheDir + file).c_str());
+	}
+};
+
+TEST_F(ClxCacheTest, LoadReturnsStoredData)
+{
+	const std::vector<uint8_t> data { 1, 2, 3, 4, 5 };
+	StoreCachedClxData("sprite", data.data(), data.size(), /*numLists=*/3);
+
+	const std::optional<CachedClxData> cached = LoadCachedClxData("sprite");
+	ASSERT_TRUE(cached.has_value());
+	EXPECT_EQ(std::vector<uint8_t>(cached->data.get(), cached->data.get() + cached->size), data);
+	EXPECT_EQ(cached->numLists, 3);
+}
+
+TEST_F(ClxCacheTest, MissingKeyIsAMiss)
+{
+	const uint8_t data[] = { 1 };
+	StoreCachedClxData("sprite", data, sizeof(data), /*numLists=*/0);
+
+	const ClxCacheStats before = GetClxCacheStats();
+	EXPECT_FALSE(LoadCachedClxData("other sprite").has_value());
+	EXPECT_EQ(GetClxCacheStats().misses, before.misses + 1);
+}
+
+TEST_F(ClxCacheTest, TruncatedFileIsAMiss)
+{
+	const std::vector<uint8_t> data(100, 42);
+	StoreCachedClxData("sprite", data.data(), data.size(), /*numLists=*/0);
+
+	const std::vector<std::string> files = ListFiles(CacheDir.c_str());
+	ASSERT_EQ(files.size(), 1);
+	std::uintmax_t size;
+	ASSERT_TRUE(GetFileSize((CacheDir + files[0]).c_str(), &size));
+	ASSERT_TRUE(ResizeFile((CacheDir + files[0]).c_str(), size - 1));
+
+	EXPECT_FALSE(LoadCachedClxData("sprite").has_value());
+}
+
+TEST_F(ClxCacheTest, CorruptDataSizeIsAMiss)
+{
+	const std::vector<uint8_t> data(100, 42);
+	StoreCachedClxData("sprite", data.data(), data.size(), /*numLists=*/0);
+
+	const std::vector<std::string> files = ListFiles(CacheDir.c_str());
+	ASSERT_EQ(files.size(), 1);
+	FILE *file = OpenFile((CacheDir + files[0]).c_str(), "r+b");
+	ASSERT_NE(file, nullptr);
+	// The data size follows the magic, the version and the key size.
+	const uint32_t dataSize = 0xFFFFFFF0;
+	std::fseek(file, 12, SEEK_SET);
+	std::fwrite(&dataSize, sizeof(dataSize), 1, file);
+	std::fclose(file);
+
+	EXPECT_FALSE(LoadCachedClxData("sprite").has_value());
+}
+
+TEST_F(ClxCacheTest, TrailingDataIsAMiss)
+{
+	const std::vector<uint8_t> data(100, 42);
+	StoreCachedClxData("sprite", data.data(), data.size(), /*numLists=*/0);
+
+	const std::vector<std::string> files = ListFiles(CacheDir.c_str());
+	ASSERT_EQ(files.size(), 1);
+	std::uintmax_t size;
+	ASSERT_TRUE(GetFileSize((CacheDir + files[0]).c_str(), &size));
+	ASSERT_TRUE(ResizeFile((CacheDir + files[0]).c_str(), size + 1));
+
+	EXPECT_FALSE(LoadCachedClxData("sprite").has_value());
+}
+
+TEST_F(ClxCacheTest, FrameWidthListsAreNotCached)
+{
+	const uint16_t widths[] = { 96, 128 };
+	EXPECT_FALSE(ClxCacheKey("monsters\\zombie\\zombiea.cl2", PointerOrValue<uint16_t> { widths }).has_value());
+}
+
+} // namespace
+} // namespace devilution
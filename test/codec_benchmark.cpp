@@ -0,0 +1,55 @@
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "codec.h"
+
+namespace devilution {
+namespace {
+
+constexpr char Password[] = "xrgyrkj1";
+
+std::vector<std::byte> MakeEntry(size_t size)
+{
+	std::vector<std::byte> data(codec_get_encoded_len(size));
+	for (size_t i = 0; i < size; ++i)
+		data[i] = static_cast<std::byte>(i * 2654435761U >> 13);
+	return data;
+}
+
+void BM_Encode(benchmark::State &state)
+{
+	const auto size = static_cast<size_t>(state.range(0));
+	const std::vector<std::byte> plainText = MakeEntry(size);
+	std::vector<std::byte> data(plainText.size());
+	for (auto _ : state) {
+		memcpy(data.data(), plainText.data(), size);
+		codec_encode(data.data(), size, data.size(), Password);
+		benchmark::DoNotOptimize(data.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(size * state.iterations()));
+}
+
+void BM_Decode(benchmark::State &state)
+{
+	const auto size = static_cast<size_t>(state.range(0));
+	std::vector<std::byte> encoded = MakeEntry(size);
+	codec_encode(encoded.data(), size, encoded.size(), Password);
+	std::vector<std::byte> data(encoded.size());
+	for (auto _ : state) {
+		memcpy(data.data(), encoded.data(), encoded.size());
+		if (codec_decode(data.data(), data.size(), Password) != size) {
+			state.SkipWithError("Failed to decode");
+			break;
+		}
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(size * state.iterations()));
+}
+
+BENCHMARK(BM_Encode)->Arg(1 << 20);
+BENCHMARK(BM_Decode)->Arg(1 << 20);
+
+} // namespace
+} // namespace devilution
@@ -1,9 +1,28 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "codec.h"
 
 using namespace devilution;
 
+namespace {
+
+constexpr char Password[] = "xrgyrkj1";
+
+std::vector<std::byte> MakePlainText(size_t size)
+{
+	std::vector<std::byte> data(codec_get_encoded_len(size));
+	for (size_t i = 0; i < size; ++i)
+		data[i] = static_cast<std::byte>(i * 7 + 3);
+	return data;
+}
+
+} // namespace
+
 TEST(Codec, codec_get_encoded_len)
 {
 	EXPECT_EQ(codec_get_encoded_len(50), 72);
@@ -13,3 +32,54 @@ TEST(Codec, codec_get_encoded_len_eq)
 {
 	EXPECT_EQ(codec_get_encoded_len(128), 136);
 }
+
+TEST(Codec, codec_encode_matches_saves)
+{
+	// Encoded by the original block by block implementation, which existing saves were written with.
+	constexpr uint8_t Expected[] = {
+	0x61, 0x67, 0xe5, 0x33, 0x51, 0xc2, 0x0e, 0xa0, 0xe9, 0xfc, 0x82, 0xc7,
+	0x4e, 0x4b, 0x2a, 0x00, 0x45, 0x2d, 0x92, 0xab, 0xed, 0xfb, 0x69, 0x8f,
+	0xe5, 0x56, 0x9a, 0x54, 0x15, 0x70, 0x1e, 0x4b, 0xfa, 0xff, 0xbe, 0x94,
+	0xc9, 0x51, 0x1e, 0x37, 0x79, 0x4f, 0xdd, 0x1b, 0x79, 0xda, 0x66, 0xd8,
+	0x81, 0xe4, 0xcb, 0x97, 0x19, 0x15, 0x4f, 0x6c, 0x36, 0x57, 0x13, 0x23,
+	0x62, 0x6d, 0xf4, 0x2b, 0xb1, 0xae, 0x81, 0xcb, 0x00, 0x32, 0x00, 0x00,
+	};
+	std::vector<std::byte> data = MakePlainText(50);
+	ASSERT_EQ(data.size(), sizeof(Expected));
+	codec_encode(data.data(), 50, data.size(), Password);
+	for (size_t i = 0; i < sizeof(Expected); ++i)
+		EXPECT_EQ(static_cast<uint8_t>(data[i]), Expected[i]) << "at byte " << i;
+}
+
+TEST(Codec, codec_round_trip)
+{
+	for (const size_t size : { 0, 1, 63, 64, 65, 1000, 1 << 20 }) {
+		const std::vector<std::byte> plainText = MakePlainText(size);
+		std::vector<std::byte> data = plainText;
+		codec_encode(data.data(), size, data.size(), Password);
+		ASSERT_EQ(codec_decode(data.data(), data.size(), Password), size) << "size " << size;
+		EXPECT_TRUE(std::equal(plainText.begin(), plainText.begin() + size, data.begin())) << "size " << size;
+	}
+}
+
+TEST(Codec, codec_decode_wrong_password)
+{
+	std::vector<std::byte> data = MakePlainText(100);
+	codec_encode(data.data(), 100, data.size(), Password);
+	EXPECT_EQ(codec_decode(data.data(), data.size(), "szqnlsk1"), 0);
+}
+
+TEST(Codec, codec_decode_corrupted)
+{
+	std::vector<std::byte> data = MakePlainText(100);
+	codec_encode(data.data(), 100, data.size(), Password);
+	data[10] ^= std::byte { 1 };
+	EXPECT_EQ(codec_decode(data.data(), data.size(), Password), 0);
+}
+
+TEST(Codec, codec_decode_partial_block)
+{
+	std::vector<std::byte> data = MakePlainText(100);
+	codec_encode(data.data(), 100, data.size(), Password);
+	EXPECT_EQ(codec_decode(data.data(), data.size() - 16, Password), 0);
+}
@@ -0,0 +1,154 @@
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "data/compiled_file.hpp"
+#include "data/delimiter_scan.hpp"
+#include "data/file.hpp"
+#include "engine/assets.hpp"
+#include "headless_mode.hpp"
+#include "tables/itemdat.h"
+#include "tables/misdat.h"
+#include "tables/monstdat.h"
+
+namespace devilution {
+namespace {
+
+constexpr std::string_view ItemDatPath = "txtdata\\items\\itemdat.tsv";
+constexpr std::string_view MonstDatPath = "txtdata\\monsters\\monstdat.tsv";
+constexpr std::string_view MisDatPath = "txtdata\\missiles\\misdat.tsv";
+
+void InitOnce()
+{
+	[[maybe_unused]] static const bool GlobalInitDone = []() {
+		HeadlessMode = true;
+		LoadCoreArchives();
+		LoadGameArchives();
+		return true;
+	}();
+}
+
+/** @brief Loads a data file without a delimiter index. */
+DataFile LoadSource(std::string_view path)
+{
+	InitOnce();
+	SetDelimiterScanIsa(DelimiterScanIsa::Scalar);
+	DataFile dataFile = DataFile::loadOrDie(path);
+	SetDelimiterScanIsa(GetBestDelimiterScanIsa());
+	return dataFile;
+}
+
+DataFile Compile(const DataFile &source)
+{
+	constexpr std::string_view SourceKey = "benchmark";
+	auto file = std::make_shared<const std::string>(CompileDataFile(source, SourceKey).value());
+	const char *data = file->data();
+	const size_t size = file->size();
+	return *OpenCompiledDataFile(std::shared_ptr<const char>(std::move(file), data), size, SourceKey);
+}
+
+void LoadItemDat(DataFile dataFile)
+{
+	AllItemsList.clear();
+	ItemMappingIdsToIndices.clear();
+	LoadItemDatFromFile(dataFile, ItemDatPath, 0);
+}
+
+void LoadMonstDat(DataFile dataFile)
+{
+	MonstersData.clear();
+	MonstersData.resize(NUM_DEFAULT_MTYPES);
+	LoadMonstDatFromFile(dataFile, MonstDatPath, false);
+}
+
+void LoadMisDat(DataFile dataFile)
+{
+	LoadMisdatFromFile(dataFile, MisDatPath);
+}
+
+template <void (*Load)(DataFile), const std::string_view *Path>
+void BM_ParseText(benchmark::State &state)
+{
+	const DataFile source = LoadSource(*Path);
+	for (auto _ : state) {
+		Load(source);
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(source.size()));
+}
+
+template <void (*Load)(DataFile), const std::string_view *Path>
+void BM_ParseIndexed(benchmark::State &state)
+{
+	if (GetBestDelimiterScanIsa() == DelimiterScanIsa::Scalar) {
+		state.SkipWithError("Data files are not indexed without SIMD");
+		return;
+	}
+	const DataFile source = LoadSource(*Path);
+	for (auto _ : state) {
+		// The source is loaded without an index, so that indexing is measured too.
+		DataFile dataFile = source;
+		dataFile.buildIndex();
+		Load(std::move(dataFile));
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(source.size()));
+}
+
+template <void (*Load)(DataFile), const std::string_view *Path>
+void BM_ParseCompiled(benchmark::State &state)
+{
+	const DataFile source = LoadSource(*Path);
+	const DataFile compiled = Compile(source);
+	for (auto _ : state) {
+		Load(compiled);
+	}
+	// Counts the bytes of the source, so that the rates are comparable to BM_ParseText.
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(source.size()));
+}
+
+void BM_ScanDelimiters(benchmark::State &state)
+{
+	const auto isa = static_cast<DelimiterScanIsa>(state.range(0));
+	if (GetDelimiterScanKernel(isa) == nullptr) {
+		state.SkipWithError("Not supported by this CPU");
+		return;
+	}
+	const DataFile source = LoadSource(MonstDatPath);
+	SetDelimiterScanIsa(isa);
+	for (auto _ : state) {
+		const DelimiterIndex index(source.data(), source.size());
+		benchmark::DoNotOptimize(index.find(source.data(), source.data() + source.size()));
+	}
+	SetDelimiterScanIsa(GetBestDelimiterScanIsa());
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(source.size()));
+}
+
+void BM_SourceKey(benchmark::State &state)
+{
+	InitOnce();
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(DataFileSourceKey(FindAsset(ItemDatPath), ItemDatPath));
+	}
+}
+
+BENCHMARK(BM_ParseText<LoadItemDat, &ItemDatPath>)->Name("BM_ParseText/itemdat");
+BENCHMARK(BM_ParseIndexed<LoadItemDat, &ItemDatPath>)->Name("BM_ParseIndexed/itemdat");
+BENCHMARK(BM_ParseCompiled<LoadItemDat, &ItemDatPath>)->Name("BM_ParseCompiled/itemdat");
+BENCHMARK(BM_ParseText<LoadMonstDat, &MonstDatPath>)->Name("BM_ParseText/monstdat");
+BENCHMARK(BM_ParseIndexed<LoadMonstDat, &MonstDatPath>)->Name("BM_ParseIndexed/monstdat");
+BENCHMARK(BM_ParseCompiled<LoadMonstDat, &MonstDatPath>)->Name("BM_ParseCompiled/monstdat");
+BENCHMARK(BM_ParseText<LoadMisDat, &MisDatPath>)->Name("BM_ParseText/misdat");
+BENCHMARK(BM_ParseIndexed<LoadMisDat, &MisDatPath>)->Name("BM_ParseIndexed/misdat");
+BENCHMARK(BM_ParseCompiled<LoadMisDat, &MisDatPath>)->Name("BM_ParseCompiled/misdat");
+BENCHMARK(BM_ScanDelimiters)
+    ->ArgName("isa")
+    ->Arg(static_cast<int>(DelimiterScanIsa::Scalar))
+    ->Arg(static_cast<int>(DelimiterScanIsa::Sse2))
+    ->Arg(static_cast<int>(DelimiterScanIsa::Neon));
+BENCHMARK(BM_SourceKey);
+
+} // namespace
+} // namespace devilution
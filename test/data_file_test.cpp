@@ -1,11 +1,16 @@
 #include <gtest/gtest.h>
 
+#include "data/compiled_file.hpp"
 #include "data/file.hpp"
 #include "data/parser.hpp"
 
+#include <memory>
+#include <optional>
+#include <string>
 #include <string_view>
 #include <vector>
 
+#include "engine/assets.hpp"
 #include "utils/paths.h"
 
 namespace devilution {
@@ -529,4 +534,168 @@ TEST(DataFileTest, SkipRowIterator)
 	EXPECT_EQ(row, expectedFields.size()) << "Parsing returned fewer records than expected";
 }
 
+std::optional<DataFile> CompileDataFileForTest(const DataFile &source)
+{
+	constexpr std::string_view SourceKey = "test";
+	std::expected<std::string, std::string> compiled = CompileDataFile(source, SourceKey);
+	if (!compiled.has_value())
+		return std::nullopt;
+	auto file = std::make_shared<const std::string>(*std::move(compiled));
+	const char *data = file->data();
+	const size_t size = file->size();
+	return OpenCompiledDataFile(std::shared_ptr<const char>(std::move(file), data), size, SourceKey);
+}
+
+TEST(DataFileTest, CompiledFileMatchesSource)
+{
+	for (const std::string_view path : { "txtdata\\lf.tsv", "txtdata\\crlf.tsv", "txtdata\\lf_no_trail.tsv", "txtdata\\utf8_bom.tsv", "txtdata\\sample.tsv", "txtdata\\empty.tsv" }) {
+		auto result = LoadDataFile(path);
+		ASSERT_TRUE(result.has_value()) << "Unable to load " << path;
+		const DataFile &source = result.value();
+
+		std::optional<DataFile> compiled = CompileDataFileForTest(source);
+		ASSERT_TRUE(compiled.has_value()) << "Unable to compile " << path;
+		EXPECT_EQ(compiled->encoding(), FieldEncoding::LengthPrefixed);
+		EXPECT_EQ(compiled->numRecords(), source.numRecords()) << "Compiled " << path << " should report the same number of records";
+
+		auto sourceRecord = source.begin();
+		auto compiledRecord = compiled->begin();
+		for (; sourceRecord != source.end(); ++sourceRecord, ++compiledRecord) {
+			ASSERT_NE(compiledRecord, compiled->end()) << "Compiled " << path << " has fewer records than the source";
+			DataFileRecord sourceFields = *sourceRecord;
+			DataFileRecord compiledFields = *compiledRecord;
+			EXPECT_EQ(compiledFields.row(), sourceFields.row());
+			auto sourceField = sourceFields.begin();
+			auto compiledField = compiledFields.begin();
+			for (; sourceField != sourceFields.end(); ++sourceField, ++compiledField) {
+				ASSERT_NE(compiledField, compiledFields.end()) << "Compiled " << path << " has fewer fields than the source in row " << sourceFields.row();
+				EXPECT_EQ((*compiledField).value(), (*sourceField).value()) << "Unexpected value in compiled " << path << " at row " << sourceFields.row() << " and column " << sourceField.column();
+				EXPECT_EQ(compiledField.column(), sourceField.column());
+			}
+			EXPECT_EQ(compiledField, compiledFields.end()) << "Compiled " << path << " has more fields than the source in row " << sourceFields.row();
+		}
+		EXPECT_EQ(compiledRecord, compiled->end()) << "Compiled " << path << " has more records than the source";
+	}
+}
+
+TEST(DataFileTest, CompiledFileParseInt)
+{
+	auto result = LoadDataFile("txtdata\\sample.tsv");
+	ASSERT_TRUE(result.has_value()) << "Unable to load sample.tsv";
+	std::optional<DataFile> compiled = CompileDataFileForTest(result.value());
+	ASSERT_TRUE(compiled.has_value()) << "Unable to compile sample.tsv";
+
+	ASSERT_TRUE(compiled->skipHeader().has_value()) << "Should be able to skip the header of the compiled sample.tsv file";
+	for (DataFileRecord record : *compiled) {
+		auto fieldIt = record.begin();
+		uint8_t shortVal = 5;
+		auto parseIntResult = (*fieldIt).parseInt(shortVal);
+		ASSERT_FALSE(parseIntResult.has_value()) << "Parsing a string as an int should not succeed";
+		EXPECT_EQ(parseIntResult.error(), DataFileField::Error::NotANumber);
+
+		fieldIt += 2;
+		DataFileField field = *fieldIt;
+		parseIntResult = field.parseInt(shortVal);
+		ASSERT_FALSE(parseIntResult.has_value()) << "Parsing an int into a short variable should not succeed";
+		EXPECT_EQ(parseIntResult.error(), DataFileField::Error::OutOfRange);
+		int longVal = 42;
+		EXPECT_TRUE(field.parseInt(longVal).has_value()) << "Expected " << field << " to fit into an int variable";
+		EXPECT_EQ(longVal, 70322);
+		EXPECT_EQ(*field, "70322");
+
+		++fieldIt;
+		field = *fieldIt;
+		EXPECT_TRUE(field.parseInt(shortVal).has_value()) << "Expected " << field << " to be parsed up to the first non-digit character";
+		EXPECT_EQ(shortVal, 6);
+		int fixedVal = 64;
+		EXPECT_TRUE(field.parseFixed6(fixedVal).has_value()) << "Expected " << field << " to be parsed as a fixed point value";
+		EXPECT_EQ(fixedVal, 406);
+		EXPECT_EQ(*field, "6.34");
+	}
+}
+
+TEST(DataFileTest, IndexedIterationMatchesScanning)
+{
+	for (const std::string_view text : { "", "\n", "a", "a\n", "a\n\n", "a\t", "a\t\n", "\t\t", "a\tb\r\nc\td", "a\r\n\r\n", "a\rb\tc", "a\r",
+	         "a longer field that spans a word\tand\tthen a few short ones\t1\t2\t3\nand a second record that has\tfields spanning words as well\r\n" }) {
+		const DelimiterIndex index(text.data(), text.size());
+		const char *end = text.data() + text.size();
+		RecordIterator scanned { text.data(), end, false };
+		RecordIterator indexed { text.data(), end, false, FieldEncoding::Text, &index };
+		for (; scanned != RecordIterator {}; ++scanned, ++indexed) {
+			ASSERT_NE(indexed, RecordIterator {}) << "Indexing found fewer records in \"" << text << "\"";
+			DataFileRecord scannedFields = *scanned;
+			DataFileRecord indexedFields = *indexed;
+			auto scannedField = scannedFields.begin();
+			auto indexedField = indexedFields.begin();
+			for (; scannedField != scannedFields.end(); ++scannedField, ++indexedField) {
+				ASSERT_NE(indexedField, indexedFields.end()) << "Indexing found fewer fields in \"" << text << "\"";
+				EXPECT_EQ((*indexedField).value(), (*scannedField).value()) << "in \"" << text << "\"";
+			}
+			EXPECT_EQ(indexedField, indexedFields.end()) << "Indexing found more fields in \"" << text << "\"";
+		}
+		EXPECT_EQ(indexed, RecordIterator {}) << "Indexing found more records in \"" << text << "\"";
+	}
+}
+
+TEST(DataFileTest, IndexedSkipFields)
+{
+	auto result = LoadDataFile("txtdata\\sample.tsv");
+	ASSERT_TRUE(result.has_value()) << "Unable to load sample.tsv";
+	DataFile &dataFile = result.value();
+	ASSERT_TRUE(dataFile.skipHeader().has_value());
+
+	for (DataFileRecord record : dataFile) {
+		auto fieldIt = record.begin();
+		fieldIt += 2;
+		int value = 0;
+		EXPECT_TRUE((*fieldIt).parseInt(value).has_value());
+		EXPECT_EQ(value, 70322) << "Skipping fields of an indexed file should land on the third field";
+		fieldIt += 2;
+		EXPECT_EQ((*fieldIt).value(), "3.999") << "Skipping fields of an indexed file should land on the last field";
+		++fieldIt;
+		EXPECT_EQ(fieldIt, record.end()) << "Advancing past the last field of an indexed record should reach the end";
+	}
+}
+
+TEST(DataFileTest, CompiledFileRejectsOtherSource)
+{
+	auto result = LoadDataFile("txtdata\\lf.tsv");
+	ASSERT_TRUE(result.has_value()) << "Unable to load lf.tsv";
+	const DataFile &source = result.value();
+
+	const std::optional<std::string> sourceKey = DataFileSourceKey(FindAsset("txtdata\\lf.tsv"), "txtdata\\lf.tsv");
+	ASSERT_TRUE(sourceKey.has_value()) << "A data file on disk should have a source key";
+	std::expected<std::string, std::string> compiled = CompileDataFile(source, *sourceKey);
+	ASSERT_TRUE(compiled.has_value());
+	auto file = std::make_shared<const std::string>(*std::move(compiled));
+	const std::shared_ptr<const char> data { file, file->data() };
+
+	EXPECT_TRUE(OpenCompiledDataFile(data, file->size(), *sourceKey).has_value());
+	const std::optional<std::string> otherKey = DataFileSourceKey(FindAsset("txtdata\\crlf.tsv"), "txtdata\\crlf.tsv");
+	ASSERT_TRUE(otherKey.has_value());
+	EXPECT_NE(*sourceKey, *otherKey);
+	EXPECT_FALSE(OpenCompiledDataFile(data, file->size(), *otherKey).has_value()) << "A compiled file must not be used for a different source";
+	EXPECT_FALSE(OpenCompiledDataFile(data, file->size() - 1, *sourceKey).has_value()) << "A truncated compiled file must be rejected";
+}
+
+TEST(DataFileTest, CompiledFileRejectsEditedSource)
+{
+	auto result = LoadDataFile("txtdata\\lf.tsv");
+	ASSERT_TRUE(result.has_value()) << "Unable to load lf.tsv";
+	const DataFile &source = result.value();
+	auto edited = LoadDataFile("txtdata\\crlf.tsv");
+	ASSERT_TRUE(edited.has_value()) << "Unable to load crlf.tsv";
+
+	constexpr std::string_view SourceKey = "test";
+	std::expected<std::string, std::string> compiled = CompileDataFile(source, SourceKey);
+	ASSERT_TRUE(compiled.has_value());
+	auto file = std::make_shared<const std::string>(*std::move(compiled));
+	const std::shared_ptr<const char> data { file, file->data() };
+
+	EXPECT_TRUE(OpenCompiledDataFile(data, file->size(), SourceKey, HashDataFileSource(source)).has_value());
+	EXPECT_NE(HashDataFileSource(source), HashDataFileSource(edited.value()));
+	EXPECT_FALSE(OpenCompiledDataFile(data, file->size(), SourceKey, HashDataFileSource(edited.value())).has_value()) << "A compiled file must not be used once its source has been edited, even if the key is unchanged";
+}
+
 } // namespace devilution
@@ -0,0 +1,71 @@
+#include "data/delimiter_scan.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+constexpr DelimiterScanIsa AllIsas[] = {
+	DelimiterScanIsa::Scalar,
+	DelimiterScanIsa::Sse2,
+	DelimiterScanIsa::Neon,
+};
+
+std::string MakeText(size_t size)
+{
+	static constexpr char Chars[] = { 'a', '\t', '1', '\n', 'b', '\r', ' ', '-' };
+	std::string text(size, '\0');
+	for (size_t i = 0; i < size; ++i)
+		text[i] = Chars[(i * 7 + i / 5) % std::size(Chars)];
+	return text;
+}
+
+class DelimiterScanTest : public ::testing::TestWithParam<DelimiterScanIsa> { };
+
+TEST_P(DelimiterScanTest, MarksAllDelimiters)
+{
+	const DelimiterScanKernel kernel = GetDelimiterScanKernel(GetParam());
+	if (kernel == nullptr)
+		GTEST_SKIP() << "Not supported by this CPU";
+
+	const std::string text = MakeText(300);
+	// Cover the scalar tails and full words of every implementation.
+	for (size_t size = 0; size <= text.size(); ++size) {
+		std::vector<uint64_t> bits(DelimiterBitsSize(size), 0xAAAAAAAAAAAAAAAA);
+		kernel(text.data(), size, bits.data());
+		for (size_t i = 0; i < bits.size() * 64; ++i) {
+			const bool marked = ((bits[i / 64] >> (i % 64)) & 1) != 0;
+			const bool expected = i < size && (text[i] == '\t' || text[i] == '\r' || text[i] == '\n');
+			ASSERT_EQ(marked, expected) << "size " << size << ", index " << i;
+		}
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(AllIsas, DelimiterScanTest, ::testing::ValuesIn(AllIsas));
+
+TEST(GetBestDelimiterScanIsaTest, IsSupported)
+{
+	EXPECT_NE(GetDelimiterScanKernel(GetBestDelimiterScanIsa()), nullptr);
+}
+
+TEST(DelimiterIndexTest, FindsNextDelimiter)
+{
+	const std::string text = MakeText(200);
+	const DelimiterIndex index(text.data(), text.size());
+	const char *end = text.data() + text.size();
+	for (const char *begin = text.data(); begin <= end; ++begin) {
+		const char *expected = begin;
+		while (expected != end && *expected != '\t' && *expected != '\r' && *expected != '\n')
+			++expected;
+		ASSERT_EQ(index.find(begin, end), expected) << "offset " << (begin - text.data());
+	}
+	// The search stops at `end` even if the data continues.
+	EXPECT_EQ(index.find(text.data() + 2, text.data() + 3), text.data() + 3);
+}
+
+} // namespace
+} // namespace devilution
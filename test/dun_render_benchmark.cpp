@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
 #include <span>
+#include <vector>
 
 #include <ankerl/unordered_dense.h>
 #include <benchmark/benchmark.h>
@@ -12,6 +14,7 @@
 #include "engine/lighting_defs.hpp"
 #include "engine/load_file.hpp"
 #include "engine/render/dun_render.hpp"
+#include "engine/render/light_table_simd.hpp"
 #include "engine/surface.hpp"
 #include "levels/dun_tile.hpp"
 #include "levels/gendung.h"
@@ -19,6 +22,7 @@
 #include "options.h"
 #include "utils/log.hpp"
 #include "utils/sdl_wrap.h"
+#include "utils/thread_pool.hpp"
 
 namespace devilution {
 namespace {
@@ -26,6 +30,7 @@ namespace {
 SDLSurfaceUniquePtr SdlSurface;
 ankerl::unordered_dense::map<TileType, std::vector<LevelCelBlock>> Tiles;
 std::unique_ptr<std::byte[]> BmDunCelData;
+std::unique_ptr<std::byte[]> BmDunCelSpans;
 uint_fast8_t BmMicroTileLen;
 
 void InitOnce()
@@ -40,7 +45,7 @@ void InitOnce()
 
 		leveltype = DTYPE_CATHEDRAL;
 		BmDunCelData = LoadFileInMem("levels\\l1data\\l1.cel");
-		SetDungeonMicros(BmDunCelData, BmMicroTileLen);
+		SetDungeonMicros(BmDunCelData, BmDunCelSpans, BmMicroTileLen);
 		MakeLightTable();
 
 		SdlSurface = SDLWrap::CreateRGBSurfaceWithFormat(
@@ -75,7 +80,7 @@ void RunForTileMaskLight(benchmark::State &state, TileType tileType, MaskType ma
 	const std::span<const LevelCelBlock> tiles = Tiles[tileType];
 	for (auto _ : state) {
 		for (const LevelCelBlock &levelCelBlock : tiles) {
-			RenderTile(out, lightmap, Point { 320, 240 }, BmDunCelData.get(), levelCelBlock, maskType, lightTable);
+			RenderTile(out, lightmap, Point { 320, 240 }, BmDunCelData.get(), BmDunCelSpans.get(), levelCelBlock, maskType, lightTable);
 			uint8_t color = out[Point { 310, 200 }];
 			benchmark::DoNotOptimize(color);
 		}
@@ -96,6 +101,18 @@ void Render(benchmark::State &state)
 	RunForTileMaskLight(state, TileT, MaskT, GetLightTableFnT());
 }
 
+/**
+ * @brief Same as `Render` but decodes the frames on every draw instead of using the pre-decoded spans.
+ */
+template <TileType TileT, MaskType MaskT, GetLightTableFn GetLightTableFnT>
+void RenderDecoded(benchmark::State &state)
+{
+	InitOnce();
+	UseDunFrameSpans = false;
+	RunForTileMaskLight(state, TileT, MaskT, GetLightTableFnT());
+	UseDunFrameSpans = true;
+}
+
 // Define aliases in order to have shorter benchmark names.
 constexpr auto LeftTriangle = TileType::LeftTriangle;
 constexpr auto RightTriangle = TileType::RightTriangle;
@@ -105,11 +122,16 @@ constexpr auto LeftTrapezoid = TileType::LeftTrapezoid;
 constexpr auto RightTrapezoid = TileType::RightTrapezoid;
 constexpr auto Transparent = MaskType::Transparent;
 constexpr auto Solid = MaskType::Solid;
+constexpr auto Left = MaskType::Left;
+constexpr auto Right = MaskType::Right;
 
-#define DEFINE_FOR_TILE_AND_MASK_TYPE(TILE_TYPE, MASK_TYPE)      \
-	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, FullyLit);  \
-	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, FullyDark); \
-	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, PartiallyLit);
+#define DEFINE_FOR_TILE_AND_MASK_TYPE(TILE_TYPE, MASK_TYPE)                  \
+	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, FullyLit);              \
+	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, FullyDark);             \
+	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, PartiallyLit);          \
+	BENCHMARK_TEMPLATE(RenderDecoded, TILE_TYPE, MASK_TYPE, FullyLit);       \
+	BENCHMARK_TEMPLATE(RenderDecoded, TILE_TYPE, MASK_TYPE, FullyDark);      \
+	BENCHMARK_TEMPLATE(RenderDecoded, TILE_TYPE, MASK_TYPE, PartiallyLit);
 
 #define DEFINE_FOR_TILE_TYPE(TILE_TYPE)             \
 	DEFINE_FOR_TILE_AND_MASK_TYPE(TILE_TYPE, Solid) \
@@ -122,6 +144,58 @@ DEFINE_FOR_TILE_TYPE(Square)
 DEFINE_FOR_TILE_TYPE(LeftTrapezoid)
 DEFINE_FOR_TILE_TYPE(RightTrapezoid)
 
+DEFINE_FOR_TILE_AND_MASK_TYPE(TransparentSquare, Left)
+DEFINE_FOR_TILE_AND_MASK_TYPE(LeftTrapezoid, Left)
+DEFINE_FOR_TILE_AND_MASK_TYPE(RightTrapezoid, Right)
+
+template <TileType TileT, MaskType MaskT, LightTableIsa Isa>
+void RenderWithIsa(benchmark::State &state)
+{
+	InitOnce();
+	const LightTableKernel previous = ApplyLightTable;
+	if (!SetLightTableIsa(Isa)) {
+		state.SkipWithError("Not supported by this CPU");
+		return;
+	}
+	RunForTileMaskLight(state, TileT, MaskT, PartiallyLit());
+	ApplyLightTable = previous;
+}
+
+constexpr auto Scalar = LightTableIsa::Scalar;
+constexpr auto Neon = LightTableIsa::Neon;
+
+#define DEFINE_FOR_TILE_AND_MASK_TYPE_PER_ISA(TILE_TYPE, MASK_TYPE) \
+	BENCHMARK_TEMPLATE(RenderWithIsa, TILE_TYPE, MASK_TYPE, Scalar); \
+	BENCHMARK_TEMPLATE(RenderWithIsa, TILE_TYPE, MASK_TYPE, Neon);
+
+DEFINE_FOR_TILE_AND_MASK_TYPE_PER_ISA(Square, Solid)
+DEFINE_FOR_TILE_AND_MASK_TYPE_PER_ISA(Square, Transparent)
+DEFINE_FOR_TILE_AND_MASK_TYPE_PER_ISA(LeftTriangle, Solid)
+
+template <LightTableIsa Isa>
+void BM_ApplyLightTable(benchmark::State &state)
+{
+	InitOnce();
+	const LightTableKernel kernel = GetLightTableKernel(Isa);
+	if (kernel == nullptr) {
+		state.SkipWithError("Not supported by this CPU");
+		return;
+	}
+	const auto length = static_cast<unsigned>(state.range(0));
+	std::vector<uint8_t> src(length);
+	std::vector<uint8_t> dst(length);
+	for (unsigned i = 0; i < length; ++i)
+		src[i] = static_cast<uint8_t>(i * 31);
+	const uint8_t *lightTable = PartiallyLit();
+	for (auto _ : state) {
+		kernel(dst.data(), src.data(), length, lightTable);
+		benchmark::DoNotOptimize(dst.data());
+	}
+	state.SetBytesProcessed(state.iterations() * length);
+}
+BENCHMARK_TEMPLATE(BM_ApplyLightTable, Scalar)->Arg(16)->Arg(32)->Arg(640);
+BENCHMARK_TEMPLATE(BM_ApplyLightTable, Neon)->Arg(16)->Arg(32)->Arg(640);
+
 void BM_RenderBlackTile(benchmark::State &state)
 {
 	InitOnce();
@@ -135,5 +209,53 @@ void BM_RenderBlackTile(benchmark::State &state)
 }
 BENCHMARK(BM_RenderBlackTile);
 
+/**
+ * @brief Covers the buffer with a diamond grid of floor tiles, as DrawFloor does.
+ * @param top Row of the full viewport that `out` starts at.
+ */
+void RenderFloorGrid(const Surface &out, int top, const Lightmap &lightmap, const uint8_t *lightTable)
+{
+	const std::span<const LevelCelBlock> leftTiles = Tiles[TileType::LeftTriangle];
+	const std::span<const LevelCelBlock> rightTiles = Tiles[TileType::RightTriangle];
+	size_t tileIndex = 0;
+	for (int row = 0, y = -top; y < out.h() + TILE_HEIGHT; ++row, y += TILE_HEIGHT / 2) {
+		const int rowStart = (row % 2) == 0 ? 0 : -TILE_WIDTH / 2;
+		for (int x = rowStart; x < out.w(); x += TILE_WIDTH, ++tileIndex) {
+			RenderTile(out, lightmap, Point { x, y }, BmDunCelData.get(), BmDunCelSpans.get(),
+			    leftTiles[tileIndex % leftTiles.size()], MaskType::Solid, lightTable);
+			RenderTile(out, lightmap, Point { x + DunFrameWidth, y }, BmDunCelData.get(), BmDunCelSpans.get(),
+			    rightTiles[tileIndex % rightTiles.size()], MaskType::Solid, lightTable);
+		}
+	}
+}
+
+/**
+ * @brief Renders a 1440p floor split into `state.range(0)` screen bands on the worker pool.
+ */
+void BM_RenderFloorInBands(benchmark::State &state)
+{
+	InitOnce();
+	const SDLSurfaceUniquePtr sdlSurface = SDLWrap::CreateRGBSurfaceWithFormat(
+	    /*flags=*/0, /*width=*/2560, /*height=*/1440, /*depth=*/8, SDL_PIXELFORMAT_INDEX8);
+	const Surface out = Surface(sdlSurface.get());
+	std::array<std::array<uint8_t, LightTableSize>, NumLightingLevels> lightTables;
+	const Lightmap lightmap(/*outBuffer=*/nullptr, /*lightmapBuffer=*/ {}, /*pitch=*/1, lightTables, FullyLitLightTable, FullyDarkLightTable);
+	const uint8_t *lightTable = PartiallyLit();
+
+	const int bandCount = static_cast<int>(state.range(0));
+	const int bandHeight = (out.h() + bandCount - 1) / bandCount;
+	ThreadPool &pool = GetWorkerPool();
+	for (auto _ : state) {
+		pool.parallelFor(bandCount, [&](size_t band) {
+			const int top = static_cast<int>(band) * bandHeight;
+			RenderFloorGrid(out.subregionY(top, std::min(bandHeight, out.h() - top)), top, lightmap, lightTable);
+		});
+		uint8_t color = out[Point { 310, 200 }];
+		benchmark::DoNotOptimize(color);
+	}
+	state.SetBytesProcessed(state.iterations() * out.w() * out.h());
+}
+BENCHMARK(BM_RenderFloorInBands)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
 } // namespace
 } // namespace devilution
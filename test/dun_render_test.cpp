@@ -0,0 +1,136 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "engine/assets.hpp"
+#include "engine/load_file.hpp"
+#include "engine/render/dun_render.hpp"
+#include "engine/surface.hpp"
+#include "levels/dun_tile.hpp"
+#include "levels/gendung.h"
+#include "lighting.h"
+#include "options.h"
+#include "utils/sdl_wrap.h"
+
+namespace devilution {
+namespace {
+
+constexpr int SurfaceWidth = 64;
+constexpr int SurfaceHeight = 64;
+
+class DunRenderTest : public ::testing::Test {
+protected:
+	static void SetUpTestSuite()
+	{
+		LoadCoreArchives();
+		LoadGameArchives();
+		missingMpqAssets_ = !HaveMainData();
+		if (missingMpqAssets_)
+			return;
+
+		leveltype = DTYPE_CATHEDRAL;
+		dunCelData_ = LoadFileInMem("levels\\l1data\\l1.cel");
+		uint_fast8_t microTileLen;
+		SetDungeonMicros(dunCelData_, dunCelSpans_, microTileLen);
+		MakeLightTable();
+		GetOptions().Graphics.perPixelLighting.SetValue(false);
+	}
+
+	static void TearDownTestSuite()
+	{
+		dunCelData_ = nullptr;
+		dunCelSpans_ = nullptr;
+	}
+
+	void SetUp() override
+	{
+		if (missingMpqAssets_)
+			GTEST_SKIP() << "MPQ assets (spawn.mpq or DIABDAT.MPQ) not found - skipping test";
+	}
+
+	/** @brief Renders the tile at every position that clips it against an edge of the surface, and some that don't. */
+	static std::vector<uint8_t> RenderEverywhere(LevelCelBlock levelCelBlock, MaskType maskType, const uint8_t *tbl)
+	{
+		const SDLSurfaceUniquePtr sdlSurface = SDLWrap::CreateRGBSurfaceWithFormat(
+		    /*flags=*/0, SurfaceWidth, SurfaceHeight, /*depth=*/8, SDL_PIXELFORMAT_INDEX8);
+		const Surface out = Surface(sdlSurface.get());
+		std::array<std::array<uint8_t, LightTableSize>, NumLightingLevels> lightTables {};
+		const Lightmap lightmap(/*outBuffer=*/nullptr, /*lightmapBuffer=*/ {}, /*pitch=*/1, lightTables, FullyLitLightTable, FullyDarkLightTable);
+
+		std::vector<uint8_t> result;
+		for (int y = -1; y <= SurfaceHeight + DunFrameHeight; y += 3) {
+			for (int x = -DunFrameWidth; x <= SurfaceWidth; x += 5) {
+				// A background that differs from pixel to pixel, so that a skipped pixel shows.
+				for (int i = 0; i < SurfaceHeight; ++i) {
+					for (int j = 0; j < SurfaceWidth; ++j)
+						out[Point { j, i }] = static_cast<uint8_t>((i * 7) + j);
+				}
+				RenderTile(out, lightmap, Point { x, y }, dunCelData_.get(), dunCelSpans_.get(), levelCelBlock, maskType, tbl);
+				for (int i = 0; i < SurfaceHeight; ++i) {
+					for (int j = 0; j < SurfaceWidth; ++j)
+						result.push_back(out[Point { j, i }]);
+				}
+			}
+		}
+		return result;
+	}
+
+	static void ExpectSameAsDecoding(TileType tileType, MaskType maskType)
+	{
+		int tested = 0;
+		for (size_t i = 0; i < 700 && tested < 20; ++i) {
+			for (size_t j = 0; j < 10 && tested < 20; ++j) {
+				const LevelCelBlock levelCelBlock = DPieceMicros[i].mt[j];
+				if (!levelCelBlock.hasValue() || levelCelBlock.type() != tileType)
+					continue;
+				// Re-encoded foliage is a triangle followed by a TransparentSquare.
+				if ((j == 0 || j == 1) && tileType == TileType::TransparentSquare)
+					continue;
+				for (const uint8_t *tbl : { LightTables[0].data(), LightTables[5].data(), LightTables.back().data() }) {
+					UseDunFrameSpans = false;
+					const std::vector<uint8_t> expected = RenderEverywhere(levelCelBlock, maskType, tbl);
+					UseDunFrameSpans = true;
+					const std::vector<uint8_t> actual = RenderEverywhere(levelCelBlock, maskType, tbl);
+					ASSERT_EQ(actual, expected) << "Frame " << levelCelBlock.frame() << " drawn with mask " << static_cast<int>(maskType);
+				}
+				++tested;
+			}
+		}
+		EXPECT_GT(tested, 0);
+	}
+
+	static inline bool missingMpqAssets_;
+	static inline std::unique_ptr<std::byte[]> dunCelData_;
+	static inline std::unique_ptr<std::byte[]> dunCelSpans_;
+};
+
+TEST_F(DunRenderTest, SolidMatchesDecoding)
+{
+	for (const TileType tileType : { TileType::Square, TileType::TransparentSquare, TileType::LeftTriangle, TileType::RightTriangle, TileType::LeftTrapezoid, TileType::RightTrapezoid })
+		ExpectSameAsDecoding(tileType, MaskType::Solid);
+}
+
+TEST_F(DunRenderTest, TransparentMatchesDecoding)
+{
+	for (const TileType tileType : { TileType::Square, TileType::TransparentSquare, TileType::LeftTriangle, TileType::RightTriangle, TileType::LeftTrapezoid, TileType::RightTrapezoid })
+		ExpectSameAsDecoding(tileType, MaskType::Transparent);
+}
+
+TEST_F(DunRenderTest, LeftMaskMatchesDecoding)
+{
+	ExpectSameAsDecoding(TileType::TransparentSquare, MaskType::Left);
+	ExpectSameAsDecoding(TileType::LeftTrapezoid, MaskType::Left);
+}
+
+TEST_F(DunRenderTest, RightMaskMatchesDecoding)
+{
+	ExpectSameAsDecoding(TileType::TransparentSquare, MaskType::Right);
+	ExpectSameAsDecoding(TileType::RightTrapezoid, MaskType::Right);
+}
+
+} // namespace
+} // namespace devilution
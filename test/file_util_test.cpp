@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 
 #include <cstdio>
+#include <optional>
+#include <string>
 
 #include "utils/file_util.h"
+#include "utils/mapped_file.hpp"
 
 using namespace devilution;
 
@@ -82,4 +85,19 @@ TEST(FileUtil, RecursivelyCreateDir)
 	EXPECT_TRUE(DirectoryExists(path.c_str()));
 }
 
+TEST(FileUtil, MappedFile)
+{
+	const std::string path = GetTmpPathName();
+	WriteDummyFile(path.c_str(), 42);
+	const std::optional<MappedFile> file = MappedFile::Open(path.c_str());
+#if defined(_WIN32) || defined(__DJGPP__)
+	EXPECT_FALSE(file.has_value());
+#else
+	ASSERT_TRUE(file.has_value());
+	ASSERT_EQ(file->size(), 42);
+	EXPECT_EQ(file->data()[41], '\0');
+#endif
+	EXPECT_FALSE(MappedFile::Open((path + ".missing").c_str()).has_value());
+}
+
 } // namespace
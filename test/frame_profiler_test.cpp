@@ -0,0 +1,94 @@
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "utils/frame_profiler.hpp"
+
+using namespace devilution;
+
+namespace {
+
+size_t CountOccurrences(const std::string &haystack, const std::string &needle)
+{
+	size_t count = 0;
+	for (size_t pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + needle.size()))
+		++count;
+	return count;
+}
+
+TEST(FrameProfilerTest, RecordsNothingWhenStopped)
+{
+	StopFrameProfiler();
+	{
+		const ProfileScope scope("Stopped");
+	}
+	EXPECT_EQ(GetFrameProfilerTrace().find("Stopped"), std::string::npos);
+}
+
+TEST(FrameProfilerTest, WritesCompleteEvents)
+{
+	StartFrameProfiler();
+	{
+		const ProfileScope outer("Outer");
+		{
+			const ProfileScope inner("Inner \"quoted\"");
+		}
+	}
+	StopFrameProfiler();
+
+	const std::string trace = GetFrameProfilerTrace();
+	EXPECT_EQ(trace.rfind(R"({"traceEvents":[)", 0), 0U);
+	EXPECT_NE(trace.find(R"({"name":"Outer","ph":"X","ts":)"), std::string::npos);
+	EXPECT_NE(trace.find(R"({"name":"Inner \"quoted\"","ph":"X","ts":)"), std::string::npos);
+	// Inner scopes finish first.
+	EXPECT_LT(trace.find("Inner"), trace.find("Outer"));
+}
+
+TEST(FrameProfilerTest, StartDiscardsEarlierEvents)
+{
+	StartFrameProfiler();
+	RecordProfileEvent("Earlier", GetProfilerTime(), GetProfilerTime());
+	StartFrameProfiler();
+	RecordProfileEvent("Later", GetProfilerTime(), GetProfilerTime());
+	StopFrameProfiler();
+
+	const std::string trace = GetFrameProfilerTrace();
+	EXPECT_EQ(trace.find("Earlier"), std::string::npos);
+	EXPECT_NE(trace.find("Later"), std::string::npos);
+}
+
+TEST(FrameProfilerTest, KeepsNewestEventsWhenFull)
+{
+	StartFrameProfiler();
+	const uint64_t now = GetProfilerTime();
+	RecordProfileEvent("Oldest", now, now);
+	for (size_t i = 0; i < ProfileEventsPerThread; ++i)
+		RecordProfileEvent("Newer", now, now);
+	StopFrameProfiler();
+
+	const std::string trace = GetFrameProfilerTrace();
+	EXPECT_EQ(trace.find("Oldest"), std::string::npos);
+	// The slot the writer would overwrite next is left out.
+	EXPECT_EQ(CountOccurrences(trace, R"("name":"Newer")"), ProfileEventsPerThread - 1);
+}
+
+TEST(FrameProfilerTest, ReadsWhileRecording)
+{
+	StartFrameProfiler();
+	std::atomic<bool> done { false };
+	std::thread writer([&]() {
+		for (size_t i = 0; i < 4 * ProfileEventsPerThread; ++i)
+			RecordProfileEvent("Concurrent", GetProfilerTime(), GetProfilerTime());
+		done = true;
+	});
+	while (!done) {
+		const std::string trace = GetFrameProfilerTrace();
+		EXPECT_EQ(CountOccurrences(trace, R"("name":)"), CountOccurrences(trace, R"("name":"Concurrent")"));
+	}
+	writer.join();
+	StopFrameProfiler();
+}
+
+} // namespace
@@ -0,0 +1,63 @@
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "utils/frame_time_stats.hpp"
+
+namespace devilution {
+namespace {
+
+FrameTimeStats OneToHundredMilliseconds()
+{
+	FrameTimeStats stats;
+	for (uint64_t i = 100; i >= 1; --i)
+		stats.addFrame(i * 1000000);
+	return stats;
+}
+
+TEST(FrameTimeStatsTest, EmptyIsZero)
+{
+	const FrameTimeStats stats;
+	EXPECT_EQ(stats.percentile(50), 0U);
+	EXPECT_EQ(stats.max(), 0U);
+	EXPECT_EQ(stats.stutterCount(), 0U);
+}
+
+TEST(FrameTimeStatsTest, Percentiles)
+{
+	const FrameTimeStats stats = OneToHundredMilliseconds();
+	EXPECT_EQ(stats.percentile(0), 1000000U);
+	EXPECT_EQ(stats.percentile(50), 50000000U);
+	EXPECT_EQ(stats.percentile(90), 90000000U);
+	EXPECT_EQ(stats.percentile(99), 99000000U);
+	EXPECT_EQ(stats.percentile(100), 100000000U);
+	EXPECT_EQ(stats.max(), 100000000U);
+}
+
+TEST(FrameTimeStatsTest, StuttersAreSlowerThanTwiceTheMedian)
+{
+	FrameTimeStats stats;
+	for (int i = 0; i < 10; ++i)
+		stats.addFrame(10);
+	stats.addFrame(20);
+	stats.addFrame(21);
+	stats.addFrame(100);
+	EXPECT_EQ(stats.stutterCount(), 2U);
+}
+
+TEST(FrameTimeStatsTest, Json)
+{
+	FrameTimeStats stats;
+	stats.addFrame(2000000);
+	stats.addFrame(4000000);
+	stats.addLogic(500000);
+	stats.addLogic(1500000);
+	stats.addRender(3000000);
+	EXPECT_EQ(stats.toJson(2.0),
+	    R"({"frames":2,"seconds":2.000,"renderedFps":1.0,)"
+	    R"("frameTimeMs":{"p50":2.000,"p90":4.000,"p99":4.000,"max":4.000},"stutters":0,)"
+	    R"("logic":{"ticks":2,"totalMs":2.000},"render":{"frames":1,"totalMs":3.000}})");
+}
+
+} // namespace
+} // namespace devilution
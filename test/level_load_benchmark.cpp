@@ -0,0 +1,213 @@
+#include <cstdint>
+#include <cstdlib>
+#include <expected>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "DiabloUI/diabloui.h"
+#include "diablo.h"
+#include "engine/assets.hpp"
+#include "engine/sound.h"
+#include "game_mode.hpp"
+#include "headless_mode.hpp"
+#include "levels/gendung.h"
+#include "loadsave.h"
+#include "options.h"
+#include "pfile.h"
+#include "player.h"
+#include "portal.h"
+#include "quests.h"
+#include "save_snapshot.hpp"
+#include "tables/load_tables.hpp"
+#include "utils/log.hpp"
+#include "utils/paths.h"
+
+namespace devilution {
+namespace {
+
+void ExitOnError(const std::expected<void, std::string> &result)
+{
+	if (!result.has_value()) {
+		LogError("{}", result.error());
+		exit(1);
+	}
+}
+
+/**
+ * @brief Starts a new single player game in town, the way the game does for a new hero.
+ *
+ * The dungeon seeds are fixed, so that every run generates the same levels.
+ */
+void InitOnce()
+{
+	[[maybe_unused]] static const bool GlobalInitDone = []() {
+		LoadCoreArchives();
+		LoadGameArchives();
+		if (!HaveMainData()) {
+			LogError("This benchmark needs spawn.mpq or diabdat.mpq");
+			exit(1);
+		}
+
+		paths::SetPrefPath(paths::BasePath());
+		gbIsHellfire = false;
+		gbIsMultiplayer = false;
+		gbMusicOn = false;
+		gbSoundOn = false;
+		HeadlessMode = true;
+
+		Players.resize(1);
+		MyPlayerId = 0;
+		MyPlayer = &Players[MyPlayerId];
+
+		LoadDataTables();
+
+		_uiheroinfo info {};
+		info.heroclass = HeroClass::Warrior;
+		pfile_ui_save_create(&info);
+
+		InitLevels();
+		InitQuests();
+		InitPortals();
+		InitDungMsgs(*MyPlayer);
+		for (int i = 0; i < NUMLEVELS; i++)
+			DungeonSeeds[i] = static_cast<uint32_t>(i + 1);
+
+		currlevel = 0;
+		leveltype = DTYPE_TOWN;
+		setlevel = false;
+		Player &myPlayer = *MyPlayer;
+		myPlayer.position.tile = { 75, 68 };
+		myPlayer.position.future = myPlayer.position.tile;
+		myPlayer.setLevel(currlevel);
+		myPlayer.plractive = true;
+
+		pfile_remove_temp_files();
+		ExitOnError(LoadGameLevel(/*firstflag=*/true, ENTRY_MAIN));
+		return true;
+	}();
+}
+
+/**
+ * @brief Takes the stairs to the given level, the way the game does: the level left behind is saved, the new one is generated or loaded.
+ * @param level 0 is the town, 1 the first level of the cathedral
+ */
+void GoToLevel(uint8_t level)
+{
+	InitOnce();
+	if (currlevel == level)
+		return;
+	const lvl_entry entry = level > currlevel ? ENTRY_MAIN : ENTRY_PREV;
+	pfile_save_level();
+	FreeGameMem();
+	setlevel = false;
+	currlevel = level;
+	leveltype = GetLevelType(currlevel);
+	MyPlayer->setLevel(currlevel);
+	ExitOnError(LoadGameLevel(/*firstflag=*/false, entry));
+}
+
+/**
+ * @brief Leaving a level and coming back: saving the level, then loading it again.
+ * @param state Argument 0 is the level, argument 1 the number of levels kept in memory, 0 reads every level back from the save archive.
+ */
+void BM_LevelRoundTrip(benchmark::State &state)
+{
+	GoToLevel(static_cast<uint8_t>(state.range(0)));
+	GetOptions().Gameplay.levelCacheSize.SetValue(static_cast<int>(state.range(1)));
+	pfile_remove_temp_files();
+	for (auto _ : state) {
+		pfile_save_level();
+		if (const std::expected<void, std::string> result = LoadLevel(); !result.has_value()) {
+			state.SkipWithError(result.error().c_str());
+			break;
+		}
+	}
+	WaitForSaves();
+}
+
+BENCHMARK(BM_LevelRoundTrip)->ArgNames({ "level", "cached" })->ArgsProduct({ { 0, 1 }, { 0, 4 } });
+
+/**
+ * @brief Serializing the level, without encoding or writing it.
+ * @param state Argument 0 is the level
+ */
+void BM_SaveLevel(benchmark::State &state)
+{
+	GoToLevel(static_cast<uint8_t>(state.range(0)));
+	size_t bytes = 0;
+	for (auto _ : state) {
+		SaveSnapshot snapshot(pfile_get_password());
+		SaveLevel(snapshot);
+		bytes += snapshot.size();
+		benchmark::DoNotOptimize(snapshot);
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+/**
+ * @brief Deserializing the level, which is kept in memory so that the save archive is not read.
+ * @param state Argument 0 is the level
+ */
+void BM_LoadLevel(benchmark::State &state)
+{
+	GoToLevel(static_cast<uint8_t>(state.range(0)));
+	GetOptions().Gameplay.levelCacheSize.SetValue(1);
+	pfile_remove_temp_files();
+	SaveSnapshot level(pfile_get_password());
+	SaveLevel(level);
+	for (auto _ : state) {
+		state.PauseTiming();
+		pfile_save_level();
+		state.ResumeTiming();
+		if (const std::expected<void, std::string> result = LoadLevel(); !result.has_value()) {
+			state.SkipWithError(result.error().c_str());
+			break;
+		}
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(level.size() * state.iterations()));
+	WaitForSaves();
+}
+
+BENCHMARK(BM_SaveLevel)->ArgName("level")->Arg(0)->Arg(1);
+BENCHMARK(BM_LoadLevel)->ArgName("level")->Arg(0)->Arg(1);
+
+/**
+ * @brief Serializing the game file, which also holds the current level, without encoding or writing it.
+ * @param state Argument 0 is the level
+ */
+void BM_SaveGameData(benchmark::State &state)
+{
+	GoToLevel(static_cast<uint8_t>(state.range(0)));
+	size_t bytes = 0;
+	for (auto _ : state) {
+		SaveSnapshot snapshot(pfile_get_password());
+		SaveGameData(snapshot);
+		bytes += snapshot.size();
+		benchmark::DoNotOptimize(snapshot);
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+/**
+ * @brief Loading a saved game from the save archive, including setting up its current level.
+ * @param state Argument 0 is the level
+ */
+void BM_LoadGame(benchmark::State &state)
+{
+	GoToLevel(static_cast<uint8_t>(state.range(0)));
+	SaveGame();
+	WaitForSaves();
+	for (auto _ : state) {
+		if (const std::expected<void, std::string> result = LoadGame(/*firstflag=*/false); !result.has_value()) {
+			state.SkipWithError(result.error().c_str());
+			break;
+		}
+	}
+}
+
+BENCHMARK(BM_SaveGameData)->ArgName("level")->Arg(0)->Arg(1);
+BENCHMARK(BM_LoadGame)->ArgName("level")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace devilution
@@ -1,13 +1,19 @@
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 
 #include <benchmark/benchmark.h>
 
 #include "engine/lighting_defs.hpp"
 #include "engine/render/light_render.hpp"
 #include "engine/surface.hpp"
+#include "levels/dun_tile.hpp"
 #include "levels/gendung_defs.hpp"
+#include "utils/bitset2d.hpp"
 #include "utils/log.hpp"
 #include "utils/paths.h"
 #include "utils/sdl_wrap.h"
@@ -15,52 +21,156 @@
 namespace devilution {
 namespace {
 
-void BM_BuildLightmap(benchmark::State &state)
+struct LightmapBenchmarkData {
+	uint8_t dLight[MAXDUNX][MAXDUNY];
+	std::array<std::array<uint8_t, LightTableSize>, NumLightingLevels> lightTables;
+	SDLSurfaceUniquePtr sdlSurface;
+};
+
+void LoadBenchmarkData(LightmapBenchmarkData &data)
 {
 	const std::string benchmarkDataPath = paths::BasePath() + "test/fixtures/light_render_benchmark/dLight.dmp";
 	FILE *lightFile = std::fopen(benchmarkDataPath.c_str(), "rb");
-	uint8_t dLight[MAXDUNX][MAXDUNY];
-	std::array<std::array<uint8_t, LightTableSize>, NumLightingLevels> lightTables;
 	if (lightFile != nullptr) {
-		if (std::fread(&dLight[0][0], sizeof(uint8_t) * MAXDUNX * MAXDUNY, 1, lightFile) != 1) {
+		if (std::fread(&data.dLight[0][0], sizeof(uint8_t) * MAXDUNX * MAXDUNY, 1, lightFile) != 1) {
 			std::perror("Failed to read dLight.dmp");
 			exit(1);
 		}
 		std::fclose(lightFile);
 	}
 
-	const SDLSurfaceUniquePtr sdl_surface = SDLWrap::CreateRGBSurfaceWithFormat(
+	data.sdlSurface = SDLWrap::CreateRGBSurfaceWithFormat(
 	    /*flags=*/0, /*width=*/640, /*height=*/480, /*depth=*/8, SDL_PIXELFORMAT_INDEX8);
-	if (sdl_surface == nullptr) {
+	if (data.sdlSurface == nullptr) {
 		std::fprintf(stderr, "Failed to create SDL Surface: %s\n", SDL_GetError());
 		exit(1);
 	}
-	const Surface out = Surface(sdl_surface.get());
+}
+
+const Point TilePosition { 48, 44 };
+const Point TargetBufferPosition { 0, -17 };
+const int ViewportWidth = 640;
+const int ViewportHeight = 352;
+const int Rows = 25;
+const int Columns = 10;
+
+Lightmap BuildBenchmarkLightmap(LightmapBenchmarkData &data, Bitset2d<MAXDUNX, MAXDUNY> *dirtyTiles)
+{
+	const Surface out = Surface(data.sdlSurface.get());
+	return Lightmap::build(/*perPixelLighting=*/true,
+	    TilePosition, TargetBufferPosition,
+	    ViewportWidth, ViewportHeight, Rows, Columns,
+	    out.at(0, 0), out.pitch(), data.lightTables, data.lightTables[0].data(), data.lightTables.back().data(),
+	    data.dLight, dirtyTiles, /*microTileLen=*/10);
+}
 
-	const Point tilePosition { 48, 44 };
-	const Point targetBufferPosition { 0, -17 };
-	const int viewportWidth = 640;
-	const int viewportHeight = 352;
-	const int rows = 25;
-	const int columns = 10;
-	const uint8_t *outBuffer = out.at(0, 0);
-	const uint16_t outPitch = out.pitch();
+void BM_BuildLightmap(benchmark::State &state)
+{
+	LightmapBenchmarkData data;
+	LoadBenchmarkData(data);
+	const uint8_t *outBuffer = Surface(data.sdlSurface.get()).at(0, 0);
+	const uint16_t outPitch = Surface(data.sdlSurface.get()).pitch();
+
+	for (auto _ : state) {
+		const Lightmap lightmap = BuildBenchmarkLightmap(data, /*dirtyTiles=*/nullptr);
+
+		uint8_t lightLevel = *lightmap.getLightingAt(outBuffer + outPitch * 120 + 120);
+		benchmark::DoNotOptimize(lightLevel);
+	}
+	state.SetBytesProcessed(state.iterations() * ViewportWidth * ViewportHeight);
+	state.SetItemsProcessed(state.iterations() * Rows * Columns);
+}
+
+/**
+ * @brief Lights the tiles around `center`, or restores them to `base` when `lit` is false.
+ */
+void SetTorch(uint8_t dLight[MAXDUNX][MAXDUNY], const uint8_t base[MAXDUNX][MAXDUNY], Point center, bool lit, Bitset2d<MAXDUNX, MAXDUNY> &dirtyTiles)
+{
+	constexpr int Radius = 5;
+	for (int x = center.x - Radius; x <= center.x + Radius; x++) {
+		for (int y = center.y - Radius; y <= center.y + Radius; y++) {
+			const int distance = std::max(std::abs(x - center.x), std::abs(y - center.y));
+			const uint8_t light = lit ? std::min<uint8_t>(base[x][y], static_cast<uint8_t>(distance * 3)) : base[x][y];
+			if (dLight[x][y] != light) {
+				dLight[x][y] = light;
+				dirtyTiles.set(x, y);
+			}
+		}
+	}
+}
+
+void BM_BuildLightmapOneTorchMoved(benchmark::State &state)
+{
+	LightmapBenchmarkData data;
+	LoadBenchmarkData(data);
+	const uint8_t *outBuffer = Surface(data.sdlSurface.get()).at(0, 0);
+	const uint16_t outPitch = Surface(data.sdlSurface.get()).pitch();
+
+	uint8_t base[MAXDUNX][MAXDUNY];
+	std::memcpy(base, data.dLight, sizeof(base));
+	Bitset2d<MAXDUNX, MAXDUNY> dirtyTiles;
+	dirtyTiles.set();
+	BuildBenchmarkLightmap(data, &dirtyTiles);
+
+	// The torch steps back and forth between two tiles in the middle of the view
+	const Point torchPositions[] = { TilePosition + Displacement { 4, 4 }, TilePosition + Displacement { 5, 4 } };
+	size_t torch = 0;
+	SetTorch(data.dLight, base, torchPositions[torch], /*lit=*/true, dirtyTiles);
+	for (auto _ : state) {
+		SetTorch(data.dLight, base, torchPositions[torch], /*lit=*/false, dirtyTiles);
+		torch ^= 1;
+		SetTorch(data.dLight, base, torchPositions[torch], /*lit=*/true, dirtyTiles);
+
+		const Lightmap lightmap = BuildBenchmarkLightmap(data, &dirtyTiles);
+
+		uint8_t lightLevel = *lightmap.getLightingAt(outBuffer + outPitch * 120 + 120);
+		benchmark::DoNotOptimize(lightLevel);
+	}
+	state.SetBytesProcessed(state.iterations() * ViewportWidth * ViewportHeight);
+	state.SetItemsProcessed(state.iterations() * Rows * Columns);
+}
+
+/**
+ * @brief Rebuilds the whole lightmap of a `state.range(0)` x `state.range(1)` viewport with the given instruction set.
+ */
+template <LightmapIsa Isa>
+void BM_BuildLightmapWithIsa(benchmark::State &state)
+{
+	if (!SetLightmapIsa(Isa)) {
+		state.SkipWithError("Not supported by this CPU");
+		return;
+	}
+
+	LightmapBenchmarkData data;
+	LoadBenchmarkData(data);
+	const Surface out = Surface(data.sdlSurface.get());
+
+	const auto viewportWidth = static_cast<int>(state.range(0));
+	const auto viewportHeight = static_cast<int>(state.range(1));
+	const int columns = (viewportWidth + TILE_WIDTH - 1) / TILE_WIDTH + 1;
+	const int rows = (viewportHeight + TILE_HEIGHT / 2 - 1) / (TILE_HEIGHT / 2) + 1;
 
 	for (auto _ : state) {
 		const Lightmap lightmap = Lightmap::build(/*perPixelLighting=*/true,
-		    tilePosition, targetBufferPosition,
+		    TilePosition, TargetBufferPosition,
 		    viewportWidth, viewportHeight, rows, columns,
-		    outBuffer, outPitch, lightTables, lightTables[0].data(), lightTables.back().data(),
-		    dLight, /*microTileLen=*/10);
+		    out.at(0, 0), out.pitch(), data.lightTables, data.lightTables[0].data(), data.lightTables.back().data(),
+		    data.dLight, /*dirtyTiles=*/nullptr, /*microTileLen=*/10);
 
-		uint8_t lightLevel = *lightmap.getLightingAt(outBuffer + outPitch * 120 + 120);
+		uint8_t lightLevel = *lightmap.getLightingAt(out.at(120, 120));
 		benchmark::DoNotOptimize(lightLevel);
 	}
 	state.SetBytesProcessed(state.iterations() * viewportWidth * viewportHeight);
 	state.SetItemsProcessed(state.iterations() * rows * columns);
+
+	SetLightmapIsa(GetBestLightmapIsa());
 }
 
 BENCHMARK(BM_BuildLightmap);
+BENCHMARK(BM_BuildLightmapOneTorchMoved);
+BENCHMARK_TEMPLATE(BM_BuildLightmapWithIsa, LightmapIsa::Scalar)->Args({ 1920, 1080 })->Args({ 3840, 2160 });
+BENCHMARK_TEMPLATE(BM_BuildLightmapWithIsa, LightmapIsa::Sse2)->Args({ 1920, 1080 })->Args({ 3840, 2160 });
+BENCHMARK_TEMPLATE(BM_BuildLightmapWithIsa, LightmapIsa::Neon)->Args({ 1920, 1080 })->Args({ 3840, 2160 });
 
 } // namespace
 } // namespace devilution
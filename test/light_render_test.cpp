@@ -0,0 +1,125 @@
+#include "engine/render/light_render.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "engine/point.hpp"
+#include "levels/gendung_defs.hpp"
+#include "utils/bitset2d.hpp"
+
+namespace devilution {
+namespace {
+
+constexpr int ViewportWidth = 640;
+constexpr int ViewportHeight = 352;
+constexpr int Rows = 25;
+constexpr int Columns = 12;
+constexpr uint_fast8_t MicroTileLen = 10;
+constexpr int BufferHeight = ViewportHeight + (32 * (MicroTileLen / 2 + 1));
+
+uint8_t TileLights[MAXDUNX][MAXDUNY];
+std::array<std::array<uint8_t, LightTableSize>, NumLightingLevels> LightTables;
+std::array<uint8_t, ViewportWidth * BufferHeight> OutBuffer;
+
+std::vector<uint8_t> RenderLightmap(Point tilePosition, Point targetBufferPosition, int rows = Rows, int columns = Columns,
+    Bitset2d<MAXDUNX, MAXDUNY> *dirtyTiles = nullptr)
+{
+	const Lightmap lightmap = Lightmap::build(/*perPixelLighting=*/true, tilePosition, targetBufferPosition,
+	    ViewportWidth, ViewportHeight, rows, columns, OutBuffer.data(), ViewportWidth,
+	    LightTables, LightTables[0].data(), LightTables.back().data(),
+	    TileLights, dirtyTiles, MicroTileLen);
+	std::vector<uint8_t> result(OutBuffer.size());
+	for (size_t i = 0; i < OutBuffer.size(); ++i)
+		result[i] = *lightmap.getLightingAt(&OutBuffer[i]);
+	return result;
+}
+
+void FillTileLights()
+{
+	// A mix of smooth gradients and abrupt changes exercises every cell shape
+	for (int x = 0; x < MAXDUNX; ++x) {
+		for (int y = 0; y < MAXDUNY; ++y)
+			TileLights[x][y] = static_cast<uint8_t>(((x * 7) ^ (y * 3)) % NumLightingLevels);
+	}
+}
+
+/**
+ * @brief Renders the frames of walking a few tiles, during which lights also change.
+ * @param dirtyTiles Builds the lightmap incrementally if set, otherwise from scratch every frame
+ */
+std::vector<std::vector<uint8_t>> RenderWalk(Bitset2d<MAXDUNX, MAXDUNY> *dirtyTiles)
+{
+	FillTileLights();
+	// Start from scratch, whatever earlier tests left behind.
+	RenderLightmap({ 0, 0 }, { 0, 0 });
+
+	std::vector<std::vector<uint8_t>> frames;
+	constexpr int FramesPerTile = 8;
+	for (int frame = 0; frame < FramesPerTile * 4; ++frame) {
+		// Walking south-east, then south-west, scrolls the view by a fraction of a tile on most frames,
+		// which is when the renderer adds a row and a column to cover the partial tiles on the edges.
+		const int progress = frame % FramesPerTile;
+		const bool southEast = frame < FramesPerTile * 2;
+		const Point tilePosition = southEast ? Point { 40 + (frame / FramesPerTile), 30 } : Point { 42, 30 + (frame / FramesPerTile) - 2 };
+		const Point targetBufferPosition { (southEast ? -4 : 4) * progress, -17 - (2 * progress) };
+		const int extra = progress != 0 ? 1 : 0;
+
+		if (frame % 5 == 0) {
+			const Point changed = tilePosition + Displacement { 3 + frame % 7, 5 };
+			TileLights[changed.x][changed.y] = static_cast<uint8_t>((TileLights[changed.x][changed.y] + 5) % NumLightingLevels);
+			if (dirtyTiles != nullptr)
+				dirtyTiles->set(changed.x, changed.y);
+		}
+		frames.push_back(RenderLightmap(tilePosition, targetBufferPosition, Rows + extra, Columns + extra, dirtyTiles));
+	}
+	return frames;
+}
+
+TEST(LightmapTest, IncrementalMatchesFullRebuild)
+{
+	const std::vector<std::vector<uint8_t>> expected = RenderWalk(nullptr);
+	Bitset2d<MAXDUNX, MAXDUNY> dirtyTiles;
+	const std::vector<std::vector<uint8_t>> actual = RenderWalk(&dirtyTiles);
+	ASSERT_EQ(actual.size(), expected.size());
+	for (size_t frame = 0; frame < expected.size(); ++frame)
+		EXPECT_EQ(actual[frame], expected[frame]) << "frame " << frame;
+}
+
+class LightmapIsaTest : public ::testing::TestWithParam<LightmapIsa> {
+protected:
+	void TearDown() override
+	{
+		SetLightmapIsa(GetBestLightmapIsa());
+	}
+};
+
+TEST_P(LightmapIsaTest, MatchesScalar)
+{
+	if (!SetLightmapIsa(GetParam()))
+		GTEST_SKIP() << "Not supported by this CPU";
+
+	FillTileLights();
+
+	for (const Point targetBufferPosition : { Point { 0, -17 }, Point { -31, -1 }, Point { -64, -32 } }) {
+		const Point tilePosition { 40, 30 };
+		const std::vector<uint8_t> actual = RenderLightmap(tilePosition, targetBufferPosition);
+		SetLightmapIsa(LightmapIsa::Scalar);
+		const std::vector<uint8_t> expected = RenderLightmap(tilePosition, targetBufferPosition);
+		SetLightmapIsa(GetParam());
+		EXPECT_EQ(actual, expected) << "targetBufferPosition " << targetBufferPosition.x << "," << targetBufferPosition.y;
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(AllIsas, LightmapIsaTest,
+    ::testing::Values(LightmapIsa::Scalar, LightmapIsa::Sse2, LightmapIsa::Neon));
+
+TEST(GetBestLightmapIsaTest, IsSupported)
+{
+	EXPECT_TRUE(SetLightmapIsa(GetBestLightmapIsa()));
+}
+
+} // namespace
+} // namespace devilution
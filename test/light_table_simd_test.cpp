@@ -0,0 +1,53 @@
+#include "engine/render/light_table_simd.hpp"
+
+#include <array>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+constexpr LightTableIsa AllIsas[] = {
+	LightTableIsa::Scalar,
+	LightTableIsa::Neon,
+};
+
+class LightTableSimdTest : public ::testing::TestWithParam<LightTableIsa> { };
+
+TEST_P(LightTableSimdTest, MatchesScalarLookup)
+{
+	const LightTableKernel kernel = GetLightTableKernel(GetParam());
+	if (kernel == nullptr)
+		GTEST_SKIP() << "Not supported by this CPU";
+
+	std::array<uint8_t, 256> colorMap;
+	for (size_t i = 0; i < colorMap.size(); ++i)
+		colorMap[i] = static_cast<uint8_t>((i * 167) ^ 0x5A);
+
+	std::array<uint8_t, 300> src;
+	for (size_t i = 0; i < src.size(); ++i)
+		src[i] = static_cast<uint8_t>(i * 31 + 7);
+
+	// Cover the scalar tails, full blocks and overlapping last blocks of every implementation.
+	for (unsigned length = 1; length <= src.size(); ++length) {
+		std::array<uint8_t, 300> dst {};
+		kernel(dst.data(), src.data(), length, colorMap.data());
+		for (unsigned i = 0; i < length; ++i) {
+			ASSERT_EQ(dst[i], colorMap[src[i]]) << "length " << length << ", index " << i;
+		}
+		for (unsigned i = length; i < dst.size(); ++i) {
+			ASSERT_EQ(dst[i], 0) << "wrote past the end, length " << length;
+		}
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(AllIsas, LightTableSimdTest, ::testing::ValuesIn(AllIsas));
+
+TEST(GetBestLightTableIsaTest, IsSupported)
+{
+	EXPECT_NE(GetLightTableKernel(GetBestLightTableIsa()), nullptr);
+}
+
+} // namespace
+} // namespace devilution
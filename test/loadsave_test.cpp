@@ -0,0 +1,113 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "automap.h"
+#include "items.h"
+#include "levels/gendung.h"
+#include "loadsave.h"
+#include "monster.h"
+#include "objects.h"
+#include "player.h"
+#include "save_snapshot.hpp"
+
+using namespace devilution;
+
+namespace {
+
+/** @brief Appends a grid value by value, `[x][y]` in row order, the way the level file has always been written. */
+template <class T, size_t Width, size_t Height, class Fn>
+void AppendGrid(std::vector<uint8_t> &out, const T (&grid)[Width][Height], Fn toBytes)
+{
+	for (size_t j = 0; j < Height; j++) {
+		for (size_t i = 0; i < Width; i++)
+			toBytes(out, grid[i][j]);
+	}
+}
+
+void AppendByte(std::vector<uint8_t> &out, uint8_t value)
+{
+	out.push_back(value);
+}
+
+void AppendInt32BE(std::vector<uint8_t> &out, int32_t value)
+{
+	const auto bits = static_cast<uint32_t>(value);
+	out.push_back(static_cast<uint8_t>(bits >> 24));
+	out.push_back(static_cast<uint8_t>(bits >> 16));
+	out.push_back(static_cast<uint8_t>(bits >> 8));
+	out.push_back(static_cast<uint8_t>(bits));
+}
+
+void InitDungeonLevel()
+{
+	Players.resize(1);
+	MyPlayerId = 0;
+	MyPlayer = &Players[MyPlayerId];
+
+	leveltype = DTYPE_CATHEDRAL;
+	currlevel = 1;
+	setlevel = false;
+	ActiveMonsterCount = 0;
+	ActiveItemCount = 0;
+	ActiveObjectCount = 0;
+	memset(dItem, 0, sizeof(dItem));
+
+	// Distinct values in every cell, so that swapped axes or misplaced rows don't go unnoticed.
+	for (int i = 0; i < MAXDUNX; i++) {
+		for (int j = 0; j < MAXDUNY; j++) {
+			dCorpse[i][j] = static_cast<int8_t>(i * 3 + j * 5);
+			dFlags[i][j] = static_cast<DungeonFlag>((i * 7 + j * 13) & 0xFF);
+			dMonster[i][j] = static_cast<int16_t>((i * 31 + j * 17) % 401 - 200);
+			dObject[i][j] = static_cast<int8_t>(i * 11 - j);
+			dLight[i][j] = static_cast<uint8_t>((i + j * 2) % 16);
+			dPreLight[i][j] = static_cast<uint8_t>((i * 2 + j) % 16);
+		}
+	}
+	for (int i = 0; i < DMAXX; i++) {
+		for (int j = 0; j < DMAXY; j++)
+			AutomapView[i][j] = static_cast<uint8_t>((i + j * DMAXX) % 3);
+	}
+}
+
+std::vector<uint8_t> SaveLevelFile()
+{
+	SaveSnapshot snapshot("");
+	SaveLevel(snapshot);
+	std::vector<uint8_t> level;
+	snapshot.forEachFile([&](std::string_view, const std::byte *data, size_t size) {
+		const auto *bytes = reinterpret_cast<const uint8_t *>(data);
+		level.assign(bytes, bytes + size);
+	});
+	return level;
+}
+
+} // namespace
+
+TEST(LoadSave, DungeonLevelGridLayout)
+{
+	InitDungeonLevel();
+	const std::vector<uint8_t> level = SaveLevelFile();
+
+	std::vector<uint8_t> corpses;
+	AppendGrid(corpses, dCorpse, [](std::vector<uint8_t> &out, int8_t corpse) { AppendByte(out, static_cast<uint8_t>(corpse)); });
+
+	// Saving removes the player's vision, so the flags are read back after the level has been saved.
+	std::vector<uint8_t> grids;
+	AppendGrid(grids, dFlags, [](std::vector<uint8_t> &out, DungeonFlag flags) { AppendByte(out, static_cast<uint8_t>(flags & DungeonFlag::SavedFlags)); });
+	AppendGrid(grids, dItem, [](std::vector<uint8_t> &out, int8_t item) { AppendByte(out, static_cast<uint8_t>(item)); });
+	AppendGrid(grids, dMonster, [](std::vector<uint8_t> &out, int16_t monster) { AppendInt32BE(out, monster); });
+	AppendGrid(grids, dObject, [](std::vector<uint8_t> &out, int8_t object) { AppendByte(out, static_cast<uint8_t>(object)); });
+	AppendGrid(grids, dLight, AppendByte);
+	AppendGrid(grids, dPreLight, AppendByte);
+	AppendGrid(grids, AutomapView, AppendByte);
+
+	ASSERT_GE(level.size(), corpses.size() + grids.size());
+	const std::vector<uint8_t> head(level.begin(), level.begin() + corpses.size());
+	EXPECT_EQ(head, corpses);
+	const std::vector<uint8_t> tail(level.end() - grids.size(), level.end());
+	EXPECT_EQ(tail, grids);
+}
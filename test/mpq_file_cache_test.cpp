@@ -0,0 +1,90 @@
+#include <cstddef>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "mpq/mpq_file_cache.hpp"
+
+namespace devilution {
+namespace {
+
+std::shared_ptr<const std::byte[]> MakeData(size_t size)
+{
+	return std::shared_ptr<const std::byte[]> { new std::byte[size] {} };
+}
+
+TEST(MpqFileCacheTest, FindReturnsInsertedFile)
+{
+	MpqFileCache cache(1024);
+	const std::shared_ptr<const std::byte[]> data = MakeData(100);
+	cache.insert(1, 7, data, 100);
+
+	size_t size = 0;
+	EXPECT_EQ(cache.find(1, 7, size), data);
+	EXPECT_EQ(size, 100);
+	EXPECT_EQ(cache.find(2, 7, size), nullptr);
+	EXPECT_EQ(cache.find(1, 8, size), nullptr);
+
+	const MpqFileCache::Stats stats = cache.stats();
+	EXPECT_EQ(stats.hits, 1);
+	EXPECT_EQ(stats.misses, 2);
+	EXPECT_EQ(stats.entries, 1);
+	EXPECT_EQ(stats.bytes, 100);
+}
+
+TEST(MpqFileCacheTest, EvictsLeastRecentlyUsed)
+{
+	MpqFileCache cache(1000);
+	cache.insert(1, 1, MakeData(250), 250);
+	cache.insert(1, 2, MakeData(250), 250);
+	cache.insert(1, 3, MakeData(250), 250);
+	cache.insert(1, 4, MakeData(250), 250);
+
+	size_t size;
+	ASSERT_NE(cache.find(1, 1, size), nullptr);
+	cache.insert(1, 5, MakeData(250), 250);
+
+	EXPECT_NE(cache.find(1, 1, size), nullptr);
+	EXPECT_EQ(cache.find(1, 2, size), nullptr);
+	EXPECT_NE(cache.find(1, 5, size), nullptr);
+	EXPECT_EQ(cache.stats().evictions, 1);
+	EXPECT_EQ(cache.stats().bytes, 1000);
+}
+
+TEST(MpqFileCacheTest, RejectsLargeFiles)
+{
+	MpqFileCache cache(1000);
+	EXPECT_TRUE(cache.accepts(1000 / MpqFileCache::MaxEntryFraction));
+	EXPECT_FALSE(cache.accepts(1000 / MpqFileCache::MaxEntryFraction + 1));
+	EXPECT_FALSE(cache.accepts(0));
+
+	cache.insert(1, 1, MakeData(500), 500);
+	EXPECT_EQ(cache.stats().entries, 0);
+}
+
+TEST(MpqFileCacheTest, ZeroBudgetDisablesCache)
+{
+	MpqFileCache cache(0);
+	EXPECT_FALSE(cache.accepts(1));
+	cache.insert(1, 1, MakeData(1), 1);
+	size_t size;
+	EXPECT_EQ(cache.find(1, 1, size), nullptr);
+	EXPECT_EQ(cache.stats().misses, 0);
+}
+
+TEST(MpqFileCacheTest, ShrinkingBudgetEvicts)
+{
+	MpqFileCache cache(1000);
+	cache.insert(1, 1, MakeData(200), 200);
+	cache.insert(1, 2, MakeData(200), 200);
+	cache.setBudget(300);
+	EXPECT_EQ(cache.stats().entries, 1);
+	size_t size;
+	EXPECT_NE(cache.find(1, 2, size), nullptr);
+	cache.setBudget(0);
+	EXPECT_EQ(cache.stats().entries, 0);
+	EXPECT_EQ(cache.stats().bytes, 0);
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,81 @@
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "mpq/mpq_reader.hpp"
+#include "utils/paths.h"
+
+namespace devilution {
+namespace {
+
+// A hand-made archive with an uncompressed file, a compressed file and a localized file.
+std::expected<MpqArchive, std::string> OpenFixture()
+{
+	const std::string path = paths::BasePath() + "test/fixtures/mpq/stored.mpq";
+	return MpqArchive::Open(path.c_str());
+}
+
+std::string_view AsStringView(const std::shared_ptr<const std::byte[]> &data, size_t size)
+{
+	return std::string_view(reinterpret_cast<const char *>(data.get()), size);
+}
+
+TEST(MpqReaderTest, MapsStoredFiles)
+{
+	std::expected<MpqArchive, std::string> result = OpenFixture();
+	ASSERT_TRUE(result.has_value()) << result.error();
+	MpqArchive &archive = *result;
+	size_t size = 0;
+	EXPECT_EQ(archive.MapFile("data\\stored.bin", size), nullptr) << "Only archives with the file cache are mapped";
+
+	archive.EnableFileCache();
+	const std::shared_ptr<const std::byte[]> data = archive.MapFile("data\\stored.bin", size);
+#if defined(_WIN32) || defined(__DJGPP__)
+	EXPECT_EQ(data, nullptr);
+#else
+	ASSERT_NE(data, nullptr);
+	EXPECT_EQ(AsStringView(data, size), "hello stored file!");
+
+	const std::shared_ptr<const std::byte[]> sameFile = archive.MapFile("DATA/Stored.bin", size);
+	EXPECT_EQ(sameFile, data);
+#endif
+}
+
+TEST(MpqReaderTest, DoesNotMapOtherFiles)
+{
+	std::expected<MpqArchive, std::string> result = OpenFixture();
+	ASSERT_TRUE(result.has_value()) << result.error();
+	MpqArchive &archive = *result;
+	archive.EnableFileCache();
+	size_t size = 0;
+	EXPECT_EQ(archive.MapFile("data\\packed.bin", size), nullptr);
+	EXPECT_EQ(archive.MapFile("data\\loc.bin", size), nullptr);
+	EXPECT_EQ(archive.MapFile("data\\missing.bin", size), nullptr);
+}
+
+#if !defined(_WIN32) && !defined(__DJGPP__)
+TEST(MpqReaderTest, MappedFileOutlivesArchive)
+{
+	std::shared_ptr<const std::byte[]> data;
+	size_t size = 0;
+	{
+		std::expected<MpqArchive, std::string> archive = OpenFixture();
+		ASSERT_TRUE(archive.has_value()) << archive.error();
+		archive->EnableFileCache();
+		std::expected<MpqArchive, std::string> clone = archive->Clone();
+		ASSERT_TRUE(clone.has_value());
+		data = clone->MapFile("levels\\l1data\\l1.sol", size);
+	}
+	ASSERT_NE(data, nullptr);
+	ASSERT_EQ(size, 200);
+	for (size_t i = 0; i < size; ++i)
+		EXPECT_EQ(static_cast<size_t>(data[i]), i);
+}
+#endif
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,87 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "engine/shared_asset_cache.hpp"
+
+namespace devilution {
+namespace {
+
+using StringCache = SharedAssetCache<int, std::string>;
+
+TEST(SharedAssetCacheTest, SharesLoadedAsset)
+{
+	StringCache cache;
+	int loads = 0;
+	const auto load = [&]() {
+		++loads;
+		return std::string("asset");
+	};
+
+	const std::shared_ptr<const std::string> first = cache.getOrLoad(1, load);
+	const std::shared_ptr<const std::string> second = cache.getOrLoad(1, load);
+	EXPECT_EQ(first, second);
+	EXPECT_EQ(*first, "asset");
+	EXPECT_EQ(loads, 1);
+
+	const std::shared_ptr<const std::string> other = cache.getOrLoad(2, load);
+	EXPECT_NE(other, first);
+	EXPECT_EQ(loads, 2);
+
+	const StringCache::Stats stats = cache.stats();
+	EXPECT_EQ(stats.hits, 1);
+	EXPECT_EQ(stats.misses, 2);
+	EXPECT_EQ(stats.loaded, 2);
+}
+
+TEST(SharedAssetCacheTest, FreesAssetWithLastReference)
+{
+	StringCache cache;
+	int loads = 0;
+	const auto load = [&]() {
+		++loads;
+		return std::string("asset");
+	};
+
+	std::shared_ptr<const std::string> first = cache.getOrLoad(1, load);
+	std::shared_ptr<const std::string> second = cache.getOrLoad(1, load);
+	const std::weak_ptr<const std::string> weak = first;
+	first = nullptr;
+	EXPECT_FALSE(weak.expired());
+	second = nullptr;
+	EXPECT_TRUE(weak.expired());
+	EXPECT_EQ(cache.stats().loaded, 0);
+
+	const std::shared_ptr<const std::string> reloaded = cache.getOrLoad(1, load);
+	EXPECT_EQ(loads, 2);
+	EXPECT_EQ(cache.stats().loaded, 1);
+}
+
+TEST(SharedAssetCacheTest, ClearKeepsHeldAssets)
+{
+	StringCache cache;
+	const std::shared_ptr<const std::string> held = cache.getOrLoad(1, []() { return std::string("old"); });
+	cache.clear();
+	const std::shared_ptr<const std::string> reloaded = cache.getOrLoad(1, []() { return std::string("new"); });
+	EXPECT_EQ(*held, "old");
+	EXPECT_EQ(*reloaded, "new");
+}
+
+TEST(SharedAssetCacheTest, ForgetsFreedAssets)
+{
+	StringCache cache;
+	std::vector<std::shared_ptr<const std::string>> held;
+	for (int key = 0; key < 1000; ++key) {
+		std::shared_ptr<const std::string> asset = cache.getOrLoad(key, [key]() { return std::to_string(key); });
+		if (key % 100 == 0)
+			held.push_back(std::move(asset));
+	}
+	EXPECT_EQ(cache.stats().loaded, 10);
+	for (const std::shared_ptr<const std::string> &asset : held)
+		EXPECT_EQ(cache.getOrLoad(std::stoi(*asset), []() { return std::string(); }), asset);
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,143 @@
+#include <cstddef>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "engine/sound_cache.hpp"
+
+namespace devilution {
+namespace {
+
+struct FakeSound {
+	bool playing = false;
+
+	bool isPlaying() const
+	{
+		return playing;
+	}
+};
+
+using FakeSoundCache = SoundCache<FakeSound>;
+
+FakeSound *Insert(FakeSoundCache &cache, FakeSoundCache::Key key, size_t size, SoundCategory category = SoundCategory::Effect)
+{
+	return cache.insert(key, category, std::make_unique<FakeSound>(), size);
+}
+
+TEST(SoundCacheTest, FindReturnsInsertedSound)
+{
+	FakeSoundCache cache(1000);
+	FakeSound *sound = Insert(cache, 1, 100);
+
+	EXPECT_EQ(cache.find(1, SoundCategory::Effect), sound);
+	EXPECT_EQ(cache.find(2, SoundCategory::Effect), nullptr);
+
+	const SoundCacheStats stats = cache.stats();
+	const SoundCacheStats::Category &effects = stats.categories[static_cast<size_t>(SoundCategory::Effect)];
+	EXPECT_EQ(effects.hits, 1);
+	EXPECT_EQ(effects.misses, 1);
+	EXPECT_EQ(effects.entries, 1);
+	EXPECT_EQ(effects.bytes, 100);
+	EXPECT_EQ(stats.bytes, 100);
+}
+
+TEST(SoundCacheTest, InsertKeepsCachedSound)
+{
+	FakeSoundCache cache(1000);
+	FakeSound *sound = Insert(cache, 1, 100);
+	EXPECT_EQ(Insert(cache, 1, 100), sound);
+	EXPECT_EQ(cache.stats().bytes, 100);
+}
+
+TEST(SoundCacheTest, EvictsLeastRecentlyPlayed)
+{
+	FakeSoundCache cache(300);
+	Insert(cache, 1, 100);
+	Insert(cache, 2, 100);
+	Insert(cache, 3, 100);
+
+	ASSERT_NE(cache.find(1, SoundCategory::Effect), nullptr);
+	Insert(cache, 4, 100);
+
+	EXPECT_NE(cache.peek(1), nullptr);
+	EXPECT_EQ(cache.peek(2), nullptr);
+	EXPECT_NE(cache.peek(3), nullptr);
+	EXPECT_NE(cache.peek(4), nullptr);
+	EXPECT_EQ(cache.stats().evictions, 1);
+	EXPECT_EQ(cache.stats().bytes, 300);
+}
+
+TEST(SoundCacheTest, NeverEvictsPlayingSounds)
+{
+	FakeSoundCache cache(200);
+	FakeSound *first = Insert(cache, 1, 100);
+	FakeSound *second = Insert(cache, 2, 100);
+	first->playing = true;
+	second->playing = true;
+
+	Insert(cache, 3, 100);
+	EXPECT_EQ(cache.peek(1), first);
+	EXPECT_EQ(cache.peek(2), second);
+	EXPECT_EQ(cache.stats().bytes, 300);
+
+	first->playing = false;
+	cache.trim();
+	EXPECT_EQ(cache.peek(1), nullptr);
+	EXPECT_EQ(cache.peek(2), second);
+	EXPECT_EQ(cache.stats().bytes, 200);
+}
+
+TEST(SoundCacheTest, PrefetchesOnlyUseFreeSpace)
+{
+	FakeSoundCache cache(200);
+	Insert(cache, 1, 150);
+
+	EXPECT_FALSE(cache.insertIfRoom(2, SoundCategory::Monster, std::make_unique<FakeSound>(), 100));
+	EXPECT_NE(cache.peek(1), nullptr);
+	EXPECT_TRUE(cache.insertIfRoom(3, SoundCategory::Monster, std::make_unique<FakeSound>(), 50));
+	EXPECT_EQ(cache.stats().dropped, 1);
+	EXPECT_EQ(cache.stats().evictions, 0);
+}
+
+TEST(SoundCacheTest, NoBudgetKeepsEverything)
+{
+	FakeSoundCache cache;
+	for (FakeSoundCache::Key key = 0; key < 100; ++key)
+		Insert(cache, key, 1000);
+	cache.trim();
+	EXPECT_EQ(cache.stats().bytes, 100000);
+	EXPECT_EQ(cache.stats().evictions, 0);
+
+	cache.setBudget(10000);
+	EXPECT_EQ(cache.stats().bytes, 10000);
+	EXPECT_NE(cache.peek(99), nullptr);
+	EXPECT_EQ(cache.peek(89), nullptr);
+}
+
+TEST(SoundCacheTest, TracksCategoriesSeparately)
+{
+	FakeSoundCache cache;
+	Insert(cache, 1, 100, SoundCategory::Effect);
+	Insert(cache, 2, 200, SoundCategory::Monster);
+	Insert(cache, 3, 300, SoundCategory::Monster);
+	cache.find(2, SoundCategory::Monster);
+	cache.find(4, SoundCategory::Ui);
+
+	SoundCacheStats stats = cache.stats();
+	EXPECT_EQ(stats.categories[static_cast<size_t>(SoundCategory::Effect)].bytes, 100);
+	EXPECT_EQ(stats.categories[static_cast<size_t>(SoundCategory::Monster)].bytes, 500);
+	EXPECT_EQ(stats.categories[static_cast<size_t>(SoundCategory::Monster)].entries, 2);
+	EXPECT_EQ(stats.categories[static_cast<size_t>(SoundCategory::Monster)].hits, 1);
+	EXPECT_EQ(stats.categories[static_cast<size_t>(SoundCategory::Ui)].misses, 1);
+
+	cache.clear(SoundCategory::Monster);
+	stats = cache.stats();
+	EXPECT_EQ(stats.categories[static_cast<size_t>(SoundCategory::Monster)].bytes, 0);
+	EXPECT_EQ(stats.categories[static_cast<size_t>(SoundCategory::Monster)].entries, 0);
+	EXPECT_EQ(stats.bytes, 100);
+	EXPECT_NE(cache.peek(1), nullptr);
+	EXPECT_EQ(cache.peek(2), nullptr);
+}
+
+} // namespace
+} // namespace devilution
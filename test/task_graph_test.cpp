@@ -0,0 +1,82 @@
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utils/task_graph.hpp"
+
+namespace devilution {
+namespace {
+
+TEST(TaskGraphTest, FinishesInOrderOfAdding)
+{
+	for (const unsigned workerCount : { 0U, 4U }) {
+		std::vector<std::string> finished;
+		TaskGraph graph;
+		for (const char *name : { "a", "b", "c", "d", "e" }) {
+			graph.add(name, {}, []() {}, [&finished, name]() { finished.emplace_back(name); });
+		}
+		graph.run(workerCount);
+		EXPECT_EQ(finished, (std::vector<std::string> { "a", "b", "c", "d", "e" }));
+	}
+}
+
+TEST(TaskGraphTest, LoadsAfterDependenciesFinished)
+{
+	for (const unsigned workerCount : { 0U, 4U }) {
+		std::atomic<int> value = 0;
+		int seenByDependent = -1;
+		TaskGraph graph;
+		const TaskGraph::TaskId first = graph.add(
+		    "first", {}, [&value]() { value = 1; }, [&value]() { value = 2; });
+		graph.add("unrelated", {}, []() {});
+		graph.add("second", { first }, [&value, &seenByDependent]() { seenByDependent = value; });
+		graph.run(workerCount);
+		EXPECT_EQ(seenByDependent, 2);
+	}
+}
+
+TEST(TaskGraphTest, FinishesWhileNothingLoads)
+{
+	for (const unsigned workerCount : { 0U, 4U }) {
+		std::atomic<int> loading = 0;
+		bool finishedWhileLoading = false;
+		const auto load = [&loading]() {
+			++loading;
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			--loading;
+		};
+		const auto finish = [&loading, &finishedWhileLoading]() {
+			if (loading != 0)
+				finishedWhileLoading = true;
+		};
+		TaskGraph graph;
+		const TaskGraph::TaskId first = graph.add("first", {}, []() {}, finish);
+		graph.add("unrelated", {}, load);
+		graph.add("second", { first }, load, finish);
+		graph.add("late", {}, load);
+		graph.run(workerCount);
+		EXPECT_FALSE(finishedWhileLoading);
+	}
+}
+
+TEST(TaskGraphTest, RunsEveryLoadOnce)
+{
+	std::atomic<int> loads = 0;
+	TaskGraph graph;
+	TaskGraph::TaskId previous = graph.add("root", {}, [&loads]() { ++loads; });
+	for (int i = 0; i < 20; ++i) {
+		const TaskGraph::TaskId leaf = graph.add("leaf", {}, [&loads]() { ++loads; });
+		previous = graph.add("join", { previous, leaf }, [&loads]() { ++loads; });
+	}
+	const std::vector<TaskGraph::Timing> timings = graph.run(4);
+	EXPECT_EQ(loads, 41);
+	ASSERT_EQ(timings.size(), 41);
+	EXPECT_EQ(timings[0].name, "root");
+}
+
+} // namespace
+} // namespace devilution
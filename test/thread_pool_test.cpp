@@ -0,0 +1,84 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "utils/thread_pool.hpp"
+
+namespace devilution {
+namespace {
+
+TEST(JobThreadTest, WaitReturnsOnceTheJobHasFinished)
+{
+	JobThread thread;
+	std::atomic<bool> finished = false;
+	thread.start([&finished]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		finished = true;
+	});
+	thread.wait();
+	EXPECT_TRUE(finished);
+	EXPECT_FALSE(thread.busy());
+}
+
+TEST(JobThreadTest, RunsOneJobAtATime)
+{
+	JobThread thread;
+	std::atomic<int> running = 0;
+	std::atomic<bool> overlapped = false;
+	int finished = 0;
+	for (int i = 0; i < 5; ++i) {
+		thread.start([&]() {
+			if (++running != 1)
+				overlapped = true;
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			--running;
+			++finished;
+		});
+	}
+	thread.wait();
+	EXPECT_FALSE(overlapped);
+	EXPECT_EQ(finished, 5);
+}
+
+TEST(JobThreadTest, JobOverlapsWithTheCaller)
+{
+	JobThread thread;
+	std::atomic<bool> release = false;
+	std::atomic<bool> finished = false;
+	thread.start([&]() {
+		// Without a thread of its own, the job runs inline and mustn't wait for the caller.
+		while (!release && thread.isThreaded())
+			std::this_thread::yield();
+		finished = true;
+	});
+	if (thread.isThreaded()) {
+		EXPECT_TRUE(thread.busy());
+		EXPECT_FALSE(finished);
+	}
+	release = true;
+	thread.wait();
+	EXPECT_TRUE(finished);
+}
+
+TEST(JobThreadTest, JobIsReleasedBeforeWaitReturns)
+{
+	JobThread thread;
+	auto state = std::make_shared<int>(0);
+	std::weak_ptr<int> weakState = state;
+	thread.start([state = std::move(state)]() { ++*state; });
+	thread.wait();
+	EXPECT_TRUE(weakState.expired());
+}
+
+TEST(JobThreadTest, WaitWithoutJobReturnsImmediately)
+{
+	JobThread thread;
+	thread.wait();
+	EXPECT_FALSE(thread.busy());
+}
+
+} // namespace
+} // namespace devilution
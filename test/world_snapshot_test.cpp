@@ -0,0 +1,248 @@
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "engine/animationinfo.h"
+#include "engine/render/world_snapshot.hpp"
+#include "levels/gendung.h"
+#include "lighting.h"
+#include "monster.h"
+#include "player.h"
+
+using namespace devilution;
+
+namespace {
+
+void WriteLE16(std::vector<uint8_t> &out, size_t offset, uint16_t value)
+{
+	out[offset] = static_cast<uint8_t>(value);
+	out[offset + 1] = static_cast<uint8_t>(value >> 8);
+}
+
+void WriteLE32(std::vector<uint8_t> &out, size_t offset, uint32_t value)
+{
+	for (int i = 0; i < 4; i++)
+		out[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+/**
+ * @brief Builds a sprite sheet of empty sprites, where sprite `i` of list `l` is `l * 10 + i + 1` pixels wide.
+ */
+std::unique_ptr<uint8_t[]> MakeSheet(uint16_t numLists, uint32_t spritesPerList)
+{
+	constexpr uint32_t SpriteSize = 6;
+	const uint32_t listSize = 4 + (spritesPerList + 1) * 4 + spritesPerList * SpriteSize;
+	std::vector<uint8_t> data(numLists * 4 + numLists * listSize);
+	for (uint16_t l = 0; l < numLists; l++) {
+		const uint32_t listOffset = numLists * 4 + l * listSize;
+		WriteLE32(data, l * 4, listOffset);
+		WriteLE32(data, listOffset, spritesPerList);
+		for (uint32_t i = 0; i <= spritesPerList; i++) {
+			const uint32_t spriteOffset = 4 + (spritesPerList + 1) * 4 + i * SpriteSize;
+			WriteLE32(data, listOffset + 4 + i * 4, spriteOffset);
+			if (i == spritesPerList)
+				continue;
+			WriteLE16(data, listOffset + spriteOffset, SpriteSize);
+			WriteLE16(data, listOffset + spriteOffset + 2, static_cast<uint16_t>(l * 10 + i + 1));
+			WriteLE16(data, listOffset + spriteOffset + 4, 0);
+		}
+	}
+	auto result = std::make_unique<uint8_t[]>(data.size());
+	std::memcpy(result.get(), data.data(), data.size());
+	return result;
+}
+
+class WorldSnapshotTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		leveltype = DTYPE_CATHEDRAL;
+		Players.clear();
+		Players.resize(1);
+		MyPlayerId = 0;
+		MyPlayer = &Players[MyPlayerId];
+
+		LevelMonsterTypeCount = 0;
+		ActiveMonsterCount = 0;
+		ActiveItemCount = 0;
+		ActiveObjectCount = 0;
+		for (Monster &monster : Monsters)
+			monster.uniqueMonsterTRN = nullptr;
+
+		memset(dLight, 0, sizeof(dLight));
+		memset(dFlags, 0, sizeof(dFlags));
+		memset(dMonster, 0, sizeof(dMonster));
+		memset(dPlayer, 0, sizeof(dPlayer));
+		memset(dItem, 0, sizeof(dItem));
+		memset(dObject, 0, sizeof(dObject));
+		memset(dCorpse, 0, sizeof(dCorpse));
+		DirtyLightTiles.reset();
+		DiscardWorldSnapshots();
+	}
+
+	void TearDown() override
+	{
+		LevelMonsterTypes[0].anims[0].sprites = std::nullopt;
+		LevelMonsterTypeCount = 0;
+		ActiveMonsterCount = 0;
+		Players.clear();
+		MyPlayer = nullptr;
+		DiscardWorldSnapshots();
+	}
+
+	WorldSnapshot snapshot_ {};
+};
+
+} // namespace
+
+TEST_F(WorldSnapshotTest, CopiesGridsAndTakesLightChanges)
+{
+	dLight[10][20] = 7;
+	dMonster[11][21] = -3;
+	DirtyLightTiles.set(10, 20);
+
+	CaptureWorldSnapshot(snapshot_);
+	dLight[10][20] = 2;
+	dMonster[11][21] = 0;
+
+	EXPECT_EQ(snapshot_.light[10][20], 7);
+	EXPECT_EQ(snapshot_.monsterIds[11][21], -3);
+	EXPECT_TRUE(snapshot_.lightChanges.test(10, 20));
+	EXPECT_FALSE(snapshot_.lightChanges.test(20, 10));
+	EXPECT_FALSE(DirtyLightTiles.any()) << "The capture takes the pending light changes";
+}
+
+TEST_F(WorldSnapshotTest, MonsterSpritesAreLookedUpAgain)
+{
+	const std::unique_ptr<uint8_t[]> sheetData = MakeSheet(8, 4);
+	const ClxSpriteSheet sheet { sheetData.get(), 8 };
+	LevelMonsterTypeCount = 1;
+	LevelMonsterTypes[0].anims[0].sprites = ClxSpriteListOrSheet { sheetData.get(), 8 };
+
+	Monster &monster = Monsters[5];
+	monster.levelType = 0;
+	monster.animInfo = {};
+	monster.animInfo.sprites = sheet[2];
+	ActiveMonsters[0] = 5;
+	ActiveMonsterCount = 1;
+
+	CaptureWorldSnapshot(snapshot_);
+
+	const MonsterSnapshot &entry = snapshot_.monsters[5];
+	EXPECT_FALSE(entry.animInfo.sprites) << "A snapshot must not point into sprite data";
+	EXPECT_EQ(entry.sprites.source, SpriteListRef::Source::Monster);
+	EXPECT_EQ(entry.sprites.list, 2);
+	const OptionalClxSprite sprite = entry.sprites.frame(1);
+	ASSERT_TRUE(sprite);
+	EXPECT_EQ(sprite->width(), 22);
+	EXPECT_FALSE(entry.sprites.frame(4)) << "Frames past the end of the list are skipped";
+
+	LevelMonsterTypes[0].anims[0].sprites = std::nullopt;
+	EXPECT_FALSE(entry.sprites.frame(1)) << "Freed sprites are not drawn";
+}
+
+TEST_F(WorldSnapshotTest, UniqueTranslationIsCopied)
+{
+	Monsters[3].uniqueMonsterTRN = std::make_unique<uint8_t[]>(256);
+	Monsters[3].uniqueMonsterTRN[1] = 42;
+
+	CaptureWorldSnapshot(snapshot_);
+	Monsters[3].uniqueMonsterTRN = nullptr;
+
+	EXPECT_EQ(snapshot_.uniqueTrnIndex[2], -1);
+	const uint8_t *trn = snapshot_.uniqueTrn(snapshot_.uniqueTrnIndex[3]);
+	ASSERT_NE(trn, nullptr);
+	EXPECT_EQ(trn[1], 42);
+	EXPECT_EQ(snapshot_.uniqueTrn(-1), nullptr);
+}
+
+TEST_F(WorldSnapshotTest, PlayerSpritesStayAlive)
+{
+	Player &player = Players[0];
+	auto sheet = std::make_shared<const OwnedClxSpriteSheet>(MakeSheet(8, 3), 8);
+	player.AnimationData[0].sprites = sheet;
+	player.AnimInfo = {};
+	player.AnimInfo.sprites = (*sheet)[4];
+
+	CaptureWorldSnapshot(snapshot_);
+	player.AnimationData[0].sprites = nullptr;
+	player.AnimInfo.sprites = std::nullopt;
+	sheet = nullptr;
+
+	const PlayerSnapshot &entry = snapshot_.players[0];
+	EXPECT_FALSE(entry.animInfo.sprites);
+	const OptionalClxSprite sprite = entry.sprites.frame(2);
+	ASSERT_TRUE(sprite);
+	EXPECT_EQ(sprite->width(), 43);
+}
+
+TEST_F(WorldSnapshotTest, ClearsStaleDeadPlayerMarkers)
+{
+	dFlags[30][40] |= DungeonFlag::DeadPlayer | DungeonFlag::Lit;
+
+	CaptureWorldSnapshot(snapshot_);
+
+	EXPECT_FALSE(snapshot_.tileContainsDeadPlayer({ 30, 40 }));
+	EXPECT_TRUE(snapshot_.isTileLit({ 30, 40 }));
+	EXPECT_FALSE(HasAnyOf(dFlags[30][40], DungeonFlag::DeadPlayer));
+}
+
+TEST_F(WorldSnapshotTest, ReusesSnapshotsOnlyOnceReleased)
+{
+	PublishWorldSnapshot();
+	const WorldSnapshot *first = GetWorldSnapshot().get();
+	PublishWorldSnapshot();
+	PublishWorldSnapshot();
+	EXPECT_EQ(GetWorldSnapshot().get(), first);
+
+	const std::shared_ptr<const WorldSnapshot> held = GetWorldSnapshot();
+	const uint32_t heldSequence = held->sequence;
+	dLight[1][1] = 9;
+	PublishWorldSnapshot();
+	PublishWorldSnapshot();
+	EXPECT_NE(GetWorldSnapshot().get(), held.get());
+	EXPECT_EQ(held->sequence, heldSequence);
+	EXPECT_EQ(held->light[1][1], 0);
+	EXPECT_EQ(GetWorldSnapshot()->light[1][1], 9);
+	EXPECT_EQ(GetWorldSnapshot()->sequence, heldSequence + 2);
+}
+
+TEST_F(WorldSnapshotTest, RecapturesWhenStaleOrDiscarded)
+{
+	const std::shared_ptr<const WorldSnapshot> first = GetWorldSnapshot();
+	EXPECT_EQ(GetWorldSnapshot(), first);
+
+	MarkWorldSnapshotStale();
+	const std::shared_ptr<const WorldSnapshot> recaptured = GetWorldSnapshot();
+	EXPECT_NE(recaptured, first);
+	EXPECT_EQ(recaptured->generation, first->generation);
+
+	DiscardWorldSnapshots();
+	EXPECT_NE(GetWorldSnapshot()->generation, first->generation);
+}
+
+TEST(WorldSnapshot, MissileStopsBeforeTileItCouldCollideWith)
+{
+	MissileSnapshot missile {};
+	missile.moves = true;
+	missile.tile = { 10, 10 };
+	missile.start = { 10, 10 };
+	missile.velocity = { 48 << 16, 0 };
+
+	const MissileRenderPosition free = GetMissileRenderPosition(missile, AnimationInfo::baseValueFraction);
+	EXPECT_NE(free.tile, missile.tile);
+
+	missile.collisionMask = (1U << 25) - 1;
+	const MissileRenderPosition blocked = GetMissileRenderPosition(missile, AnimationInfo::baseValueFraction);
+	EXPECT_EQ(blocked.tile, missile.tile);
+	EXPECT_GT(blocked.offset.deltaX, 0) << "The missile still moves up to the edge of its tile";
+
+	missile.moves = false;
+	missile.offset = { 3, 4 };
+	const MissileRenderPosition still = GetMissileRenderPosition(missile, AnimationInfo::baseValueFraction);
+	EXPECT_EQ(still.tile, missile.tile);
+	EXPECT_EQ(still.offset, missile.offset);
+}
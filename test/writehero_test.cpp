@@ -14,6 +14,7 @@
 #include "loadsave.h"
 #include "pack.h"
 #include "pfile.h"
+#include "save_snapshot.hpp"
 #include "tables/playerdat.hpp"
 #include "utils/endian_swap.hpp"
 #include "utils/file_util.h"
@@ -400,6 +401,7 @@ TEST(Writehero, pfile_write_hero)
 	UnPackPlayer(pks, *MyPlayer);
 	AssertPlayer(Players[0]);
 	pfile_write_hero();
+	WaitForSaves();
 
 	uintmax_t fileSize;
 	ASSERT_TRUE(GetFileSize(savePath.c_str(), &fileSize));
@@ -1,6 +1,7 @@
 #!/usr/bin/env python
 
 import argparse
+import json
 import re
 import sys
 import statistics
@@ -8,18 +9,24 @@ import subprocess
 from typing import NamedTuple
 
 _TIME_AND_FPS_REGEX = re.compile(rb'\d+ frames, (\d+(?:\.\d+)?) seconds: (\d+(?:\.\d+)?) fps')
+_REPORT_REGEX = re.compile(rb'Timedemo report: (\{.*\})')
 
 class RunMetrics(NamedTuple):
 	time: float
 	fps: float
+	p99: float
 
 def measure(binary: str) -> RunMetrics:
 	result: subprocess.CompletedProcess = subprocess.run(
 		[binary, '--diablo', '--spawn', '--lang', 'en', '--demo', '0', '--timedemo'], capture_output=True)
+	# FPS is taken from the summary line rather than the report, which counts rendered frames,
+	# so that it stays comparable with earlier measurements.
 	match = _TIME_AND_FPS_REGEX.search(result.stderr)
-	if not match:
+	report_match = _REPORT_REGEX.search(result.stderr)
+	if not match or not report_match:
 		raise Exception(f"Failed to parse output in:\n{result.stderr}")
-	return RunMetrics(float(match.group(1)), float(match.group(2)))
+	report = json.loads(report_match.group(1))
+	return RunMetrics(float(match.group(1)), float(match.group(2)), report['frameTimeMs']['p99'])
 
 
 def main():
@@ -33,11 +40,11 @@ def main():
 	for i in range(1, num_runs + 1):
 		print(f"Run {i:>2} of {num_runs}: ", end='', file=sys.stderr, flush=True)
 		run_metrics = measure(args.binary)
-		print(f"\t{run_metrics.time:>5.2f} seconds\t{run_metrics.fps:>5.1f} FPS", file=sys.stderr, flush=True)
+		print(f"\t{run_metrics.time:>5.2f} seconds\t{run_metrics.fps:>5.1f} FPS\tp99 {run_metrics.p99:>6.2f} ms", file=sys.stderr, flush=True)
 		metrics.append(run_metrics)
 
-	mean = RunMetrics(statistics.mean(m.time for m in metrics), statistics.mean(m.fps for m in metrics))
-	stdev = RunMetrics(statistics.stdev((m.time for m in metrics), mean.time), statistics.stdev((m.fps for m in metrics), mean.fps))
-	print(f"{mean.time:.3f} ± {stdev.time:.3f} seconds, {mean.fps:.3f} ± {stdev.fps:.3f} FPS")
+	mean = RunMetrics(*(statistics.mean(m[i] for m in metrics) for i in range(len(RunMetrics._fields))))
+	stdev = RunMetrics(*(statistics.stdev((m[i] for m in metrics), mean[i]) for i in range(len(RunMetrics._fields))))
+	print(f"{mean.time:.3f} ± {stdev.time:.3f} seconds, {mean.fps:.3f} ± {stdev.fps:.3f} FPS, p99 frame time {mean.p99:.3f} ± {stdev.p99:.3f} ms")
 
 main()